@@ -39,6 +39,7 @@ find_package(Threads REQUIRED)
 find_package(melon REQUIRED)
 find_package(alkaid REQUIRED)
 find_package(turbo REQUIRED)
+find_package(ZLIB REQUIRED)
 include_directories(${melon_INCLUDE_DIR})
 include_directories(${melon_INCLUDE_DIRS})
 ############################################################
@@ -52,6 +53,7 @@ set(CARBIN_DEPS_LINK
         ${MELON_STATIC_LIBRARIES}
         ${ALKAID_LIBRARIES}
         turbo::turbo_static
+        ZLIB::ZLIB
         ${CARBIN_SYSTEM_DYLINK}
 )
 list(REMOVE_DUPLICATES CARBIN_DEPS_LINK)
@@ -0,0 +1,161 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-30.
+//
+#include <halakv/anti_entropy.h>
+#include <gflags/gflags.h>
+#include <melon/fiber/fiber.h>
+#include <melon/utility/time.h>
+#include <string_view>
+#include <unordered_map>
+
+DEFINE_int32(anti_entropy_scan_leaves, 16, "Max merkle leaves scanned from the peer in one rpc");
+
+namespace halakv {
+
+    void AntiEntropy::init(Cache *local, bool from_replica, int64_t bytes_per_second) {
+        _local = local;
+        _from_replica = from_replica;
+        _bytes_per_second = bytes_per_second;
+    }
+
+    void AntiEntropy::expose(const std::string &prefix) {
+        _round_count.expose_as(prefix, "anti_entropy_round");
+        _diff_leaf_count.expose_as(prefix, "anti_entropy_diff_leaf");
+        _repair_count.expose_as(prefix, "anti_entropy_repair");
+        _bytes_count.expose_as(prefix, "anti_entropy_bytes");
+    }
+
+    turbo::Status AntiEntropy::sync(RouterSender *peer) {
+        _round_count << 1;
+        _start_us = mutil::gettimeofday_us();
+        _bytes = 0;
+        std::vector<uint32_t> leaves;
+        auto rs = diff_leaves(peer, &leaves);
+        if (!rs.ok() || leaves.empty()) {
+            return rs;
+        }
+        _diff_leaf_count << leaves.size();
+        const size_t batch = std::max(FLAGS_anti_entropy_scan_leaves, 1);
+        for (size_t i = 0; i < leaves.size(); i += batch) {
+            std::vector<uint32_t> part(leaves.begin() + i, leaves.begin() + std::min(leaves.size(), i + batch));
+            rs = repair(peer, part);
+            if (!rs.ok()) {
+                return rs;
+            }
+        }
+        return turbo::OkStatus();
+    }
+
+    turbo::Status AntiEntropy::diff_leaves(RouterSender *peer, std::vector<uint32_t> *leaves) {
+        std::vector<uint32_t> nodes{1};
+        while (!nodes.empty()) {
+            halakv::MerkleRequest request;
+            request.set_replica(_from_replica);
+            request.mutable_nodes()->Reserve(nodes.size());
+            for (auto node: nodes) {
+                request.add_nodes(node);
+            }
+            halakv::MerkleResponse remote;
+            auto rs = peer->merkle(request, remote, 1);
+            if (!rs.ok()) {
+                return rs;
+            }
+            if (remote.hashes_size() != request.nodes_size()) {
+                return turbo::internal_error(turbo::substitute("peer returned $0 hashes for $1 nodes",
+                                                               remote.hashes_size(), request.nodes_size()));
+            }
+            throttle(remote.ByteSizeLong());
+            halakv::MerkleResponse local;
+            _local->merkle(&request, &local);
+            std::vector<uint32_t> next;
+            for (int i = 0; i < request.nodes_size(); i++) {
+                if (remote.hashes(i) == local.hashes(i)) {
+                    continue;
+                }
+                auto node = request.nodes(i);
+                if (MerkleTree::is_leaf(node)) {
+                    leaves->push_back(node);
+                } else {
+                    next.push_back(2 * node);
+                    next.push_back(2 * node + 1);
+                }
+            }
+            nodes.swap(next);
+        }
+        return turbo::OkStatus();
+    }
+
+    turbo::Status AntiEntropy::repair(RouterSender *peer, const std::vector<uint32_t> &leaves) {
+        halakv::ScanRequest request;
+        request.set_replica(_from_replica);
+        for (auto leaf: leaves) {
+            request.add_leaves(leaf);
+        }
+        halakv::ScanResponse remote;
+        auto rs = peer->scan(request, remote, 1);
+        if (!rs.ok()) {
+            return rs;
+        }
+        throttle(remote.ByteSizeLong());
+        halakv::ScanResponse local;
+        _local->scan(&request, &local);
+        std::unordered_map<std::string_view, const halakv::KvRequest *> local_values;
+        for (auto &entry: local.entries()) {
+            local_values.emplace(entry.key(), &entry);
+        }
+        halakv::KvResponse response;
+        for (auto &entry: remote.entries()) {
+            auto it = local_values.find(entry.key());
+            if (it != local_values.end()) {
+                auto same = it->second->value() == entry.value() &&
+                            it->second->expire_at_us() == entry.expire_at_us() &&
+                            it->second->flags() == entry.flags();
+                local_values.erase(it);
+                if (same) {
+                    continue;
+                }
+            }
+            _local->put(&entry, &response);
+            _repair_count << 1;
+        }
+        // what is left is gone from the peer.
+        halakv::KvRequest remove_request;
+        for (auto &it: local_values) {
+            remove_request.set_key(std::string(it.first));
+            _local->remove(&remove_request, &response);
+            _repair_count << 1;
+        }
+        return turbo::OkStatus();
+    }
+
+    void AntiEntropy::throttle(size_t bytes) {
+        _bytes += bytes;
+        _bytes_count << bytes;
+        if (_bytes_per_second <= 0) {
+            return;
+        }
+        auto expect_us = _bytes * 1000000 / _bytes_per_second;
+        auto elapsed_us = mutil::gettimeofday_us() - _start_us;
+        if (expect_us > elapsed_us) {
+            fiber_usleep(expect_us - elapsed_us);
+        }
+    }
+
+}  // namespace halakv
@@ -0,0 +1,69 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-30.
+//
+#pragma once
+
+#include <halakv/cache.h>
+#include <halakv/router_sender.h>
+#include <melon/var/var.h>
+#include <turbo/utility/status.h>
+#include <cstdint>
+#include <vector>
+
+namespace halakv {
+
+    // AntiEntropy repairs a local cache to a cache of a peer. the merkle
+    // trees are compared from the root down, one rpc per level and only the
+    // differing nodes are expanded, then the differing leaves are scanned from
+    // the peer and applied locally. the bytes read from the peer are throttled
+    // so that a repair never competes with the foreground traffic. the replica
+    // follows the cache of its primary, a restarted primary restores its cache
+    // from the replica kept by its backup.
+    class AntiEntropy {
+    public:
+        AntiEntropy() = default;
+
+        // from_replica reads the replica of the peer instead of its cache.
+        void init(Cache *local, bool from_replica, int64_t bytes_per_second);
+
+        void expose(const std::string &prefix);
+
+        turbo::Status sync(RouterSender *peer);
+
+    private:
+        turbo::Status diff_leaves(RouterSender *peer, std::vector<uint32_t> *leaves);
+
+        turbo::Status repair(RouterSender *peer, const std::vector<uint32_t> &leaves);
+
+        void throttle(size_t bytes);
+
+    private:
+        Cache *_local{nullptr};
+        bool _from_replica{false};
+        int64_t _bytes_per_second{0};
+        int64_t _start_us{0};
+        int64_t _bytes{0};
+        melon::var::Adder<int64_t> _round_count;
+        melon::var::Adder<int64_t> _diff_leaf_count;
+        melon::var::Adder<int64_t> _repair_count;
+        melon::var::Adder<int64_t> _bytes_count;
+    };
+
+}  // namespace halakv
@@ -0,0 +1,224 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-8.
+//
+#include <halakv/batch_stream.h>
+#include <halakv/fiber.h>
+#include <halakv/kv_json.h>
+#include <halakv/kv_proxy.h>
+#include <halakv/namespaces.h>
+#include <collie/nlohmann/json.hpp>
+#include <gflags/gflags.h>
+#include <melon/utility/time.h>
+#include <turbo/strings/substitute.h>
+#include <algorithm>
+#include <cerrno>
+
+DEFINE_int32(rest_batch_workers, 8, "Chunks of a ndjson batch resolved at the same time");
+DEFINE_int32(rest_batch_chunk, 32, "Keys of a ndjson batch resolved by one multi call");
+DEFINE_int32(rest_batch_write_timeout_ms, 5000, "A ndjson batch stops if the client takes none of its results in this time");
+
+namespace halakv {
+
+    BatchStream::BatchStream(Call call, bool with_value, const std::string &ns)
+            : _call(call), _with_value(with_value), _ns(ns) {
+    }
+
+    void BatchStream::init_ndjson(const mutil::IOBuf &body) {
+        // shares the blocks of the body, nothing is copied.
+        _body = body;
+        _ndjson = true;
+    }
+
+    void BatchStream::init_request(halakv::MultiKvRequest &&request) {
+        _request = std::move(request);
+        _ndjson = false;
+    }
+
+    void BatchStream::start(mutil::intrusive_ptr<melon::ProgressiveAttachment> attachment) {
+        _attachment = attachment;
+        auto workers = std::max(FLAGS_rest_batch_workers, 1);
+        _running = workers;
+        for (int i = 0; i < workers; i++) {
+            auto self = shared_from_this();
+            Fiber().run([self] {
+                self->work();
+            });
+        }
+    }
+
+    void BatchStream::work() {
+        halakv::MultiKvRequest chunk;
+        std::string lines;
+        while (!_broken.load(std::memory_order_acquire)) {
+            chunk.Clear();
+            if (!next_chunk(&chunk)) {
+                break;
+            }
+            lines.clear();
+            resolve(chunk, &lines);
+            _key_count.fetch_add(chunk.requests_size(), std::memory_order_relaxed);
+            if (!write(lines)) {
+                _broken.store(true, std::memory_order_release);
+            }
+        }
+        if (_running.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            finish();
+        }
+    }
+
+    bool BatchStream::next_chunk(halakv::MultiKvRequest *chunk) {
+        auto max = std::max(FLAGS_rest_batch_chunk, 1);
+        std::unique_lock lock(_parse_mutex);
+        if (!_status.ok()) {
+            return false;
+        }
+        if (!_ndjson) {
+            for (; _next < _request.requests_size() && chunk->requests_size() < max; _next++) {
+                chunk->add_requests()->Swap(_request.mutable_requests(_next));
+            }
+            return chunk->requests_size() > 0;
+        }
+        while (!_body.empty() && chunk->requests_size() < max) {
+            mutil::IOBuf line_buf;
+            if (_body.cut_until(&line_buf, "\n") != 0) {
+                // the last line with no newline.
+                line_buf.swap(_body);
+            }
+            ++_line_no;
+            auto line = line_buf.to_string();
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty()) {
+                continue;
+            }
+            auto rs = parse_line(line, chunk->add_requests());
+            if (!rs.ok()) {
+                chunk->mutable_requests()->RemoveLast();
+                // the keys before the bad line are still resolved.
+                _status = turbo::invalid_argument_error(turbo::substitute("line $0: $1", _line_no, rs.message()));
+                break;
+            }
+        }
+        return chunk->requests_size() > 0;
+    }
+
+    turbo::Status BatchStream::parse_line(const std::string &line, halakv::KvRequest *item) const {
+        nlohmann::json j = nlohmann::json::parse(line, nullptr, false);
+        if (j.is_discarded()) {
+            return turbo::invalid_argument_error("not a valid json");
+        }
+        if (j.is_string() && !_with_value) {
+            item->set_key(j.get<std::string>());
+            return turbo::OkStatus();
+        }
+        if (!j.is_object() || !j.contains("key") || !j["key"].is_string()) {
+            return turbo::invalid_argument_error(_with_value ? "want an object of key and value"
+                                                             : "want a key or an object of key");
+        }
+        item->set_key(j["key"].get<std::string>());
+        if (_with_value) {
+            if (!j.contains("value") || !j["value"].is_string()) {
+                return turbo::invalid_argument_error("value is not a string");
+            }
+            item->set_value(j["value"].get<std::string>());
+        }
+        if (j.contains("ns")) {
+            if (!j["ns"].is_string()) {
+                return turbo::invalid_argument_error("ns is not a string");
+            }
+            item->set_ns(j["ns"].get<std::string>());
+        }
+        return turbo::OkStatus();
+    }
+
+    void BatchStream::resolve(const halakv::MultiKvRequest &chunk, std::string *lines) {
+        halakv::MultiKvRequest request;
+        const halakv::MultiKvRequest *call_request = &chunk;
+        turbo::Status rs;
+        if (!_ns.empty() || Namespaces::has_namespace(chunk)) {
+            request = chunk;
+            for (auto &item: *request.mutable_requests()) {
+                if (!item.has_ns() && !_ns.empty()) {
+                    item.set_ns(_ns);
+                }
+            }
+            rs = Namespaces::instance()->scope(&request);
+            call_request = &request;
+        } else {
+            for (auto &item: chunk.requests()) {
+                rs = Namespaces::check_key(item.key());
+                if (!rs.ok()) {
+                    break;
+                }
+            }
+        }
+        halakv::MultiKvResponse response;
+        if (rs.ok()) {
+            rs = (KvProxy::instance()->*_call)(call_request, &response, nullptr);
+        }
+        halakv::KvResponse failed;
+        failed.set_code(static_cast<int>(rs.code()));
+        failed.set_message(std::string(rs.message()));
+        for (int i = 0; i < chunk.requests_size(); i++) {
+            // keys are written as the client sent them, not scoped.
+            auto &item = i < response.responses_size() && rs.ok() ? response.responses(i) : failed;
+            append_json_line(chunk.requests(i).key(), item, lines);
+        }
+    }
+
+    bool BatchStream::write(const std::string &data) {
+        if (data.empty()) {
+            return true;
+        }
+        mutil::IOBuf buf;
+        buf.append(data);
+        auto deadline = mutil::gettimeofday_us() + FLAGS_rest_batch_write_timeout_ms * 1000L;
+        std::unique_lock lock(_write_mutex);
+        while (true) {
+            if (_attachment->Write(buf) == 0) {
+                return true;
+            }
+            // too much not taken by the client yet, other errors mean it is gone.
+            if (errno != melon::EOVERCROWDED || mutil::gettimeofday_us() >= deadline) {
+                LOG(WARNING) << "stop ndjson batch after " << _key_count.load() << " keys: " << errno;
+                return false;
+            }
+            fiber_usleep(1000);
+        }
+    }
+
+    void BatchStream::finish() {
+        if (!_broken.load(std::memory_order_acquire)) {
+            halakv::KvResponse last;
+            last.set_code(static_cast<int>(_status.code()));
+            last.set_message(_status.ok() ? std::string("ok") : std::string(_status.message()));
+            std::string line;
+            append_json(last, &line);
+            line.pop_back();
+            line.append(turbo::substitute(R"(,"keys":$0})", _key_count.load()));
+            line.push_back('\n');
+            write(line);
+        }
+        // dropping the attachment ends the response.
+        _attachment.reset();
+    }
+
+}  // namespace halakv
@@ -0,0 +1,97 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-8.
+//
+#pragma once
+
+#include <halakv/kv.pb.h>
+#include <melon/rpc/controller.h>
+#include <melon/utility/iobuf.h>
+#include <turbo/utility/status.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace halakv {
+
+    class KvProxy;
+
+    // BatchStream resolves the keys of a batch rest call by chunks on a few
+    // fibers and writes a ndjson line per key to a progressive attachment as
+    // soon as its chunk is back, so results are in completion order, each line
+    // carries its key. only the output is streamed, the http server hands
+    // over the whole body before the batch starts. a ndjson body is parsed a
+    // line at a time as the workers ask for keys and the parsed part of it is
+    // dropped, so at most workers * chunk keys are held as requests at once. a
+    // json body is parsed whole by the caller. the last line has no key, it
+    // tells the count of keys and why the batch stopped if it did.
+    class BatchStream : public std::enable_shared_from_this<BatchStream> {
+    public:
+        using Call = turbo::Status (KvProxy::*)(const halakv::MultiKvRequest *, halakv::MultiKvResponse *,
+                                                melon::Controller *);
+
+        // ns is the namespace of the keys not naming one.
+        BatchStream(Call call, bool with_value, const std::string &ns);
+
+        // a line per key, a json string or an object of key, value and ns. the
+        // body is received whole already.
+        void init_ndjson(const mutil::IOBuf &body);
+
+        // the keys of a json body already parsed.
+        void init_request(halakv::MultiKvRequest &&request);
+
+        void start(mutil::intrusive_ptr<melon::ProgressiveAttachment> attachment);
+
+    private:
+        void work();
+
+        // false at the end of the batch or after a bad line.
+        bool next_chunk(halakv::MultiKvRequest *chunk);
+
+        turbo::Status parse_line(const std::string &line, halakv::KvRequest *item) const;
+
+        void resolve(const halakv::MultiKvRequest &chunk, std::string *lines);
+
+        // waits for the client to take what was written before, false if it is gone.
+        bool write(const std::string &data);
+
+        void finish();
+
+    private:
+        Call _call;
+        bool _with_value{false};
+        std::string _ns;
+        mutil::intrusive_ptr<melon::ProgressiveAttachment> _attachment;
+
+        std::mutex _parse_mutex;
+        bool _ndjson{false};
+        mutil::IOBuf _body;
+        halakv::MultiKvRequest _request;
+        int _next{0};
+        int64_t _line_no{0};
+        turbo::Status _status;
+
+        std::mutex _write_mutex;
+        std::atomic<bool> _broken{false};
+        std::atomic<int> _running{0};
+        std::atomic<int64_t> _key_count{0};
+    };
+
+}  // namespace halakv
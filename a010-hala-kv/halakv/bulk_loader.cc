@@ -0,0 +1,124 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-12.
+//
+#include <halakv/bulk_loader.h>
+#include <halakv/key_hash.h>
+#include <halakv/kv_proxy.h>
+#include <halakv/namespaces.h>
+#include <gflags/gflags.h>
+#include <turbo/log/logging.h>
+#include <turbo/strings/substitute.h>
+
+DEFINE_int32(load_window_bytes, 64 * 1024 * 1024, "Bytes of a bulk load stream buffered by the server before the loader waits");
+
+namespace halakv {
+
+    BulkLoader::BulkLoader() {
+        _stream_count.expose_as("halakv_load", "stream");
+        _batch_count.expose_as("halakv_load", "batch");
+        _loaded_count.expose_as("halakv_load", "loaded");
+        _failed_count.expose_as("halakv_load", "failed");
+    }
+
+    turbo::Status BulkLoader::accept(melon::Controller *cntl, const halakv::LoadRequest *request) {
+        if (!Namespaces::instance()->known(request->ns())) {
+            return turbo::invalid_argument_error(turbo::substitute("unknown namespace $0", request->ns()));
+        }
+        auto *session = new Session(this, request->ns());
+        melon::StreamOptions options;
+        options.handler = session;
+        options.max_buf_size = FLAGS_load_window_bytes;
+        melon::StreamId stream;
+        if (melon::StreamAccept(&stream, *cntl, &options) != 0) {
+            delete session;
+            return turbo::invalid_argument_error("no stream in the load request");
+        }
+        _stream_count << 1;
+        LOG(INFO) << "bulk load from " << cntl->remote_side() << " into namespace '" << request->ns() << "'";
+        return turbo::OkStatus();
+    }
+
+    int BulkLoader::Session::on_received_messages(melon::StreamId id, mutil::IOBuf *const messages[], size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            load(*messages[i]);
+        }
+        halakv::LoadAck ack;
+        ack.set_batches(_batches);
+        ack.set_loaded(_loaded);
+        ack.set_failed(_failed);
+        mutil::IOBuf buf;
+        buf.append(ack.SerializeAsString());
+        if (melon::StreamWrite(id, buf) != 0) {
+            // the next ack carries the totals anyway.
+            VLOG(10) << "ack to loader failed, batches " << _batches;
+        }
+        return 0;
+    }
+
+    void BulkLoader::Session::load(const mutil::IOBuf &message) {
+        ++_batches;
+        _loader->_batch_count << 1;
+        halakv::MultiKvRequest batch;
+        mutil::IOBufAsZeroCopyInputStream input(message);
+        if (!batch.ParseFromZeroCopyStream(&input)) {
+            LOG(WARNING) << "bad load batch " << _batches;
+            ++_failed;
+            _loader->_failed_count << 1;
+            return;
+        }
+        for (auto &item: batch.requests()) {
+            if (!Namespaces::check_key(item.key()).ok()) {
+                LOG(WARNING) << "load batch " << _batches << " has a key holding the namespace separator";
+                _failed += batch.requests_size();
+                _loader->_failed_count << batch.requests_size();
+                return;
+            }
+        }
+        if (!_ns.empty()) {
+            for (auto &item: *batch.mutable_requests()) {
+                item.set_key(scoped_key(_ns, item.key()));
+            }
+        }
+        halakv::MultiKvResponse response;
+        auto rs = KvProxy::instance()->mset(&batch, &response);
+        int64_t loaded = 0;
+        if (rs.ok()) {
+            for (auto &item: response.responses()) {
+                if (item.code() == static_cast<int>(turbo::StatusCode::kOk)) {
+                    ++loaded;
+                }
+            }
+        } else {
+            LOG(WARNING) << "load batch " << _batches << " failed: " << rs;
+        }
+        int64_t failed = batch.requests_size() - loaded;
+        _loaded += loaded;
+        _failed += failed;
+        _loader->_loaded_count << loaded;
+        _loader->_failed_count << failed;
+    }
+
+    void BulkLoader::Session::on_closed(melon::StreamId id) {
+        LOG(INFO) << "bulk load closed, batches " << _batches << " loaded " << _loaded << " failed " << _failed;
+        _loader->_stream_count << -1;
+        delete this;
+    }
+
+}  // namespace halakv
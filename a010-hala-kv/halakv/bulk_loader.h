@@ -0,0 +1,82 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-12.
+//
+#pragma once
+
+#include <halakv/kv.pb.h>
+#include <melon/rpc/controller.h>
+#include <melon/rpc/stream.h>
+#include <melon/var/var.h>
+#include <turbo/utility/status.h>
+#include <cstdint>
+#include <string>
+
+namespace halakv {
+
+    // BulkLoader takes the streams of load calls. each message of a stream is
+    // a batch of keys and values, a serialized MultiKvRequest, applied as one
+    // mset: the keys of each owner go to it in one call and the local cache is
+    // locked once per batch. every message taken is acked with the totals of
+    // the stream, the window of the stream bounds what the loader sends ahead.
+    class BulkLoader {
+    public:
+        static BulkLoader *instance() {
+            static BulkLoader ins;
+            return &ins;
+        }
+
+        // accept the stream of a load call, it lives until the loader closes it.
+        turbo::Status accept(melon::Controller *cntl, const halakv::LoadRequest *request);
+
+    private:
+        class Session : public melon::StreamInputHandler {
+        public:
+            Session(BulkLoader *loader, const std::string &ns) : _loader(loader), _ns(ns) {
+            }
+
+            int on_received_messages(melon::StreamId id, mutil::IOBuf *const messages[], size_t size) override;
+
+            void on_idle_timeout(melon::StreamId id) override {
+            }
+
+            void on_closed(melon::StreamId id) override;
+
+        private:
+            void load(const mutil::IOBuf &message);
+
+        private:
+            BulkLoader *_loader;
+            std::string _ns;
+            // messages of a stream are taken one call at a time, no lock needed.
+            uint64_t _batches{0};
+            uint64_t _loaded{0};
+            uint64_t _failed{0};
+        };
+
+        BulkLoader();
+
+    private:
+        melon::var::Adder<int64_t> _stream_count;
+        melon::var::Adder<int64_t> _batch_count;
+        melon::var::Adder<int64_t> _loaded_count;
+        melon::var::Adder<int64_t> _failed_count;
+    };
+
+}  // namespace halakv
@@ -19,53 +19,497 @@
 // Created by jeff on 24-6-19.
 //
 #include <halakv/cache.h>
+#include <halakv/hlc.h>
+#include <halakv/key_hash.h>
+#include <melon/utility/time.h>
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <unordered_set>
 
 namespace halakv {
 
-    turbo::Status Cache::init(int capacity) {
-        _cache = std::make_unique<turbo::LRUCache<std::string, std::string>>(capacity);
+    namespace {
+
+        template <typename T>
+        bool parse_integer(const std::string &s, T *value) {
+            auto result = std::from_chars(s.data(), s.data() + s.size(), *value);
+            return !s.empty() && result.ec == std::errc() && result.ptr == s.data() + s.size();
+        }
+
+    }  // namespace
+
+    turbo::Status Cache::init(int capacity, const std::vector<NamespaceOptions> &namespaces) {
+        if (capacity <= 0) {
+            return turbo::invalid_argument_error("cache capacity must be positive");
+        }
+        _capacity = capacity;
+        _namespaces = namespaces;
+        _partitions.clear();
+        _partition_index.clear();
+        _partitions.push_back(std::make_unique<Partition>());
+        _leaf_keys.assign(MerkleTree::kLeaves, {});
+        for (auto &options: namespaces) {
+            auto partition = std::make_unique<Partition>();
+            partition->options = options;
+            _partition_index[options.name] = partition.get();
+            _partitions.push_back(std::move(partition));
+        }
         return turbo::OkStatus();
     }
 
+    void Cache::expose(const std::string &prefix) {
+        for (auto &partition: _partitions) {
+            auto name = partition->options.name.empty() ? std::string("default") : partition->options.name;
+            partition->entry_count.expose_as(prefix, name + "_entries");
+            partition->bytes_count.expose_as(prefix, name + "_bytes");
+            partition->evict_count.expose_as(prefix, name + "_evict");
+            partition->hit_count.expose_as(prefix, name + "_hit");
+            partition->miss_count.expose_as(prefix, name + "_miss");
+        }
+    }
+
     void Cache::put(const halakv::KvRequest *request, halakv::KvResponse *response) {
-        if(!request->has_value()) {
+        std::unique_lock lock(_mutex);
+        apply_locked(*request, response);
+    }
+
+    void Cache::put_batch(const std::vector<const halakv::KvRequest *> &requests,
+                          const std::vector<halakv::KvResponse *> &responses) {
+        std::unique_lock lock(_mutex);
+        for (size_t i = 0; i < requests.size(); i++) {
+            apply_locked(*requests[i], responses[i]);
+        }
+    }
+
+    void Cache::apply_locked(const halakv::KvRequest &request, halakv::KvResponse *response) {
+        if (request.has_incr_by() || request.has_incr_unsigned()) {
+            incr_locked(request, response);
+            return;
+        }
+        if (request.if_absent()) {
+            auto it = _index.find(request.key());
+            if (it != _index.end() && !expired(*it->second.second, mutil::gettimeofday_us())) {
+                response->set_code(static_cast<int>(turbo::StatusCode::kAlreadyExists));
+                response->set_message("already exists");
+                return;
+            }
+        }
+        if (!request.has_value() && !request.has_expire_at_us()) {
             response->set_code(static_cast<int>(turbo::StatusCode::kInvalidArgument));
             response->set_message("no value");
             return;
         }
-        {
-            std::unique_lock lock(_mutex);
-            _cache->put(request->key(), request->value());
+        if (!request.has_value()) {
+            if (!expire_locked(request)) {
+                response->set_code(static_cast<int>(turbo::StatusCode::kNotFound));
+                response->set_message("not found");
+                return;
+            }
+            response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+            response->set_message("ok");
+            return;
         }
+        uint64_t version = 0;
+        auto applied = put_locked(request, &version);
+        response->set_version(version);
+        response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+        response->set_message(applied ? "ok" : "newer write kept");
+    }
+
+    bool Cache::put_locked(const halakv::KvRequest &request, uint64_t *version) {
+        auto it = _index.find(request.key());
+        Partition *partition;
+        if (it != _index.end()) {
+            partition = it->second.first;
+            auto &entry = *it->second.second;
+            // a resent write has the version of the entry.
+            if (request.has_version() && entry.version >= request.version()) {
+                *version = entry.version;
+                return false;
+            }
+            entry.version = version_of_locked(request);
+            set_expiry_locked(entry, request.expire_at_us());
+            _tree.remove(entry.key, entry.value);
+            int64_t delta = static_cast<int64_t>(request.value().size()) - static_cast<int64_t>(entry.value.size());
+            entry.value = request.value();
+            entry.flags = request.flags();
+            partition->bytes += delta;
+            partition->bytes_count << delta;
+            _tree.add(entry.key, entry.value);
+            entry.referenced.store(false, std::memory_order_relaxed);
+            if (partition->options.eviction == NamespaceOptions::kLru) {
+                partition->lru.splice(partition->lru.begin(), partition->lru, it->second.second);
+            }
+        } else {
+            auto tombstone = tombstone_of_locked(request.key());
+            if (request.has_version() && tombstone >= request.version()) {
+                *version = tombstone;
+                return false;
+            }
+            if (tombstone != 0) {
+                erase_tombstone_locked(request.key());
+            }
+            partition = partition_of(request.key());
+            auto &entry = partition->lru.emplace_front();
+            entry.key = request.key();
+            entry.value = request.value();
+            entry.flags = request.flags();
+            entry.version = version_of_locked(request);
+            _index.emplace(entry.key, std::make_pair(partition, partition->lru.begin()));
+            _leaf_keys[MerkleTree::leaf_of(entry.key) - MerkleTree::kLeaves].insert(entry.key);
+            _tree.add(entry.key, entry.value);
+            set_expiry_locked(entry, request.expire_at_us());
+            auto bytes = static_cast<int64_t>(entry_bytes(entry));
+            partition->bytes += bytes;
+            partition->bytes_count << bytes;
+            partition->entry_count << 1;
+            ++_size;
+        }
+        auto &entry = *_index.find(request.key())->second.second;
+        *version = entry.version;
+        notify_locked(entry.key, &entry.value, false, entry.version, entry.expire_at_us, entry.flags);
+        evict_locked(partition);
+        return true;
+    }
+
+    uint64_t Cache::version_of_locked(const halakv::KvRequest &request) {
+        if (!request.has_version()) {
+            return Hlc::instance()->now();
+        }
+        Hlc::instance()->update(request.version());
+        return request.version();
+    }
+
+    bool Cache::expire_locked(const halakv::KvRequest &request) {
+        auto it = _index.find(request.key());
+        if (it == _index.end() || expired(*it->second.second, mutil::gettimeofday_us())) {
+            return false;
+        }
+        auto &entry = *it->second.second;
+        if (request.has_version() && entry.version >= request.version()) {
+            return true;
+        }
+        entry.version = version_of_locked(request);
+        set_expiry_locked(entry, request.expire_at_us());
+        notify_locked(entry.key, nullptr, false, entry.version, entry.expire_at_us, entry.flags);
+        return true;
+    }
+
+    void Cache::incr_locked(const halakv::KvRequest &request, halakv::KvResponse *response) {
+        halakv::KvRequest write;
+        write.set_key(request.key());
+        const Entry *entry = nullptr;
+        auto it = _index.find(request.key());
+        if (it != _index.end() && !expired(*it->second.second, mutil::gettimeofday_us())) {
+            entry = &*it->second.second;
+            if (entry->expire_at_us != 0) {
+                write.set_expire_at_us(entry->expire_at_us);
+            }
+            write.set_flags(entry->flags);
+        }
+        if (request.has_incr_unsigned()) {
+            uint64_t value = 0;
+            if (entry == nullptr && !request.has_incr_initial()) {
+                response->set_code(static_cast<int>(turbo::StatusCode::kNotFound));
+                response->set_message("not found");
+                return;
+            }
+            if (entry == nullptr) {
+                value = request.incr_initial();
+                if (request.expire_at_us() != 0) {
+                    write.set_expire_at_us(request.expire_at_us());
+                }
+            } else if (!parse_integer(entry->value, &value)) {
+                response->set_code(static_cast<int>(turbo::StatusCode::kInvalidArgument));
+                response->set_message("value is not an integer");
+                return;
+            } else {
+                value += request.incr_unsigned();
+            }
+            write.set_value(std::to_string(value));
+        } else {
+            int64_t value = 0;
+            if (entry != nullptr && !parse_integer(entry->value, &value)) {
+                response->set_code(static_cast<int>(turbo::StatusCode::kInvalidArgument));
+                response->set_message("value is not an integer");
+                return;
+            }
+            auto delta = request.incr_by();
+            if ((delta > 0 && value > std::numeric_limits<int64_t>::max() - delta) ||
+                (delta < 0 && value < std::numeric_limits<int64_t>::min() - delta)) {
+                response->set_code(static_cast<int>(turbo::StatusCode::kOutOfRange));
+                response->set_message("increment would overflow");
+                return;
+            }
+            write.set_value(std::to_string(value + delta));
+        }
+        uint64_t version;
+        put_locked(write, &version);
+        response->set_version(version);
+        response->set_value(write.value());
         response->set_code(static_cast<int>(turbo::StatusCode::kOk));
         response->set_message("ok");
     }
 
+    void Cache::set_expiry_locked(Entry &entry, uint64_t expire_at_us) {
+        if (entry.expire_at_us != 0) {
+            _expiry.erase(std::make_pair(entry.expire_at_us, std::string_view(entry.key)));
+        }
+        entry.expire_at_us = expire_at_us;
+        if (expire_at_us != 0) {
+            _expiry.emplace(expire_at_us, entry.key);
+        }
+    }
+
     void Cache::get(const halakv::KvRequest *request, halakv::KvResponse *response) const {
         std::shared_lock lock(_mutex);
-        auto r = _cache->try_get(request->key());
-        if (r.second) {
-            response->set_value(*r.first);
-            response->set_code(static_cast<int>(turbo::StatusCode::kOk));
-            response->set_message("ok");
-        } else {
+        auto *entry = touch_locked(request->key());
+        if (entry == nullptr) {
+            response->clear_value();
             response->set_code(static_cast<int>(turbo::StatusCode::kNotFound));
             response->set_message("not found");
+            return;
+        }
+        response->set_version(entry->version);
+        if (entry->expire_at_us != 0) {
+            response->set_expire_at_us(entry->expire_at_us);
+        }
+        if (entry->flags != 0) {
+            response->set_flags(entry->flags);
+        }
+        response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+        if (request->has_if_not_version() && request->if_not_version() == entry->version) {
+            response->clear_value();
+            response->set_message("not modified");
+            return;
         }
+        response->set_value(entry->value);
+        response->set_message("ok");
+    }
+
+    bool Cache::lookup(std::string_view key, std::string *value, uint32_t *flags) const {
+        std::shared_lock lock(_mutex);
+        auto *entry = touch_locked(key);
+        if (entry == nullptr) {
+            return false;
+        }
+        *value = entry->value;
+        if (flags != nullptr) {
+            *flags = entry->flags;
+        }
+        return true;
+    }
+
+    const Cache::Entry *Cache::touch_locked(std::string_view key) const {
+        auto it = _index.find(key);
+        if (it == _index.end() || expired(*it->second.second, mutil::gettimeofday_us())) {
+            partition_of(key)->miss_count << 1;
+            return nullptr;
+        }
+        auto *partition = it->second.first;
+        auto &entry = *it->second.second;
+        // a store only if not set yet, so that hot keys do not bounce the cache line.
+        if (partition->options.eviction == NamespaceOptions::kLru && !entry.referenced.load(std::memory_order_relaxed)) {
+            entry.referenced.store(true, std::memory_order_relaxed);
+        }
+        partition->hit_count << 1;
+        return &entry;
     }
 
     void Cache::remove(const halakv::KvRequest *request, halakv::KvResponse *response) {
         std::unique_lock lock(_mutex);
-        auto r = _cache->try_get(request->key());
-        if (r.second) {
-            response->set_value(*r.first);
+        auto it = _index.find(request->key());
+        if (it != _index.end() && request->has_version() && it->second.second->version > request->version()) {
+            response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+            response->set_message("newer write kept");
+            return;
+        }
+        if (it != _index.end() && expired(*it->second.second, mutil::gettimeofday_us())) {
+            erase_locked(it->second.first, it->second.second);
+            notify_locked(request->key(), nullptr, true, Hlc::instance()->now(), 0);
+            it = _index.end();
+        }
+        auto version = version_of_locked(*request);
+        if (_keep_tombstones) {
+            add_tombstone_locked(request->key(), version);
+        }
+        response->set_version(version);
+        if (it != _index.end()) {
+            response->set_value(it->second.second->value);
             response->set_code(static_cast<int>(turbo::StatusCode::kOk));
             response->set_message("ok");
-            _cache->remove(request->key());
+            erase_locked(it->second.first, it->second.second);
+            notify_locked(request->key(), nullptr, true, version, 0);
         } else {
             response->set_code(static_cast<int>(turbo::StatusCode::kNotFound));
             response->set_message("not found");
         }
     }
 
-}  // namespace halakv
\ No newline at end of file
+    size_t Cache::tombstone_count() const {
+        std::shared_lock lock(_mutex);
+        return _tombstones.size();
+    }
+
+    void Cache::drop_tombstones(uint64_t before_version) {
+        std::unique_lock lock(_mutex);
+        while (!_tombstone_order.empty() && _tombstone_order.begin()->first < before_version) {
+            auto key = std::string(_tombstone_order.begin()->second);
+            _tombstone_order.erase(_tombstone_order.begin());
+            _tombstones.erase(key);
+        }
+    }
+
+    uint64_t Cache::tombstone_of_locked(const std::string &key) const {
+        auto it = _tombstones.find(key);
+        return it == _tombstones.end() ? 0 : it->second;
+    }
+
+    void Cache::add_tombstone_locked(const std::string &key, uint64_t version) {
+        auto it = _tombstones.find(key);
+        if (it != _tombstones.end()) {
+            if (it->second >= version) {
+                return;
+            }
+            _tombstone_order.erase(std::make_pair(it->second, std::string_view(it->first)));
+            it->second = version;
+        } else {
+            it = _tombstones.emplace(key, version).first;
+        }
+        _tombstone_order.emplace(version, it->first);
+    }
+
+    void Cache::erase_tombstone_locked(const std::string &key) {
+        auto it = _tombstones.find(key);
+        if (it == _tombstones.end()) {
+            return;
+        }
+        _tombstone_order.erase(std::make_pair(it->second, std::string_view(it->first)));
+        _tombstones.erase(it);
+    }
+
+    void Cache::clear() {
+        std::unique_lock lock(_mutex);
+        _index.clear();
+        for (auto &partition: _partitions) {
+            partition->entry_count << -static_cast<int64_t>(partition->lru.size());
+            partition->bytes_count << -partition->bytes;
+            partition->lru.clear();
+            partition->bytes = 0;
+        }
+        _size = 0;
+        _tree.clear();
+        _expiry.clear();
+        _tombstones.clear();
+        _tombstone_order.clear();
+        for (auto &keys: _leaf_keys) {
+            keys.clear();
+        }
+    }
+
+    void Cache::remove_expired(uint64_t now_us, size_t max, std::vector<std::string> *keys) {
+        std::unique_lock lock(_mutex);
+        while (max > 0 && !_expiry.empty() && _expiry.begin()->first <= now_us) {
+            auto it = _index.find(_expiry.begin()->second);
+            keys->push_back(it->second.second->key);
+            erase_locked(it->second.first, it->second.second);
+            notify_locked(keys->back(), nullptr, true, Hlc::instance()->now(), 0);
+            --max;
+        }
+    }
+
+    void Cache::merkle(const halakv::MerkleRequest *request, halakv::MerkleResponse *response) const {
+        std::shared_lock lock(_mutex);
+        response->mutable_hashes()->Reserve(request->nodes_size());
+        for (auto node: request->nodes()) {
+            response->add_hashes(_tree.node(node));
+        }
+        response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+        response->set_message("ok");
+    }
+
+    void Cache::scan(const halakv::ScanRequest *request, halakv::ScanResponse *response) const {
+        std::unordered_set<uint32_t> leaves(request->leaves().begin(), request->leaves().end());
+        std::shared_lock lock(_mutex);
+        auto now = mutil::gettimeofday_us();
+        for (auto leaf: leaves) {
+            if (!MerkleTree::is_leaf(leaf) || leaf >= 2 * MerkleTree::kLeaves || _leaf_keys.empty()) {
+                continue;
+            }
+            for (auto key: _leaf_keys[leaf - MerkleTree::kLeaves]) {
+                auto &entry = *_index.find(key)->second.second;
+                if (expired(entry, now)) {
+                    continue;
+                }
+                auto *item = response->add_entries();
+                item->set_key(entry.key);
+                item->set_value(entry.value);
+                if (entry.expire_at_us != 0) {
+                    item->set_expire_at_us(entry.expire_at_us);
+                }
+                if (entry.flags != 0) {
+                    item->set_flags(entry.flags);
+                }
+            }
+        }
+        response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+        response->set_message("ok");
+    }
+
+    Cache::Partition *Cache::partition_of(std::string_view key) const {
+        auto ns = namespace_of(key);
+        if (!ns.empty()) {
+            auto it = _partition_index.find(std::string(ns));
+            if (it != _partition_index.end()) {
+                return it->second;
+            }
+        }
+        // keys of unknown namespaces, from a peer configured otherwise, are
+        // charged to the default one.
+        return _partitions.front().get();
+    }
+
+    void Cache::evict_locked(Partition *writer) {
+        auto quota = writer->options.quota_bytes;
+        while (quota > 0 && writer->bytes > quota && writer->lru.size() > 1) {
+            evict_tail_locked(writer);
+        }
+        while (_size > static_cast<size_t>(_capacity)) {
+            auto *victim = writer;
+            if (victim->lru.size() <= 1) {
+                victim = std::max_element(_partitions.begin(), _partitions.end(), [](auto &a, auto &b) {
+                    return a->lru.size() < b->lru.size();
+                })->get();
+            }
+            evict_tail_locked(victim);
+        }
+    }
+
+    void Cache::evict_tail_locked(Partition *partition) {
+        auto &lru = partition->lru;
+        if (partition->options.eviction == NamespaceOptions::kLru) {
+            // each pass clears a mark, the walk ends within one round of the list.
+            while (lru.size() > 1 && lru.back().referenced.load(std::memory_order_relaxed)) {
+                lru.back().referenced.store(false, std::memory_order_relaxed);
+                lru.splice(lru.begin(), lru, std::prev(lru.end()));
+            }
+        }
+        erase_locked(partition, std::prev(lru.end()));
+        partition->evict_count << 1;
+    }
+
+    void Cache::erase_locked(Partition *partition, EntryList::iterator it) {
+        auto bytes = static_cast<int64_t>(entry_bytes(*it));
+        partition->bytes -= bytes;
+        partition->bytes_count << -bytes;
+        partition->entry_count << -1;
+        --_size;
+        set_expiry_locked(*it, 0);
+        _tree.remove(it->key, it->value);
+        _leaf_keys[MerkleTree::leaf_of(it->key) - MerkleTree::kLeaves].erase(it->key);
+        _index.erase(it->key);
+        partition->lru.erase(it);
+    }
+
+}  // namespace halakv
@@ -20,26 +20,208 @@
 //
 #pragma once
 #include <halakv/kv.pb.h>
-#include <turbo/container/cache.h>
+#include <halakv/merkle_tree.h>
+#include <halakv/namespaces.h>
+#include <melon/var/var.h>
 #include <turbo/utility/status.h>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <set>
 #include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace halakv {
 
+    // Cache is a LRU bounded by the count of entries. it keeps a merkle tree of
+    // its entries up to date on every put, remove and eviction, so that two
+    // copies can be compared by anti entropy.
+    // entries are kept in one partition per namespace, found by the prefix of
+    // the key, see scoped_key. a partition is bounded by the bytes quota of its
+    // namespace and evicts by its policy, the writer pays for the eviction, so
+    // that a namespace over its share does not push out the others.
+    // an entry may carry an expiry, every write replaces it. an expired entry
+    // is not seen by reads and is dropped by remove_expired.
+    // reads take the lock shared, they only mark the entry referenced, the lru
+    // order is kept by the writers, see Partition.
+    // versions are taken from the Hlc. with tombstones kept, a removed key
+    // keeps the version of its remove until drop_tombstones, so that a write
+    // older than the remove, replayed from a hint, is not taken.
     class Cache {
     public:
+        // a write the cache applied, valid for the call of the listener only.
+        struct Write {
+            const std::string &key;
+            // null for a remove and for a set that changed only the expiry.
+            const std::string *value;
+            bool remove;
+            // the version the entry took, or the remove was taken at.
+            uint64_t version;
+            uint64_t expire_at_us;
+            uint32_t flags;
+        };
+
+        // called under the lock of the cache for every write it applied, so the
+        // writes are seen in the order the cache took them. it must not call
+        // back into the cache.
+        using WriteListener = std::function<void(const Write &write)>;
+
         Cache()  = default;
 
-        turbo::Status init(int capacity);
+        turbo::Status init(int capacity, const std::vector<NamespaceOptions> &namespaces = {});
+
+        const std::vector<NamespaceOptions> &namespaces() const {
+            return _namespaces;
+        }
+
+        // set before the cache is written.
+        void set_write_listener(WriteListener listener) {
+            _listener = std::move(listener);
+        }
+
+        // entries, bytes, evictions, hits and misses of each namespace.
+        void expose(const std::string &prefix);
 
         void put(const halakv::KvRequest *request, halakv::KvResponse *response);
 
+        // puts under one lock, responses in the order of the requests.
+        void put_batch(const std::vector<const halakv::KvRequest *> &requests,
+                       const std::vector<halakv::KvResponse *> &responses);
+
         void get(const halakv::KvRequest *request, halakv::KvResponse *response) const;
 
+        // get without a request and response, false if the key is not there.
+        bool lookup(std::string_view key, std::string *value, uint32_t *flags = nullptr) const;
+
         void remove(const halakv::KvRequest *request, halakv::KvResponse *response);
+
+        // set before the cache is written.
+        void keep_tombstones(bool keep) {
+            _keep_tombstones = keep;
+        }
+
+        size_t tombstone_count() const;
+
+        // drops the tombstones of removes taken before the version.
+        void drop_tombstones(uint64_t before_version);
+
+        void clear();
+
+        // drops up to max entries expired at now_us, their keys are added to keys.
+        void remove_expired(uint64_t now_us, size_t max, std::vector<std::string> *keys);
+
+        int capacity() const {
+            return _capacity;
+        }
+
+        // hashes of the merkle tree nodes in request order.
+        void merkle(const halakv::MerkleRequest *request, halakv::MerkleResponse *response) const;
+
+        // the entries in the requested merkle leaves.
+        void scan(const halakv::ScanRequest *request, halakv::ScanResponse *response) const;
+    private:
+        struct Entry {
+            std::string key;
+            std::string value;
+            // when the entry was last written, a write replayed from a peer
+            // keeps the version it was taken at.
+            uint64_t version{0};
+            uint64_t expire_at_us{0};
+            uint32_t flags{0};
+            // set by a read under the shared lock, cleared by a write.
+            mutable std::atomic<bool> referenced{false};
+        };
+        using EntryList = std::list<Entry>;
+
+        struct Partition {
+            NamespaceOptions options;
+            // front is the most recently written. unless the eviction is fifo, a
+            // referenced entry at the tail is moved to the front instead of
+            // evicted, a second chance as in clock.
+            EntryList lru;
+            int64_t bytes{0};
+            melon::var::Adder<int64_t> entry_count;
+            melon::var::Adder<int64_t> bytes_count;
+            melon::var::Adder<int64_t> evict_count;
+            melon::var::Adder<int64_t> hit_count;
+            melon::var::Adder<int64_t> miss_count;
+        };
+
+        Partition *partition_of(std::string_view key) const;
+
+        // the entry of a read, counted as a hit or miss and marked referenced.
+        const Entry *touch_locked(std::string_view key) const;
+
+        void apply_locked(const halakv::KvRequest &request, halakv::KvResponse *response);
+
+        // false if the request carries a version older than the entry or its
+        // tombstone. version is set to the version the key is at.
+        bool put_locked(const halakv::KvRequest &request, uint64_t *version);
+
+        // the version carried by the request, or a new one.
+        uint64_t version_of_locked(const halakv::KvRequest &request);
+
+        // the version of the last remove of the key, 0 if none is kept.
+        uint64_t tombstone_of_locked(const std::string &key) const;
+
+        void add_tombstone_locked(const std::string &key, uint64_t version);
+
+        void erase_tombstone_locked(const std::string &key);
+
+        // a set without a value, false if the key is not there.
+        bool expire_locked(const halakv::KvRequest &request);
+
+        // a set with incr_by or incr_unsigned, the read and the write under one lock.
+        void incr_locked(const halakv::KvRequest &request, halakv::KvResponse *response);
+
+        void set_expiry_locked(Entry &entry, uint64_t expire_at_us);
+
+        void notify_locked(const std::string &key, const std::string *value, bool remove, uint64_t version,
+                           uint64_t expire_at_us, uint32_t flags = 0) {
+            if (_listener) {
+                _listener(Write{key, value, remove, version, expire_at_us, flags});
+            }
+        }
+
+        static bool expired(const Entry &entry, uint64_t now_us) {
+            return entry.expire_at_us != 0 && entry.expire_at_us <= now_us;
+        }
+
+        // evicts from the tail of the writer while it is over its quota, then
+        // from the writer or the largest partition while over the capacity.
+        void evict_locked(Partition *writer);
+
+        void evict_tail_locked(Partition *partition);
+
+        void erase_locked(Partition *partition, EntryList::iterator it);
+
+        static size_t entry_bytes(const Entry &entry) {
+            return entry.key.size() + entry.value.size();
+        }
     private:
+        int _capacity{0};
+        std::vector<NamespaceOptions> _namespaces;
         mutable std::shared_mutex _mutex;
-        std::unique_ptr<turbo::LRUCache<std::string, std::string>> _cache;
+        // the default namespace first, then the configured ones in order.
+        std::vector<std::unique_ptr<Partition>> _partitions;
+        std::unordered_map<std::string, Partition *> _partition_index;
+        size_t _size{0};
+        std::unordered_map<std::string_view, std::pair<Partition *, EntryList::iterator>> _index;
+        MerkleTree _tree;
+        // the entries with an expiry, by the time they expire at.
+        std::set<std::pair<uint64_t, std::string_view>> _expiry;
+        // the keys in each merkle leaf, so that a scan reads only the leaves asked.
+        std::vector<std::unordered_set<std::string_view>> _leaf_keys;
+        bool _keep_tombstones{false};
+        // the version of the last remove of each removed key, and the keys by it.
+        std::unordered_map<std::string, uint64_t> _tombstones;
+        std::set<std::pair<uint64_t, std::string_view>> _tombstone_order;
+        WriteListener _listener;
     };
 
 }  // namespace halakv
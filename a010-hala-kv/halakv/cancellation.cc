@@ -0,0 +1,114 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-2.
+//
+#include <halakv/cancellation.h>
+#include <algorithm>
+
+namespace halakv {
+
+    class Cancellation::OnCancel : public google::protobuf::Closure {
+    public:
+        explicit OnCancel(std::shared_ptr<State> state) : _state(std::move(state)) {
+        }
+
+        // also run when the inbound rpc ends normally, done is set by then.
+        void Run() override {
+            cancel_state(_state);
+            delete this;
+        }
+
+    private:
+        std::shared_ptr<State> _state;
+    };
+
+    Cancellation::Cancellation(melon::Controller *cntl) : _state(std::make_shared<State>()) {
+        if (cntl != nullptr) {
+            cntl->NotifyOnCancel(new OnCancel(_state));
+        }
+    }
+
+    Cancellation::~Cancellation() {
+        std::unique_lock lock(_state->mutex);
+        _state->done = true;
+        _state->calls.clear();
+        _state->callback = nullptr;
+    }
+
+    void Cancellation::cancel_state(const std::shared_ptr<State> &state) {
+        std::vector<melon::CallId> calls;
+        std::function<void()> callback;
+        {
+            std::unique_lock lock(state->mutex);
+            if (state->done || state->canceled) {
+                return;
+            }
+            state->canceled = true;
+            calls.swap(state->calls);
+            callback.swap(state->callback);
+        }
+        for (auto id: calls) {
+            melon::StartCancel(id);
+        }
+        if (callback) {
+            callback();
+        }
+    }
+
+    void Cancellation::cancel() {
+        cancel_state(_state);
+    }
+
+    void Cancellation::on_cancel(std::function<void()> callback) {
+        {
+            std::unique_lock lock(_state->mutex);
+            if (!_state->canceled) {
+                _state->callback = std::move(callback);
+                return;
+            }
+        }
+        callback();
+    }
+
+    bool Cancellation::canceled() const {
+        std::unique_lock lock(_state->mutex);
+        return _state->canceled;
+    }
+
+    bool Cancellation::enter(melon::CallId id) {
+        std::unique_lock lock(_state->mutex);
+        if (_state->canceled) {
+            return false;
+        }
+        _state->calls.push_back(id);
+        return true;
+    }
+
+    void Cancellation::leave(melon::CallId id) {
+        std::unique_lock lock(_state->mutex);
+        auto &calls = _state->calls;
+        auto it = std::find_if(calls.begin(), calls.end(), [id](const melon::CallId &call) {
+            return call.value == id.value;
+        });
+        if (it != calls.end()) {
+            calls.erase(it);
+        }
+    }
+
+}  // namespace halakv
@@ -0,0 +1,78 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-2.
+//
+#pragma once
+
+#include <melon/rpc/controller.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace halakv {
+
+    // Cancellation ties the outbound calls made for an inbound rpc to it. when
+    // the client cancels or disconnects, the calls in flight are canceled and
+    // no more retries are tried. it lives on the stack of the handler, which
+    // must return before the inbound rpc is done.
+    class Cancellation {
+    public:
+        // a null controller is never canceled.
+        explicit Cancellation(melon::Controller *cntl);
+
+        ~Cancellation();
+
+        Cancellation(const Cancellation &) = delete;
+
+        Cancellation &operator=(const Cancellation &) = delete;
+
+        bool canceled() const;
+
+        // cancels the calls in flight and the ones to come, as the client would.
+        void cancel();
+
+        // run once when canceled, at once if it is already. not run after the
+        // handler returned.
+        void on_cancel(std::function<void()> callback);
+
+        // an outbound call about to be made, false if the inbound rpc is canceled already.
+        bool enter(melon::CallId id);
+
+        void leave(melon::CallId id);
+
+    private:
+        // shared with the callback of the inbound controller, which may run
+        // after the handler returned.
+        struct State {
+            std::mutex mutex;
+            bool canceled{false};
+            bool done{false};
+            std::vector<melon::CallId> calls;
+            std::function<void()> callback;
+        };
+
+        static void cancel_state(const std::shared_ptr<State> &state);
+
+        class OnCancel;
+
+        std::shared_ptr<State> _state;
+    };
+
+}  // namespace halakv
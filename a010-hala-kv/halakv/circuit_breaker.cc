@@ -0,0 +1,130 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-28.
+//
+#include <halakv/circuit_breaker.h>
+#include <gflags/gflags.h>
+#include <turbo/log/logging.h>
+#include <melon/utility/time.h>
+#include <algorithm>
+
+DEFINE_double(breaker_error_rate, 0.5, "Open the breaker of a peer when its error rate is over this");
+DEFINE_int64(breaker_latency_us, 0, "Open the breaker of a peer when its average latency is over this, 0 disables it");
+DEFINE_int32(breaker_min_samples, 20, "Calls needed before the breaker of a peer can open");
+DEFINE_double(breaker_ema_alpha, 0.05, "Weight of the latest call in the moving averages of the breaker");
+DEFINE_int32(breaker_open_ms, 100, "Initial time a breaker stays open before a probe");
+DEFINE_int32(breaker_max_open_ms, 5000, "Max time a breaker stays open before a probe");
+
+namespace halakv {
+
+    void CircuitBreaker::init(const std::string &name) {
+        _name = name;
+        _open_duration_us = 1000L * FLAGS_breaker_open_ms;
+        _state_var = std::make_unique<melon::var::PassiveStatus<int>>(get_state, this);
+        _state_var->expose_as("halakv_breaker", name + "_state");
+        _open_count.expose_as("halakv_breaker", name + "_open");
+        _close_count.expose_as("halakv_breaker", name + "_close");
+        _reject_count.expose_as("halakv_breaker", name + "_reject");
+    }
+
+    bool CircuitBreaker::allow() {
+        if (_state.load(std::memory_order_relaxed) == kClosed) {
+            return true;
+        }
+        std::unique_lock lock(_mutex);
+        auto state = _state.load(std::memory_order_relaxed);
+        if (state == kClosed) {
+            return true;
+        }
+        if (state == kOpen && mutil::gettimeofday_us() >= _open_until_us) {
+            _state.store(kHalfOpen, std::memory_order_relaxed);
+            state = kHalfOpen;
+        }
+        if (state == kHalfOpen && !_probing) {
+            _probing = true;
+            return true;
+        }
+        _reject_count << 1;
+        return false;
+    }
+
+    void CircuitBreaker::on_success(int64_t latency_us) {
+        std::unique_lock lock(_mutex);
+        if (_state.load(std::memory_order_relaxed) != kClosed) {
+            close_locked();
+            return;
+        }
+        const double alpha = FLAGS_breaker_ema_alpha;
+        _error_ema = _error_ema * (1 - alpha);
+        _latency_ema_us = _latency_ema_us * (1 - alpha) + latency_us * alpha;
+        ++_samples;
+        if (FLAGS_breaker_latency_us > 0 && _samples >= FLAGS_breaker_min_samples &&
+            _latency_ema_us > FLAGS_breaker_latency_us) {
+            trip_locked(mutil::gettimeofday_us());
+        }
+    }
+
+    void CircuitBreaker::on_failure() {
+        std::unique_lock lock(_mutex);
+        auto now = mutil::gettimeofday_us();
+        if (_state.load(std::memory_order_relaxed) != kClosed) {
+            // the probe failed, stay open for longer.
+            _open_duration_us = std::min<int64_t>(_open_duration_us * 2, 1000L * FLAGS_breaker_max_open_ms);
+            _open_until_us = now + _open_duration_us;
+            _state.store(kOpen, std::memory_order_relaxed);
+            _probing = false;
+            return;
+        }
+        const double alpha = FLAGS_breaker_ema_alpha;
+        _error_ema = _error_ema * (1 - alpha) + alpha;
+        ++_samples;
+        if (_samples >= FLAGS_breaker_min_samples && _error_ema > FLAGS_breaker_error_rate) {
+            trip_locked(now);
+        }
+    }
+
+    void CircuitBreaker::release_probe() {
+        std::unique_lock lock(_mutex);
+        _probing = false;
+    }
+
+    void CircuitBreaker::trip_locked(int64_t now_us) {
+        LOG(WARNING) << "circuit breaker of " << _name << " open, error rate: " << _error_ema << " latency: " << _latency_ema_us << "us";
+        _open_until_us = now_us + _open_duration_us;
+        _state.store(kOpen, std::memory_order_relaxed);
+        _probing = false;
+        _open_count << 1;
+    }
+
+    void CircuitBreaker::close_locked() {
+        LOG(INFO) << "circuit breaker of " << _name << " closed";
+        _state.store(kClosed, std::memory_order_relaxed);
+        _probing = false;
+        _error_ema = 0;
+        _latency_ema_us = 0;
+        _samples = 0;
+        _open_duration_us = 1000L * FLAGS_breaker_open_ms;
+        _close_count << 1;
+    }
+
+    int CircuitBreaker::get_state(void *arg) {
+        return static_cast<CircuitBreaker *>(arg)->state();
+    }
+
+}  // namespace halakv
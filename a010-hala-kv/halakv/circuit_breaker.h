@@ -0,0 +1,83 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-28.
+//
+#pragma once
+
+#include <melon/var/var.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace halakv {
+
+    // CircuitBreaker tracks the error rate and latency of the calls to a peer with
+    // exponential moving averages. when either goes over its threshold the breaker
+    // opens and calls fail fast, after a cool down one probe call is let through
+    // (half open), its result closes the breaker or opens it again for longer.
+    class CircuitBreaker {
+    public:
+        enum State {
+            kClosed = 0,
+            kOpen = 1,
+            kHalfOpen = 2
+        };
+
+        CircuitBreaker() = default;
+
+        void init(const std::string &name);
+
+        bool allow();
+
+        void on_success(int64_t latency_us);
+
+        void on_failure();
+
+        // the allowed call was not made, let the next one probe.
+        void release_probe();
+
+        State state() const {
+            return _state.load(std::memory_order_relaxed);
+        }
+
+    private:
+        void trip_locked(int64_t now_us);
+
+        void close_locked();
+
+        static int get_state(void *arg);
+
+    private:
+        std::string _name;
+        std::mutex _mutex;
+        std::atomic<State> _state{kClosed};
+        double _error_ema{0};
+        double _latency_ema_us{0};
+        int64_t _samples{0};
+        int64_t _open_until_us{0};
+        int64_t _open_duration_us{0};
+        bool _probing{false};
+        std::unique_ptr<melon::var::PassiveStatus<int>> _state_var;
+        melon::var::Adder<int64_t> _open_count;
+        melon::var::Adder<int64_t> _close_count;
+        melon::var::Adder<int64_t> _reject_count;
+    };
+
+}  // namespace halakv
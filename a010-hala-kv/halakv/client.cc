@@ -23,41 +23,177 @@
 #include <gflags/gflags.h>
 #include <turbo/log/logging.h>
 #include <melon/utility/time.h>
-#include <melon/rpc/channel.h>
+#include <halakv/kv_client.h>
+#include <halakv/kv_loader.h>
 #include <halakv/kv.pb.h>
+#include <turbo/strings/str_split.h>
+#include <melon/rpc/channel.h>
+#include <melon/rpc/stream.h>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <thread>
 
-DEFINE_string(op, "", "Operation type. Available values: set, get, remove");
-DEFINE_string(key, "", "Key to operate");
-DEFINE_string(value, "", "Value to operate");
-DEFINE_string(protocol, "melon_std", "Protocol type. Defined in melon/rpc/options.proto");
-DEFINE_string(connection_type, "", "Connection type. Available values: single, pooled, short");
-DEFINE_string(server, "0.0.0.0:8018", "IP Address of server");
+DEFINE_string(op, "", "Operation type. Available values: set, get, remove, mset, mget, mremove, load, watch");
+DEFINE_string(key, "", "Key to operate, comma separated keys for mset, mget and mremove, prefixes for watch");
+DEFINE_string(value, "", "Value to operate, comma separated values for mset");
+DEFINE_string(connection_type, "pooled", "Connection type. Available values: single, pooled, short");
+DEFINE_string(server, "0.0.0.0:8018", "Comma separated servers to fetch the route table from");
 DEFINE_int32(timeout_ms, 100, "RPC timeout in milliseconds");
-DEFINE_int32(max_retry, 3, "Max retries(not including the first RPC)"); 
-DEFINE_int32(interval_ms, 1000, "Milliseconds between consecutive requests");
+DEFINE_int32(max_redirects, 3, "Max redirects followed when the route table is stale");
+DEFINE_string(file, "", "File to load, a key, a tab and a value per line");
+DEFINE_string(ns, "", "Namespace the keys are loaded into or watched in");
+DEFINE_int32(load_batch_keys, 1000, "Keys of each batch sent by load");
+
+// streams the lines of the file to the server, which routes them to their owners.
+static int load() {
+    std::ifstream input(FLAGS_file);
+    if (!input) {
+        LOG(ERROR) << "Fail to open " << FLAGS_file;
+        return -1;
+    }
+    std::vector<std::string> servers = turbo::str_split(FLAGS_server, ",", turbo::SkipEmpty());
+    if (servers.empty()) {
+        LOG(ERROR) << "Please specify server";
+        return -1;
+    }
+    halakv::KvLoaderOptions options;
+    options.server = servers.front();
+    options.ns = FLAGS_ns;
+    options.timeout_ms = FLAGS_timeout_ms;
+    options.batch_keys = FLAGS_load_batch_keys;
+    halakv::KvLoader loader;
+    auto rs = loader.open(options);
+    if (!rs.ok()) {
+        LOG(ERROR) << rs;
+        return -1;
+    }
+    auto start_us = mutil::gettimeofday_us();
+    std::string line;
+    while (std::getline(input, line)) {
+        auto pos = line.find('\t');
+        if (pos == std::string::npos || pos == 0) {
+            continue;
+        }
+        rs = loader.add(std::string_view(line).substr(0, pos), std::string_view(line).substr(pos + 1));
+        if (!rs.ok()) {
+            LOG(ERROR) << rs;
+            return -1;
+        }
+    }
+    halakv::LoadAck ack;
+    rs = loader.finish(&ack);
+    auto elapsed_ms = (mutil::gettimeofday_us() - start_us) / 1000;
+    LOG(INFO) << "Loaded " << ack.loaded() << " keys in " << elapsed_ms << "ms, failed " << ack.failed();
+    if (!rs.ok()) {
+        LOG(ERROR) << rs;
+        return -1;
+    }
+    return 0;
+}
+
+// prints the events of a watch stream.
+class WatchPrinter : public melon::StreamInputHandler {
+public:
+    explicit WatchPrinter(const std::string &server) : _server(server) {
+    }
+
+    int on_received_messages(melon::StreamId id, mutil::IOBuf *const messages[], size_t size) override {
+        for (size_t i = 0; i < size; i++) {
+            halakv::WatchBatch batch;
+            if (!batch.ParseFromString(messages[i]->to_string())) {
+                continue;
+            }
+            if (batch.resync()) {
+                LOG(INFO) << _server << " resync up to seq " << batch.resync_seq();
+            }
+            for (auto &event: batch.events()) {
+                LOG(INFO) << _server << " seq " << event.seq() << (event.remove() ? " remove " : " set ") << event.key();
+            }
+        }
+        return 0;
+    }
+
+    void on_idle_timeout(melon::StreamId id) override {
+    }
+
+    void on_closed(melon::StreamId id) override {
+        LOG(INFO) << "watch of " << _server << " closed";
+    }
+
+private:
+    std::string _server;
+};
+
+// watches every server listed, each pushes the writes of the keys it owns.
+static int watch() {
+    std::vector<std::string> servers = turbo::str_split(FLAGS_server, ",", turbo::SkipEmpty());
+    std::vector<std::string> prefixes = turbo::str_split(FLAGS_key, ",", turbo::SkipEmpty());
+    halakv::WatchRequest request;
+    for (auto &prefix: prefixes) {
+        request.add_prefixes(prefix);
+    }
+    if (!FLAGS_ns.empty()) {
+        request.set_ns(FLAGS_ns);
+    }
+    std::vector<std::unique_ptr<melon::Channel>> channels;
+    std::vector<std::unique_ptr<WatchPrinter>> printers;
+    for (auto &server: servers) {
+        melon::ChannelOptions options;
+        options.timeout_ms = FLAGS_timeout_ms;
+        auto channel = std::make_unique<melon::Channel>();
+        if (channel->Init(server.c_str(), &options) != 0) {
+            LOG(ERROR) << "Fail to initialize channel to " << server;
+            return -1;
+        }
+        auto printer = std::make_unique<WatchPrinter>(server);
+        melon::StreamOptions stream_options;
+        stream_options.handler = printer.get();
+        melon::StreamId stream;
+        melon::Controller cntl;
+        if (melon::StreamCreate(&stream, cntl, &stream_options) != 0) {
+            LOG(ERROR) << "Fail to create stream to " << server;
+            return -1;
+        }
+        halakv::KvService_Stub stub(channel.get());
+        halakv::KvResponse response;
+        stub.watch(&cntl, &request, &response, nullptr);
+        if (cntl.Failed()) {
+            LOG(ERROR) << "Fail to watch " << server << ": " << cntl.ErrorText();
+            melon::StreamClose(stream);
+            return -1;
+        }
+        channels.push_back(std::move(channel));
+        printers.push_back(std::move(printer));
+    }
+    // until killed.
+    while (true) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+}
 
 int main(int argc, char* argv[]) {
     // Parse gflags. We recommend you to use gflags as well.
     google::ParseCommandLineFlags(&argc, &argv, true);
-    
-    // A Channel represents a communication line to a Server. Notice that 
-    // Channel is thread-safe and can be shared by all threads in your program.
-    melon::Channel channel;
-    
-    // Initialize the channel, NULL means using default options.
-    melon::ChannelOptions options;
-    options.protocol = FLAGS_protocol;
+    if (FLAGS_op == "load") {
+        return load();
+    }
+    if (FLAGS_op == "watch") {
+        return watch();
+    }
+
+    // the client sends each key straight to the peer owning it.
+    halakv::KvClientOptions options;
+    options.servers = FLAGS_server;
     options.connection_type = FLAGS_connection_type;
-    options.timeout_ms = FLAGS_timeout_ms/*milliseconds*/;
-    options.max_retry = FLAGS_max_retry;
-    if (channel.Init(FLAGS_server.c_str(), "", &options) != 0) {
-        LOG(ERROR) << "Fail to initialize channel";
+    options.timeout_ms = FLAGS_timeout_ms;
+    options.max_redirects = FLAGS_max_redirects;
+    halakv::KvClient client;
+    auto rs = client.init(options);
+    if (!rs.ok()) {
+        LOG(ERROR) << "Fail to initialize client: " << rs;
         return -1;
     }
-
-    // Normally, you should not call a Channel directly, but instead construct
-    // a stub Service wrapping it. stub can be shared by all threads as well.
-    halakv::KvService_Stub stub(&channel);
     if(FLAGS_op.empty()) {
         LOG(ERROR) << "Please specify operation type";
         return -1;
@@ -67,54 +203,56 @@ int main(int argc, char* argv[]) {
         return -1;
     }
 
-    if(FLAGS_op == "set") {
-        if(FLAGS_value.empty()) {
+    if(FLAGS_op == "set" || FLAGS_op == "get" || FLAGS_op == "remove") {
+        if(FLAGS_op == "set" && FLAGS_value.empty()) {
             LOG(ERROR) << "Please specify value";
             return -1;
         }
         halakv::KvRequest request;
         halakv::KvResponse response;
-        melon::Controller cntl;
         request.set_key(FLAGS_key);
-        request.set_value(FLAGS_value);
-        stub.set(&cntl, &request, &response, NULL);
-        if (!cntl.Failed()) {
-            LOG(INFO) << "Received response from " << cntl.remote_side()
-                << " to " << cntl.local_side()
-                << ": " << response.ShortDebugString();
+        if(FLAGS_op == "set") {
+            request.set_value(FLAGS_value);
+            rs = client.set(request, &response);
+        } else if(FLAGS_op == "get") {
+            rs = client.get(request, &response);
+        } else {
+            rs = client.remove(request, &response);
+        }
+        if (rs.ok()) {
+            LOG(INFO) << "Received response of epoch " << client.epoch() << ": " << response.ShortDebugString();
         } else {
-            LOG(WARNING) << cntl.ErrorText();
+            LOG(WARNING) << rs;
         }
         return 0;
     }
-    if(FLAGS_op == "get") {
-           halakv::KvRequest request;
-            halakv::KvResponse response;
-            melon::Controller cntl;
-            request.set_key(FLAGS_key);
-            stub.get(&cntl, &request, &response, NULL);
-            if (!cntl.Failed()) {
-                LOG(INFO) << "Received response from " << cntl.remote_side()
-                          << " to " << cntl.local_side()
-                          << ": " << response.ShortDebugString();
-            } else {
-                LOG(WARNING) << cntl.ErrorText();
+    if(FLAGS_op == "mset" || FLAGS_op == "mget" || FLAGS_op == "mremove") {
+        std::vector<std::string> keys = turbo::str_split(FLAGS_key, ",", turbo::SkipEmpty());
+        std::vector<std::string> values = turbo::str_split(FLAGS_value, ",");
+        if(FLAGS_op == "mset" && values.size() != keys.size()) {
+            LOG(ERROR) << "Please specify one value for each key";
+            return -1;
+        }
+        halakv::MultiKvRequest request;
+        halakv::MultiKvResponse response;
+        for(size_t i = 0; i < keys.size(); i++) {
+            auto *item = request.add_requests();
+            item->set_key(keys[i]);
+            if(FLAGS_op == "mset") {
+                item->set_value(values[i]);
             }
-            return 0;
-    }
-
-    if(FLAGS_op == "remove") {
-        halakv::KvRequest request;
-        halakv::KvResponse response;
-        melon::Controller cntl;
-        request.set_key(FLAGS_key);
-        stub.remove(&cntl, &request, &response, NULL);
-        if (!cntl.Failed()) {
-            LOG(INFO) << "Received response from " << cntl.remote_side()
-                << " to " << cntl.local_side()
-                << ": " << response.ShortDebugString();
+        }
+        if(FLAGS_op == "mset") {
+            rs = client.mset(request, &response);
+        } else if(FLAGS_op == "mget") {
+            rs = client.mget(request, &response);
+        } else {
+            rs = client.mremove(request, &response);
+        }
+        if (rs.ok()) {
+            LOG(INFO) << "Received response of epoch " << client.epoch() << ": " << response.ShortDebugString();
         } else {
-            LOG(WARNING) << cntl.ErrorText();
+            LOG(WARNING) << rs;
         }
         return 0;
     }
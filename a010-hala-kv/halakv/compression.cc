@@ -0,0 +1,224 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-9.
+//
+#include <halakv/compression.h>
+#include <gflags/gflags.h>
+#include <turbo/log/logging.h>
+#include <melon/utility/time.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <functional>
+#include <string_view>
+#include <zlib.h>
+
+DEFINE_int32(http_compress_min_bytes, 4096, "Http bodies smaller than this are sent as they are");
+DEFINE_int32(rpc_compress_min_bytes, 4096, "Rpc responses with fewer bytes of values than this are not compressed");
+DEFINE_string(rpc_compress_type, "gzip", "Compress type of large rpc responses. Available values: gzip, zlib, snappy, none");
+DEFINE_int64(compress_cache_bytes, 64 * 1024 * 1024, "Max bytes of gzip bodies kept to be sent again");
+
+namespace halakv {
+
+    bool gzip_compress(const std::string &in, std::string *out, int level) {
+        z_stream stream{};
+        // 16 on the window bits asks for a gzip header.
+        if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return false;
+        }
+        out->resize(deflateBound(&stream, in.size()));
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(in.data()));
+        stream.avail_in = in.size();
+        stream.next_out = reinterpret_cast<Bytef *>(out->data());
+        stream.avail_out = out->size();
+        auto rc = deflate(&stream, Z_FINISH);
+        out->resize(stream.total_out);
+        deflateEnd(&stream);
+        return rc == Z_STREAM_END;
+    }
+
+    void Compressor::expose(const std::string &prefix) {
+        _in_bytes.expose_as(prefix, "in_bytes");
+        _out_bytes.expose_as(prefix, "out_bytes");
+        _hit_count.expose_as(prefix, "cache_hit");
+        _miss_count.expose_as(prefix, "cache_miss");
+        _rpc_count.expose_as(prefix, "rpc");
+        _rpc_bytes.expose_as(prefix, "rpc_bytes");
+        _compress_latency.expose(prefix, "gzip");
+        _ratio_var = std::make_unique<melon::var::PassiveStatus<double>>(get_ratio, this);
+        _ratio_var->expose_as(prefix, "ratio");
+    }
+
+    namespace {
+
+        std::string_view trim(std::string_view s) {
+            while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+                s.remove_prefix(1);
+            }
+            while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) {
+                s.remove_suffix(1);
+            }
+            return s;
+        }
+
+        bool iequals(std::string_view a, std::string_view b) {
+            return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+                return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+            });
+        }
+
+        // the q of the parameters of a coding, 1 if not given. a bad q counts as 0.
+        double quality_of(std::string_view params) {
+            while (!params.empty()) {
+                auto end = params.find(';');
+                auto param = trim(params.substr(0, end));
+                params = end == std::string_view::npos ? std::string_view() : params.substr(end + 1);
+                auto eq = param.find('=');
+                if (eq == std::string_view::npos || !iequals(trim(param.substr(0, eq)), "q")) {
+                    continue;
+                }
+                auto value = std::string(trim(param.substr(eq + 1)));
+                char *parsed = nullptr;
+                auto q = std::strtod(value.c_str(), &parsed);
+                if (value.empty() || parsed != value.c_str() + value.size()) {
+                    return 0;
+                }
+                return q;
+            }
+            return 1;
+        }
+
+    }  // namespace
+
+    bool Compressor::accepts_gzip(const std::string *accept_encoding) {
+        if (accept_encoding == nullptr) {
+            return false;
+        }
+        // gzip named takes over a *, as in rfc 9110.
+        double gzip_q = -1;
+        double any_q = -1;
+        std::string_view codings(*accept_encoding);
+        while (!codings.empty()) {
+            auto end = codings.find(',');
+            auto coding = codings.substr(0, end);
+            codings = end == std::string_view::npos ? std::string_view() : codings.substr(end + 1);
+            auto semi = coding.find(';');
+            auto name = trim(coding.substr(0, semi));
+            auto q = semi == std::string_view::npos ? 1.0 : quality_of(coding.substr(semi + 1));
+            if (iequals(name, "gzip") || iequals(name, "x-gzip")) {
+                gzip_q = q;
+            } else if (name == "*") {
+                any_q = q;
+            }
+        }
+        return gzip_q >= 0 ? gzip_q > 0 : any_q > 0;
+    }
+
+    size_t Compressor::http_min_bytes() {
+        return static_cast<size_t>(std::max(FLAGS_http_compress_min_bytes, 0));
+    }
+
+    bool Compressor::http_gzip(const std::string *accept_encoding, const Key *key, const std::string &body,
+                               mutil::IOBuf *out) {
+        if (body.size() < static_cast<size_t>(FLAGS_http_compress_min_bytes) || !accepts_gzip(accept_encoding)) {
+            return false;
+        }
+        if (key != nullptr && lookup(*key, out)) {
+            _hit_count << 1;
+            return true;
+        }
+        _miss_count << 1;
+        auto start = mutil::gettimeofday_us();
+        std::string compressed;
+        auto ok = gzip_compress(body, &compressed);
+        _compress_latency << mutil::gettimeofday_us() - start;
+        _in_bytes << body.size();
+        if (!ok || compressed.size() >= body.size()) {
+            _out_bytes << body.size();
+            return false;
+        }
+        _out_bytes << compressed.size();
+        out->append(compressed);
+        if (key != nullptr) {
+            insert(*key, *out);
+        }
+        return true;
+    }
+
+    void Compressor::rpc_compress(melon::Controller *cntl, size_t value_bytes) {
+        if (value_bytes < static_cast<size_t>(FLAGS_rpc_compress_min_bytes)) {
+            return;
+        }
+        melon::CompressType type;
+        if (FLAGS_rpc_compress_type == "gzip") {
+            type = melon::COMPRESS_TYPE_GZIP;
+        } else if (FLAGS_rpc_compress_type == "zlib") {
+            type = melon::COMPRESS_TYPE_ZLIB;
+        } else if (FLAGS_rpc_compress_type == "snappy") {
+            type = melon::COMPRESS_TYPE_SNAPPY;
+        } else {
+            return;
+        }
+        // the client decompresses by the type in the response meta, nothing to
+        // negotiate. melon compresses the serialized response after the handler
+        // returned, so its size and time are not seen here and a cached form
+        // can not be handed to it.
+        cntl->set_response_compress_type(type);
+        _rpc_count << 1;
+        _rpc_bytes << value_bytes;
+    }
+
+    bool Compressor::lookup(const Key &key, mutil::IOBuf *out) {
+        std::unique_lock lock(_mutex);
+        auto it = _index.find(key);
+        if (it == _index.end()) {
+            return false;
+        }
+        _lru.splice(_lru.begin(), _lru, it->second);
+        // shares the blocks of the cached body.
+        out->append(it->second->gzip);
+        return true;
+    }
+
+    void Compressor::insert(const Key &key, const mutil::IOBuf &gzip) {
+        if (FLAGS_compress_cache_bytes <= 0 || gzip.size() > static_cast<size_t>(FLAGS_compress_cache_bytes)) {
+            return;
+        }
+        std::unique_lock lock(_mutex);
+        if (_index.count(key) > 0) {
+            return;
+        }
+        _lru.push_front(Entry{key, gzip});
+        _index[key] = _lru.begin();
+        _bytes += gzip.size();
+        while (_bytes > static_cast<size_t>(FLAGS_compress_cache_bytes)) {
+            auto &back = _lru.back();
+            _bytes -= back.gzip.size();
+            _index.erase(back.key);
+            _lru.pop_back();
+        }
+    }
+
+    double Compressor::get_ratio(void *arg) {
+        auto *self = static_cast<Compressor *>(arg);
+        auto in = self->_in_bytes.get_value();
+        return in == 0 ? 1.0 : static_cast<double>(self->_out_bytes.get_value()) / in;
+    }
+
+}  // namespace halakv
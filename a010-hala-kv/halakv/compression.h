@@ -0,0 +1,126 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-9.
+//
+#pragma once
+
+#include <melon/rpc/controller.h>
+#include <melon/utility/iobuf.h>
+#include <melon/var/var.h>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace halakv {
+
+    // level as zlib takes it, -1 for its default.
+    bool gzip_compress(const std::string &in, std::string *out, int level = -1);
+
+    // Compressor gzips http bodies over http_compress_min_bytes for clients
+    // accepting it, and picks the compress type of large rpc responses. the
+    // gzip of a body built from an entry is kept in a lru bounded by
+    // compress_cache_bytes, keyed by the key and version of the entry, so that
+    // a hot value is only compressed once and a new write is never answered
+    // with the old body.
+    class Compressor {
+    public:
+        // the bodies built from one entry.
+        enum Form {
+            kJson,
+            kValue
+        };
+
+        struct Key {
+            // the stored key, scoped to its namespace.
+            std::string key;
+            uint64_t version;
+            Form form;
+
+            bool operator==(const Key &other) const {
+                return version == other.version && form == other.form && key == other.key;
+            }
+        };
+
+        static Compressor *instance() {
+            static Compressor ins;
+            return &ins;
+        }
+
+        void expose(const std::string &prefix);
+
+        // the gzip of body in out, false if the client does not take it, the body
+        // is small or it does not shrink. the gzip is cached under key, not
+        // cached if key is null, for a body of an entry with no version.
+        bool http_gzip(const std::string *accept_encoding, const Key *key, const std::string &body,
+                       mutil::IOBuf *out);
+
+        // compresses the response of cntl by rpc_compress_type if it carries at
+        // least rpc_compress_min_bytes of values. for the responses to clients
+        // only, the hops between peers are on the local network and would pay
+        // the compression twice. only the http bodies are cached and counted
+        // in the ratio, melon compresses rpc responses on its own write path.
+        void rpc_compress(melon::Controller *cntl, size_t value_bytes);
+
+        // gzip or * with a q above 0 in the Accept-Encoding header.
+        static bool accepts_gzip(const std::string *accept_encoding);
+
+        // bodies below it are not worth building only to be compressed.
+        static size_t http_min_bytes();
+
+    private:
+        Compressor() = default;
+
+        struct KeyHash {
+            size_t operator()(const Key &key) const {
+                return std::hash<std::string>()(key.key) ^ (key.version * 0x9e3779b97f4a7c15ULL) ^ key.form;
+            }
+        };
+
+        struct Entry {
+            Key key;
+            mutil::IOBuf gzip;
+        };
+        using EntryList = std::list<Entry>;
+
+        bool lookup(const Key &key, mutil::IOBuf *out);
+
+        void insert(const Key &key, const mutil::IOBuf &gzip);
+
+        static double get_ratio(void *arg);
+
+    private:
+        std::mutex _mutex;
+        EntryList _lru;
+        std::unordered_map<Key, EntryList::iterator, KeyHash> _index;
+        size_t _bytes{0};
+        melon::var::Adder<int64_t> _in_bytes;
+        melon::var::Adder<int64_t> _out_bytes;
+        melon::var::Adder<int64_t> _hit_count;
+        melon::var::Adder<int64_t> _miss_count;
+        melon::var::Adder<int64_t> _rpc_count;
+        melon::var::Adder<int64_t> _rpc_bytes;
+        melon::var::LatencyRecorder _compress_latency;
+        std::unique_ptr<melon::var::PassiveStatus<double>> _ratio_var;
+    };
+
+}  // namespace halakv
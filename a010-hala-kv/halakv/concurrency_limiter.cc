@@ -0,0 +1,129 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-3.
+//
+#include <halakv/concurrency_limiter.h>
+#include <gflags/gflags.h>
+#include <melon/utility/time.h>
+#include <algorithm>
+
+DEFINE_bool(router_concurrency_limit, true, "Limit the calls in flight to each peer adaptively, shed the excess");
+DEFINE_int32(router_initial_concurrency, 32, "Limit of the calls in flight to a peer before any sample");
+DEFINE_int32(router_min_concurrency, 4, "Min limit of the calls in flight to a peer");
+DEFINE_int32(router_max_concurrency, 1024, "Max limit of the calls in flight to a peer");
+DEFINE_double(router_concurrency_alpha, 3, "The limit of a peer grows while less calls than this are queued");
+DEFINE_double(router_concurrency_beta, 6, "The limit of a peer shrinks while more calls than this are queued");
+DEFINE_int32(router_concurrency_window_ms, 100, "Interval to adapt the limit of a peer");
+DEFINE_int32(router_concurrency_min_samples, 20, "Calls needed in a window to adapt the limit");
+DEFINE_int32(router_min_latency_refresh_ms, 10000, "Interval to take the no load latency of a peer again");
+DEFINE_double(router_concurrency_drop_ratio, 0.9, "The limit of a peer is scaled by this on a call time out");
+
+namespace halakv {
+
+    void ConcurrencyLimiter::init(const std::string &name) {
+        _name = name;
+        _limit.store(std::clamp(FLAGS_router_initial_concurrency, FLAGS_router_min_concurrency,
+                                FLAGS_router_max_concurrency), std::memory_order_relaxed);
+        _limit_var = std::make_unique<melon::var::PassiveStatus<int>>(get_limit, this);
+        _limit_var->expose_as("halakv_limiter", name + "_limit");
+        _inflight_var = std::make_unique<melon::var::PassiveStatus<int>>(get_inflight, this);
+        _inflight_var->expose_as("halakv_limiter", name + "_inflight");
+        _shed_count.expose_as("halakv_limiter", name + "_shed");
+    }
+
+    bool ConcurrencyLimiter::acquire() {
+        auto inflight = _inflight.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (FLAGS_router_concurrency_limit && inflight > _limit.load(std::memory_order_relaxed)) {
+            _inflight.fetch_sub(1, std::memory_order_relaxed);
+            _shed_count << 1;
+            return false;
+        }
+        return true;
+    }
+
+    void ConcurrencyLimiter::release(int64_t latency_us) {
+        auto inflight = _inflight.fetch_sub(1, std::memory_order_relaxed);
+        if (latency_us < 0) {
+            return;
+        }
+        auto now = mutil::gettimeofday_us();
+        std::unique_lock lock(_mutex);
+        if (_window_samples == 0 || latency_us < _window_min_latency_us) {
+            _window_min_latency_us = latency_us;
+        }
+        _window_latency_us += latency_us;
+        ++_window_samples;
+        _window_max_inflight = std::max(_window_max_inflight, inflight);
+        update_locked(now);
+    }
+
+    void ConcurrencyLimiter::release_dropped() {
+        _inflight.fetch_sub(1, std::memory_order_relaxed);
+        auto now = mutil::gettimeofday_us();
+        std::unique_lock lock(_mutex);
+        ++_window_drops;
+        update_locked(now);
+    }
+
+    void ConcurrencyLimiter::update_locked(int64_t now_us) {
+        if (_window_start_us == 0) {
+            _window_start_us = now_us;
+            return;
+        }
+        if (now_us - _window_start_us < 1000L * FLAGS_router_concurrency_window_ms) {
+            return;
+        }
+        auto limit = _limit.load(std::memory_order_relaxed);
+        if (_window_drops > 0) {
+            limit = static_cast<int>(limit * FLAGS_router_concurrency_drop_ratio);
+        } else if (_window_samples >= FLAGS_router_concurrency_min_samples) {
+            // the min latency may have moved up for good, take it again from this window.
+            if (_min_latency_us == 0 || now_us >= _min_latency_refresh_us) {
+                _min_latency_us = _window_min_latency_us;
+                _min_latency_refresh_us = now_us + 1000L * FLAGS_router_min_latency_refresh_ms;
+            } else {
+                _min_latency_us = std::min(_min_latency_us, _window_min_latency_us);
+            }
+            auto avg_latency_us = _window_latency_us / _window_samples;
+            auto queue = avg_latency_us > 0 ? limit * (1 - static_cast<double>(_min_latency_us) / avg_latency_us) : 0;
+            if (queue > FLAGS_router_concurrency_beta) {
+                --limit;
+            } else if (queue < FLAGS_router_concurrency_alpha && 2 * _window_max_inflight >= limit) {
+                // only grow a limit that is used.
+                ++limit;
+            }
+        }
+        _limit.store(std::clamp(limit, FLAGS_router_min_concurrency, FLAGS_router_max_concurrency),
+                     std::memory_order_relaxed);
+        _window_start_us = now_us;
+        _window_latency_us = 0;
+        _window_samples = 0;
+        _window_drops = 0;
+        _window_max_inflight = 0;
+    }
+
+    int ConcurrencyLimiter::get_limit(void *arg) {
+        return static_cast<ConcurrencyLimiter *>(arg)->limit();
+    }
+
+    int ConcurrencyLimiter::get_inflight(void *arg) {
+        return static_cast<ConcurrencyLimiter *>(arg)->_inflight.load(std::memory_order_relaxed);
+    }
+
+}  // namespace halakv
@@ -0,0 +1,81 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-3.
+//
+#pragma once
+
+#include <melon/var/var.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace halakv {
+
+    // ConcurrencyLimiter bounds the calls in flight to a peer with a limit
+    // adapted the TCP Vegas way. the no load latency is the min latency seen,
+    // refreshed now and then, and the queue at the peer is estimated every
+    // window as limit * (1 - min latency / average latency). the limit grows
+    // while the queue is short and shrinks when it builds up or calls time out,
+    // so that a slow peer gets fewer calls instead of a longer queue.
+    class ConcurrencyLimiter {
+    public:
+        ConcurrencyLimiter() = default;
+
+        void init(const std::string &name);
+
+        // false if the peer is at its limit, the call is shed.
+        bool acquire();
+
+        // latency_us of a call done, -1 for a call that says nothing about the load.
+        void release(int64_t latency_us);
+
+        // a call timed out, the peer is overloaded.
+        void release_dropped();
+
+        int limit() const {
+            return _limit.load(std::memory_order_relaxed);
+        }
+
+    private:
+        void update_locked(int64_t now_us);
+
+        static int get_limit(void *arg);
+
+        static int get_inflight(void *arg);
+
+    private:
+        std::string _name;
+        std::atomic<int> _inflight{0};
+        std::atomic<int> _limit{0};
+        std::mutex _mutex;
+        int64_t _min_latency_us{0};
+        int64_t _min_latency_refresh_us{0};
+        int64_t _window_start_us{0};
+        int64_t _window_latency_us{0};
+        int64_t _window_min_latency_us{0};
+        int64_t _window_samples{0};
+        int64_t _window_drops{0};
+        int _window_max_inflight{0};
+        std::unique_ptr<melon::var::PassiveStatus<int>> _limit_var;
+        std::unique_ptr<melon::var::PassiveStatus<int>> _inflight_var;
+        melon::var::Adder<int64_t> _shed_count;
+    };
+
+}  // namespace halakv
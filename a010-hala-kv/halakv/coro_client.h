@@ -0,0 +1,446 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-5.
+//
+#pragma once
+
+// awaitable kv calls, needs c++20.
+#include <melon/rpc/channel.h>
+#include <melon/rpc/controller.h>
+#include <turbo/utility/status.h>
+#include <turbo/strings/substitute.h>
+#include <halakv/kv.pb.h>
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace halakv {
+
+    // where a coroutine resumes once its rpc is done, null resumes it on the
+    // fiber that ran the done of the rpc.
+    class CoroExecutor {
+    public:
+        virtual ~CoroExecutor() = default;
+
+        virtual void post(std::coroutine_handle<> handle) = 0;
+    };
+
+    template<typename Response>
+    struct CoroResult {
+        // the status of the rpc, the result of the key is in the response.
+        turbo::Status status;
+        Response response;
+    };
+
+    // a barrier for the calls of a when_all, the last one in resumes the awaiter.
+    class CoroJoin {
+    public:
+        explicit CoroJoin(size_t count) : _count(count + 1) {
+        }
+
+        // true for the last arrival.
+        bool arrive() {
+            return _count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+
+        std::coroutine_handle<> handle;
+        CoroExecutor *executor{nullptr};
+
+    private:
+        std::atomic<size_t> _count;
+    };
+
+    inline void coro_resume(CoroExecutor *executor, std::coroutine_handle<> handle) {
+        if (executor != nullptr) {
+            executor->post(handle);
+        } else {
+            handle.resume();
+        }
+    }
+
+    // CoroCall is one rpc awaited by a coroutine. it is its own done closure and
+    // lives in the frame of the awaiting coroutine, so a call allocates nothing
+    // beyond what the channel does. it may be moved only before it is awaited.
+    template<typename Request, typename Response>
+    class CoroCall : public google::protobuf::Closure {
+    public:
+        CoroCall(melon::Channel *channel, const google::protobuf::MethodDescriptor *method,
+                 CoroExecutor *executor, int64_t timeout_ms)
+                : _channel(channel), _method(method), _executor(executor), _timeout_ms(timeout_ms) {
+        }
+
+        CoroCall(CoroCall &&other) noexcept
+                : _channel(other._channel), _method(other._method), _executor(other._executor),
+                  _timeout_ms(other._timeout_ms), _request(std::move(other._request)) {
+        }
+
+        CoroCall &operator=(CoroCall &&) = delete;
+
+        Request &request() {
+            return _request;
+        }
+
+        CoroExecutor *executor() const {
+            return _executor;
+        }
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        // the done may run before the call returns, whoever comes second resumes.
+        bool await_suspend(std::coroutine_handle<> handle) {
+            _handle = handle;
+            start(nullptr);
+            return _state.exchange(kSuspended, std::memory_order_acq_rel) != kDone;
+        }
+
+        CoroResult<Response> await_resume() {
+            CoroResult<Response> result;
+            if (_cntl.Failed()) {
+                result.status = turbo::unavailable_error(turbo::substitute("$0 failed: $1", _method->name(),
+                                                                           _cntl.ErrorText()));
+            }
+            result.response = std::move(_response);
+            return result;
+        }
+
+        void start(CoroJoin *join) {
+            _join = join;
+            if (_timeout_ms > 0) {
+                _cntl.set_timeout_ms(_timeout_ms);
+            }
+            _channel->CallMethod(_method, &_cntl, &_request, &_response, this);
+        }
+
+        void Run() override {
+            if (_join != nullptr) {
+                if (_join->arrive()) {
+                    coro_resume(_join->executor, _join->handle);
+                }
+                return;
+            }
+            if (_state.exchange(kDone, std::memory_order_acq_rel) == kSuspended) {
+                coro_resume(_executor, _handle);
+            }
+        }
+
+    private:
+        enum State {
+            kIdle,
+            kSuspended,
+            kDone
+        };
+
+        melon::Channel *_channel;
+        const google::protobuf::MethodDescriptor *_method;
+        CoroExecutor *_executor;
+        int64_t _timeout_ms;
+        melon::Controller _cntl;
+        Request _request;
+        Response _response;
+        std::coroutine_handle<> _handle;
+        CoroJoin *_join{nullptr};
+        std::atomic<State> _state{kIdle};
+    };
+
+    // awaits all the calls in parallel, the results come back in argument order.
+    template<typename... Calls>
+    class CoroWhenAll {
+    public:
+        explicit CoroWhenAll(CoroExecutor *executor, Calls &... calls) : _calls(calls...), _join(sizeof...(Calls)) {
+            _join.executor = executor;
+        }
+
+        bool await_ready() const noexcept {
+            return sizeof...(Calls) == 0;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            _join.handle = handle;
+            std::apply([this](auto &... call) {
+                (call.start(&_join), ...);
+            }, _calls);
+            return !_join.arrive();
+        }
+
+        auto await_resume() {
+            return std::apply([](auto &... call) {
+                return std::make_tuple(call.await_resume()...);
+            }, _calls);
+        }
+
+    private:
+        std::tuple<Calls &...> _calls;
+        CoroJoin _join;
+    };
+
+    // resumes on the executor of the first call, the one of the client that made it.
+    template<typename Call, typename... Calls>
+    CoroWhenAll<Call, Calls...> when_all(Call &&call, Calls &&... calls) {
+        return CoroWhenAll<Call, Calls...>(call.executor(), call, calls...);
+    }
+
+    // the same for a run time number of calls of one kind.
+    template<typename Call>
+    class CoroWhenAllRange {
+    public:
+        CoroWhenAllRange(std::vector<Call> &calls, CoroExecutor *executor) : _calls(calls), _join(calls.size()) {
+            _join.executor = executor;
+        }
+
+        bool await_ready() const noexcept {
+            return _calls.empty();
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            _join.handle = handle;
+            for (auto &call: _calls) {
+                call.start(&_join);
+            }
+            return !_join.arrive();
+        }
+
+        auto await_resume() {
+            std::vector<decltype(_calls.front().await_resume())> results;
+            results.reserve(_calls.size());
+            for (auto &call: _calls) {
+                results.push_back(call.await_resume());
+            }
+            return results;
+        }
+
+    private:
+        std::vector<Call> &_calls;
+        CoroJoin _join;
+    };
+
+    template<typename Call>
+    CoroWhenAllRange<Call> when_all(std::vector<Call> &calls) {
+        return CoroWhenAllRange<Call>(calls, calls.empty() ? nullptr : calls.front().executor());
+    }
+
+    // CoroTask is a lazy coroutine returning T, started by co_await or by spawn.
+    template<typename T = void>
+    class CoroTask;
+
+    namespace detail {
+
+        template<typename Promise>
+        struct CoroFinal {
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                auto continuation = handle.promise().continuation;
+                if (continuation) {
+                    return continuation;
+                }
+                // spawned, nobody awaits it.
+                handle.destroy();
+                return std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {
+            }
+        };
+
+        struct CoroPromiseBase {
+            std::coroutine_handle<> continuation;
+
+            std::suspend_always initial_suspend() const noexcept {
+                return {};
+            }
+
+            void unhandled_exception() {
+                std::terminate();
+            }
+        };
+
+    }  // namespace detail
+
+    template<typename T>
+    class CoroTask {
+    public:
+        struct promise_type : detail::CoroPromiseBase {
+            T value;
+
+            CoroTask get_return_object() {
+                return CoroTask(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            detail::CoroFinal<promise_type> final_suspend() const noexcept {
+                return {};
+            }
+
+            void return_value(T v) {
+                value = std::move(v);
+            }
+        };
+
+        explicit CoroTask(std::coroutine_handle<promise_type> handle) : _handle(handle) {
+        }
+
+        CoroTask(CoroTask &&other) noexcept : _handle(std::exchange(other._handle, nullptr)) {
+        }
+
+        ~CoroTask() {
+            if (_handle) {
+                _handle.destroy();
+            }
+        }
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) {
+            _handle.promise().continuation = continuation;
+            return _handle;
+        }
+
+        T await_resume() {
+            return std::move(_handle.promise().value);
+        }
+
+    private:
+        std::coroutine_handle<promise_type> _handle;
+    };
+
+    template<>
+    class CoroTask<void> {
+    public:
+        struct promise_type : detail::CoroPromiseBase {
+            CoroTask get_return_object() {
+                return CoroTask(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            detail::CoroFinal<promise_type> final_suspend() const noexcept {
+                return {};
+            }
+
+            void return_void() {
+            }
+        };
+
+        explicit CoroTask(std::coroutine_handle<promise_type> handle) : _handle(handle) {
+        }
+
+        CoroTask(CoroTask &&other) noexcept : _handle(std::exchange(other._handle, nullptr)) {
+        }
+
+        ~CoroTask() {
+            if (_handle) {
+                _handle.destroy();
+            }
+        }
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) {
+            _handle.promise().continuation = continuation;
+            return _handle;
+        }
+
+        void await_resume() {
+        }
+
+        // run it on the calling thread up to its first suspension, the frame
+        // frees itself when it finishes.
+        void spawn() && {
+            std::exchange(_handle, nullptr).resume();
+        }
+
+    private:
+        std::coroutine_handle<promise_type> _handle;
+    };
+
+    // CoroKvClient issues the kv rpcs of one channel as awaitables:
+    //   auto r = co_await kv.get("key");
+    //   auto [a, b] = co_await when_all(kv.get("a"), kv.get("b"));
+    class CoroKvClient {
+    public:
+        using KvCall = CoroCall<halakv::KvRequest, halakv::KvResponse>;
+        using MultiKvCall = CoroCall<halakv::MultiKvRequest, halakv::MultiKvResponse>;
+
+        explicit CoroKvClient(melon::Channel *channel, CoroExecutor *executor = nullptr, int64_t timeout_ms = -1)
+                : _channel(channel), _executor(executor), _timeout_ms(timeout_ms) {
+        }
+
+        KvCall set(std::string_view key, std::string_view value) {
+            KvCall call(_channel, method(kSet), _executor, _timeout_ms);
+            call.request().set_key(std::string(key));
+            call.request().set_value(std::string(value));
+            return call;
+        }
+
+        KvCall get(std::string_view key) {
+            KvCall call(_channel, method(kGet), _executor, _timeout_ms);
+            call.request().set_key(std::string(key));
+            return call;
+        }
+
+        KvCall remove(std::string_view key) {
+            KvCall call(_channel, method(kRemove), _executor, _timeout_ms);
+            call.request().set_key(std::string(key));
+            return call;
+        }
+
+        // fill the request of the returned call before awaiting it.
+        MultiKvCall mset() {
+            return MultiKvCall(_channel, method(kMset), _executor, _timeout_ms);
+        }
+
+        MultiKvCall mget() {
+            return MultiKvCall(_channel, method(kMget), _executor, _timeout_ms);
+        }
+
+        MultiKvCall mremove() {
+            return MultiKvCall(_channel, method(kMremove), _executor, _timeout_ms);
+        }
+
+    private:
+        // the method indexes in kv.proto.
+        enum Method {
+            kSet = 0,
+            kGet = 1,
+            kRemove = 2,
+            kMset = 3,
+            kMget = 4,
+            kMremove = 5
+        };
+
+        static const google::protobuf::MethodDescriptor *method(Method index) {
+            return halakv::KvService::descriptor()->method(index);
+        }
+
+    private:
+        melon::Channel *_channel;
+        CoroExecutor *_executor;
+        int64_t _timeout_ms;
+    };
+
+}  // namespace halakv
@@ -0,0 +1,156 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-28.
+//
+#include <halakv/hint_store.h>
+#include <halakv/hlc.h>
+#include <melon/utility/time.h>
+#include <turbo/utility/status.h>
+
+namespace halakv {
+
+    void HintStore::init(size_t peer_size, size_t max_bytes_per_peer) {
+        _max_bytes_per_peer = max_bytes_per_peer;
+        _peers.clear();
+        for (size_t i = 0; i < peer_size; i++) {
+            _peers.push_back(std::make_unique<PeerHints>());
+        }
+    }
+
+    void HintStore::expose(const std::string &prefix) {
+        _hint_count.expose_as(prefix, "hint");
+        _drop_count.expose_as(prefix, "hint_drop");
+        _replay_count.expose_as(prefix, "hint_replay");
+    }
+
+    bool HintStore::add(size_t peer, const std::string &key, const std::string &value, bool remove,
+                        uint64_t expire_at_us, uint32_t flags) {
+        Hint hint;
+        hint.key = key;
+        hint.remove = remove;
+        if (!remove) {
+            hint.value = value;
+            hint.expire_at_us = expire_at_us;
+            hint.flags = flags;
+        }
+        hint.seq = _seq.fetch_add(1, std::memory_order_relaxed) + 1;
+        hint.version = Hlc::instance()->now();
+        auto bytes = hint_bytes(hint);
+        auto &peer_hints = *_peers[peer];
+        std::unique_lock lock(peer_hints.mutex);
+        auto it = peer_hints.hints.find(key);
+        size_t old_bytes = it == peer_hints.hints.end() ? 0 : hint_bytes(it->second);
+        if (peer_hints.bytes - old_bytes + bytes > _max_bytes_per_peer) {
+            _drop_count << 1;
+            return false;
+        }
+        peer_hints.bytes = peer_hints.bytes - old_bytes + bytes;
+        peer_hints.hints[key] = std::move(hint);
+        peer_hints.size.store(peer_hints.hints.size(), std::memory_order_release);
+        _hint_count << 1;
+        return true;
+    }
+
+    bool HintStore::lookup(size_t peer, const std::string &key, halakv::KvResponse *response) {
+        auto &peer_hints = *_peers[peer];
+        if (peer_hints.size.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+        std::unique_lock lock(peer_hints.mutex);
+        auto it = peer_hints.hints.find(key);
+        if (it == peer_hints.hints.end()) {
+            return false;
+        }
+        auto &hint = it->second;
+        if (hint.remove || (hint.expire_at_us != 0 && hint.expire_at_us <= static_cast<uint64_t>(mutil::gettimeofday_us()))) {
+            response->set_code(static_cast<int>(turbo::StatusCode::kNotFound));
+            response->set_message("not found");
+        } else {
+            response->set_value(hint.value);
+            if (hint.expire_at_us != 0) {
+                response->set_expire_at_us(hint.expire_at_us);
+            }
+            if (hint.flags != 0) {
+                response->set_flags(hint.flags);
+            }
+            response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+            response->set_message("ok");
+        }
+        return true;
+    }
+
+    void HintStore::drop(size_t peer, const std::string &key) {
+        auto &peer_hints = *_peers[peer];
+        if (peer_hints.size.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+        std::unique_lock lock(peer_hints.mutex);
+        auto it = peer_hints.hints.find(key);
+        if (it == peer_hints.hints.end()) {
+            return;
+        }
+        peer_hints.bytes -= hint_bytes(it->second);
+        peer_hints.hints.erase(it);
+        peer_hints.size.store(peer_hints.hints.size(), std::memory_order_release);
+    }
+
+    void HintStore::clear(size_t peer) {
+        auto &peer_hints = *_peers[peer];
+        std::unique_lock lock(peer_hints.mutex);
+        _drop_count << peer_hints.hints.size();
+        peer_hints.hints.clear();
+        peer_hints.bytes = 0;
+        peer_hints.size.store(0, std::memory_order_release);
+    }
+
+    bool HintStore::empty(size_t peer) {
+        return size(peer) == 0;
+    }
+
+    size_t HintStore::size(size_t peer) {
+        return _peers[peer]->size.load(std::memory_order_acquire);
+    }
+
+    void HintStore::peek(size_t peer, size_t max, std::vector<Hint> *hints) {
+        auto &peer_hints = *_peers[peer];
+        std::unique_lock lock(peer_hints.mutex);
+        for (auto &it: peer_hints.hints) {
+            if (hints->size() >= max) {
+                break;
+            }
+            hints->push_back(it.second);
+        }
+    }
+
+    void HintStore::ack(size_t peer, const std::vector<Hint> &hints) {
+        auto &peer_hints = *_peers[peer];
+        std::unique_lock lock(peer_hints.mutex);
+        for (auto &hint: hints) {
+            auto it = peer_hints.hints.find(hint.key);
+            if (it == peer_hints.hints.end() || it->second.seq != hint.seq) {
+                continue;
+            }
+            peer_hints.bytes -= hint_bytes(it->second);
+            peer_hints.hints.erase(it);
+            _replay_count << 1;
+        }
+        peer_hints.size.store(peer_hints.hints.size(), std::memory_order_release);
+    }
+
+}  // namespace halakv
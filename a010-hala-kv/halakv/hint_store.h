@@ -0,0 +1,100 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-28.
+//
+#pragma once
+
+#include <halakv/kv.pb.h>
+#include <melon/var/var.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace halakv {
+
+    // HintStore keeps the writes that could not be delivered to their owner, per
+    // peer and per key only the latest write is kept. they are replayed when the
+    // peer is back, reads of a hinted key are answered from the hint meanwhile.
+    class HintStore {
+    public:
+        struct Hint {
+            std::string key;
+            std::string value;
+            bool remove{false};
+            uint64_t seq{0};
+            // the hlc time the write was taken at, replayed as its version.
+            uint64_t version{0};
+            uint64_t expire_at_us{0};
+            uint32_t flags{0};
+        };
+
+        HintStore() = default;
+
+        void init(size_t peer_size, size_t max_bytes_per_peer);
+
+        void expose(const std::string &prefix);
+
+        // false if the hints of the peer are full.
+        bool add(size_t peer, const std::string &key, const std::string &value, bool remove,
+                 uint64_t expire_at_us = 0, uint32_t flags = 0);
+
+        bool lookup(size_t peer, const std::string &key, halakv::KvResponse *response);
+
+        // a newer write reached the owner, the hint must not be replayed over it.
+        void drop(size_t peer, const std::string &key);
+
+        bool empty(size_t peer);
+
+        size_t size(size_t peer);
+
+        // the peer left, its keys are owned by others now.
+        void clear(size_t peer);
+
+        // copy up to max hints of a peer for replay, they stay in the store until ack.
+        void peek(size_t peer, size_t max, std::vector<Hint> *hints);
+
+        // drop the replayed hints not overwritten since peek.
+        void ack(size_t peer, const std::vector<Hint> &hints);
+
+    private:
+        struct PeerHints {
+            std::mutex mutex;
+            std::unordered_map<std::string, Hint> hints;
+            size_t bytes{0};
+            // lets lookup and empty skip the lock when the peer has no hint.
+            std::atomic<size_t> size{0};
+        };
+
+        static size_t hint_bytes(const Hint &hint) {
+            return hint.key.size() * 2 + hint.value.size() + sizeof(Hint) + 32;
+        }
+
+    private:
+        size_t _max_bytes_per_peer{0};
+        std::atomic<uint64_t> _seq{0};
+        std::vector<std::unique_ptr<PeerHints>> _peers;
+        melon::var::Adder<int64_t> _hint_count;
+        melon::var::Adder<int64_t> _drop_count;
+        melon::var::Adder<int64_t> _replay_count;
+    };
+
+}  // namespace halakv
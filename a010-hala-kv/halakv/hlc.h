@@ -0,0 +1,65 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-13.
+//
+#pragma once
+
+#include <melon/utility/time.h>
+#include <atomic>
+#include <cstdint>
+
+namespace halakv {
+
+    // Hlc is the clock the versions of writes are taken from, the wall clock in
+    // us pushed past every version the server has seen. the versions of other
+    // servers come in with replies, shipped logs and gossip, so a write taken
+    // after another was seen gets a higher version whatever the skew of the
+    // clocks of the two servers.
+    class Hlc {
+    public:
+        static Hlc *instance() {
+            static Hlc ins;
+            return &ins;
+        }
+
+        uint64_t now() {
+            auto wall = static_cast<uint64_t>(mutil::gettimeofday_us());
+            auto last = _last.load(std::memory_order_relaxed);
+            while (true) {
+                auto next = wall > last ? wall : last + 1;
+                if (_last.compare_exchange_weak(last, next, std::memory_order_relaxed)) {
+                    return next;
+                }
+            }
+        }
+
+        void update(uint64_t seen) {
+            auto last = _last.load(std::memory_order_relaxed);
+            while (last < seen && !_last.compare_exchange_weak(last, seen, std::memory_order_relaxed)) {
+            }
+        }
+
+    private:
+        Hlc() = default;
+
+    private:
+        std::atomic<uint64_t> _last{0};
+    };
+
+}  // namespace halakv
@@ -0,0 +1,123 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-7.
+//
+// compare the json of a KvResponse by json2pb and by the hand written
+// writer, check they give the same bytes and time both.
+
+#include <gflags/gflags.h>
+#include <turbo/log/logging.h>
+#include <melon/json2pb/pb_to_json.h>
+#include <melon/utility/fast_rand.h>
+#include <melon/utility/time.h>
+#include <halakv/kv_json.h>
+#include <halakv/kv.pb.h>
+#include <string>
+#include <vector>
+
+DEFINE_int32(iterations, 1000000, "Responses converted by each path");
+DEFINE_int32(value_size, 64, "Bytes of the value of a response");
+DEFINE_double(escape_ratio, 0.01, "Share of the value bytes needing an escape");
+
+namespace {
+
+    std::string random_value(size_t size, double escape_ratio) {
+        static const std::string kEscaped = "\"\\\n\t\x01";
+        std::string value;
+        value.reserve(size);
+        for (size_t i = 0; i < size; i++) {
+            if (mutil::fast_rand_double() < escape_ratio) {
+                value.push_back(kEscaped[mutil::fast_rand_less_than(kEscaped.size())]);
+            } else {
+                value.push_back(static_cast<char>('a' + mutil::fast_rand_less_than(26)));
+            }
+        }
+        return value;
+    }
+
+    std::vector<halakv::KvResponse> make_responses() {
+        std::vector<halakv::KvResponse> responses;
+        for (int i = 0; i < 64; i++) {
+            halakv::KvResponse response;
+            response.set_code(i % 8 == 0 ? static_cast<int>(turbo::StatusCode::kNotFound) : 0);
+            response.set_message(i % 8 == 0 ? "not found" : "ok");
+            if (i % 8 != 0) {
+                response.set_value(random_value(FLAGS_value_size, FLAGS_escape_ratio));
+                response.set_version(mutil::gettimeofday_us() + i);
+            }
+            if (i % 4 == 1) {
+                response.set_expire_at_us(mutil::gettimeofday_us() + 1000000L * i);
+            }
+            // every field of the response set, so that a field the writer leaves
+            // out fails the check.
+            if (i % 16 == 1) {
+                response.set_redirect("127.0.0.1:8019");
+                response.set_epoch(mutil::fast_rand());
+            }
+            responses.push_back(std::move(response));
+        }
+        return responses;
+    }
+
+    bool check(const std::vector<halakv::KvResponse> &responses) {
+        for (auto &response: responses) {
+            std::string expected;
+            json2pb::ProtoMessageToJson(response, &expected);
+            std::string json;
+            halakv::append_json(response, &json);
+            if (json != expected) {
+                LOG(ERROR) << "mismatch, json2pb: " << expected << " writer: " << json;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename F>
+    void run(const char *name, const std::vector<halakv::KvResponse> &responses, F &&convert) {
+        size_t bytes = 0;
+        auto start = mutil::gettimeofday_us();
+        for (int i = 0; i < FLAGS_iterations; i++) {
+            bytes += convert(responses[i % responses.size()]);
+        }
+        auto elapsed = mutil::gettimeofday_us() - start;
+        LOG(INFO) << name << ": " << elapsed * 1000.0 / FLAGS_iterations << " ns/op, "
+                  << bytes / std::max<int64_t>(elapsed, 1) << " MB/s";
+    }
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, true);
+    auto responses = make_responses();
+    if (!check(responses)) {
+        return -1;
+    }
+    run("json2pb", responses, [](const halakv::KvResponse &response) {
+        std::string json;
+        json2pb::ProtoMessageToJson(response, &json);
+        return json.size();
+    });
+    run("writer", responses, [](const halakv::KvResponse &response) {
+        mutil::IOBuf buf;
+        halakv::write_json(response, &buf);
+        return buf.size();
+    });
+    return 0;
+}
@@ -0,0 +1,91 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-4.
+//
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace halakv {
+
+    // the placing of a key on the ring, shared by the peers and the clients so
+    // that they agree on the owner of a key. fnv-1a 64 bits hashes of the key
+    // and the peers, weighted by rendezvous, see owner_of.
+    static constexpr const char *kHashScheme = "fnv1a64-rendezvous";
+
+    // the key of a namespace as stored, keys of the default namespace are kept as they are.
+    static constexpr char kNamespaceSeparator = '\x1f';
+
+    inline std::string scoped_key(std::string_view ns, std::string_view key) {
+        if (ns.empty()) {
+            return std::string(key);
+        }
+        std::string scoped;
+        scoped.reserve(ns.size() + 1 + key.size());
+        scoped.append(ns).append(1, kNamespaceSeparator).append(key);
+        return scoped;
+    }
+
+    inline std::string_view namespace_of(std::string_view scoped) {
+        auto pos = scoped.find(kNamespaceSeparator);
+        return pos == std::string_view::npos ? std::string_view() : scoped.substr(0, pos);
+    }
+
+    inline uint64_t key_hash(std::string_view key) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (auto c: key) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    // the weight of a peer for a key, murmur3 finalizer of the pair.
+    inline uint64_t rendezvous_weight(uint64_t key_hash, uint64_t peer_hash) {
+        uint64_t h = key_hash ^ (peer_hash * 0x9e3779b97f4a7c15ULL);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // the position of the owner of a key in peer_hashes, the hashes of the peer
+    // addresses: the peer of the highest weight, the first one on a tie. a peer
+    // joining or leaving moves only the keys it wins or won, dead peers keep
+    // their keys. linear in the peers, which are a few hundred at most.
+    inline size_t owner_of(std::string_view key, const std::vector<uint64_t> &peer_hashes) {
+        auto hash = key_hash(key);
+        size_t owner = 0;
+        uint64_t best = 0;
+        for (size_t i = 0; i < peer_hashes.size(); i++) {
+            auto weight = rendezvous_weight(hash, peer_hashes[i]);
+            if (i == 0 || weight > best) {
+                owner = i;
+                best = weight;
+            }
+        }
+        return owner;
+    }
+
+}  // namespace halakv
@@ -8,12 +8,12 @@
 #include <string>
 
 #include <google/protobuf/port_def.inc>
-#if PROTOBUF_VERSION < 3020000
+#if PROTOBUF_VERSION < 3021000
 #error This file was generated by a newer version of protoc which is
 #error incompatible with your Protocol Buffer headers. Please update
 #error your headers.
 #endif
-#if 3020000 < PROTOBUF_MIN_PROTOC_VERSION
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
 #error This file was generated by an older version of protoc which is
 #error incompatible with your Protocol Buffer headers. Please
 #error regenerate this file with a newer version of protoc.
@@ -23,12 +23,14 @@
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/arena.h>
 #include <google/protobuf/arenastring.h>
+#include <google/protobuf/generated_message_bases.h>
 #include <google/protobuf/generated_message_util.h>
 #include <google/protobuf/metadata_lite.h>
 #include <google/protobuf/generated_message_reflection.h>
 #include <google/protobuf/message.h>
 #include <google/protobuf/repeated_field.h>  // IWYU pragma: export
 #include <google/protobuf/extension_set.h>  // IWYU pragma: export
+#include <google/protobuf/generated_enum_reflection.h>
 #include <google/protobuf/service.h>
 #include <google/protobuf/unknown_field_set.h>
 // @@protoc_insertion_point(includes)
@@ -46,19 +48,143 @@ struct TableStruct_halakv_2fkv_2eproto {
 };
 extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_halakv_2fkv_2eproto;
 namespace halakv {
+class GossipRequest;
+struct GossipRequestDefaultTypeInternal;
+extern GossipRequestDefaultTypeInternal _GossipRequest_default_instance_;
+class GossipResponse;
+struct GossipResponseDefaultTypeInternal;
+extern GossipResponseDefaultTypeInternal _GossipResponse_default_instance_;
+class HintsRequest;
+struct HintsRequestDefaultTypeInternal;
+extern HintsRequestDefaultTypeInternal _HintsRequest_default_instance_;
+class HintsResponse;
+struct HintsResponseDefaultTypeInternal;
+extern HintsResponseDefaultTypeInternal _HintsResponse_default_instance_;
+class HttpRequest;
+struct HttpRequestDefaultTypeInternal;
+extern HttpRequestDefaultTypeInternal _HttpRequest_default_instance_;
+class HttpResponse;
+struct HttpResponseDefaultTypeInternal;
+extern HttpResponseDefaultTypeInternal _HttpResponse_default_instance_;
+class InvalidateRequest;
+struct InvalidateRequestDefaultTypeInternal;
+extern InvalidateRequestDefaultTypeInternal _InvalidateRequest_default_instance_;
 class KvRequest;
 struct KvRequestDefaultTypeInternal;
 extern KvRequestDefaultTypeInternal _KvRequest_default_instance_;
 class KvResponse;
 struct KvResponseDefaultTypeInternal;
 extern KvResponseDefaultTypeInternal _KvResponse_default_instance_;
+class LoadAck;
+struct LoadAckDefaultTypeInternal;
+extern LoadAckDefaultTypeInternal _LoadAck_default_instance_;
+class LoadRequest;
+struct LoadRequestDefaultTypeInternal;
+extern LoadRequestDefaultTypeInternal _LoadRequest_default_instance_;
+class LogAck;
+struct LogAckDefaultTypeInternal;
+extern LogAckDefaultTypeInternal _LogAck_default_instance_;
+class LogBatch;
+struct LogBatchDefaultTypeInternal;
+extern LogBatchDefaultTypeInternal _LogBatch_default_instance_;
+class LogEntry;
+struct LogEntryDefaultTypeInternal;
+extern LogEntryDefaultTypeInternal _LogEntry_default_instance_;
+class MemberUpdate;
+struct MemberUpdateDefaultTypeInternal;
+extern MemberUpdateDefaultTypeInternal _MemberUpdate_default_instance_;
+class MerkleRequest;
+struct MerkleRequestDefaultTypeInternal;
+extern MerkleRequestDefaultTypeInternal _MerkleRequest_default_instance_;
+class MerkleResponse;
+struct MerkleResponseDefaultTypeInternal;
+extern MerkleResponseDefaultTypeInternal _MerkleResponse_default_instance_;
+class MultiKvRequest;
+struct MultiKvRequestDefaultTypeInternal;
+extern MultiKvRequestDefaultTypeInternal _MultiKvRequest_default_instance_;
+class MultiKvResponse;
+struct MultiKvResponseDefaultTypeInternal;
+extern MultiKvResponseDefaultTypeInternal _MultiKvResponse_default_instance_;
+class ReplicateRequest;
+struct ReplicateRequestDefaultTypeInternal;
+extern ReplicateRequestDefaultTypeInternal _ReplicateRequest_default_instance_;
+class RouteRequest;
+struct RouteRequestDefaultTypeInternal;
+extern RouteRequestDefaultTypeInternal _RouteRequest_default_instance_;
+class RouteTable;
+struct RouteTableDefaultTypeInternal;
+extern RouteTableDefaultTypeInternal _RouteTable_default_instance_;
+class ScanRequest;
+struct ScanRequestDefaultTypeInternal;
+extern ScanRequestDefaultTypeInternal _ScanRequest_default_instance_;
+class ScanResponse;
+struct ScanResponseDefaultTypeInternal;
+extern ScanResponseDefaultTypeInternal _ScanResponse_default_instance_;
+class WatchBatch;
+struct WatchBatchDefaultTypeInternal;
+extern WatchBatchDefaultTypeInternal _WatchBatch_default_instance_;
+class WatchEvent;
+struct WatchEventDefaultTypeInternal;
+extern WatchEventDefaultTypeInternal _WatchEvent_default_instance_;
+class WatchRequest;
+struct WatchRequestDefaultTypeInternal;
+extern WatchRequestDefaultTypeInternal _WatchRequest_default_instance_;
 }  // namespace halakv
 PROTOBUF_NAMESPACE_OPEN
+template<> ::halakv::GossipRequest* Arena::CreateMaybeMessage<::halakv::GossipRequest>(Arena*);
+template<> ::halakv::GossipResponse* Arena::CreateMaybeMessage<::halakv::GossipResponse>(Arena*);
+template<> ::halakv::HintsRequest* Arena::CreateMaybeMessage<::halakv::HintsRequest>(Arena*);
+template<> ::halakv::HintsResponse* Arena::CreateMaybeMessage<::halakv::HintsResponse>(Arena*);
+template<> ::halakv::HttpRequest* Arena::CreateMaybeMessage<::halakv::HttpRequest>(Arena*);
+template<> ::halakv::HttpResponse* Arena::CreateMaybeMessage<::halakv::HttpResponse>(Arena*);
+template<> ::halakv::InvalidateRequest* Arena::CreateMaybeMessage<::halakv::InvalidateRequest>(Arena*);
 template<> ::halakv::KvRequest* Arena::CreateMaybeMessage<::halakv::KvRequest>(Arena*);
 template<> ::halakv::KvResponse* Arena::CreateMaybeMessage<::halakv::KvResponse>(Arena*);
+template<> ::halakv::LoadAck* Arena::CreateMaybeMessage<::halakv::LoadAck>(Arena*);
+template<> ::halakv::LoadRequest* Arena::CreateMaybeMessage<::halakv::LoadRequest>(Arena*);
+template<> ::halakv::LogAck* Arena::CreateMaybeMessage<::halakv::LogAck>(Arena*);
+template<> ::halakv::LogBatch* Arena::CreateMaybeMessage<::halakv::LogBatch>(Arena*);
+template<> ::halakv::LogEntry* Arena::CreateMaybeMessage<::halakv::LogEntry>(Arena*);
+template<> ::halakv::MemberUpdate* Arena::CreateMaybeMessage<::halakv::MemberUpdate>(Arena*);
+template<> ::halakv::MerkleRequest* Arena::CreateMaybeMessage<::halakv::MerkleRequest>(Arena*);
+template<> ::halakv::MerkleResponse* Arena::CreateMaybeMessage<::halakv::MerkleResponse>(Arena*);
+template<> ::halakv::MultiKvRequest* Arena::CreateMaybeMessage<::halakv::MultiKvRequest>(Arena*);
+template<> ::halakv::MultiKvResponse* Arena::CreateMaybeMessage<::halakv::MultiKvResponse>(Arena*);
+template<> ::halakv::ReplicateRequest* Arena::CreateMaybeMessage<::halakv::ReplicateRequest>(Arena*);
+template<> ::halakv::RouteRequest* Arena::CreateMaybeMessage<::halakv::RouteRequest>(Arena*);
+template<> ::halakv::RouteTable* Arena::CreateMaybeMessage<::halakv::RouteTable>(Arena*);
+template<> ::halakv::ScanRequest* Arena::CreateMaybeMessage<::halakv::ScanRequest>(Arena*);
+template<> ::halakv::ScanResponse* Arena::CreateMaybeMessage<::halakv::ScanResponse>(Arena*);
+template<> ::halakv::WatchBatch* Arena::CreateMaybeMessage<::halakv::WatchBatch>(Arena*);
+template<> ::halakv::WatchEvent* Arena::CreateMaybeMessage<::halakv::WatchEvent>(Arena*);
+template<> ::halakv::WatchRequest* Arena::CreateMaybeMessage<::halakv::WatchRequest>(Arena*);
 PROTOBUF_NAMESPACE_CLOSE
 namespace halakv {
 
+enum MemberState : int {
+  MEMBER_ALIVE = 0,
+  MEMBER_SUSPECT = 1,
+  MEMBER_DEAD = 2
+};
+bool MemberState_IsValid(int value);
+constexpr MemberState MemberState_MIN = MEMBER_ALIVE;
+constexpr MemberState MemberState_MAX = MEMBER_DEAD;
+constexpr int MemberState_ARRAYSIZE = MemberState_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* MemberState_descriptor();
+template<typename T>
+inline const std::string& MemberState_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, MemberState>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function MemberState_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    MemberState_descriptor(), enum_t_value);
+}
+inline bool MemberState_Parse(
+    ::PROTOBUF_NAMESPACE_ID::ConstStringParam name, MemberState* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<MemberState>(
+    MemberState_descriptor(), name, value);
+}
 // ===================================================================
 
 class KvRequest final :
@@ -148,9 +274,11 @@ class KvRequest final :
   using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const KvRequest& from);
   using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom(const KvRequest& from);
+  void MergeFrom( const KvRequest& from) {
+    KvRequest::MergeImpl(*this, from);
+  }
   private:
-  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message* to, const ::PROTOBUF_NAMESPACE_ID::Message& from);
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
   public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
@@ -159,10 +287,10 @@ class KvRequest final :
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   uint8_t* _InternalSerialize(
       uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  void SharedCtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(KvRequest* other);
@@ -189,6 +317,16 @@ class KvRequest final :
   enum : int {
     kKeyFieldNumber = 1,
     kValueFieldNumber = 2,
+    kNsFieldNumber = 4,
+    kEpochFieldNumber = 3,
+    kVersionFieldNumber = 5,
+    kExpireAtUsFieldNumber = 7,
+    kIfNotVersionFieldNumber = 8,
+    kIncrByFieldNumber = 9,
+    kFlagsFieldNumber = 10,
+    kIfAbsentFieldNumber = 11,
+    kIncrUnsignedFieldNumber = 12,
+    kIncrInitialFieldNumber = 13,
   };
   // required string key = 1;
   bool has_key() const;
@@ -226,6 +364,141 @@ class KvRequest final :
   std::string* _internal_mutable_value();
   public:
 
+  // optional string ns = 4;
+  bool has_ns() const;
+  private:
+  bool _internal_has_ns() const;
+  public:
+  void clear_ns();
+  const std::string& ns() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_ns(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_ns();
+  PROTOBUF_NODISCARD std::string* release_ns();
+  void set_allocated_ns(std::string* ns);
+  private:
+  const std::string& _internal_ns() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_ns(const std::string& value);
+  std::string* _internal_mutable_ns();
+  public:
+
+  // optional uint64 epoch = 3;
+  bool has_epoch() const;
+  private:
+  bool _internal_has_epoch() const;
+  public:
+  void clear_epoch();
+  uint64_t epoch() const;
+  void set_epoch(uint64_t value);
+  private:
+  uint64_t _internal_epoch() const;
+  void _internal_set_epoch(uint64_t value);
+  public:
+
+  // optional uint64 version = 5;
+  bool has_version() const;
+  private:
+  bool _internal_has_version() const;
+  public:
+  void clear_version();
+  uint64_t version() const;
+  void set_version(uint64_t value);
+  private:
+  uint64_t _internal_version() const;
+  void _internal_set_version(uint64_t value);
+  public:
+
+  // optional uint64 expire_at_us = 7;
+  bool has_expire_at_us() const;
+  private:
+  bool _internal_has_expire_at_us() const;
+  public:
+  void clear_expire_at_us();
+  uint64_t expire_at_us() const;
+  void set_expire_at_us(uint64_t value);
+  private:
+  uint64_t _internal_expire_at_us() const;
+  void _internal_set_expire_at_us(uint64_t value);
+  public:
+
+  // optional uint64 if_not_version = 8;
+  bool has_if_not_version() const;
+  private:
+  bool _internal_has_if_not_version() const;
+  public:
+  void clear_if_not_version();
+  uint64_t if_not_version() const;
+  void set_if_not_version(uint64_t value);
+  private:
+  uint64_t _internal_if_not_version() const;
+  void _internal_set_if_not_version(uint64_t value);
+  public:
+
+  // optional sint64 incr_by = 9;
+  bool has_incr_by() const;
+  private:
+  bool _internal_has_incr_by() const;
+  public:
+  void clear_incr_by();
+  int64_t incr_by() const;
+  void set_incr_by(int64_t value);
+  private:
+  int64_t _internal_incr_by() const;
+  void _internal_set_incr_by(int64_t value);
+  public:
+
+  // optional uint32 flags = 10;
+  bool has_flags() const;
+  private:
+  bool _internal_has_flags() const;
+  public:
+  void clear_flags();
+  uint32_t flags() const;
+  void set_flags(uint32_t value);
+  private:
+  uint32_t _internal_flags() const;
+  void _internal_set_flags(uint32_t value);
+  public:
+
+  // optional bool if_absent = 11;
+  bool has_if_absent() const;
+  private:
+  bool _internal_has_if_absent() const;
+  public:
+  void clear_if_absent();
+  bool if_absent() const;
+  void set_if_absent(bool value);
+  private:
+  bool _internal_if_absent() const;
+  void _internal_set_if_absent(bool value);
+  public:
+
+  // optional uint64 incr_unsigned = 12;
+  bool has_incr_unsigned() const;
+  private:
+  bool _internal_has_incr_unsigned() const;
+  public:
+  void clear_incr_unsigned();
+  uint64_t incr_unsigned() const;
+  void set_incr_unsigned(uint64_t value);
+  private:
+  uint64_t _internal_incr_unsigned() const;
+  void _internal_set_incr_unsigned(uint64_t value);
+  public:
+
+  // optional uint64 incr_initial = 13;
+  bool has_incr_initial() const;
+  private:
+  bool _internal_has_incr_initial() const;
+  public:
+  void clear_incr_initial();
+  uint64_t incr_initial() const;
+  void set_incr_initial(uint64_t value);
+  private:
+  uint64_t _internal_incr_initial() const;
+  void _internal_set_incr_initial(uint64_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:halakv.KvRequest)
  private:
   class _Internal;
@@ -233,10 +506,23 @@ class KvRequest final :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr key_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr value_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr key_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr value_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr ns_;
+    uint64_t epoch_;
+    uint64_t version_;
+    uint64_t expire_at_us_;
+    uint64_t if_not_version_;
+    int64_t incr_by_;
+    uint32_t flags_;
+    bool if_absent_;
+    uint64_t incr_unsigned_;
+    uint64_t incr_initial_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_halakv_2fkv_2eproto;
 };
 // -------------------------------------------------------------------
@@ -328,9 +614,11 @@ class KvResponse final :
   using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const KvResponse& from);
   using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom(const KvResponse& from);
+  void MergeFrom( const KvResponse& from) {
+    KvResponse::MergeImpl(*this, from);
+  }
   private:
-  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message* to, const ::PROTOBUF_NAMESPACE_ID::Message& from);
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
   public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
@@ -339,10 +627,10 @@ class KvResponse final :
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   uint8_t* _InternalSerialize(
       uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  void SharedCtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(KvResponse* other);
@@ -369,7 +657,12 @@ class KvResponse final :
   enum : int {
     kMessageFieldNumber = 2,
     kValueFieldNumber = 3,
+    kRedirectFieldNumber = 4,
     kCodeFieldNumber = 1,
+    kFlagsFieldNumber = 8,
+    kEpochFieldNumber = 5,
+    kExpireAtUsFieldNumber = 6,
+    kVersionFieldNumber = 7,
   };
   // required string message = 2;
   bool has_message() const;
@@ -407,6 +700,24 @@ class KvResponse final :
   std::string* _internal_mutable_value();
   public:
 
+  // optional string redirect = 4;
+  bool has_redirect() const;
+  private:
+  bool _internal_has_redirect() const;
+  public:
+  void clear_redirect();
+  const std::string& redirect() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_redirect(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_redirect();
+  PROTOBUF_NODISCARD std::string* release_redirect();
+  void set_allocated_redirect(std::string* redirect);
+  private:
+  const std::string& _internal_redirect() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_redirect(const std::string& value);
+  std::string* _internal_mutable_redirect();
+  public:
+
   // required int32 code = 1;
   bool has_code() const;
   private:
@@ -420,6 +731,58 @@ class KvResponse final :
   void _internal_set_code(int32_t value);
   public:
 
+  // optional uint32 flags = 8;
+  bool has_flags() const;
+  private:
+  bool _internal_has_flags() const;
+  public:
+  void clear_flags();
+  uint32_t flags() const;
+  void set_flags(uint32_t value);
+  private:
+  uint32_t _internal_flags() const;
+  void _internal_set_flags(uint32_t value);
+  public:
+
+  // optional uint64 epoch = 5;
+  bool has_epoch() const;
+  private:
+  bool _internal_has_epoch() const;
+  public:
+  void clear_epoch();
+  uint64_t epoch() const;
+  void set_epoch(uint64_t value);
+  private:
+  uint64_t _internal_epoch() const;
+  void _internal_set_epoch(uint64_t value);
+  public:
+
+  // optional uint64 expire_at_us = 6;
+  bool has_expire_at_us() const;
+  private:
+  bool _internal_has_expire_at_us() const;
+  public:
+  void clear_expire_at_us();
+  uint64_t expire_at_us() const;
+  void set_expire_at_us(uint64_t value);
+  private:
+  uint64_t _internal_expire_at_us() const;
+  void _internal_set_expire_at_us(uint64_t value);
+  public:
+
+  // optional uint64 version = 7;
+  bool has_version() const;
+  private:
+  bool _internal_has_version() const;
+  public:
+  void clear_version();
+  uint64_t version() const;
+  void set_version(uint64_t value);
+  private:
+  uint64_t _internal_version() const;
+  void _internal_set_version(uint64_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:halakv.KvResponse)
  private:
   class _Internal;
@@ -430,401 +793,8718 @@ class KvResponse final :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr message_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr value_;
-  int32_t code_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr message_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr value_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr redirect_;
+    int32_t code_;
+    uint32_t flags_;
+    uint64_t epoch_;
+    uint64_t expire_at_us_;
+    uint64_t version_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_halakv_2fkv_2eproto;
 };
-// ===================================================================
-
-class KvService_Stub;
+// -------------------------------------------------------------------
 
-class KvService : public ::PROTOBUF_NAMESPACE_ID::Service {
- protected:
-  // This class should be treated as an abstract interface.
-  inline KvService() {};
+class MultiKvRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.MultiKvRequest) */ {
  public:
-  virtual ~KvService();
+  inline MultiKvRequest() : MultiKvRequest(nullptr) {}
+  ~MultiKvRequest() override;
+  explicit PROTOBUF_CONSTEXPR MultiKvRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
-  typedef KvService_Stub Stub;
+  MultiKvRequest(const MultiKvRequest& from);
+  MultiKvRequest(MultiKvRequest&& from) noexcept
+    : MultiKvRequest() {
+    *this = ::std::move(from);
+  }
 
-  static const ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor* descriptor();
+  inline MultiKvRequest& operator=(const MultiKvRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline MultiKvRequest& operator=(MultiKvRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
 
-  virtual void set(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
-                       const ::halakv::KvRequest* request,
-                       ::halakv::KvResponse* response,
-                       ::google::protobuf::Closure* done);
-  virtual void get(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
-                       const ::halakv::KvRequest* request,
-                       ::halakv::KvResponse* response,
-                       ::google::protobuf::Closure* done);
-  virtual void remove(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
-                       const ::halakv::KvRequest* request,
-                       ::halakv::KvResponse* response,
-                       ::google::protobuf::Closure* done);
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
 
-  // implements Service ----------------------------------------------
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const MultiKvRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const MultiKvRequest* internal_default_instance() {
+    return reinterpret_cast<const MultiKvRequest*>(
+               &_MultiKvRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    2;
 
-  const ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor* GetDescriptor();
-  void CallMethod(const ::PROTOBUF_NAMESPACE_ID::MethodDescriptor* method,
-                  ::PROTOBUF_NAMESPACE_ID::RpcController* controller,
-                  const ::PROTOBUF_NAMESPACE_ID::Message* request,
-                  ::PROTOBUF_NAMESPACE_ID::Message* response,
-                  ::google::protobuf::Closure* done);
-  const ::PROTOBUF_NAMESPACE_ID::Message& GetRequestPrototype(
-    const ::PROTOBUF_NAMESPACE_ID::MethodDescriptor* method) const;
-  const ::PROTOBUF_NAMESPACE_ID::Message& GetResponsePrototype(
-    const ::PROTOBUF_NAMESPACE_ID::MethodDescriptor* method) const;
+  friend void swap(MultiKvRequest& a, MultiKvRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(MultiKvRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(MultiKvRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
 
- private:
-  GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(KvService);
-};
+  // implements Message ----------------------------------------------
 
-class KvService_Stub : public KvService {
- public:
-  KvService_Stub(::PROTOBUF_NAMESPACE_ID::RpcChannel* channel);
-  KvService_Stub(::PROTOBUF_NAMESPACE_ID::RpcChannel* channel,
-                   ::PROTOBUF_NAMESPACE_ID::Service::ChannelOwnership ownership);
-  ~KvService_Stub();
+  MultiKvRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<MultiKvRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const MultiKvRequest& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const MultiKvRequest& from) {
+    MultiKvRequest::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
 
-  inline ::PROTOBUF_NAMESPACE_ID::RpcChannel* channel() { return channel_; }
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
-  // implements KvService ------------------------------------------
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(MultiKvRequest* other);
 
-  void set(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
-                       const ::halakv::KvRequest* request,
-                       ::halakv::KvResponse* response,
-                       ::google::protobuf::Closure* done);
-  void get(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
-                       const ::halakv::KvRequest* request,
-                       ::halakv::KvResponse* response,
-                       ::google::protobuf::Closure* done);
-  void remove(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
-                       const ::halakv::KvRequest* request,
-                       ::halakv::KvResponse* response,
-                       ::google::protobuf::Closure* done);
- private:
-  ::PROTOBUF_NAMESPACE_ID::RpcChannel* channel_;
-  bool owns_channel_;
-  GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(KvService_Stub);
-};
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.MultiKvRequest";
+  }
+  protected:
+  explicit MultiKvRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
 
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-// ===================================================================
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
+  // nested types ----------------------------------------------------
 
-// ===================================================================
+  // accessors -------------------------------------------------------
 
-#ifdef __GNUC__
-  #pragma GCC diagnostic push
-  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
-#endif  // __GNUC__
-// KvRequest
+  enum : int {
+    kRequestsFieldNumber = 1,
+  };
+  // repeated .halakv.KvRequest requests = 1;
+  int requests_size() const;
+  private:
+  int _internal_requests_size() const;
+  public:
+  void clear_requests();
+  ::halakv::KvRequest* mutable_requests(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::KvRequest >*
+      mutable_requests();
+  private:
+  const ::halakv::KvRequest& _internal_requests(int index) const;
+  ::halakv::KvRequest* _internal_add_requests();
+  public:
+  const ::halakv::KvRequest& requests(int index) const;
+  ::halakv::KvRequest* add_requests();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::KvRequest >&
+      requests() const;
 
-// required string key = 1;
-inline bool KvRequest::_internal_has_key() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
-  return value;
-}
-inline bool KvRequest::has_key() const {
-  return _internal_has_key();
-}
-inline void KvRequest::clear_key() {
-  key_.ClearToEmpty();
-  _has_bits_[0] &= ~0x00000001u;
-}
-inline const std::string& KvRequest::key() const {
-  // @@protoc_insertion_point(field_get:halakv.KvRequest.key)
-  return _internal_key();
-}
-template <typename ArgT0, typename... ArgT>
+  // @@protoc_insertion_point(class_scope:halakv.MultiKvRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::KvRequest > requests_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class MultiKvResponse final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.MultiKvResponse) */ {
+ public:
+  inline MultiKvResponse() : MultiKvResponse(nullptr) {}
+  ~MultiKvResponse() override;
+  explicit PROTOBUF_CONSTEXPR MultiKvResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  MultiKvResponse(const MultiKvResponse& from);
+  MultiKvResponse(MultiKvResponse&& from) noexcept
+    : MultiKvResponse() {
+    *this = ::std::move(from);
+  }
+
+  inline MultiKvResponse& operator=(const MultiKvResponse& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline MultiKvResponse& operator=(MultiKvResponse&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const MultiKvResponse& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const MultiKvResponse* internal_default_instance() {
+    return reinterpret_cast<const MultiKvResponse*>(
+               &_MultiKvResponse_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    3;
+
+  friend void swap(MultiKvResponse& a, MultiKvResponse& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(MultiKvResponse* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(MultiKvResponse* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  MultiKvResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<MultiKvResponse>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const MultiKvResponse& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const MultiKvResponse& from) {
+    MultiKvResponse::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(MultiKvResponse* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.MultiKvResponse";
+  }
+  protected:
+  explicit MultiKvResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kResponsesFieldNumber = 3,
+    kMessageFieldNumber = 2,
+    kCodeFieldNumber = 1,
+  };
+  // repeated .halakv.KvResponse responses = 3;
+  int responses_size() const;
+  private:
+  int _internal_responses_size() const;
+  public:
+  void clear_responses();
+  ::halakv::KvResponse* mutable_responses(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::KvResponse >*
+      mutable_responses();
+  private:
+  const ::halakv::KvResponse& _internal_responses(int index) const;
+  ::halakv::KvResponse* _internal_add_responses();
+  public:
+  const ::halakv::KvResponse& responses(int index) const;
+  ::halakv::KvResponse* add_responses();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::KvResponse >&
+      responses() const;
+
+  // required string message = 2;
+  bool has_message() const;
+  private:
+  bool _internal_has_message() const;
+  public:
+  void clear_message();
+  const std::string& message() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_message(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_message();
+  PROTOBUF_NODISCARD std::string* release_message();
+  void set_allocated_message(std::string* message);
+  private:
+  const std::string& _internal_message() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_message(const std::string& value);
+  std::string* _internal_mutable_message();
+  public:
+
+  // required int32 code = 1;
+  bool has_code() const;
+  private:
+  bool _internal_has_code() const;
+  public:
+  void clear_code();
+  int32_t code() const;
+  void set_code(int32_t value);
+  private:
+  int32_t _internal_code() const;
+  void _internal_set_code(int32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.MultiKvResponse)
+ private:
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::KvResponse > responses_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr message_;
+    int32_t code_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class HintsRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.HintsRequest) */ {
+ public:
+  inline HintsRequest() : HintsRequest(nullptr) {}
+  ~HintsRequest() override;
+  explicit PROTOBUF_CONSTEXPR HintsRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  HintsRequest(const HintsRequest& from);
+  HintsRequest(HintsRequest&& from) noexcept
+    : HintsRequest() {
+    *this = ::std::move(from);
+  }
+
+  inline HintsRequest& operator=(const HintsRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline HintsRequest& operator=(HintsRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const HintsRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const HintsRequest* internal_default_instance() {
+    return reinterpret_cast<const HintsRequest*>(
+               &_HintsRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    4;
+
+  friend void swap(HintsRequest& a, HintsRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(HintsRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(HintsRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  HintsRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<HintsRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const HintsRequest& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const HintsRequest& from) {
+    HintsRequest::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(HintsRequest* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.HintsRequest";
+  }
+  protected:
+  explicit HintsRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kPeerFieldNumber = 1,
+  };
+  // required string peer = 1;
+  bool has_peer() const;
+  private:
+  bool _internal_has_peer() const;
+  public:
+  void clear_peer();
+  const std::string& peer() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_peer(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_peer();
+  PROTOBUF_NODISCARD std::string* release_peer();
+  void set_allocated_peer(std::string* peer);
+  private:
+  const std::string& _internal_peer() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_peer(const std::string& value);
+  std::string* _internal_mutable_peer();
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.HintsRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr peer_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class HintsResponse final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.HintsResponse) */ {
+ public:
+  inline HintsResponse() : HintsResponse(nullptr) {}
+  ~HintsResponse() override;
+  explicit PROTOBUF_CONSTEXPR HintsResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  HintsResponse(const HintsResponse& from);
+  HintsResponse(HintsResponse&& from) noexcept
+    : HintsResponse() {
+    *this = ::std::move(from);
+  }
+
+  inline HintsResponse& operator=(const HintsResponse& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline HintsResponse& operator=(HintsResponse&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const HintsResponse& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const HintsResponse* internal_default_instance() {
+    return reinterpret_cast<const HintsResponse*>(
+               &_HintsResponse_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    5;
+
+  friend void swap(HintsResponse& a, HintsResponse& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(HintsResponse* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(HintsResponse* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  HintsResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<HintsResponse>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const HintsResponse& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const HintsResponse& from) {
+    HintsResponse::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(HintsResponse* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.HintsResponse";
+  }
+  protected:
+  explicit HintsResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kMessageFieldNumber = 2,
+    kCountFieldNumber = 3,
+    kCodeFieldNumber = 1,
+  };
+  // required string message = 2;
+  bool has_message() const;
+  private:
+  bool _internal_has_message() const;
+  public:
+  void clear_message();
+  const std::string& message() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_message(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_message();
+  PROTOBUF_NODISCARD std::string* release_message();
+  void set_allocated_message(std::string* message);
+  private:
+  const std::string& _internal_message() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_message(const std::string& value);
+  std::string* _internal_mutable_message();
+  public:
+
+  // optional uint64 count = 3;
+  bool has_count() const;
+  private:
+  bool _internal_has_count() const;
+  public:
+  void clear_count();
+  uint64_t count() const;
+  void set_count(uint64_t value);
+  private:
+  uint64_t _internal_count() const;
+  void _internal_set_count(uint64_t value);
+  public:
+
+  // required int32 code = 1;
+  bool has_code() const;
+  private:
+  bool _internal_has_code() const;
+  public:
+  void clear_code();
+  int32_t code() const;
+  void set_code(int32_t value);
+  private:
+  int32_t _internal_code() const;
+  void _internal_set_code(int32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.HintsResponse)
+ private:
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr message_;
+    uint64_t count_;
+    int32_t code_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class InvalidateRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.InvalidateRequest) */ {
+ public:
+  inline InvalidateRequest() : InvalidateRequest(nullptr) {}
+  ~InvalidateRequest() override;
+  explicit PROTOBUF_CONSTEXPR InvalidateRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  InvalidateRequest(const InvalidateRequest& from);
+  InvalidateRequest(InvalidateRequest&& from) noexcept
+    : InvalidateRequest() {
+    *this = ::std::move(from);
+  }
+
+  inline InvalidateRequest& operator=(const InvalidateRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline InvalidateRequest& operator=(InvalidateRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const InvalidateRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const InvalidateRequest* internal_default_instance() {
+    return reinterpret_cast<const InvalidateRequest*>(
+               &_InvalidateRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    6;
+
+  friend void swap(InvalidateRequest& a, InvalidateRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(InvalidateRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(InvalidateRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  InvalidateRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<InvalidateRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const InvalidateRequest& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const InvalidateRequest& from) {
+    InvalidateRequest::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(InvalidateRequest* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.InvalidateRequest";
+  }
+  protected:
+  explicit InvalidateRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kKeysFieldNumber = 1,
+  };
+  // repeated string keys = 1;
+  int keys_size() const;
+  private:
+  int _internal_keys_size() const;
+  public:
+  void clear_keys();
+  const std::string& keys(int index) const;
+  std::string* mutable_keys(int index);
+  void set_keys(int index, const std::string& value);
+  void set_keys(int index, std::string&& value);
+  void set_keys(int index, const char* value);
+  void set_keys(int index, const char* value, size_t size);
+  std::string* add_keys();
+  void add_keys(const std::string& value);
+  void add_keys(std::string&& value);
+  void add_keys(const char* value);
+  void add_keys(const char* value, size_t size);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>& keys() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>* mutable_keys();
+  private:
+  const std::string& _internal_keys(int index) const;
+  std::string* _internal_add_keys();
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.InvalidateRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string> keys_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class MerkleRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.MerkleRequest) */ {
+ public:
+  inline MerkleRequest() : MerkleRequest(nullptr) {}
+  ~MerkleRequest() override;
+  explicit PROTOBUF_CONSTEXPR MerkleRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  MerkleRequest(const MerkleRequest& from);
+  MerkleRequest(MerkleRequest&& from) noexcept
+    : MerkleRequest() {
+    *this = ::std::move(from);
+  }
+
+  inline MerkleRequest& operator=(const MerkleRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline MerkleRequest& operator=(MerkleRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const MerkleRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const MerkleRequest* internal_default_instance() {
+    return reinterpret_cast<const MerkleRequest*>(
+               &_MerkleRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    7;
+
+  friend void swap(MerkleRequest& a, MerkleRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(MerkleRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(MerkleRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  MerkleRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<MerkleRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const MerkleRequest& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const MerkleRequest& from) {
+    MerkleRequest::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(MerkleRequest* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.MerkleRequest";
+  }
+  protected:
+  explicit MerkleRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kNodesFieldNumber = 1,
+    kReplicaFieldNumber = 2,
+  };
+  // repeated uint32 nodes = 1;
+  int nodes_size() const;
+  private:
+  int _internal_nodes_size() const;
+  public:
+  void clear_nodes();
+  private:
+  uint32_t _internal_nodes(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      _internal_nodes() const;
+  void _internal_add_nodes(uint32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      _internal_mutable_nodes();
+  public:
+  uint32_t nodes(int index) const;
+  void set_nodes(int index, uint32_t value);
+  void add_nodes(uint32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      nodes() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      mutable_nodes();
+
+  // optional bool replica = 2;
+  bool has_replica() const;
+  private:
+  bool _internal_has_replica() const;
+  public:
+  void clear_replica();
+  bool replica() const;
+  void set_replica(bool value);
+  private:
+  bool _internal_replica() const;
+  void _internal_set_replica(bool value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.MerkleRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t > nodes_;
+    bool replica_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class MerkleResponse final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.MerkleResponse) */ {
+ public:
+  inline MerkleResponse() : MerkleResponse(nullptr) {}
+  ~MerkleResponse() override;
+  explicit PROTOBUF_CONSTEXPR MerkleResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  MerkleResponse(const MerkleResponse& from);
+  MerkleResponse(MerkleResponse&& from) noexcept
+    : MerkleResponse() {
+    *this = ::std::move(from);
+  }
+
+  inline MerkleResponse& operator=(const MerkleResponse& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline MerkleResponse& operator=(MerkleResponse&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const MerkleResponse& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const MerkleResponse* internal_default_instance() {
+    return reinterpret_cast<const MerkleResponse*>(
+               &_MerkleResponse_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    8;
+
+  friend void swap(MerkleResponse& a, MerkleResponse& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(MerkleResponse* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(MerkleResponse* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  MerkleResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<MerkleResponse>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const MerkleResponse& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const MerkleResponse& from) {
+    MerkleResponse::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(MerkleResponse* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.MerkleResponse";
+  }
+  protected:
+  explicit MerkleResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kHashesFieldNumber = 3,
+    kMessageFieldNumber = 2,
+    kCodeFieldNumber = 1,
+  };
+  // repeated uint64 hashes = 3;
+  int hashes_size() const;
+  private:
+  int _internal_hashes_size() const;
+  public:
+  void clear_hashes();
+  private:
+  uint64_t _internal_hashes(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+      _internal_hashes() const;
+  void _internal_add_hashes(uint64_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+      _internal_mutable_hashes();
+  public:
+  uint64_t hashes(int index) const;
+  void set_hashes(int index, uint64_t value);
+  void add_hashes(uint64_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+      hashes() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+      mutable_hashes();
+
+  // required string message = 2;
+  bool has_message() const;
+  private:
+  bool _internal_has_message() const;
+  public:
+  void clear_message();
+  const std::string& message() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_message(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_message();
+  PROTOBUF_NODISCARD std::string* release_message();
+  void set_allocated_message(std::string* message);
+  private:
+  const std::string& _internal_message() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_message(const std::string& value);
+  std::string* _internal_mutable_message();
+  public:
+
+  // required int32 code = 1;
+  bool has_code() const;
+  private:
+  bool _internal_has_code() const;
+  public:
+  void clear_code();
+  int32_t code() const;
+  void set_code(int32_t value);
+  private:
+  int32_t _internal_code() const;
+  void _internal_set_code(int32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.MerkleResponse)
+ private:
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t > hashes_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr message_;
+    int32_t code_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class ScanRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.ScanRequest) */ {
+ public:
+  inline ScanRequest() : ScanRequest(nullptr) {}
+  ~ScanRequest() override;
+  explicit PROTOBUF_CONSTEXPR ScanRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  ScanRequest(const ScanRequest& from);
+  ScanRequest(ScanRequest&& from) noexcept
+    : ScanRequest() {
+    *this = ::std::move(from);
+  }
+
+  inline ScanRequest& operator=(const ScanRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ScanRequest& operator=(ScanRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ScanRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ScanRequest* internal_default_instance() {
+    return reinterpret_cast<const ScanRequest*>(
+               &_ScanRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    9;
+
+  friend void swap(ScanRequest& a, ScanRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(ScanRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ScanRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  ScanRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<ScanRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const ScanRequest& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const ScanRequest& from) {
+    ScanRequest::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(ScanRequest* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.ScanRequest";
+  }
+  protected:
+  explicit ScanRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kLeavesFieldNumber = 1,
+    kReplicaFieldNumber = 2,
+  };
+  // repeated uint32 leaves = 1;
+  int leaves_size() const;
+  private:
+  int _internal_leaves_size() const;
+  public:
+  void clear_leaves();
+  private:
+  uint32_t _internal_leaves(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      _internal_leaves() const;
+  void _internal_add_leaves(uint32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      _internal_mutable_leaves();
+  public:
+  uint32_t leaves(int index) const;
+  void set_leaves(int index, uint32_t value);
+  void add_leaves(uint32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      leaves() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      mutable_leaves();
+
+  // optional bool replica = 2;
+  bool has_replica() const;
+  private:
+  bool _internal_has_replica() const;
+  public:
+  void clear_replica();
+  bool replica() const;
+  void set_replica(bool value);
+  private:
+  bool _internal_replica() const;
+  void _internal_set_replica(bool value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.ScanRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t > leaves_;
+    bool replica_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class ScanResponse final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.ScanResponse) */ {
+ public:
+  inline ScanResponse() : ScanResponse(nullptr) {}
+  ~ScanResponse() override;
+  explicit PROTOBUF_CONSTEXPR ScanResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  ScanResponse(const ScanResponse& from);
+  ScanResponse(ScanResponse&& from) noexcept
+    : ScanResponse() {
+    *this = ::std::move(from);
+  }
+
+  inline ScanResponse& operator=(const ScanResponse& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ScanResponse& operator=(ScanResponse&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ScanResponse& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ScanResponse* internal_default_instance() {
+    return reinterpret_cast<const ScanResponse*>(
+               &_ScanResponse_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    10;
+
+  friend void swap(ScanResponse& a, ScanResponse& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(ScanResponse* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ScanResponse* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  ScanResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<ScanResponse>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const ScanResponse& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const ScanResponse& from) {
+    ScanResponse::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(ScanResponse* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.ScanResponse";
+  }
+  protected:
+  explicit ScanResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kEntriesFieldNumber = 3,
+    kMessageFieldNumber = 2,
+    kCodeFieldNumber = 1,
+  };
+  // repeated .halakv.KvRequest entries = 3;
+  int entries_size() const;
+  private:
+  int _internal_entries_size() const;
+  public:
+  void clear_entries();
+  ::halakv::KvRequest* mutable_entries(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::KvRequest >*
+      mutable_entries();
+  private:
+  const ::halakv::KvRequest& _internal_entries(int index) const;
+  ::halakv::KvRequest* _internal_add_entries();
+  public:
+  const ::halakv::KvRequest& entries(int index) const;
+  ::halakv::KvRequest* add_entries();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::KvRequest >&
+      entries() const;
+
+  // required string message = 2;
+  bool has_message() const;
+  private:
+  bool _internal_has_message() const;
+  public:
+  void clear_message();
+  const std::string& message() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_message(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_message();
+  PROTOBUF_NODISCARD std::string* release_message();
+  void set_allocated_message(std::string* message);
+  private:
+  const std::string& _internal_message() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_message(const std::string& value);
+  std::string* _internal_mutable_message();
+  public:
+
+  // required int32 code = 1;
+  bool has_code() const;
+  private:
+  bool _internal_has_code() const;
+  public:
+  void clear_code();
+  int32_t code() const;
+  void set_code(int32_t value);
+  private:
+  int32_t _internal_code() const;
+  void _internal_set_code(int32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.ScanResponse)
+ private:
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::KvRequest > entries_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr message_;
+    int32_t code_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class ReplicateRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.ReplicateRequest) */ {
+ public:
+  inline ReplicateRequest() : ReplicateRequest(nullptr) {}
+  ~ReplicateRequest() override;
+  explicit PROTOBUF_CONSTEXPR ReplicateRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  ReplicateRequest(const ReplicateRequest& from);
+  ReplicateRequest(ReplicateRequest&& from) noexcept
+    : ReplicateRequest() {
+    *this = ::std::move(from);
+  }
+
+  inline ReplicateRequest& operator=(const ReplicateRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ReplicateRequest& operator=(ReplicateRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ReplicateRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ReplicateRequest* internal_default_instance() {
+    return reinterpret_cast<const ReplicateRequest*>(
+               &_ReplicateRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    11;
+
+  friend void swap(ReplicateRequest& a, ReplicateRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(ReplicateRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ReplicateRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  ReplicateRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<ReplicateRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const ReplicateRequest& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const ReplicateRequest& from) {
+    ReplicateRequest::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(ReplicateRequest* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.ReplicateRequest";
+  }
+  protected:
+  explicit ReplicateRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kPrimaryFieldNumber = 1,
+    kStartSeqFieldNumber = 2,
+    kIncarnationFieldNumber = 3,
+  };
+  // required string primary = 1;
+  bool has_primary() const;
+  private:
+  bool _internal_has_primary() const;
+  public:
+  void clear_primary();
+  const std::string& primary() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_primary(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_primary();
+  PROTOBUF_NODISCARD std::string* release_primary();
+  void set_allocated_primary(std::string* primary);
+  private:
+  const std::string& _internal_primary() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_primary(const std::string& value);
+  std::string* _internal_mutable_primary();
+  public:
+
+  // required uint64 start_seq = 2;
+  bool has_start_seq() const;
+  private:
+  bool _internal_has_start_seq() const;
+  public:
+  void clear_start_seq();
+  uint64_t start_seq() const;
+  void set_start_seq(uint64_t value);
+  private:
+  uint64_t _internal_start_seq() const;
+  void _internal_set_start_seq(uint64_t value);
+  public:
+
+  // optional uint64 incarnation = 3;
+  bool has_incarnation() const;
+  private:
+  bool _internal_has_incarnation() const;
+  public:
+  void clear_incarnation();
+  uint64_t incarnation() const;
+  void set_incarnation(uint64_t value);
+  private:
+  uint64_t _internal_incarnation() const;
+  void _internal_set_incarnation(uint64_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.ReplicateRequest)
+ private:
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr primary_;
+    uint64_t start_seq_;
+    uint64_t incarnation_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class LogEntry final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.LogEntry) */ {
+ public:
+  inline LogEntry() : LogEntry(nullptr) {}
+  ~LogEntry() override;
+  explicit PROTOBUF_CONSTEXPR LogEntry(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  LogEntry(const LogEntry& from);
+  LogEntry(LogEntry&& from) noexcept
+    : LogEntry() {
+    *this = ::std::move(from);
+  }
+
+  inline LogEntry& operator=(const LogEntry& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline LogEntry& operator=(LogEntry&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const LogEntry& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const LogEntry* internal_default_instance() {
+    return reinterpret_cast<const LogEntry*>(
+               &_LogEntry_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    12;
+
+  friend void swap(LogEntry& a, LogEntry& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(LogEntry* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(LogEntry* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  LogEntry* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<LogEntry>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const LogEntry& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const LogEntry& from) {
+    LogEntry::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(LogEntry* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.LogEntry";
+  }
+  protected:
+  explicit LogEntry(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kKeyFieldNumber = 2,
+    kValueFieldNumber = 3,
+    kSeqFieldNumber = 1,
+    kExpireAtUsFieldNumber = 5,
+    kRemoveFieldNumber = 4,
+    kFlagsFieldNumber = 7,
+    kVersionFieldNumber = 6,
+  };
+  // required string key = 2;
+  bool has_key() const;
+  private:
+  bool _internal_has_key() const;
+  public:
+  void clear_key();
+  const std::string& key() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_key(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_key();
+  PROTOBUF_NODISCARD std::string* release_key();
+  void set_allocated_key(std::string* key);
+  private:
+  const std::string& _internal_key() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_key(const std::string& value);
+  std::string* _internal_mutable_key();
+  public:
+
+  // optional string value = 3;
+  bool has_value() const;
+  private:
+  bool _internal_has_value() const;
+  public:
+  void clear_value();
+  const std::string& value() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_value(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_value();
+  PROTOBUF_NODISCARD std::string* release_value();
+  void set_allocated_value(std::string* value);
+  private:
+  const std::string& _internal_value() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_value(const std::string& value);
+  std::string* _internal_mutable_value();
+  public:
+
+  // required uint64 seq = 1;
+  bool has_seq() const;
+  private:
+  bool _internal_has_seq() const;
+  public:
+  void clear_seq();
+  uint64_t seq() const;
+  void set_seq(uint64_t value);
+  private:
+  uint64_t _internal_seq() const;
+  void _internal_set_seq(uint64_t value);
+  public:
+
+  // optional uint64 expire_at_us = 5;
+  bool has_expire_at_us() const;
+  private:
+  bool _internal_has_expire_at_us() const;
+  public:
+  void clear_expire_at_us();
+  uint64_t expire_at_us() const;
+  void set_expire_at_us(uint64_t value);
+  private:
+  uint64_t _internal_expire_at_us() const;
+  void _internal_set_expire_at_us(uint64_t value);
+  public:
+
+  // optional bool remove = 4;
+  bool has_remove() const;
+  private:
+  bool _internal_has_remove() const;
+  public:
+  void clear_remove();
+  bool remove() const;
+  void set_remove(bool value);
+  private:
+  bool _internal_remove() const;
+  void _internal_set_remove(bool value);
+  public:
+
+  // optional uint32 flags = 7;
+  bool has_flags() const;
+  private:
+  bool _internal_has_flags() const;
+  public:
+  void clear_flags();
+  uint32_t flags() const;
+  void set_flags(uint32_t value);
+  private:
+  uint32_t _internal_flags() const;
+  void _internal_set_flags(uint32_t value);
+  public:
+
+  // optional uint64 version = 6;
+  bool has_version() const;
+  private:
+  bool _internal_has_version() const;
+  public:
+  void clear_version();
+  uint64_t version() const;
+  void set_version(uint64_t value);
+  private:
+  uint64_t _internal_version() const;
+  void _internal_set_version(uint64_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.LogEntry)
+ private:
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr key_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr value_;
+    uint64_t seq_;
+    uint64_t expire_at_us_;
+    bool remove_;
+    uint32_t flags_;
+    uint64_t version_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class LogBatch final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.LogBatch) */ {
+ public:
+  inline LogBatch() : LogBatch(nullptr) {}
+  ~LogBatch() override;
+  explicit PROTOBUF_CONSTEXPR LogBatch(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  LogBatch(const LogBatch& from);
+  LogBatch(LogBatch&& from) noexcept
+    : LogBatch() {
+    *this = ::std::move(from);
+  }
+
+  inline LogBatch& operator=(const LogBatch& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline LogBatch& operator=(LogBatch&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const LogBatch& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const LogBatch* internal_default_instance() {
+    return reinterpret_cast<const LogBatch*>(
+               &_LogBatch_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    13;
+
+  friend void swap(LogBatch& a, LogBatch& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(LogBatch* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(LogBatch* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  LogBatch* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<LogBatch>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const LogBatch& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const LogBatch& from) {
+    LogBatch::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(LogBatch* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.LogBatch";
+  }
+  protected:
+  explicit LogBatch(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kEntriesFieldNumber = 1,
+  };
+  // repeated .halakv.LogEntry entries = 1;
+  int entries_size() const;
+  private:
+  int _internal_entries_size() const;
+  public:
+  void clear_entries();
+  ::halakv::LogEntry* mutable_entries(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::LogEntry >*
+      mutable_entries();
+  private:
+  const ::halakv::LogEntry& _internal_entries(int index) const;
+  ::halakv::LogEntry* _internal_add_entries();
+  public:
+  const ::halakv::LogEntry& entries(int index) const;
+  ::halakv::LogEntry* add_entries();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::LogEntry >&
+      entries() const;
+
+  // @@protoc_insertion_point(class_scope:halakv.LogBatch)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::LogEntry > entries_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class LogAck final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.LogAck) */ {
+ public:
+  inline LogAck() : LogAck(nullptr) {}
+  ~LogAck() override;
+  explicit PROTOBUF_CONSTEXPR LogAck(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  LogAck(const LogAck& from);
+  LogAck(LogAck&& from) noexcept
+    : LogAck() {
+    *this = ::std::move(from);
+  }
+
+  inline LogAck& operator=(const LogAck& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline LogAck& operator=(LogAck&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const LogAck& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const LogAck* internal_default_instance() {
+    return reinterpret_cast<const LogAck*>(
+               &_LogAck_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    14;
+
+  friend void swap(LogAck& a, LogAck& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(LogAck* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(LogAck* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  LogAck* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<LogAck>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const LogAck& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const LogAck& from) {
+    LogAck::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(LogAck* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.LogAck";
+  }
+  protected:
+  explicit LogAck(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kSeqFieldNumber = 1,
+  };
+  // required uint64 seq = 1;
+  bool has_seq() const;
+  private:
+  bool _internal_has_seq() const;
+  public:
+  void clear_seq();
+  uint64_t seq() const;
+  void set_seq(uint64_t value);
+  private:
+  uint64_t _internal_seq() const;
+  void _internal_set_seq(uint64_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.LogAck)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    uint64_t seq_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class LoadRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.LoadRequest) */ {
+ public:
+  inline LoadRequest() : LoadRequest(nullptr) {}
+  ~LoadRequest() override;
+  explicit PROTOBUF_CONSTEXPR LoadRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  LoadRequest(const LoadRequest& from);
+  LoadRequest(LoadRequest&& from) noexcept
+    : LoadRequest() {
+    *this = ::std::move(from);
+  }
+
+  inline LoadRequest& operator=(const LoadRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline LoadRequest& operator=(LoadRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const LoadRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const LoadRequest* internal_default_instance() {
+    return reinterpret_cast<const LoadRequest*>(
+               &_LoadRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    15;
+
+  friend void swap(LoadRequest& a, LoadRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(LoadRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(LoadRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  LoadRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<LoadRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const LoadRequest& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const LoadRequest& from) {
+    LoadRequest::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(LoadRequest* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.LoadRequest";
+  }
+  protected:
+  explicit LoadRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kNsFieldNumber = 1,
+  };
+  // optional string ns = 1;
+  bool has_ns() const;
+  private:
+  bool _internal_has_ns() const;
+  public:
+  void clear_ns();
+  const std::string& ns() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_ns(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_ns();
+  PROTOBUF_NODISCARD std::string* release_ns();
+  void set_allocated_ns(std::string* ns);
+  private:
+  const std::string& _internal_ns() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_ns(const std::string& value);
+  std::string* _internal_mutable_ns();
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.LoadRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr ns_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class LoadAck final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.LoadAck) */ {
+ public:
+  inline LoadAck() : LoadAck(nullptr) {}
+  ~LoadAck() override;
+  explicit PROTOBUF_CONSTEXPR LoadAck(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  LoadAck(const LoadAck& from);
+  LoadAck(LoadAck&& from) noexcept
+    : LoadAck() {
+    *this = ::std::move(from);
+  }
+
+  inline LoadAck& operator=(const LoadAck& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline LoadAck& operator=(LoadAck&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const LoadAck& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const LoadAck* internal_default_instance() {
+    return reinterpret_cast<const LoadAck*>(
+               &_LoadAck_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    16;
+
+  friend void swap(LoadAck& a, LoadAck& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(LoadAck* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(LoadAck* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  LoadAck* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<LoadAck>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const LoadAck& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const LoadAck& from) {
+    LoadAck::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(LoadAck* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.LoadAck";
+  }
+  protected:
+  explicit LoadAck(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kBatchesFieldNumber = 1,
+    kLoadedFieldNumber = 2,
+    kFailedFieldNumber = 3,
+  };
+  // required uint64 batches = 1;
+  bool has_batches() const;
+  private:
+  bool _internal_has_batches() const;
+  public:
+  void clear_batches();
+  uint64_t batches() const;
+  void set_batches(uint64_t value);
+  private:
+  uint64_t _internal_batches() const;
+  void _internal_set_batches(uint64_t value);
+  public:
+
+  // required uint64 loaded = 2;
+  bool has_loaded() const;
+  private:
+  bool _internal_has_loaded() const;
+  public:
+  void clear_loaded();
+  uint64_t loaded() const;
+  void set_loaded(uint64_t value);
+  private:
+  uint64_t _internal_loaded() const;
+  void _internal_set_loaded(uint64_t value);
+  public:
+
+  // required uint64 failed = 3;
+  bool has_failed() const;
+  private:
+  bool _internal_has_failed() const;
+  public:
+  void clear_failed();
+  uint64_t failed() const;
+  void set_failed(uint64_t value);
+  private:
+  uint64_t _internal_failed() const;
+  void _internal_set_failed(uint64_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.LoadAck)
+ private:
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    uint64_t batches_;
+    uint64_t loaded_;
+    uint64_t failed_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class WatchRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.WatchRequest) */ {
+ public:
+  inline WatchRequest() : WatchRequest(nullptr) {}
+  ~WatchRequest() override;
+  explicit PROTOBUF_CONSTEXPR WatchRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  WatchRequest(const WatchRequest& from);
+  WatchRequest(WatchRequest&& from) noexcept
+    : WatchRequest() {
+    *this = ::std::move(from);
+  }
+
+  inline WatchRequest& operator=(const WatchRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline WatchRequest& operator=(WatchRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const WatchRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const WatchRequest* internal_default_instance() {
+    return reinterpret_cast<const WatchRequest*>(
+               &_WatchRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    17;
+
+  friend void swap(WatchRequest& a, WatchRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(WatchRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(WatchRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  WatchRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<WatchRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const WatchRequest& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const WatchRequest& from) {
+    WatchRequest::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(WatchRequest* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.WatchRequest";
+  }
+  protected:
+  explicit WatchRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kPrefixesFieldNumber = 1,
+    kKeysFieldNumber = 2,
+    kNsFieldNumber = 3,
+  };
+  // repeated string prefixes = 1;
+  int prefixes_size() const;
+  private:
+  int _internal_prefixes_size() const;
+  public:
+  void clear_prefixes();
+  const std::string& prefixes(int index) const;
+  std::string* mutable_prefixes(int index);
+  void set_prefixes(int index, const std::string& value);
+  void set_prefixes(int index, std::string&& value);
+  void set_prefixes(int index, const char* value);
+  void set_prefixes(int index, const char* value, size_t size);
+  std::string* add_prefixes();
+  void add_prefixes(const std::string& value);
+  void add_prefixes(std::string&& value);
+  void add_prefixes(const char* value);
+  void add_prefixes(const char* value, size_t size);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>& prefixes() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>* mutable_prefixes();
+  private:
+  const std::string& _internal_prefixes(int index) const;
+  std::string* _internal_add_prefixes();
+  public:
+
+  // repeated string keys = 2;
+  int keys_size() const;
+  private:
+  int _internal_keys_size() const;
+  public:
+  void clear_keys();
+  const std::string& keys(int index) const;
+  std::string* mutable_keys(int index);
+  void set_keys(int index, const std::string& value);
+  void set_keys(int index, std::string&& value);
+  void set_keys(int index, const char* value);
+  void set_keys(int index, const char* value, size_t size);
+  std::string* add_keys();
+  void add_keys(const std::string& value);
+  void add_keys(std::string&& value);
+  void add_keys(const char* value);
+  void add_keys(const char* value, size_t size);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>& keys() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>* mutable_keys();
+  private:
+  const std::string& _internal_keys(int index) const;
+  std::string* _internal_add_keys();
+  public:
+
+  // optional string ns = 3;
+  bool has_ns() const;
+  private:
+  bool _internal_has_ns() const;
+  public:
+  void clear_ns();
+  const std::string& ns() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_ns(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_ns();
+  PROTOBUF_NODISCARD std::string* release_ns();
+  void set_allocated_ns(std::string* ns);
+  private:
+  const std::string& _internal_ns() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_ns(const std::string& value);
+  std::string* _internal_mutable_ns();
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.WatchRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string> prefixes_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string> keys_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr ns_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class WatchEvent final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.WatchEvent) */ {
+ public:
+  inline WatchEvent() : WatchEvent(nullptr) {}
+  ~WatchEvent() override;
+  explicit PROTOBUF_CONSTEXPR WatchEvent(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  WatchEvent(const WatchEvent& from);
+  WatchEvent(WatchEvent&& from) noexcept
+    : WatchEvent() {
+    *this = ::std::move(from);
+  }
+
+  inline WatchEvent& operator=(const WatchEvent& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline WatchEvent& operator=(WatchEvent&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const WatchEvent& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const WatchEvent* internal_default_instance() {
+    return reinterpret_cast<const WatchEvent*>(
+               &_WatchEvent_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    18;
+
+  friend void swap(WatchEvent& a, WatchEvent& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(WatchEvent* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(WatchEvent* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  WatchEvent* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<WatchEvent>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const WatchEvent& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const WatchEvent& from) {
+    WatchEvent::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(WatchEvent* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.WatchEvent";
+  }
+  protected:
+  explicit WatchEvent(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kKeyFieldNumber = 2,
+    kSeqFieldNumber = 1,
+    kRemoveFieldNumber = 3,
+  };
+  // required string key = 2;
+  bool has_key() const;
+  private:
+  bool _internal_has_key() const;
+  public:
+  void clear_key();
+  const std::string& key() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_key(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_key();
+  PROTOBUF_NODISCARD std::string* release_key();
+  void set_allocated_key(std::string* key);
+  private:
+  const std::string& _internal_key() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_key(const std::string& value);
+  std::string* _internal_mutable_key();
+  public:
+
+  // required uint64 seq = 1;
+  bool has_seq() const;
+  private:
+  bool _internal_has_seq() const;
+  public:
+  void clear_seq();
+  uint64_t seq() const;
+  void set_seq(uint64_t value);
+  private:
+  uint64_t _internal_seq() const;
+  void _internal_set_seq(uint64_t value);
+  public:
+
+  // optional bool remove = 3;
+  bool has_remove() const;
+  private:
+  bool _internal_has_remove() const;
+  public:
+  void clear_remove();
+  bool remove() const;
+  void set_remove(bool value);
+  private:
+  bool _internal_remove() const;
+  void _internal_set_remove(bool value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.WatchEvent)
+ private:
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr key_;
+    uint64_t seq_;
+    bool remove_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class WatchBatch final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.WatchBatch) */ {
+ public:
+  inline WatchBatch() : WatchBatch(nullptr) {}
+  ~WatchBatch() override;
+  explicit PROTOBUF_CONSTEXPR WatchBatch(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  WatchBatch(const WatchBatch& from);
+  WatchBatch(WatchBatch&& from) noexcept
+    : WatchBatch() {
+    *this = ::std::move(from);
+  }
+
+  inline WatchBatch& operator=(const WatchBatch& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline WatchBatch& operator=(WatchBatch&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const WatchBatch& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const WatchBatch* internal_default_instance() {
+    return reinterpret_cast<const WatchBatch*>(
+               &_WatchBatch_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    19;
+
+  friend void swap(WatchBatch& a, WatchBatch& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(WatchBatch* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(WatchBatch* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  WatchBatch* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<WatchBatch>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const WatchBatch& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const WatchBatch& from) {
+    WatchBatch::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(WatchBatch* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.WatchBatch";
+  }
+  protected:
+  explicit WatchBatch(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kEventsFieldNumber = 1,
+    kResyncSeqFieldNumber = 3,
+    kResyncFieldNumber = 2,
+  };
+  // repeated .halakv.WatchEvent events = 1;
+  int events_size() const;
+  private:
+  int _internal_events_size() const;
+  public:
+  void clear_events();
+  ::halakv::WatchEvent* mutable_events(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::WatchEvent >*
+      mutable_events();
+  private:
+  const ::halakv::WatchEvent& _internal_events(int index) const;
+  ::halakv::WatchEvent* _internal_add_events();
+  public:
+  const ::halakv::WatchEvent& events(int index) const;
+  ::halakv::WatchEvent* add_events();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::WatchEvent >&
+      events() const;
+
+  // optional uint64 resync_seq = 3;
+  bool has_resync_seq() const;
+  private:
+  bool _internal_has_resync_seq() const;
+  public:
+  void clear_resync_seq();
+  uint64_t resync_seq() const;
+  void set_resync_seq(uint64_t value);
+  private:
+  uint64_t _internal_resync_seq() const;
+  void _internal_set_resync_seq(uint64_t value);
+  public:
+
+  // optional bool resync = 2;
+  bool has_resync() const;
+  private:
+  bool _internal_has_resync() const;
+  public:
+  void clear_resync();
+  bool resync() const;
+  void set_resync(bool value);
+  private:
+  bool _internal_resync() const;
+  void _internal_set_resync(bool value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.WatchBatch)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::WatchEvent > events_;
+    uint64_t resync_seq_;
+    bool resync_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class RouteRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase /* @@protoc_insertion_point(class_definition:halakv.RouteRequest) */ {
+ public:
+  inline RouteRequest() : RouteRequest(nullptr) {}
+  explicit PROTOBUF_CONSTEXPR RouteRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  RouteRequest(const RouteRequest& from);
+  RouteRequest(RouteRequest&& from) noexcept
+    : RouteRequest() {
+    *this = ::std::move(from);
+  }
+
+  inline RouteRequest& operator=(const RouteRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline RouteRequest& operator=(RouteRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const RouteRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const RouteRequest* internal_default_instance() {
+    return reinterpret_cast<const RouteRequest*>(
+               &_RouteRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    20;
+
+  friend void swap(RouteRequest& a, RouteRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(RouteRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(RouteRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  RouteRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<RouteRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyFrom;
+  inline void CopyFrom(const RouteRequest& from) {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl(*this, from);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeFrom;
+  void MergeFrom(const RouteRequest& from) {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl(*this, from);
+  }
+  public:
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.RouteRequest";
+  }
+  protected:
+  explicit RouteRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // @@protoc_insertion_point(class_scope:halakv.RouteRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+  };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class RouteTable final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.RouteTable) */ {
+ public:
+  inline RouteTable() : RouteTable(nullptr) {}
+  ~RouteTable() override;
+  explicit PROTOBUF_CONSTEXPR RouteTable(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  RouteTable(const RouteTable& from);
+  RouteTable(RouteTable&& from) noexcept
+    : RouteTable() {
+    *this = ::std::move(from);
+  }
+
+  inline RouteTable& operator=(const RouteTable& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline RouteTable& operator=(RouteTable&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const RouteTable& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const RouteTable* internal_default_instance() {
+    return reinterpret_cast<const RouteTable*>(
+               &_RouteTable_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    21;
+
+  friend void swap(RouteTable& a, RouteTable& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(RouteTable* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(RouteTable* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  RouteTable* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<RouteTable>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const RouteTable& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const RouteTable& from) {
+    RouteTable::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(RouteTable* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.RouteTable";
+  }
+  protected:
+  explicit RouteTable(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kPeersFieldNumber = 5,
+    kAliveFieldNumber = 6,
+    kMessageFieldNumber = 2,
+    kHashSchemeFieldNumber = 4,
+    kEpochFieldNumber = 3,
+    kCodeFieldNumber = 1,
+  };
+  // repeated string peers = 5;
+  int peers_size() const;
+  private:
+  int _internal_peers_size() const;
+  public:
+  void clear_peers();
+  const std::string& peers(int index) const;
+  std::string* mutable_peers(int index);
+  void set_peers(int index, const std::string& value);
+  void set_peers(int index, std::string&& value);
+  void set_peers(int index, const char* value);
+  void set_peers(int index, const char* value, size_t size);
+  std::string* add_peers();
+  void add_peers(const std::string& value);
+  void add_peers(std::string&& value);
+  void add_peers(const char* value);
+  void add_peers(const char* value, size_t size);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>& peers() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>* mutable_peers();
+  private:
+  const std::string& _internal_peers(int index) const;
+  std::string* _internal_add_peers();
+  public:
+
+  // repeated bool alive = 6;
+  int alive_size() const;
+  private:
+  int _internal_alive_size() const;
+  public:
+  void clear_alive();
+  private:
+  bool _internal_alive(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< bool >&
+      _internal_alive() const;
+  void _internal_add_alive(bool value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< bool >*
+      _internal_mutable_alive();
+  public:
+  bool alive(int index) const;
+  void set_alive(int index, bool value);
+  void add_alive(bool value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< bool >&
+      alive() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< bool >*
+      mutable_alive();
+
+  // required string message = 2;
+  bool has_message() const;
+  private:
+  bool _internal_has_message() const;
+  public:
+  void clear_message();
+  const std::string& message() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_message(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_message();
+  PROTOBUF_NODISCARD std::string* release_message();
+  void set_allocated_message(std::string* message);
+  private:
+  const std::string& _internal_message() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_message(const std::string& value);
+  std::string* _internal_mutable_message();
+  public:
+
+  // optional string hash_scheme = 4;
+  bool has_hash_scheme() const;
+  private:
+  bool _internal_has_hash_scheme() const;
+  public:
+  void clear_hash_scheme();
+  const std::string& hash_scheme() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_hash_scheme(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_hash_scheme();
+  PROTOBUF_NODISCARD std::string* release_hash_scheme();
+  void set_allocated_hash_scheme(std::string* hash_scheme);
+  private:
+  const std::string& _internal_hash_scheme() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_hash_scheme(const std::string& value);
+  std::string* _internal_mutable_hash_scheme();
+  public:
+
+  // optional uint64 epoch = 3;
+  bool has_epoch() const;
+  private:
+  bool _internal_has_epoch() const;
+  public:
+  void clear_epoch();
+  uint64_t epoch() const;
+  void set_epoch(uint64_t value);
+  private:
+  uint64_t _internal_epoch() const;
+  void _internal_set_epoch(uint64_t value);
+  public:
+
+  // required int32 code = 1;
+  bool has_code() const;
+  private:
+  bool _internal_has_code() const;
+  public:
+  void clear_code();
+  int32_t code() const;
+  void set_code(int32_t value);
+  private:
+  int32_t _internal_code() const;
+  void _internal_set_code(int32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.RouteTable)
+ private:
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string> peers_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< bool > alive_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr message_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr hash_scheme_;
+    uint64_t epoch_;
+    int32_t code_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class HttpRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase /* @@protoc_insertion_point(class_definition:halakv.HttpRequest) */ {
+ public:
+  inline HttpRequest() : HttpRequest(nullptr) {}
+  explicit PROTOBUF_CONSTEXPR HttpRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  HttpRequest(const HttpRequest& from);
+  HttpRequest(HttpRequest&& from) noexcept
+    : HttpRequest() {
+    *this = ::std::move(from);
+  }
+
+  inline HttpRequest& operator=(const HttpRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline HttpRequest& operator=(HttpRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const HttpRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const HttpRequest* internal_default_instance() {
+    return reinterpret_cast<const HttpRequest*>(
+               &_HttpRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    22;
+
+  friend void swap(HttpRequest& a, HttpRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(HttpRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(HttpRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  HttpRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<HttpRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyFrom;
+  inline void CopyFrom(const HttpRequest& from) {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl(*this, from);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeFrom;
+  void MergeFrom(const HttpRequest& from) {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl(*this, from);
+  }
+  public:
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.HttpRequest";
+  }
+  protected:
+  explicit HttpRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // @@protoc_insertion_point(class_scope:halakv.HttpRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+  };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class HttpResponse final :
+    public ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase /* @@protoc_insertion_point(class_definition:halakv.HttpResponse) */ {
+ public:
+  inline HttpResponse() : HttpResponse(nullptr) {}
+  explicit PROTOBUF_CONSTEXPR HttpResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  HttpResponse(const HttpResponse& from);
+  HttpResponse(HttpResponse&& from) noexcept
+    : HttpResponse() {
+    *this = ::std::move(from);
+  }
+
+  inline HttpResponse& operator=(const HttpResponse& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline HttpResponse& operator=(HttpResponse&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const HttpResponse& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const HttpResponse* internal_default_instance() {
+    return reinterpret_cast<const HttpResponse*>(
+               &_HttpResponse_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    23;
+
+  friend void swap(HttpResponse& a, HttpResponse& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(HttpResponse* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(HttpResponse* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  HttpResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<HttpResponse>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyFrom;
+  inline void CopyFrom(const HttpResponse& from) {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl(*this, from);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeFrom;
+  void MergeFrom(const HttpResponse& from) {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl(*this, from);
+  }
+  public:
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.HttpResponse";
+  }
+  protected:
+  explicit HttpResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // @@protoc_insertion_point(class_scope:halakv.HttpResponse)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+  };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class MemberUpdate final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.MemberUpdate) */ {
+ public:
+  inline MemberUpdate() : MemberUpdate(nullptr) {}
+  ~MemberUpdate() override;
+  explicit PROTOBUF_CONSTEXPR MemberUpdate(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  MemberUpdate(const MemberUpdate& from);
+  MemberUpdate(MemberUpdate&& from) noexcept
+    : MemberUpdate() {
+    *this = ::std::move(from);
+  }
+
+  inline MemberUpdate& operator=(const MemberUpdate& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline MemberUpdate& operator=(MemberUpdate&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const MemberUpdate& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const MemberUpdate* internal_default_instance() {
+    return reinterpret_cast<const MemberUpdate*>(
+               &_MemberUpdate_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    24;
+
+  friend void swap(MemberUpdate& a, MemberUpdate& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(MemberUpdate* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(MemberUpdate* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  MemberUpdate* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<MemberUpdate>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const MemberUpdate& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const MemberUpdate& from) {
+    MemberUpdate::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(MemberUpdate* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.MemberUpdate";
+  }
+  protected:
+  explicit MemberUpdate(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kAddressFieldNumber = 1,
+    kIncarnationFieldNumber = 2,
+    kStateFieldNumber = 3,
+  };
+  // required string address = 1;
+  bool has_address() const;
+  private:
+  bool _internal_has_address() const;
+  public:
+  void clear_address();
+  const std::string& address() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_address(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_address();
+  PROTOBUF_NODISCARD std::string* release_address();
+  void set_allocated_address(std::string* address);
+  private:
+  const std::string& _internal_address() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_address(const std::string& value);
+  std::string* _internal_mutable_address();
+  public:
+
+  // required uint64 incarnation = 2;
+  bool has_incarnation() const;
+  private:
+  bool _internal_has_incarnation() const;
+  public:
+  void clear_incarnation();
+  uint64_t incarnation() const;
+  void set_incarnation(uint64_t value);
+  private:
+  uint64_t _internal_incarnation() const;
+  void _internal_set_incarnation(uint64_t value);
+  public:
+
+  // required .halakv.MemberState state = 3;
+  bool has_state() const;
+  private:
+  bool _internal_has_state() const;
+  public:
+  void clear_state();
+  ::halakv::MemberState state() const;
+  void set_state(::halakv::MemberState value);
+  private:
+  ::halakv::MemberState _internal_state() const;
+  void _internal_set_state(::halakv::MemberState value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.MemberUpdate)
+ private:
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr address_;
+    uint64_t incarnation_;
+    int state_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class GossipRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.GossipRequest) */ {
+ public:
+  inline GossipRequest() : GossipRequest(nullptr) {}
+  ~GossipRequest() override;
+  explicit PROTOBUF_CONSTEXPR GossipRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  GossipRequest(const GossipRequest& from);
+  GossipRequest(GossipRequest&& from) noexcept
+    : GossipRequest() {
+    *this = ::std::move(from);
+  }
+
+  inline GossipRequest& operator=(const GossipRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline GossipRequest& operator=(GossipRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const GossipRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const GossipRequest* internal_default_instance() {
+    return reinterpret_cast<const GossipRequest*>(
+               &_GossipRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    25;
+
+  friend void swap(GossipRequest& a, GossipRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(GossipRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(GossipRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  GossipRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<GossipRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const GossipRequest& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const GossipRequest& from) {
+    GossipRequest::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(GossipRequest* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.GossipRequest";
+  }
+  protected:
+  explicit GossipRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kUpdatesFieldNumber = 3,
+    kFromFieldNumber = 1,
+    kTargetFieldNumber = 2,
+    kClockFieldNumber = 4,
+  };
+  // repeated .halakv.MemberUpdate updates = 3;
+  int updates_size() const;
+  private:
+  int _internal_updates_size() const;
+  public:
+  void clear_updates();
+  ::halakv::MemberUpdate* mutable_updates(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::MemberUpdate >*
+      mutable_updates();
+  private:
+  const ::halakv::MemberUpdate& _internal_updates(int index) const;
+  ::halakv::MemberUpdate* _internal_add_updates();
+  public:
+  const ::halakv::MemberUpdate& updates(int index) const;
+  ::halakv::MemberUpdate* add_updates();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::MemberUpdate >&
+      updates() const;
+
+  // required string from = 1;
+  bool has_from() const;
+  private:
+  bool _internal_has_from() const;
+  public:
+  void clear_from();
+  const std::string& from() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_from(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_from();
+  PROTOBUF_NODISCARD std::string* release_from();
+  void set_allocated_from(std::string* from);
+  private:
+  const std::string& _internal_from() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_from(const std::string& value);
+  std::string* _internal_mutable_from();
+  public:
+
+  // optional string target = 2;
+  bool has_target() const;
+  private:
+  bool _internal_has_target() const;
+  public:
+  void clear_target();
+  const std::string& target() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_target(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_target();
+  PROTOBUF_NODISCARD std::string* release_target();
+  void set_allocated_target(std::string* target);
+  private:
+  const std::string& _internal_target() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_target(const std::string& value);
+  std::string* _internal_mutable_target();
+  public:
+
+  // optional uint64 clock = 4;
+  bool has_clock() const;
+  private:
+  bool _internal_has_clock() const;
+  public:
+  void clear_clock();
+  uint64_t clock() const;
+  void set_clock(uint64_t value);
+  private:
+  uint64_t _internal_clock() const;
+  void _internal_set_clock(uint64_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.GossipRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::MemberUpdate > updates_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr from_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr target_;
+    uint64_t clock_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// -------------------------------------------------------------------
+
+class GossipResponse final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:halakv.GossipResponse) */ {
+ public:
+  inline GossipResponse() : GossipResponse(nullptr) {}
+  ~GossipResponse() override;
+  explicit PROTOBUF_CONSTEXPR GossipResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  GossipResponse(const GossipResponse& from);
+  GossipResponse(GossipResponse&& from) noexcept
+    : GossipResponse() {
+    *this = ::std::move(from);
+  }
+
+  inline GossipResponse& operator=(const GossipResponse& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline GossipResponse& operator=(GossipResponse&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const GossipResponse& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const GossipResponse* internal_default_instance() {
+    return reinterpret_cast<const GossipResponse*>(
+               &_GossipResponse_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    26;
+
+  friend void swap(GossipResponse& a, GossipResponse& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(GossipResponse* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(GossipResponse* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  GossipResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<GossipResponse>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const GossipResponse& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const GossipResponse& from) {
+    GossipResponse::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(GossipResponse* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "halakv.GossipResponse";
+  }
+  protected:
+  explicit GossipResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kUpdatesFieldNumber = 3,
+    kMessageFieldNumber = 2,
+    kClockFieldNumber = 4,
+    kCodeFieldNumber = 1,
+  };
+  // repeated .halakv.MemberUpdate updates = 3;
+  int updates_size() const;
+  private:
+  int _internal_updates_size() const;
+  public:
+  void clear_updates();
+  ::halakv::MemberUpdate* mutable_updates(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::MemberUpdate >*
+      mutable_updates();
+  private:
+  const ::halakv::MemberUpdate& _internal_updates(int index) const;
+  ::halakv::MemberUpdate* _internal_add_updates();
+  public:
+  const ::halakv::MemberUpdate& updates(int index) const;
+  ::halakv::MemberUpdate* add_updates();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::MemberUpdate >&
+      updates() const;
+
+  // required string message = 2;
+  bool has_message() const;
+  private:
+  bool _internal_has_message() const;
+  public:
+  void clear_message();
+  const std::string& message() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_message(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_message();
+  PROTOBUF_NODISCARD std::string* release_message();
+  void set_allocated_message(std::string* message);
+  private:
+  const std::string& _internal_message() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_message(const std::string& value);
+  std::string* _internal_mutable_message();
+  public:
+
+  // optional uint64 clock = 4;
+  bool has_clock() const;
+  private:
+  bool _internal_has_clock() const;
+  public:
+  void clear_clock();
+  uint64_t clock() const;
+  void set_clock(uint64_t value);
+  private:
+  uint64_t _internal_clock() const;
+  void _internal_set_clock(uint64_t value);
+  public:
+
+  // required int32 code = 1;
+  bool has_code() const;
+  private:
+  bool _internal_has_code() const;
+  public:
+  void clear_code();
+  int32_t code() const;
+  void set_code(int32_t value);
+  private:
+  int32_t _internal_code() const;
+  void _internal_set_code(int32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:halakv.GossipResponse)
+ private:
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::MemberUpdate > updates_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr message_;
+    uint64_t clock_;
+    int32_t code_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_halakv_2fkv_2eproto;
+};
+// ===================================================================
+
+class KvService_Stub;
+
+class KvService : public ::PROTOBUF_NAMESPACE_ID::Service {
+ protected:
+  // This class should be treated as an abstract interface.
+  inline KvService() {};
+ public:
+  virtual ~KvService();
+
+  typedef KvService_Stub Stub;
+
+  static const ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor* descriptor();
+
+  virtual void set(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::KvRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void get(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::KvRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void remove(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::KvRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void mset(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::MultiKvRequest* request,
+                       ::halakv::MultiKvResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void mget(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::MultiKvRequest* request,
+                       ::halakv::MultiKvResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void mremove(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::MultiKvRequest* request,
+                       ::halakv::MultiKvResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void invalidate(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::InvalidateRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void hints(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::HintsRequest* request,
+                       ::halakv::HintsResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void merkle(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::MerkleRequest* request,
+                       ::halakv::MerkleResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void scan(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::ScanRequest* request,
+                       ::halakv::ScanResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void replicate(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::ReplicateRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void route(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::RouteRequest* request,
+                       ::halakv::RouteTable* response,
+                       ::google::protobuf::Closure* done);
+  virtual void load(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::LoadRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void watch(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::WatchRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void peer_set(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::KvRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void peer_get(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::KvRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void peer_remove(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::KvRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void peer_mset(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::MultiKvRequest* request,
+                       ::halakv::MultiKvResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void peer_mget(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::MultiKvRequest* request,
+                       ::halakv::MultiKvResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void peer_mremove(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::MultiKvRequest* request,
+                       ::halakv::MultiKvResponse* response,
+                       ::google::protobuf::Closure* done);
+
+  // implements Service ----------------------------------------------
+
+  const ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor* GetDescriptor();
+  void CallMethod(const ::PROTOBUF_NAMESPACE_ID::MethodDescriptor* method,
+                  ::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                  const ::PROTOBUF_NAMESPACE_ID::Message* request,
+                  ::PROTOBUF_NAMESPACE_ID::Message* response,
+                  ::google::protobuf::Closure* done);
+  const ::PROTOBUF_NAMESPACE_ID::Message& GetRequestPrototype(
+    const ::PROTOBUF_NAMESPACE_ID::MethodDescriptor* method) const;
+  const ::PROTOBUF_NAMESPACE_ID::Message& GetResponsePrototype(
+    const ::PROTOBUF_NAMESPACE_ID::MethodDescriptor* method) const;
+
+ private:
+  GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(KvService);
+};
+
+class KvService_Stub : public KvService {
+ public:
+  KvService_Stub(::PROTOBUF_NAMESPACE_ID::RpcChannel* channel);
+  KvService_Stub(::PROTOBUF_NAMESPACE_ID::RpcChannel* channel,
+                   ::PROTOBUF_NAMESPACE_ID::Service::ChannelOwnership ownership);
+  ~KvService_Stub();
+
+  inline ::PROTOBUF_NAMESPACE_ID::RpcChannel* channel() { return channel_; }
+
+  // implements KvService ------------------------------------------
+
+  void set(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::KvRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  void get(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::KvRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  void remove(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::KvRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  void mset(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::MultiKvRequest* request,
+                       ::halakv::MultiKvResponse* response,
+                       ::google::protobuf::Closure* done);
+  void mget(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::MultiKvRequest* request,
+                       ::halakv::MultiKvResponse* response,
+                       ::google::protobuf::Closure* done);
+  void mremove(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::MultiKvRequest* request,
+                       ::halakv::MultiKvResponse* response,
+                       ::google::protobuf::Closure* done);
+  void invalidate(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::InvalidateRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  void hints(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::HintsRequest* request,
+                       ::halakv::HintsResponse* response,
+                       ::google::protobuf::Closure* done);
+  void merkle(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::MerkleRequest* request,
+                       ::halakv::MerkleResponse* response,
+                       ::google::protobuf::Closure* done);
+  void scan(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::ScanRequest* request,
+                       ::halakv::ScanResponse* response,
+                       ::google::protobuf::Closure* done);
+  void replicate(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::ReplicateRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  void route(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::RouteRequest* request,
+                       ::halakv::RouteTable* response,
+                       ::google::protobuf::Closure* done);
+  void load(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::LoadRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  void watch(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::WatchRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  void peer_set(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::KvRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  void peer_get(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::KvRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  void peer_remove(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::KvRequest* request,
+                       ::halakv::KvResponse* response,
+                       ::google::protobuf::Closure* done);
+  void peer_mset(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::MultiKvRequest* request,
+                       ::halakv::MultiKvResponse* response,
+                       ::google::protobuf::Closure* done);
+  void peer_mget(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::MultiKvRequest* request,
+                       ::halakv::MultiKvResponse* response,
+                       ::google::protobuf::Closure* done);
+  void peer_mremove(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::MultiKvRequest* request,
+                       ::halakv::MultiKvResponse* response,
+                       ::google::protobuf::Closure* done);
+ private:
+  ::PROTOBUF_NAMESPACE_ID::RpcChannel* channel_;
+  bool owns_channel_;
+  GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(KvService_Stub);
+};
+
+
+// -------------------------------------------------------------------
+
+class KvRestService_Stub;
+
+class KvRestService : public ::PROTOBUF_NAMESPACE_ID::Service {
+ protected:
+  // This class should be treated as an abstract interface.
+  inline KvRestService() {};
+ public:
+  virtual ~KvRestService();
+
+  typedef KvRestService_Stub Stub;
+
+  static const ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor* descriptor();
+
+  virtual void get(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::HttpRequest* request,
+                       ::halakv::HttpResponse* response,
+                       ::google::protobuf::Closure* done);
+
+  // implements Service ----------------------------------------------
+
+  const ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor* GetDescriptor();
+  void CallMethod(const ::PROTOBUF_NAMESPACE_ID::MethodDescriptor* method,
+                  ::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                  const ::PROTOBUF_NAMESPACE_ID::Message* request,
+                  ::PROTOBUF_NAMESPACE_ID::Message* response,
+                  ::google::protobuf::Closure* done);
+  const ::PROTOBUF_NAMESPACE_ID::Message& GetRequestPrototype(
+    const ::PROTOBUF_NAMESPACE_ID::MethodDescriptor* method) const;
+  const ::PROTOBUF_NAMESPACE_ID::Message& GetResponsePrototype(
+    const ::PROTOBUF_NAMESPACE_ID::MethodDescriptor* method) const;
+
+ private:
+  GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(KvRestService);
+};
+
+class KvRestService_Stub : public KvRestService {
+ public:
+  KvRestService_Stub(::PROTOBUF_NAMESPACE_ID::RpcChannel* channel);
+  KvRestService_Stub(::PROTOBUF_NAMESPACE_ID::RpcChannel* channel,
+                   ::PROTOBUF_NAMESPACE_ID::Service::ChannelOwnership ownership);
+  ~KvRestService_Stub();
+
+  inline ::PROTOBUF_NAMESPACE_ID::RpcChannel* channel() { return channel_; }
+
+  // implements KvRestService ------------------------------------------
+
+  void get(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::HttpRequest* request,
+                       ::halakv::HttpResponse* response,
+                       ::google::protobuf::Closure* done);
+ private:
+  ::PROTOBUF_NAMESPACE_ID::RpcChannel* channel_;
+  bool owns_channel_;
+  GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(KvRestService_Stub);
+};
+
+
+// -------------------------------------------------------------------
+
+class GossipService_Stub;
+
+class GossipService : public ::PROTOBUF_NAMESPACE_ID::Service {
+ protected:
+  // This class should be treated as an abstract interface.
+  inline GossipService() {};
+ public:
+  virtual ~GossipService();
+
+  typedef GossipService_Stub Stub;
+
+  static const ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor* descriptor();
+
+  virtual void ping(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::GossipRequest* request,
+                       ::halakv::GossipResponse* response,
+                       ::google::protobuf::Closure* done);
+  virtual void ping_req(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::GossipRequest* request,
+                       ::halakv::GossipResponse* response,
+                       ::google::protobuf::Closure* done);
+
+  // implements Service ----------------------------------------------
+
+  const ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor* GetDescriptor();
+  void CallMethod(const ::PROTOBUF_NAMESPACE_ID::MethodDescriptor* method,
+                  ::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                  const ::PROTOBUF_NAMESPACE_ID::Message* request,
+                  ::PROTOBUF_NAMESPACE_ID::Message* response,
+                  ::google::protobuf::Closure* done);
+  const ::PROTOBUF_NAMESPACE_ID::Message& GetRequestPrototype(
+    const ::PROTOBUF_NAMESPACE_ID::MethodDescriptor* method) const;
+  const ::PROTOBUF_NAMESPACE_ID::Message& GetResponsePrototype(
+    const ::PROTOBUF_NAMESPACE_ID::MethodDescriptor* method) const;
+
+ private:
+  GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(GossipService);
+};
+
+class GossipService_Stub : public GossipService {
+ public:
+  GossipService_Stub(::PROTOBUF_NAMESPACE_ID::RpcChannel* channel);
+  GossipService_Stub(::PROTOBUF_NAMESPACE_ID::RpcChannel* channel,
+                   ::PROTOBUF_NAMESPACE_ID::Service::ChannelOwnership ownership);
+  ~GossipService_Stub();
+
+  inline ::PROTOBUF_NAMESPACE_ID::RpcChannel* channel() { return channel_; }
+
+  // implements GossipService ------------------------------------------
+
+  void ping(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::GossipRequest* request,
+                       ::halakv::GossipResponse* response,
+                       ::google::protobuf::Closure* done);
+  void ping_req(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::halakv::GossipRequest* request,
+                       ::halakv::GossipResponse* response,
+                       ::google::protobuf::Closure* done);
+ private:
+  ::PROTOBUF_NAMESPACE_ID::RpcChannel* channel_;
+  bool owns_channel_;
+  GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(GossipService_Stub);
+};
+
+
+// ===================================================================
+
+
+// ===================================================================
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
+// KvRequest
+
+// required string key = 1;
+inline bool KvRequest::_internal_has_key() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool KvRequest::has_key() const {
+  return _internal_has_key();
+}
+inline void KvRequest::clear_key() {
+  _impl_.key_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& KvRequest::key() const {
+  // @@protoc_insertion_point(field_get:halakv.KvRequest.key)
+  return _internal_key();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void KvRequest::set_key(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.key_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.KvRequest.key)
+}
+inline std::string* KvRequest::mutable_key() {
+  std::string* _s = _internal_mutable_key();
+  // @@protoc_insertion_point(field_mutable:halakv.KvRequest.key)
+  return _s;
+}
+inline const std::string& KvRequest::_internal_key() const {
+  return _impl_.key_.Get();
+}
+inline void KvRequest::_internal_set_key(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.key_.Set(value, GetArenaForAllocation());
+}
+inline std::string* KvRequest::_internal_mutable_key() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.key_.Mutable(GetArenaForAllocation());
+}
+inline std::string* KvRequest::release_key() {
+  // @@protoc_insertion_point(field_release:halakv.KvRequest.key)
+  if (!_internal_has_key()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.key_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.key_.IsDefault()) {
+    _impl_.key_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void KvRequest::set_allocated_key(std::string* key) {
+  if (key != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.key_.SetAllocated(key, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.key_.IsDefault()) {
+    _impl_.key_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.KvRequest.key)
+}
+
+// optional string value = 2;
+inline bool KvRequest::_internal_has_value() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool KvRequest::has_value() const {
+  return _internal_has_value();
+}
+inline void KvRequest::clear_value() {
+  _impl_.value_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const std::string& KvRequest::value() const {
+  // @@protoc_insertion_point(field_get:halakv.KvRequest.value)
+  return _internal_value();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void KvRequest::set_value(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.value_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.KvRequest.value)
+}
+inline std::string* KvRequest::mutable_value() {
+  std::string* _s = _internal_mutable_value();
+  // @@protoc_insertion_point(field_mutable:halakv.KvRequest.value)
+  return _s;
+}
+inline const std::string& KvRequest::_internal_value() const {
+  return _impl_.value_.Get();
+}
+inline void KvRequest::_internal_set_value(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.value_.Set(value, GetArenaForAllocation());
+}
+inline std::string* KvRequest::_internal_mutable_value() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.value_.Mutable(GetArenaForAllocation());
+}
+inline std::string* KvRequest::release_value() {
+  // @@protoc_insertion_point(field_release:halakv.KvRequest.value)
+  if (!_internal_has_value()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.value_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.value_.IsDefault()) {
+    _impl_.value_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void KvRequest::set_allocated_value(std::string* value) {
+  if (value != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.value_.SetAllocated(value, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.value_.IsDefault()) {
+    _impl_.value_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.KvRequest.value)
+}
+
+// optional uint64 epoch = 3;
+inline bool KvRequest::_internal_has_epoch() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
+inline bool KvRequest::has_epoch() const {
+  return _internal_has_epoch();
+}
+inline void KvRequest::clear_epoch() {
+  _impl_.epoch_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000008u;
+}
+inline uint64_t KvRequest::_internal_epoch() const {
+  return _impl_.epoch_;
+}
+inline uint64_t KvRequest::epoch() const {
+  // @@protoc_insertion_point(field_get:halakv.KvRequest.epoch)
+  return _internal_epoch();
+}
+inline void KvRequest::_internal_set_epoch(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.epoch_ = value;
+}
+inline void KvRequest::set_epoch(uint64_t value) {
+  _internal_set_epoch(value);
+  // @@protoc_insertion_point(field_set:halakv.KvRequest.epoch)
+}
+
+// optional string ns = 4;
+inline bool KvRequest::_internal_has_ns() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool KvRequest::has_ns() const {
+  return _internal_has_ns();
+}
+inline void KvRequest::clear_ns() {
+  _impl_.ns_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline const std::string& KvRequest::ns() const {
+  // @@protoc_insertion_point(field_get:halakv.KvRequest.ns)
+  return _internal_ns();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void KvRequest::set_ns(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000004u;
+ _impl_.ns_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.KvRequest.ns)
+}
+inline std::string* KvRequest::mutable_ns() {
+  std::string* _s = _internal_mutable_ns();
+  // @@protoc_insertion_point(field_mutable:halakv.KvRequest.ns)
+  return _s;
+}
+inline const std::string& KvRequest::_internal_ns() const {
+  return _impl_.ns_.Get();
+}
+inline void KvRequest::_internal_set_ns(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.ns_.Set(value, GetArenaForAllocation());
+}
+inline std::string* KvRequest::_internal_mutable_ns() {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  return _impl_.ns_.Mutable(GetArenaForAllocation());
+}
+inline std::string* KvRequest::release_ns() {
+  // @@protoc_insertion_point(field_release:halakv.KvRequest.ns)
+  if (!_internal_has_ns()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000004u;
+  auto* p = _impl_.ns_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.ns_.IsDefault()) {
+    _impl_.ns_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void KvRequest::set_allocated_ns(std::string* ns) {
+  if (ns != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000004u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000004u;
+  }
+  _impl_.ns_.SetAllocated(ns, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.ns_.IsDefault()) {
+    _impl_.ns_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.KvRequest.ns)
+}
+
+// optional uint64 version = 5;
+inline bool KvRequest::_internal_has_version() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000010u) != 0;
+  return value;
+}
+inline bool KvRequest::has_version() const {
+  return _internal_has_version();
+}
+inline void KvRequest::clear_version() {
+  _impl_.version_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000010u;
+}
+inline uint64_t KvRequest::_internal_version() const {
+  return _impl_.version_;
+}
+inline uint64_t KvRequest::version() const {
+  // @@protoc_insertion_point(field_get:halakv.KvRequest.version)
+  return _internal_version();
+}
+inline void KvRequest::_internal_set_version(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000010u;
+  _impl_.version_ = value;
+}
+inline void KvRequest::set_version(uint64_t value) {
+  _internal_set_version(value);
+  // @@protoc_insertion_point(field_set:halakv.KvRequest.version)
+}
+
+// optional uint64 expire_at_us = 7;
+inline bool KvRequest::_internal_has_expire_at_us() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000020u) != 0;
+  return value;
+}
+inline bool KvRequest::has_expire_at_us() const {
+  return _internal_has_expire_at_us();
+}
+inline void KvRequest::clear_expire_at_us() {
+  _impl_.expire_at_us_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000020u;
+}
+inline uint64_t KvRequest::_internal_expire_at_us() const {
+  return _impl_.expire_at_us_;
+}
+inline uint64_t KvRequest::expire_at_us() const {
+  // @@protoc_insertion_point(field_get:halakv.KvRequest.expire_at_us)
+  return _internal_expire_at_us();
+}
+inline void KvRequest::_internal_set_expire_at_us(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000020u;
+  _impl_.expire_at_us_ = value;
+}
+inline void KvRequest::set_expire_at_us(uint64_t value) {
+  _internal_set_expire_at_us(value);
+  // @@protoc_insertion_point(field_set:halakv.KvRequest.expire_at_us)
+}
+
+// optional uint64 if_not_version = 8;
+inline bool KvRequest::_internal_has_if_not_version() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000040u) != 0;
+  return value;
+}
+inline bool KvRequest::has_if_not_version() const {
+  return _internal_has_if_not_version();
+}
+inline void KvRequest::clear_if_not_version() {
+  _impl_.if_not_version_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000040u;
+}
+inline uint64_t KvRequest::_internal_if_not_version() const {
+  return _impl_.if_not_version_;
+}
+inline uint64_t KvRequest::if_not_version() const {
+  // @@protoc_insertion_point(field_get:halakv.KvRequest.if_not_version)
+  return _internal_if_not_version();
+}
+inline void KvRequest::_internal_set_if_not_version(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000040u;
+  _impl_.if_not_version_ = value;
+}
+inline void KvRequest::set_if_not_version(uint64_t value) {
+  _internal_set_if_not_version(value);
+  // @@protoc_insertion_point(field_set:halakv.KvRequest.if_not_version)
+}
+
+// optional sint64 incr_by = 9;
+inline bool KvRequest::_internal_has_incr_by() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000080u) != 0;
+  return value;
+}
+inline bool KvRequest::has_incr_by() const {
+  return _internal_has_incr_by();
+}
+inline void KvRequest::clear_incr_by() {
+  _impl_.incr_by_ = int64_t{0};
+  _impl_._has_bits_[0] &= ~0x00000080u;
+}
+inline int64_t KvRequest::_internal_incr_by() const {
+  return _impl_.incr_by_;
+}
+inline int64_t KvRequest::incr_by() const {
+  // @@protoc_insertion_point(field_get:halakv.KvRequest.incr_by)
+  return _internal_incr_by();
+}
+inline void KvRequest::_internal_set_incr_by(int64_t value) {
+  _impl_._has_bits_[0] |= 0x00000080u;
+  _impl_.incr_by_ = value;
+}
+inline void KvRequest::set_incr_by(int64_t value) {
+  _internal_set_incr_by(value);
+  // @@protoc_insertion_point(field_set:halakv.KvRequest.incr_by)
+}
+
+// optional uint32 flags = 10;
+inline bool KvRequest::_internal_has_flags() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000100u) != 0;
+  return value;
+}
+inline bool KvRequest::has_flags() const {
+  return _internal_has_flags();
+}
+inline void KvRequest::clear_flags() {
+  _impl_.flags_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000100u;
+}
+inline uint32_t KvRequest::_internal_flags() const {
+  return _impl_.flags_;
+}
+inline uint32_t KvRequest::flags() const {
+  // @@protoc_insertion_point(field_get:halakv.KvRequest.flags)
+  return _internal_flags();
+}
+inline void KvRequest::_internal_set_flags(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000100u;
+  _impl_.flags_ = value;
+}
+inline void KvRequest::set_flags(uint32_t value) {
+  _internal_set_flags(value);
+  // @@protoc_insertion_point(field_set:halakv.KvRequest.flags)
+}
+
+// optional bool if_absent = 11;
+inline bool KvRequest::_internal_has_if_absent() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000200u) != 0;
+  return value;
+}
+inline bool KvRequest::has_if_absent() const {
+  return _internal_has_if_absent();
+}
+inline void KvRequest::clear_if_absent() {
+  _impl_.if_absent_ = false;
+  _impl_._has_bits_[0] &= ~0x00000200u;
+}
+inline bool KvRequest::_internal_if_absent() const {
+  return _impl_.if_absent_;
+}
+inline bool KvRequest::if_absent() const {
+  // @@protoc_insertion_point(field_get:halakv.KvRequest.if_absent)
+  return _internal_if_absent();
+}
+inline void KvRequest::_internal_set_if_absent(bool value) {
+  _impl_._has_bits_[0] |= 0x00000200u;
+  _impl_.if_absent_ = value;
+}
+inline void KvRequest::set_if_absent(bool value) {
+  _internal_set_if_absent(value);
+  // @@protoc_insertion_point(field_set:halakv.KvRequest.if_absent)
+}
+
+// optional uint64 incr_unsigned = 12;
+inline bool KvRequest::_internal_has_incr_unsigned() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000400u) != 0;
+  return value;
+}
+inline bool KvRequest::has_incr_unsigned() const {
+  return _internal_has_incr_unsigned();
+}
+inline void KvRequest::clear_incr_unsigned() {
+  _impl_.incr_unsigned_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000400u;
+}
+inline uint64_t KvRequest::_internal_incr_unsigned() const {
+  return _impl_.incr_unsigned_;
+}
+inline uint64_t KvRequest::incr_unsigned() const {
+  // @@protoc_insertion_point(field_get:halakv.KvRequest.incr_unsigned)
+  return _internal_incr_unsigned();
+}
+inline void KvRequest::_internal_set_incr_unsigned(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000400u;
+  _impl_.incr_unsigned_ = value;
+}
+inline void KvRequest::set_incr_unsigned(uint64_t value) {
+  _internal_set_incr_unsigned(value);
+  // @@protoc_insertion_point(field_set:halakv.KvRequest.incr_unsigned)
+}
+
+// optional uint64 incr_initial = 13;
+inline bool KvRequest::_internal_has_incr_initial() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000800u) != 0;
+  return value;
+}
+inline bool KvRequest::has_incr_initial() const {
+  return _internal_has_incr_initial();
+}
+inline void KvRequest::clear_incr_initial() {
+  _impl_.incr_initial_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000800u;
+}
+inline uint64_t KvRequest::_internal_incr_initial() const {
+  return _impl_.incr_initial_;
+}
+inline uint64_t KvRequest::incr_initial() const {
+  // @@protoc_insertion_point(field_get:halakv.KvRequest.incr_initial)
+  return _internal_incr_initial();
+}
+inline void KvRequest::_internal_set_incr_initial(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000800u;
+  _impl_.incr_initial_ = value;
+}
+inline void KvRequest::set_incr_initial(uint64_t value) {
+  _internal_set_incr_initial(value);
+  // @@protoc_insertion_point(field_set:halakv.KvRequest.incr_initial)
+}
+
+// -------------------------------------------------------------------
+
+// KvResponse
+
+// required int32 code = 1;
+inline bool KvResponse::_internal_has_code() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
+inline bool KvResponse::has_code() const {
+  return _internal_has_code();
+}
+inline void KvResponse::clear_code() {
+  _impl_.code_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000008u;
+}
+inline int32_t KvResponse::_internal_code() const {
+  return _impl_.code_;
+}
+inline int32_t KvResponse::code() const {
+  // @@protoc_insertion_point(field_get:halakv.KvResponse.code)
+  return _internal_code();
+}
+inline void KvResponse::_internal_set_code(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.code_ = value;
+}
+inline void KvResponse::set_code(int32_t value) {
+  _internal_set_code(value);
+  // @@protoc_insertion_point(field_set:halakv.KvResponse.code)
+}
+
+// required string message = 2;
+inline bool KvResponse::_internal_has_message() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool KvResponse::has_message() const {
+  return _internal_has_message();
+}
+inline void KvResponse::clear_message() {
+  _impl_.message_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& KvResponse::message() const {
+  // @@protoc_insertion_point(field_get:halakv.KvResponse.message)
+  return _internal_message();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void KvResponse::set_message(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.message_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.KvResponse.message)
+}
+inline std::string* KvResponse::mutable_message() {
+  std::string* _s = _internal_mutable_message();
+  // @@protoc_insertion_point(field_mutable:halakv.KvResponse.message)
+  return _s;
+}
+inline const std::string& KvResponse::_internal_message() const {
+  return _impl_.message_.Get();
+}
+inline void KvResponse::_internal_set_message(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.message_.Set(value, GetArenaForAllocation());
+}
+inline std::string* KvResponse::_internal_mutable_message() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.message_.Mutable(GetArenaForAllocation());
+}
+inline std::string* KvResponse::release_message() {
+  // @@protoc_insertion_point(field_release:halakv.KvResponse.message)
+  if (!_internal_has_message()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.message_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.message_.IsDefault()) {
+    _impl_.message_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void KvResponse::set_allocated_message(std::string* message) {
+  if (message != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.message_.SetAllocated(message, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.message_.IsDefault()) {
+    _impl_.message_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.KvResponse.message)
+}
+
+// optional string value = 3;
+inline bool KvResponse::_internal_has_value() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool KvResponse::has_value() const {
+  return _internal_has_value();
+}
+inline void KvResponse::clear_value() {
+  _impl_.value_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const std::string& KvResponse::value() const {
+  // @@protoc_insertion_point(field_get:halakv.KvResponse.value)
+  return _internal_value();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void KvResponse::set_value(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.value_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.KvResponse.value)
+}
+inline std::string* KvResponse::mutable_value() {
+  std::string* _s = _internal_mutable_value();
+  // @@protoc_insertion_point(field_mutable:halakv.KvResponse.value)
+  return _s;
+}
+inline const std::string& KvResponse::_internal_value() const {
+  return _impl_.value_.Get();
+}
+inline void KvResponse::_internal_set_value(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.value_.Set(value, GetArenaForAllocation());
+}
+inline std::string* KvResponse::_internal_mutable_value() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.value_.Mutable(GetArenaForAllocation());
+}
+inline std::string* KvResponse::release_value() {
+  // @@protoc_insertion_point(field_release:halakv.KvResponse.value)
+  if (!_internal_has_value()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.value_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.value_.IsDefault()) {
+    _impl_.value_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void KvResponse::set_allocated_value(std::string* value) {
+  if (value != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.value_.SetAllocated(value, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.value_.IsDefault()) {
+    _impl_.value_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.KvResponse.value)
+}
+
+// optional string redirect = 4;
+inline bool KvResponse::_internal_has_redirect() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool KvResponse::has_redirect() const {
+  return _internal_has_redirect();
+}
+inline void KvResponse::clear_redirect() {
+  _impl_.redirect_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline const std::string& KvResponse::redirect() const {
+  // @@protoc_insertion_point(field_get:halakv.KvResponse.redirect)
+  return _internal_redirect();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void KvResponse::set_redirect(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000004u;
+ _impl_.redirect_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.KvResponse.redirect)
+}
+inline std::string* KvResponse::mutable_redirect() {
+  std::string* _s = _internal_mutable_redirect();
+  // @@protoc_insertion_point(field_mutable:halakv.KvResponse.redirect)
+  return _s;
+}
+inline const std::string& KvResponse::_internal_redirect() const {
+  return _impl_.redirect_.Get();
+}
+inline void KvResponse::_internal_set_redirect(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.redirect_.Set(value, GetArenaForAllocation());
+}
+inline std::string* KvResponse::_internal_mutable_redirect() {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  return _impl_.redirect_.Mutable(GetArenaForAllocation());
+}
+inline std::string* KvResponse::release_redirect() {
+  // @@protoc_insertion_point(field_release:halakv.KvResponse.redirect)
+  if (!_internal_has_redirect()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000004u;
+  auto* p = _impl_.redirect_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.redirect_.IsDefault()) {
+    _impl_.redirect_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void KvResponse::set_allocated_redirect(std::string* redirect) {
+  if (redirect != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000004u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000004u;
+  }
+  _impl_.redirect_.SetAllocated(redirect, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.redirect_.IsDefault()) {
+    _impl_.redirect_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.KvResponse.redirect)
+}
+
+// optional uint64 epoch = 5;
+inline bool KvResponse::_internal_has_epoch() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000020u) != 0;
+  return value;
+}
+inline bool KvResponse::has_epoch() const {
+  return _internal_has_epoch();
+}
+inline void KvResponse::clear_epoch() {
+  _impl_.epoch_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000020u;
+}
+inline uint64_t KvResponse::_internal_epoch() const {
+  return _impl_.epoch_;
+}
+inline uint64_t KvResponse::epoch() const {
+  // @@protoc_insertion_point(field_get:halakv.KvResponse.epoch)
+  return _internal_epoch();
+}
+inline void KvResponse::_internal_set_epoch(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000020u;
+  _impl_.epoch_ = value;
+}
+inline void KvResponse::set_epoch(uint64_t value) {
+  _internal_set_epoch(value);
+  // @@protoc_insertion_point(field_set:halakv.KvResponse.epoch)
+}
+
+// optional uint64 expire_at_us = 6;
+inline bool KvResponse::_internal_has_expire_at_us() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000040u) != 0;
+  return value;
+}
+inline bool KvResponse::has_expire_at_us() const {
+  return _internal_has_expire_at_us();
+}
+inline void KvResponse::clear_expire_at_us() {
+  _impl_.expire_at_us_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000040u;
+}
+inline uint64_t KvResponse::_internal_expire_at_us() const {
+  return _impl_.expire_at_us_;
+}
+inline uint64_t KvResponse::expire_at_us() const {
+  // @@protoc_insertion_point(field_get:halakv.KvResponse.expire_at_us)
+  return _internal_expire_at_us();
+}
+inline void KvResponse::_internal_set_expire_at_us(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000040u;
+  _impl_.expire_at_us_ = value;
+}
+inline void KvResponse::set_expire_at_us(uint64_t value) {
+  _internal_set_expire_at_us(value);
+  // @@protoc_insertion_point(field_set:halakv.KvResponse.expire_at_us)
+}
+
+// optional uint64 version = 7;
+inline bool KvResponse::_internal_has_version() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000080u) != 0;
+  return value;
+}
+inline bool KvResponse::has_version() const {
+  return _internal_has_version();
+}
+inline void KvResponse::clear_version() {
+  _impl_.version_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000080u;
+}
+inline uint64_t KvResponse::_internal_version() const {
+  return _impl_.version_;
+}
+inline uint64_t KvResponse::version() const {
+  // @@protoc_insertion_point(field_get:halakv.KvResponse.version)
+  return _internal_version();
+}
+inline void KvResponse::_internal_set_version(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000080u;
+  _impl_.version_ = value;
+}
+inline void KvResponse::set_version(uint64_t value) {
+  _internal_set_version(value);
+  // @@protoc_insertion_point(field_set:halakv.KvResponse.version)
+}
+
+// optional uint32 flags = 8;
+inline bool KvResponse::_internal_has_flags() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000010u) != 0;
+  return value;
+}
+inline bool KvResponse::has_flags() const {
+  return _internal_has_flags();
+}
+inline void KvResponse::clear_flags() {
+  _impl_.flags_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000010u;
+}
+inline uint32_t KvResponse::_internal_flags() const {
+  return _impl_.flags_;
+}
+inline uint32_t KvResponse::flags() const {
+  // @@protoc_insertion_point(field_get:halakv.KvResponse.flags)
+  return _internal_flags();
+}
+inline void KvResponse::_internal_set_flags(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000010u;
+  _impl_.flags_ = value;
+}
+inline void KvResponse::set_flags(uint32_t value) {
+  _internal_set_flags(value);
+  // @@protoc_insertion_point(field_set:halakv.KvResponse.flags)
+}
+
+// -------------------------------------------------------------------
+
+// MultiKvRequest
+
+// repeated .halakv.KvRequest requests = 1;
+inline int MultiKvRequest::_internal_requests_size() const {
+  return _impl_.requests_.size();
+}
+inline int MultiKvRequest::requests_size() const {
+  return _internal_requests_size();
+}
+inline void MultiKvRequest::clear_requests() {
+  _impl_.requests_.Clear();
+}
+inline ::halakv::KvRequest* MultiKvRequest::mutable_requests(int index) {
+  // @@protoc_insertion_point(field_mutable:halakv.MultiKvRequest.requests)
+  return _impl_.requests_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::KvRequest >*
+MultiKvRequest::mutable_requests() {
+  // @@protoc_insertion_point(field_mutable_list:halakv.MultiKvRequest.requests)
+  return &_impl_.requests_;
+}
+inline const ::halakv::KvRequest& MultiKvRequest::_internal_requests(int index) const {
+  return _impl_.requests_.Get(index);
+}
+inline const ::halakv::KvRequest& MultiKvRequest::requests(int index) const {
+  // @@protoc_insertion_point(field_get:halakv.MultiKvRequest.requests)
+  return _internal_requests(index);
+}
+inline ::halakv::KvRequest* MultiKvRequest::_internal_add_requests() {
+  return _impl_.requests_.Add();
+}
+inline ::halakv::KvRequest* MultiKvRequest::add_requests() {
+  ::halakv::KvRequest* _add = _internal_add_requests();
+  // @@protoc_insertion_point(field_add:halakv.MultiKvRequest.requests)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::KvRequest >&
+MultiKvRequest::requests() const {
+  // @@protoc_insertion_point(field_list:halakv.MultiKvRequest.requests)
+  return _impl_.requests_;
+}
+
+// -------------------------------------------------------------------
+
+// MultiKvResponse
+
+// required int32 code = 1;
+inline bool MultiKvResponse::_internal_has_code() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool MultiKvResponse::has_code() const {
+  return _internal_has_code();
+}
+inline void MultiKvResponse::clear_code() {
+  _impl_.code_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline int32_t MultiKvResponse::_internal_code() const {
+  return _impl_.code_;
+}
+inline int32_t MultiKvResponse::code() const {
+  // @@protoc_insertion_point(field_get:halakv.MultiKvResponse.code)
+  return _internal_code();
+}
+inline void MultiKvResponse::_internal_set_code(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.code_ = value;
+}
+inline void MultiKvResponse::set_code(int32_t value) {
+  _internal_set_code(value);
+  // @@protoc_insertion_point(field_set:halakv.MultiKvResponse.code)
+}
+
+// required string message = 2;
+inline bool MultiKvResponse::_internal_has_message() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool MultiKvResponse::has_message() const {
+  return _internal_has_message();
+}
+inline void MultiKvResponse::clear_message() {
+  _impl_.message_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& MultiKvResponse::message() const {
+  // @@protoc_insertion_point(field_get:halakv.MultiKvResponse.message)
+  return _internal_message();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void MultiKvResponse::set_message(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.message_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.MultiKvResponse.message)
+}
+inline std::string* MultiKvResponse::mutable_message() {
+  std::string* _s = _internal_mutable_message();
+  // @@protoc_insertion_point(field_mutable:halakv.MultiKvResponse.message)
+  return _s;
+}
+inline const std::string& MultiKvResponse::_internal_message() const {
+  return _impl_.message_.Get();
+}
+inline void MultiKvResponse::_internal_set_message(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.message_.Set(value, GetArenaForAllocation());
+}
+inline std::string* MultiKvResponse::_internal_mutable_message() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.message_.Mutable(GetArenaForAllocation());
+}
+inline std::string* MultiKvResponse::release_message() {
+  // @@protoc_insertion_point(field_release:halakv.MultiKvResponse.message)
+  if (!_internal_has_message()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.message_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.message_.IsDefault()) {
+    _impl_.message_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void MultiKvResponse::set_allocated_message(std::string* message) {
+  if (message != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.message_.SetAllocated(message, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.message_.IsDefault()) {
+    _impl_.message_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.MultiKvResponse.message)
+}
+
+// repeated .halakv.KvResponse responses = 3;
+inline int MultiKvResponse::_internal_responses_size() const {
+  return _impl_.responses_.size();
+}
+inline int MultiKvResponse::responses_size() const {
+  return _internal_responses_size();
+}
+inline void MultiKvResponse::clear_responses() {
+  _impl_.responses_.Clear();
+}
+inline ::halakv::KvResponse* MultiKvResponse::mutable_responses(int index) {
+  // @@protoc_insertion_point(field_mutable:halakv.MultiKvResponse.responses)
+  return _impl_.responses_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::KvResponse >*
+MultiKvResponse::mutable_responses() {
+  // @@protoc_insertion_point(field_mutable_list:halakv.MultiKvResponse.responses)
+  return &_impl_.responses_;
+}
+inline const ::halakv::KvResponse& MultiKvResponse::_internal_responses(int index) const {
+  return _impl_.responses_.Get(index);
+}
+inline const ::halakv::KvResponse& MultiKvResponse::responses(int index) const {
+  // @@protoc_insertion_point(field_get:halakv.MultiKvResponse.responses)
+  return _internal_responses(index);
+}
+inline ::halakv::KvResponse* MultiKvResponse::_internal_add_responses() {
+  return _impl_.responses_.Add();
+}
+inline ::halakv::KvResponse* MultiKvResponse::add_responses() {
+  ::halakv::KvResponse* _add = _internal_add_responses();
+  // @@protoc_insertion_point(field_add:halakv.MultiKvResponse.responses)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::KvResponse >&
+MultiKvResponse::responses() const {
+  // @@protoc_insertion_point(field_list:halakv.MultiKvResponse.responses)
+  return _impl_.responses_;
+}
+
+// -------------------------------------------------------------------
+
+// HintsRequest
+
+// required string peer = 1;
+inline bool HintsRequest::_internal_has_peer() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool HintsRequest::has_peer() const {
+  return _internal_has_peer();
+}
+inline void HintsRequest::clear_peer() {
+  _impl_.peer_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& HintsRequest::peer() const {
+  // @@protoc_insertion_point(field_get:halakv.HintsRequest.peer)
+  return _internal_peer();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void HintsRequest::set_peer(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.peer_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.HintsRequest.peer)
+}
+inline std::string* HintsRequest::mutable_peer() {
+  std::string* _s = _internal_mutable_peer();
+  // @@protoc_insertion_point(field_mutable:halakv.HintsRequest.peer)
+  return _s;
+}
+inline const std::string& HintsRequest::_internal_peer() const {
+  return _impl_.peer_.Get();
+}
+inline void HintsRequest::_internal_set_peer(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.peer_.Set(value, GetArenaForAllocation());
+}
+inline std::string* HintsRequest::_internal_mutable_peer() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.peer_.Mutable(GetArenaForAllocation());
+}
+inline std::string* HintsRequest::release_peer() {
+  // @@protoc_insertion_point(field_release:halakv.HintsRequest.peer)
+  if (!_internal_has_peer()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.peer_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.peer_.IsDefault()) {
+    _impl_.peer_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void HintsRequest::set_allocated_peer(std::string* peer) {
+  if (peer != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.peer_.SetAllocated(peer, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.peer_.IsDefault()) {
+    _impl_.peer_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.HintsRequest.peer)
+}
+
+// -------------------------------------------------------------------
+
+// HintsResponse
+
+// required int32 code = 1;
+inline bool HintsResponse::_internal_has_code() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool HintsResponse::has_code() const {
+  return _internal_has_code();
+}
+inline void HintsResponse::clear_code() {
+  _impl_.code_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline int32_t HintsResponse::_internal_code() const {
+  return _impl_.code_;
+}
+inline int32_t HintsResponse::code() const {
+  // @@protoc_insertion_point(field_get:halakv.HintsResponse.code)
+  return _internal_code();
+}
+inline void HintsResponse::_internal_set_code(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.code_ = value;
+}
+inline void HintsResponse::set_code(int32_t value) {
+  _internal_set_code(value);
+  // @@protoc_insertion_point(field_set:halakv.HintsResponse.code)
+}
+
+// required string message = 2;
+inline bool HintsResponse::_internal_has_message() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool HintsResponse::has_message() const {
+  return _internal_has_message();
+}
+inline void HintsResponse::clear_message() {
+  _impl_.message_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& HintsResponse::message() const {
+  // @@protoc_insertion_point(field_get:halakv.HintsResponse.message)
+  return _internal_message();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void HintsResponse::set_message(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.message_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.HintsResponse.message)
+}
+inline std::string* HintsResponse::mutable_message() {
+  std::string* _s = _internal_mutable_message();
+  // @@protoc_insertion_point(field_mutable:halakv.HintsResponse.message)
+  return _s;
+}
+inline const std::string& HintsResponse::_internal_message() const {
+  return _impl_.message_.Get();
+}
+inline void HintsResponse::_internal_set_message(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.message_.Set(value, GetArenaForAllocation());
+}
+inline std::string* HintsResponse::_internal_mutable_message() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.message_.Mutable(GetArenaForAllocation());
+}
+inline std::string* HintsResponse::release_message() {
+  // @@protoc_insertion_point(field_release:halakv.HintsResponse.message)
+  if (!_internal_has_message()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.message_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.message_.IsDefault()) {
+    _impl_.message_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void HintsResponse::set_allocated_message(std::string* message) {
+  if (message != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.message_.SetAllocated(message, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.message_.IsDefault()) {
+    _impl_.message_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.HintsResponse.message)
+}
+
+// optional uint64 count = 3;
+inline bool HintsResponse::_internal_has_count() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool HintsResponse::has_count() const {
+  return _internal_has_count();
+}
+inline void HintsResponse::clear_count() {
+  _impl_.count_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline uint64_t HintsResponse::_internal_count() const {
+  return _impl_.count_;
+}
+inline uint64_t HintsResponse::count() const {
+  // @@protoc_insertion_point(field_get:halakv.HintsResponse.count)
+  return _internal_count();
+}
+inline void HintsResponse::_internal_set_count(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.count_ = value;
+}
+inline void HintsResponse::set_count(uint64_t value) {
+  _internal_set_count(value);
+  // @@protoc_insertion_point(field_set:halakv.HintsResponse.count)
+}
+
+// -------------------------------------------------------------------
+
+// InvalidateRequest
+
+// repeated string keys = 1;
+inline int InvalidateRequest::_internal_keys_size() const {
+  return _impl_.keys_.size();
+}
+inline int InvalidateRequest::keys_size() const {
+  return _internal_keys_size();
+}
+inline void InvalidateRequest::clear_keys() {
+  _impl_.keys_.Clear();
+}
+inline std::string* InvalidateRequest::add_keys() {
+  std::string* _s = _internal_add_keys();
+  // @@protoc_insertion_point(field_add_mutable:halakv.InvalidateRequest.keys)
+  return _s;
+}
+inline const std::string& InvalidateRequest::_internal_keys(int index) const {
+  return _impl_.keys_.Get(index);
+}
+inline const std::string& InvalidateRequest::keys(int index) const {
+  // @@protoc_insertion_point(field_get:halakv.InvalidateRequest.keys)
+  return _internal_keys(index);
+}
+inline std::string* InvalidateRequest::mutable_keys(int index) {
+  // @@protoc_insertion_point(field_mutable:halakv.InvalidateRequest.keys)
+  return _impl_.keys_.Mutable(index);
+}
+inline void InvalidateRequest::set_keys(int index, const std::string& value) {
+  _impl_.keys_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set:halakv.InvalidateRequest.keys)
+}
+inline void InvalidateRequest::set_keys(int index, std::string&& value) {
+  _impl_.keys_.Mutable(index)->assign(std::move(value));
+  // @@protoc_insertion_point(field_set:halakv.InvalidateRequest.keys)
+}
+inline void InvalidateRequest::set_keys(int index, const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  _impl_.keys_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:halakv.InvalidateRequest.keys)
+}
+inline void InvalidateRequest::set_keys(int index, const char* value, size_t size) {
+  _impl_.keys_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:halakv.InvalidateRequest.keys)
+}
+inline std::string* InvalidateRequest::_internal_add_keys() {
+  return _impl_.keys_.Add();
+}
+inline void InvalidateRequest::add_keys(const std::string& value) {
+  _impl_.keys_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:halakv.InvalidateRequest.keys)
+}
+inline void InvalidateRequest::add_keys(std::string&& value) {
+  _impl_.keys_.Add(std::move(value));
+  // @@protoc_insertion_point(field_add:halakv.InvalidateRequest.keys)
+}
+inline void InvalidateRequest::add_keys(const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  _impl_.keys_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:halakv.InvalidateRequest.keys)
+}
+inline void InvalidateRequest::add_keys(const char* value, size_t size) {
+  _impl_.keys_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:halakv.InvalidateRequest.keys)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>&
+InvalidateRequest::keys() const {
+  // @@protoc_insertion_point(field_list:halakv.InvalidateRequest.keys)
+  return _impl_.keys_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>*
+InvalidateRequest::mutable_keys() {
+  // @@protoc_insertion_point(field_mutable_list:halakv.InvalidateRequest.keys)
+  return &_impl_.keys_;
+}
+
+// -------------------------------------------------------------------
+
+// MerkleRequest
+
+// repeated uint32 nodes = 1;
+inline int MerkleRequest::_internal_nodes_size() const {
+  return _impl_.nodes_.size();
+}
+inline int MerkleRequest::nodes_size() const {
+  return _internal_nodes_size();
+}
+inline void MerkleRequest::clear_nodes() {
+  _impl_.nodes_.Clear();
+}
+inline uint32_t MerkleRequest::_internal_nodes(int index) const {
+  return _impl_.nodes_.Get(index);
+}
+inline uint32_t MerkleRequest::nodes(int index) const {
+  // @@protoc_insertion_point(field_get:halakv.MerkleRequest.nodes)
+  return _internal_nodes(index);
+}
+inline void MerkleRequest::set_nodes(int index, uint32_t value) {
+  _impl_.nodes_.Set(index, value);
+  // @@protoc_insertion_point(field_set:halakv.MerkleRequest.nodes)
+}
+inline void MerkleRequest::_internal_add_nodes(uint32_t value) {
+  _impl_.nodes_.Add(value);
+}
+inline void MerkleRequest::add_nodes(uint32_t value) {
+  _internal_add_nodes(value);
+  // @@protoc_insertion_point(field_add:halakv.MerkleRequest.nodes)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+MerkleRequest::_internal_nodes() const {
+  return _impl_.nodes_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+MerkleRequest::nodes() const {
+  // @@protoc_insertion_point(field_list:halakv.MerkleRequest.nodes)
+  return _internal_nodes();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+MerkleRequest::_internal_mutable_nodes() {
+  return &_impl_.nodes_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+MerkleRequest::mutable_nodes() {
+  // @@protoc_insertion_point(field_mutable_list:halakv.MerkleRequest.nodes)
+  return _internal_mutable_nodes();
+}
+
+// optional bool replica = 2;
+inline bool MerkleRequest::_internal_has_replica() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool MerkleRequest::has_replica() const {
+  return _internal_has_replica();
+}
+inline void MerkleRequest::clear_replica() {
+  _impl_.replica_ = false;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline bool MerkleRequest::_internal_replica() const {
+  return _impl_.replica_;
+}
+inline bool MerkleRequest::replica() const {
+  // @@protoc_insertion_point(field_get:halakv.MerkleRequest.replica)
+  return _internal_replica();
+}
+inline void MerkleRequest::_internal_set_replica(bool value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.replica_ = value;
+}
+inline void MerkleRequest::set_replica(bool value) {
+  _internal_set_replica(value);
+  // @@protoc_insertion_point(field_set:halakv.MerkleRequest.replica)
+}
+
+// -------------------------------------------------------------------
+
+// MerkleResponse
+
+// required int32 code = 1;
+inline bool MerkleResponse::_internal_has_code() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool MerkleResponse::has_code() const {
+  return _internal_has_code();
+}
+inline void MerkleResponse::clear_code() {
+  _impl_.code_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline int32_t MerkleResponse::_internal_code() const {
+  return _impl_.code_;
+}
+inline int32_t MerkleResponse::code() const {
+  // @@protoc_insertion_point(field_get:halakv.MerkleResponse.code)
+  return _internal_code();
+}
+inline void MerkleResponse::_internal_set_code(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.code_ = value;
+}
+inline void MerkleResponse::set_code(int32_t value) {
+  _internal_set_code(value);
+  // @@protoc_insertion_point(field_set:halakv.MerkleResponse.code)
+}
+
+// required string message = 2;
+inline bool MerkleResponse::_internal_has_message() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool MerkleResponse::has_message() const {
+  return _internal_has_message();
+}
+inline void MerkleResponse::clear_message() {
+  _impl_.message_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& MerkleResponse::message() const {
+  // @@protoc_insertion_point(field_get:halakv.MerkleResponse.message)
+  return _internal_message();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void MerkleResponse::set_message(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.message_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.MerkleResponse.message)
+}
+inline std::string* MerkleResponse::mutable_message() {
+  std::string* _s = _internal_mutable_message();
+  // @@protoc_insertion_point(field_mutable:halakv.MerkleResponse.message)
+  return _s;
+}
+inline const std::string& MerkleResponse::_internal_message() const {
+  return _impl_.message_.Get();
+}
+inline void MerkleResponse::_internal_set_message(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.message_.Set(value, GetArenaForAllocation());
+}
+inline std::string* MerkleResponse::_internal_mutable_message() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.message_.Mutable(GetArenaForAllocation());
+}
+inline std::string* MerkleResponse::release_message() {
+  // @@protoc_insertion_point(field_release:halakv.MerkleResponse.message)
+  if (!_internal_has_message()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.message_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.message_.IsDefault()) {
+    _impl_.message_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void MerkleResponse::set_allocated_message(std::string* message) {
+  if (message != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.message_.SetAllocated(message, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.message_.IsDefault()) {
+    _impl_.message_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.MerkleResponse.message)
+}
+
+// repeated uint64 hashes = 3;
+inline int MerkleResponse::_internal_hashes_size() const {
+  return _impl_.hashes_.size();
+}
+inline int MerkleResponse::hashes_size() const {
+  return _internal_hashes_size();
+}
+inline void MerkleResponse::clear_hashes() {
+  _impl_.hashes_.Clear();
+}
+inline uint64_t MerkleResponse::_internal_hashes(int index) const {
+  return _impl_.hashes_.Get(index);
+}
+inline uint64_t MerkleResponse::hashes(int index) const {
+  // @@protoc_insertion_point(field_get:halakv.MerkleResponse.hashes)
+  return _internal_hashes(index);
+}
+inline void MerkleResponse::set_hashes(int index, uint64_t value) {
+  _impl_.hashes_.Set(index, value);
+  // @@protoc_insertion_point(field_set:halakv.MerkleResponse.hashes)
+}
+inline void MerkleResponse::_internal_add_hashes(uint64_t value) {
+  _impl_.hashes_.Add(value);
+}
+inline void MerkleResponse::add_hashes(uint64_t value) {
+  _internal_add_hashes(value);
+  // @@protoc_insertion_point(field_add:halakv.MerkleResponse.hashes)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+MerkleResponse::_internal_hashes() const {
+  return _impl_.hashes_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+MerkleResponse::hashes() const {
+  // @@protoc_insertion_point(field_list:halakv.MerkleResponse.hashes)
+  return _internal_hashes();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+MerkleResponse::_internal_mutable_hashes() {
+  return &_impl_.hashes_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+MerkleResponse::mutable_hashes() {
+  // @@protoc_insertion_point(field_mutable_list:halakv.MerkleResponse.hashes)
+  return _internal_mutable_hashes();
+}
+
+// -------------------------------------------------------------------
+
+// ScanRequest
+
+// repeated uint32 leaves = 1;
+inline int ScanRequest::_internal_leaves_size() const {
+  return _impl_.leaves_.size();
+}
+inline int ScanRequest::leaves_size() const {
+  return _internal_leaves_size();
+}
+inline void ScanRequest::clear_leaves() {
+  _impl_.leaves_.Clear();
+}
+inline uint32_t ScanRequest::_internal_leaves(int index) const {
+  return _impl_.leaves_.Get(index);
+}
+inline uint32_t ScanRequest::leaves(int index) const {
+  // @@protoc_insertion_point(field_get:halakv.ScanRequest.leaves)
+  return _internal_leaves(index);
+}
+inline void ScanRequest::set_leaves(int index, uint32_t value) {
+  _impl_.leaves_.Set(index, value);
+  // @@protoc_insertion_point(field_set:halakv.ScanRequest.leaves)
+}
+inline void ScanRequest::_internal_add_leaves(uint32_t value) {
+  _impl_.leaves_.Add(value);
+}
+inline void ScanRequest::add_leaves(uint32_t value) {
+  _internal_add_leaves(value);
+  // @@protoc_insertion_point(field_add:halakv.ScanRequest.leaves)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+ScanRequest::_internal_leaves() const {
+  return _impl_.leaves_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+ScanRequest::leaves() const {
+  // @@protoc_insertion_point(field_list:halakv.ScanRequest.leaves)
+  return _internal_leaves();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+ScanRequest::_internal_mutable_leaves() {
+  return &_impl_.leaves_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+ScanRequest::mutable_leaves() {
+  // @@protoc_insertion_point(field_mutable_list:halakv.ScanRequest.leaves)
+  return _internal_mutable_leaves();
+}
+
+// optional bool replica = 2;
+inline bool ScanRequest::_internal_has_replica() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool ScanRequest::has_replica() const {
+  return _internal_has_replica();
+}
+inline void ScanRequest::clear_replica() {
+  _impl_.replica_ = false;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline bool ScanRequest::_internal_replica() const {
+  return _impl_.replica_;
+}
+inline bool ScanRequest::replica() const {
+  // @@protoc_insertion_point(field_get:halakv.ScanRequest.replica)
+  return _internal_replica();
+}
+inline void ScanRequest::_internal_set_replica(bool value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.replica_ = value;
+}
+inline void ScanRequest::set_replica(bool value) {
+  _internal_set_replica(value);
+  // @@protoc_insertion_point(field_set:halakv.ScanRequest.replica)
+}
+
+// -------------------------------------------------------------------
+
+// ScanResponse
+
+// required int32 code = 1;
+inline bool ScanResponse::_internal_has_code() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool ScanResponse::has_code() const {
+  return _internal_has_code();
+}
+inline void ScanResponse::clear_code() {
+  _impl_.code_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline int32_t ScanResponse::_internal_code() const {
+  return _impl_.code_;
+}
+inline int32_t ScanResponse::code() const {
+  // @@protoc_insertion_point(field_get:halakv.ScanResponse.code)
+  return _internal_code();
+}
+inline void ScanResponse::_internal_set_code(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.code_ = value;
+}
+inline void ScanResponse::set_code(int32_t value) {
+  _internal_set_code(value);
+  // @@protoc_insertion_point(field_set:halakv.ScanResponse.code)
+}
+
+// required string message = 2;
+inline bool ScanResponse::_internal_has_message() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool ScanResponse::has_message() const {
+  return _internal_has_message();
+}
+inline void ScanResponse::clear_message() {
+  _impl_.message_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& ScanResponse::message() const {
+  // @@protoc_insertion_point(field_get:halakv.ScanResponse.message)
+  return _internal_message();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void ScanResponse::set_message(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.message_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.ScanResponse.message)
+}
+inline std::string* ScanResponse::mutable_message() {
+  std::string* _s = _internal_mutable_message();
+  // @@protoc_insertion_point(field_mutable:halakv.ScanResponse.message)
+  return _s;
+}
+inline const std::string& ScanResponse::_internal_message() const {
+  return _impl_.message_.Get();
+}
+inline void ScanResponse::_internal_set_message(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.message_.Set(value, GetArenaForAllocation());
+}
+inline std::string* ScanResponse::_internal_mutable_message() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.message_.Mutable(GetArenaForAllocation());
+}
+inline std::string* ScanResponse::release_message() {
+  // @@protoc_insertion_point(field_release:halakv.ScanResponse.message)
+  if (!_internal_has_message()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.message_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.message_.IsDefault()) {
+    _impl_.message_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void ScanResponse::set_allocated_message(std::string* message) {
+  if (message != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.message_.SetAllocated(message, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.message_.IsDefault()) {
+    _impl_.message_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.ScanResponse.message)
+}
+
+// repeated .halakv.KvRequest entries = 3;
+inline int ScanResponse::_internal_entries_size() const {
+  return _impl_.entries_.size();
+}
+inline int ScanResponse::entries_size() const {
+  return _internal_entries_size();
+}
+inline void ScanResponse::clear_entries() {
+  _impl_.entries_.Clear();
+}
+inline ::halakv::KvRequest* ScanResponse::mutable_entries(int index) {
+  // @@protoc_insertion_point(field_mutable:halakv.ScanResponse.entries)
+  return _impl_.entries_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::KvRequest >*
+ScanResponse::mutable_entries() {
+  // @@protoc_insertion_point(field_mutable_list:halakv.ScanResponse.entries)
+  return &_impl_.entries_;
+}
+inline const ::halakv::KvRequest& ScanResponse::_internal_entries(int index) const {
+  return _impl_.entries_.Get(index);
+}
+inline const ::halakv::KvRequest& ScanResponse::entries(int index) const {
+  // @@protoc_insertion_point(field_get:halakv.ScanResponse.entries)
+  return _internal_entries(index);
+}
+inline ::halakv::KvRequest* ScanResponse::_internal_add_entries() {
+  return _impl_.entries_.Add();
+}
+inline ::halakv::KvRequest* ScanResponse::add_entries() {
+  ::halakv::KvRequest* _add = _internal_add_entries();
+  // @@protoc_insertion_point(field_add:halakv.ScanResponse.entries)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::KvRequest >&
+ScanResponse::entries() const {
+  // @@protoc_insertion_point(field_list:halakv.ScanResponse.entries)
+  return _impl_.entries_;
+}
+
+// -------------------------------------------------------------------
+
+// ReplicateRequest
+
+// required string primary = 1;
+inline bool ReplicateRequest::_internal_has_primary() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool ReplicateRequest::has_primary() const {
+  return _internal_has_primary();
+}
+inline void ReplicateRequest::clear_primary() {
+  _impl_.primary_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& ReplicateRequest::primary() const {
+  // @@protoc_insertion_point(field_get:halakv.ReplicateRequest.primary)
+  return _internal_primary();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void ReplicateRequest::set_primary(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.primary_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.ReplicateRequest.primary)
+}
+inline std::string* ReplicateRequest::mutable_primary() {
+  std::string* _s = _internal_mutable_primary();
+  // @@protoc_insertion_point(field_mutable:halakv.ReplicateRequest.primary)
+  return _s;
+}
+inline const std::string& ReplicateRequest::_internal_primary() const {
+  return _impl_.primary_.Get();
+}
+inline void ReplicateRequest::_internal_set_primary(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.primary_.Set(value, GetArenaForAllocation());
+}
+inline std::string* ReplicateRequest::_internal_mutable_primary() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.primary_.Mutable(GetArenaForAllocation());
+}
+inline std::string* ReplicateRequest::release_primary() {
+  // @@protoc_insertion_point(field_release:halakv.ReplicateRequest.primary)
+  if (!_internal_has_primary()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.primary_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.primary_.IsDefault()) {
+    _impl_.primary_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void ReplicateRequest::set_allocated_primary(std::string* primary) {
+  if (primary != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.primary_.SetAllocated(primary, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.primary_.IsDefault()) {
+    _impl_.primary_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.ReplicateRequest.primary)
+}
+
+// required uint64 start_seq = 2;
+inline bool ReplicateRequest::_internal_has_start_seq() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool ReplicateRequest::has_start_seq() const {
+  return _internal_has_start_seq();
+}
+inline void ReplicateRequest::clear_start_seq() {
+  _impl_.start_seq_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline uint64_t ReplicateRequest::_internal_start_seq() const {
+  return _impl_.start_seq_;
+}
+inline uint64_t ReplicateRequest::start_seq() const {
+  // @@protoc_insertion_point(field_get:halakv.ReplicateRequest.start_seq)
+  return _internal_start_seq();
+}
+inline void ReplicateRequest::_internal_set_start_seq(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.start_seq_ = value;
+}
+inline void ReplicateRequest::set_start_seq(uint64_t value) {
+  _internal_set_start_seq(value);
+  // @@protoc_insertion_point(field_set:halakv.ReplicateRequest.start_seq)
+}
+
+// optional uint64 incarnation = 3;
+inline bool ReplicateRequest::_internal_has_incarnation() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool ReplicateRequest::has_incarnation() const {
+  return _internal_has_incarnation();
+}
+inline void ReplicateRequest::clear_incarnation() {
+  _impl_.incarnation_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline uint64_t ReplicateRequest::_internal_incarnation() const {
+  return _impl_.incarnation_;
+}
+inline uint64_t ReplicateRequest::incarnation() const {
+  // @@protoc_insertion_point(field_get:halakv.ReplicateRequest.incarnation)
+  return _internal_incarnation();
+}
+inline void ReplicateRequest::_internal_set_incarnation(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.incarnation_ = value;
+}
+inline void ReplicateRequest::set_incarnation(uint64_t value) {
+  _internal_set_incarnation(value);
+  // @@protoc_insertion_point(field_set:halakv.ReplicateRequest.incarnation)
+}
+
+// -------------------------------------------------------------------
+
+// LogEntry
+
+// required uint64 seq = 1;
+inline bool LogEntry::_internal_has_seq() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool LogEntry::has_seq() const {
+  return _internal_has_seq();
+}
+inline void LogEntry::clear_seq() {
+  _impl_.seq_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline uint64_t LogEntry::_internal_seq() const {
+  return _impl_.seq_;
+}
+inline uint64_t LogEntry::seq() const {
+  // @@protoc_insertion_point(field_get:halakv.LogEntry.seq)
+  return _internal_seq();
+}
+inline void LogEntry::_internal_set_seq(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.seq_ = value;
+}
+inline void LogEntry::set_seq(uint64_t value) {
+  _internal_set_seq(value);
+  // @@protoc_insertion_point(field_set:halakv.LogEntry.seq)
+}
+
+// required string key = 2;
+inline bool LogEntry::_internal_has_key() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool LogEntry::has_key() const {
+  return _internal_has_key();
+}
+inline void LogEntry::clear_key() {
+  _impl_.key_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& LogEntry::key() const {
+  // @@protoc_insertion_point(field_get:halakv.LogEntry.key)
+  return _internal_key();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void LogEntry::set_key(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.key_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.LogEntry.key)
+}
+inline std::string* LogEntry::mutable_key() {
+  std::string* _s = _internal_mutable_key();
+  // @@protoc_insertion_point(field_mutable:halakv.LogEntry.key)
+  return _s;
+}
+inline const std::string& LogEntry::_internal_key() const {
+  return _impl_.key_.Get();
+}
+inline void LogEntry::_internal_set_key(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.key_.Set(value, GetArenaForAllocation());
+}
+inline std::string* LogEntry::_internal_mutable_key() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.key_.Mutable(GetArenaForAllocation());
+}
+inline std::string* LogEntry::release_key() {
+  // @@protoc_insertion_point(field_release:halakv.LogEntry.key)
+  if (!_internal_has_key()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.key_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.key_.IsDefault()) {
+    _impl_.key_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void LogEntry::set_allocated_key(std::string* key) {
+  if (key != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.key_.SetAllocated(key, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.key_.IsDefault()) {
+    _impl_.key_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.LogEntry.key)
+}
+
+// optional string value = 3;
+inline bool LogEntry::_internal_has_value() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool LogEntry::has_value() const {
+  return _internal_has_value();
+}
+inline void LogEntry::clear_value() {
+  _impl_.value_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const std::string& LogEntry::value() const {
+  // @@protoc_insertion_point(field_get:halakv.LogEntry.value)
+  return _internal_value();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void LogEntry::set_value(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.value_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.LogEntry.value)
+}
+inline std::string* LogEntry::mutable_value() {
+  std::string* _s = _internal_mutable_value();
+  // @@protoc_insertion_point(field_mutable:halakv.LogEntry.value)
+  return _s;
+}
+inline const std::string& LogEntry::_internal_value() const {
+  return _impl_.value_.Get();
+}
+inline void LogEntry::_internal_set_value(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.value_.Set(value, GetArenaForAllocation());
+}
+inline std::string* LogEntry::_internal_mutable_value() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.value_.Mutable(GetArenaForAllocation());
+}
+inline std::string* LogEntry::release_value() {
+  // @@protoc_insertion_point(field_release:halakv.LogEntry.value)
+  if (!_internal_has_value()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.value_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.value_.IsDefault()) {
+    _impl_.value_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void LogEntry::set_allocated_value(std::string* value) {
+  if (value != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.value_.SetAllocated(value, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.value_.IsDefault()) {
+    _impl_.value_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.LogEntry.value)
+}
+
+// optional bool remove = 4;
+inline bool LogEntry::_internal_has_remove() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000010u) != 0;
+  return value;
+}
+inline bool LogEntry::has_remove() const {
+  return _internal_has_remove();
+}
+inline void LogEntry::clear_remove() {
+  _impl_.remove_ = false;
+  _impl_._has_bits_[0] &= ~0x00000010u;
+}
+inline bool LogEntry::_internal_remove() const {
+  return _impl_.remove_;
+}
+inline bool LogEntry::remove() const {
+  // @@protoc_insertion_point(field_get:halakv.LogEntry.remove)
+  return _internal_remove();
+}
+inline void LogEntry::_internal_set_remove(bool value) {
+  _impl_._has_bits_[0] |= 0x00000010u;
+  _impl_.remove_ = value;
+}
+inline void LogEntry::set_remove(bool value) {
+  _internal_set_remove(value);
+  // @@protoc_insertion_point(field_set:halakv.LogEntry.remove)
+}
+
+// optional uint64 expire_at_us = 5;
+inline bool LogEntry::_internal_has_expire_at_us() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
+inline bool LogEntry::has_expire_at_us() const {
+  return _internal_has_expire_at_us();
+}
+inline void LogEntry::clear_expire_at_us() {
+  _impl_.expire_at_us_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000008u;
+}
+inline uint64_t LogEntry::_internal_expire_at_us() const {
+  return _impl_.expire_at_us_;
+}
+inline uint64_t LogEntry::expire_at_us() const {
+  // @@protoc_insertion_point(field_get:halakv.LogEntry.expire_at_us)
+  return _internal_expire_at_us();
+}
+inline void LogEntry::_internal_set_expire_at_us(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.expire_at_us_ = value;
+}
+inline void LogEntry::set_expire_at_us(uint64_t value) {
+  _internal_set_expire_at_us(value);
+  // @@protoc_insertion_point(field_set:halakv.LogEntry.expire_at_us)
+}
+
+// optional uint64 version = 6;
+inline bool LogEntry::_internal_has_version() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000040u) != 0;
+  return value;
+}
+inline bool LogEntry::has_version() const {
+  return _internal_has_version();
+}
+inline void LogEntry::clear_version() {
+  _impl_.version_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000040u;
+}
+inline uint64_t LogEntry::_internal_version() const {
+  return _impl_.version_;
+}
+inline uint64_t LogEntry::version() const {
+  // @@protoc_insertion_point(field_get:halakv.LogEntry.version)
+  return _internal_version();
+}
+inline void LogEntry::_internal_set_version(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000040u;
+  _impl_.version_ = value;
+}
+inline void LogEntry::set_version(uint64_t value) {
+  _internal_set_version(value);
+  // @@protoc_insertion_point(field_set:halakv.LogEntry.version)
+}
+
+// optional uint32 flags = 7;
+inline bool LogEntry::_internal_has_flags() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000020u) != 0;
+  return value;
+}
+inline bool LogEntry::has_flags() const {
+  return _internal_has_flags();
+}
+inline void LogEntry::clear_flags() {
+  _impl_.flags_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000020u;
+}
+inline uint32_t LogEntry::_internal_flags() const {
+  return _impl_.flags_;
+}
+inline uint32_t LogEntry::flags() const {
+  // @@protoc_insertion_point(field_get:halakv.LogEntry.flags)
+  return _internal_flags();
+}
+inline void LogEntry::_internal_set_flags(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000020u;
+  _impl_.flags_ = value;
+}
+inline void LogEntry::set_flags(uint32_t value) {
+  _internal_set_flags(value);
+  // @@protoc_insertion_point(field_set:halakv.LogEntry.flags)
+}
+
+// -------------------------------------------------------------------
+
+// LogBatch
+
+// repeated .halakv.LogEntry entries = 1;
+inline int LogBatch::_internal_entries_size() const {
+  return _impl_.entries_.size();
+}
+inline int LogBatch::entries_size() const {
+  return _internal_entries_size();
+}
+inline void LogBatch::clear_entries() {
+  _impl_.entries_.Clear();
+}
+inline ::halakv::LogEntry* LogBatch::mutable_entries(int index) {
+  // @@protoc_insertion_point(field_mutable:halakv.LogBatch.entries)
+  return _impl_.entries_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::LogEntry >*
+LogBatch::mutable_entries() {
+  // @@protoc_insertion_point(field_mutable_list:halakv.LogBatch.entries)
+  return &_impl_.entries_;
+}
+inline const ::halakv::LogEntry& LogBatch::_internal_entries(int index) const {
+  return _impl_.entries_.Get(index);
+}
+inline const ::halakv::LogEntry& LogBatch::entries(int index) const {
+  // @@protoc_insertion_point(field_get:halakv.LogBatch.entries)
+  return _internal_entries(index);
+}
+inline ::halakv::LogEntry* LogBatch::_internal_add_entries() {
+  return _impl_.entries_.Add();
+}
+inline ::halakv::LogEntry* LogBatch::add_entries() {
+  ::halakv::LogEntry* _add = _internal_add_entries();
+  // @@protoc_insertion_point(field_add:halakv.LogBatch.entries)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::LogEntry >&
+LogBatch::entries() const {
+  // @@protoc_insertion_point(field_list:halakv.LogBatch.entries)
+  return _impl_.entries_;
+}
+
+// -------------------------------------------------------------------
+
+// LogAck
+
+// required uint64 seq = 1;
+inline bool LogAck::_internal_has_seq() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool LogAck::has_seq() const {
+  return _internal_has_seq();
+}
+inline void LogAck::clear_seq() {
+  _impl_.seq_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline uint64_t LogAck::_internal_seq() const {
+  return _impl_.seq_;
+}
+inline uint64_t LogAck::seq() const {
+  // @@protoc_insertion_point(field_get:halakv.LogAck.seq)
+  return _internal_seq();
+}
+inline void LogAck::_internal_set_seq(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.seq_ = value;
+}
+inline void LogAck::set_seq(uint64_t value) {
+  _internal_set_seq(value);
+  // @@protoc_insertion_point(field_set:halakv.LogAck.seq)
+}
+
+// -------------------------------------------------------------------
+
+// LoadRequest
+
+// optional string ns = 1;
+inline bool LoadRequest::_internal_has_ns() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool LoadRequest::has_ns() const {
+  return _internal_has_ns();
+}
+inline void LoadRequest::clear_ns() {
+  _impl_.ns_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& LoadRequest::ns() const {
+  // @@protoc_insertion_point(field_get:halakv.LoadRequest.ns)
+  return _internal_ns();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void LoadRequest::set_ns(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.ns_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.LoadRequest.ns)
+}
+inline std::string* LoadRequest::mutable_ns() {
+  std::string* _s = _internal_mutable_ns();
+  // @@protoc_insertion_point(field_mutable:halakv.LoadRequest.ns)
+  return _s;
+}
+inline const std::string& LoadRequest::_internal_ns() const {
+  return _impl_.ns_.Get();
+}
+inline void LoadRequest::_internal_set_ns(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.ns_.Set(value, GetArenaForAllocation());
+}
+inline std::string* LoadRequest::_internal_mutable_ns() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.ns_.Mutable(GetArenaForAllocation());
+}
+inline std::string* LoadRequest::release_ns() {
+  // @@protoc_insertion_point(field_release:halakv.LoadRequest.ns)
+  if (!_internal_has_ns()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.ns_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.ns_.IsDefault()) {
+    _impl_.ns_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void LoadRequest::set_allocated_ns(std::string* ns) {
+  if (ns != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.ns_.SetAllocated(ns, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.ns_.IsDefault()) {
+    _impl_.ns_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.LoadRequest.ns)
+}
+
+// -------------------------------------------------------------------
+
+// LoadAck
+
+// required uint64 batches = 1;
+inline bool LoadAck::_internal_has_batches() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool LoadAck::has_batches() const {
+  return _internal_has_batches();
+}
+inline void LoadAck::clear_batches() {
+  _impl_.batches_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline uint64_t LoadAck::_internal_batches() const {
+  return _impl_.batches_;
+}
+inline uint64_t LoadAck::batches() const {
+  // @@protoc_insertion_point(field_get:halakv.LoadAck.batches)
+  return _internal_batches();
+}
+inline void LoadAck::_internal_set_batches(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.batches_ = value;
+}
+inline void LoadAck::set_batches(uint64_t value) {
+  _internal_set_batches(value);
+  // @@protoc_insertion_point(field_set:halakv.LoadAck.batches)
+}
+
+// required uint64 loaded = 2;
+inline bool LoadAck::_internal_has_loaded() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool LoadAck::has_loaded() const {
+  return _internal_has_loaded();
+}
+inline void LoadAck::clear_loaded() {
+  _impl_.loaded_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline uint64_t LoadAck::_internal_loaded() const {
+  return _impl_.loaded_;
+}
+inline uint64_t LoadAck::loaded() const {
+  // @@protoc_insertion_point(field_get:halakv.LoadAck.loaded)
+  return _internal_loaded();
+}
+inline void LoadAck::_internal_set_loaded(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.loaded_ = value;
+}
+inline void LoadAck::set_loaded(uint64_t value) {
+  _internal_set_loaded(value);
+  // @@protoc_insertion_point(field_set:halakv.LoadAck.loaded)
+}
+
+// required uint64 failed = 3;
+inline bool LoadAck::_internal_has_failed() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool LoadAck::has_failed() const {
+  return _internal_has_failed();
+}
+inline void LoadAck::clear_failed() {
+  _impl_.failed_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline uint64_t LoadAck::_internal_failed() const {
+  return _impl_.failed_;
+}
+inline uint64_t LoadAck::failed() const {
+  // @@protoc_insertion_point(field_get:halakv.LoadAck.failed)
+  return _internal_failed();
+}
+inline void LoadAck::_internal_set_failed(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.failed_ = value;
+}
+inline void LoadAck::set_failed(uint64_t value) {
+  _internal_set_failed(value);
+  // @@protoc_insertion_point(field_set:halakv.LoadAck.failed)
+}
+
+// -------------------------------------------------------------------
+
+// WatchRequest
+
+// repeated string prefixes = 1;
+inline int WatchRequest::_internal_prefixes_size() const {
+  return _impl_.prefixes_.size();
+}
+inline int WatchRequest::prefixes_size() const {
+  return _internal_prefixes_size();
+}
+inline void WatchRequest::clear_prefixes() {
+  _impl_.prefixes_.Clear();
+}
+inline std::string* WatchRequest::add_prefixes() {
+  std::string* _s = _internal_add_prefixes();
+  // @@protoc_insertion_point(field_add_mutable:halakv.WatchRequest.prefixes)
+  return _s;
+}
+inline const std::string& WatchRequest::_internal_prefixes(int index) const {
+  return _impl_.prefixes_.Get(index);
+}
+inline const std::string& WatchRequest::prefixes(int index) const {
+  // @@protoc_insertion_point(field_get:halakv.WatchRequest.prefixes)
+  return _internal_prefixes(index);
+}
+inline std::string* WatchRequest::mutable_prefixes(int index) {
+  // @@protoc_insertion_point(field_mutable:halakv.WatchRequest.prefixes)
+  return _impl_.prefixes_.Mutable(index);
+}
+inline void WatchRequest::set_prefixes(int index, const std::string& value) {
+  _impl_.prefixes_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set:halakv.WatchRequest.prefixes)
+}
+inline void WatchRequest::set_prefixes(int index, std::string&& value) {
+  _impl_.prefixes_.Mutable(index)->assign(std::move(value));
+  // @@protoc_insertion_point(field_set:halakv.WatchRequest.prefixes)
+}
+inline void WatchRequest::set_prefixes(int index, const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  _impl_.prefixes_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:halakv.WatchRequest.prefixes)
+}
+inline void WatchRequest::set_prefixes(int index, const char* value, size_t size) {
+  _impl_.prefixes_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:halakv.WatchRequest.prefixes)
+}
+inline std::string* WatchRequest::_internal_add_prefixes() {
+  return _impl_.prefixes_.Add();
+}
+inline void WatchRequest::add_prefixes(const std::string& value) {
+  _impl_.prefixes_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:halakv.WatchRequest.prefixes)
+}
+inline void WatchRequest::add_prefixes(std::string&& value) {
+  _impl_.prefixes_.Add(std::move(value));
+  // @@protoc_insertion_point(field_add:halakv.WatchRequest.prefixes)
+}
+inline void WatchRequest::add_prefixes(const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  _impl_.prefixes_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:halakv.WatchRequest.prefixes)
+}
+inline void WatchRequest::add_prefixes(const char* value, size_t size) {
+  _impl_.prefixes_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:halakv.WatchRequest.prefixes)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>&
+WatchRequest::prefixes() const {
+  // @@protoc_insertion_point(field_list:halakv.WatchRequest.prefixes)
+  return _impl_.prefixes_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>*
+WatchRequest::mutable_prefixes() {
+  // @@protoc_insertion_point(field_mutable_list:halakv.WatchRequest.prefixes)
+  return &_impl_.prefixes_;
+}
+
+// repeated string keys = 2;
+inline int WatchRequest::_internal_keys_size() const {
+  return _impl_.keys_.size();
+}
+inline int WatchRequest::keys_size() const {
+  return _internal_keys_size();
+}
+inline void WatchRequest::clear_keys() {
+  _impl_.keys_.Clear();
+}
+inline std::string* WatchRequest::add_keys() {
+  std::string* _s = _internal_add_keys();
+  // @@protoc_insertion_point(field_add_mutable:halakv.WatchRequest.keys)
+  return _s;
+}
+inline const std::string& WatchRequest::_internal_keys(int index) const {
+  return _impl_.keys_.Get(index);
+}
+inline const std::string& WatchRequest::keys(int index) const {
+  // @@protoc_insertion_point(field_get:halakv.WatchRequest.keys)
+  return _internal_keys(index);
+}
+inline std::string* WatchRequest::mutable_keys(int index) {
+  // @@protoc_insertion_point(field_mutable:halakv.WatchRequest.keys)
+  return _impl_.keys_.Mutable(index);
+}
+inline void WatchRequest::set_keys(int index, const std::string& value) {
+  _impl_.keys_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set:halakv.WatchRequest.keys)
+}
+inline void WatchRequest::set_keys(int index, std::string&& value) {
+  _impl_.keys_.Mutable(index)->assign(std::move(value));
+  // @@protoc_insertion_point(field_set:halakv.WatchRequest.keys)
+}
+inline void WatchRequest::set_keys(int index, const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  _impl_.keys_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:halakv.WatchRequest.keys)
+}
+inline void WatchRequest::set_keys(int index, const char* value, size_t size) {
+  _impl_.keys_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:halakv.WatchRequest.keys)
+}
+inline std::string* WatchRequest::_internal_add_keys() {
+  return _impl_.keys_.Add();
+}
+inline void WatchRequest::add_keys(const std::string& value) {
+  _impl_.keys_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:halakv.WatchRequest.keys)
+}
+inline void WatchRequest::add_keys(std::string&& value) {
+  _impl_.keys_.Add(std::move(value));
+  // @@protoc_insertion_point(field_add:halakv.WatchRequest.keys)
+}
+inline void WatchRequest::add_keys(const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  _impl_.keys_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:halakv.WatchRequest.keys)
+}
+inline void WatchRequest::add_keys(const char* value, size_t size) {
+  _impl_.keys_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:halakv.WatchRequest.keys)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>&
+WatchRequest::keys() const {
+  // @@protoc_insertion_point(field_list:halakv.WatchRequest.keys)
+  return _impl_.keys_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>*
+WatchRequest::mutable_keys() {
+  // @@protoc_insertion_point(field_mutable_list:halakv.WatchRequest.keys)
+  return &_impl_.keys_;
+}
+
+// optional string ns = 3;
+inline bool WatchRequest::_internal_has_ns() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool WatchRequest::has_ns() const {
+  return _internal_has_ns();
+}
+inline void WatchRequest::clear_ns() {
+  _impl_.ns_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& WatchRequest::ns() const {
+  // @@protoc_insertion_point(field_get:halakv.WatchRequest.ns)
+  return _internal_ns();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void WatchRequest::set_ns(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.ns_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.WatchRequest.ns)
+}
+inline std::string* WatchRequest::mutable_ns() {
+  std::string* _s = _internal_mutable_ns();
+  // @@protoc_insertion_point(field_mutable:halakv.WatchRequest.ns)
+  return _s;
+}
+inline const std::string& WatchRequest::_internal_ns() const {
+  return _impl_.ns_.Get();
+}
+inline void WatchRequest::_internal_set_ns(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.ns_.Set(value, GetArenaForAllocation());
+}
+inline std::string* WatchRequest::_internal_mutable_ns() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.ns_.Mutable(GetArenaForAllocation());
+}
+inline std::string* WatchRequest::release_ns() {
+  // @@protoc_insertion_point(field_release:halakv.WatchRequest.ns)
+  if (!_internal_has_ns()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.ns_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.ns_.IsDefault()) {
+    _impl_.ns_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void WatchRequest::set_allocated_ns(std::string* ns) {
+  if (ns != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.ns_.SetAllocated(ns, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.ns_.IsDefault()) {
+    _impl_.ns_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.WatchRequest.ns)
+}
+
+// -------------------------------------------------------------------
+
+// WatchEvent
+
+// required uint64 seq = 1;
+inline bool WatchEvent::_internal_has_seq() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool WatchEvent::has_seq() const {
+  return _internal_has_seq();
+}
+inline void WatchEvent::clear_seq() {
+  _impl_.seq_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline uint64_t WatchEvent::_internal_seq() const {
+  return _impl_.seq_;
+}
+inline uint64_t WatchEvent::seq() const {
+  // @@protoc_insertion_point(field_get:halakv.WatchEvent.seq)
+  return _internal_seq();
+}
+inline void WatchEvent::_internal_set_seq(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.seq_ = value;
+}
+inline void WatchEvent::set_seq(uint64_t value) {
+  _internal_set_seq(value);
+  // @@protoc_insertion_point(field_set:halakv.WatchEvent.seq)
+}
+
+// required string key = 2;
+inline bool WatchEvent::_internal_has_key() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool WatchEvent::has_key() const {
+  return _internal_has_key();
+}
+inline void WatchEvent::clear_key() {
+  _impl_.key_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& WatchEvent::key() const {
+  // @@protoc_insertion_point(field_get:halakv.WatchEvent.key)
+  return _internal_key();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void WatchEvent::set_key(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.key_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.WatchEvent.key)
+}
+inline std::string* WatchEvent::mutable_key() {
+  std::string* _s = _internal_mutable_key();
+  // @@protoc_insertion_point(field_mutable:halakv.WatchEvent.key)
+  return _s;
+}
+inline const std::string& WatchEvent::_internal_key() const {
+  return _impl_.key_.Get();
+}
+inline void WatchEvent::_internal_set_key(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.key_.Set(value, GetArenaForAllocation());
+}
+inline std::string* WatchEvent::_internal_mutable_key() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.key_.Mutable(GetArenaForAllocation());
+}
+inline std::string* WatchEvent::release_key() {
+  // @@protoc_insertion_point(field_release:halakv.WatchEvent.key)
+  if (!_internal_has_key()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.key_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.key_.IsDefault()) {
+    _impl_.key_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void WatchEvent::set_allocated_key(std::string* key) {
+  if (key != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.key_.SetAllocated(key, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.key_.IsDefault()) {
+    _impl_.key_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.WatchEvent.key)
+}
+
+// optional bool remove = 3;
+inline bool WatchEvent::_internal_has_remove() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool WatchEvent::has_remove() const {
+  return _internal_has_remove();
+}
+inline void WatchEvent::clear_remove() {
+  _impl_.remove_ = false;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline bool WatchEvent::_internal_remove() const {
+  return _impl_.remove_;
+}
+inline bool WatchEvent::remove() const {
+  // @@protoc_insertion_point(field_get:halakv.WatchEvent.remove)
+  return _internal_remove();
+}
+inline void WatchEvent::_internal_set_remove(bool value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.remove_ = value;
+}
+inline void WatchEvent::set_remove(bool value) {
+  _internal_set_remove(value);
+  // @@protoc_insertion_point(field_set:halakv.WatchEvent.remove)
+}
+
+// -------------------------------------------------------------------
+
+// WatchBatch
+
+// repeated .halakv.WatchEvent events = 1;
+inline int WatchBatch::_internal_events_size() const {
+  return _impl_.events_.size();
+}
+inline int WatchBatch::events_size() const {
+  return _internal_events_size();
+}
+inline void WatchBatch::clear_events() {
+  _impl_.events_.Clear();
+}
+inline ::halakv::WatchEvent* WatchBatch::mutable_events(int index) {
+  // @@protoc_insertion_point(field_mutable:halakv.WatchBatch.events)
+  return _impl_.events_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::WatchEvent >*
+WatchBatch::mutable_events() {
+  // @@protoc_insertion_point(field_mutable_list:halakv.WatchBatch.events)
+  return &_impl_.events_;
+}
+inline const ::halakv::WatchEvent& WatchBatch::_internal_events(int index) const {
+  return _impl_.events_.Get(index);
+}
+inline const ::halakv::WatchEvent& WatchBatch::events(int index) const {
+  // @@protoc_insertion_point(field_get:halakv.WatchBatch.events)
+  return _internal_events(index);
+}
+inline ::halakv::WatchEvent* WatchBatch::_internal_add_events() {
+  return _impl_.events_.Add();
+}
+inline ::halakv::WatchEvent* WatchBatch::add_events() {
+  ::halakv::WatchEvent* _add = _internal_add_events();
+  // @@protoc_insertion_point(field_add:halakv.WatchBatch.events)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::WatchEvent >&
+WatchBatch::events() const {
+  // @@protoc_insertion_point(field_list:halakv.WatchBatch.events)
+  return _impl_.events_;
+}
+
+// optional bool resync = 2;
+inline bool WatchBatch::_internal_has_resync() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool WatchBatch::has_resync() const {
+  return _internal_has_resync();
+}
+inline void WatchBatch::clear_resync() {
+  _impl_.resync_ = false;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline bool WatchBatch::_internal_resync() const {
+  return _impl_.resync_;
+}
+inline bool WatchBatch::resync() const {
+  // @@protoc_insertion_point(field_get:halakv.WatchBatch.resync)
+  return _internal_resync();
+}
+inline void WatchBatch::_internal_set_resync(bool value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.resync_ = value;
+}
+inline void WatchBatch::set_resync(bool value) {
+  _internal_set_resync(value);
+  // @@protoc_insertion_point(field_set:halakv.WatchBatch.resync)
+}
+
+// optional uint64 resync_seq = 3;
+inline bool WatchBatch::_internal_has_resync_seq() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool WatchBatch::has_resync_seq() const {
+  return _internal_has_resync_seq();
+}
+inline void WatchBatch::clear_resync_seq() {
+  _impl_.resync_seq_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline uint64_t WatchBatch::_internal_resync_seq() const {
+  return _impl_.resync_seq_;
+}
+inline uint64_t WatchBatch::resync_seq() const {
+  // @@protoc_insertion_point(field_get:halakv.WatchBatch.resync_seq)
+  return _internal_resync_seq();
+}
+inline void WatchBatch::_internal_set_resync_seq(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.resync_seq_ = value;
+}
+inline void WatchBatch::set_resync_seq(uint64_t value) {
+  _internal_set_resync_seq(value);
+  // @@protoc_insertion_point(field_set:halakv.WatchBatch.resync_seq)
+}
+
+// -------------------------------------------------------------------
+
+// RouteRequest
+
+// -------------------------------------------------------------------
+
+// RouteTable
+
+// required int32 code = 1;
+inline bool RouteTable::_internal_has_code() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
+inline bool RouteTable::has_code() const {
+  return _internal_has_code();
+}
+inline void RouteTable::clear_code() {
+  _impl_.code_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000008u;
+}
+inline int32_t RouteTable::_internal_code() const {
+  return _impl_.code_;
+}
+inline int32_t RouteTable::code() const {
+  // @@protoc_insertion_point(field_get:halakv.RouteTable.code)
+  return _internal_code();
+}
+inline void RouteTable::_internal_set_code(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.code_ = value;
+}
+inline void RouteTable::set_code(int32_t value) {
+  _internal_set_code(value);
+  // @@protoc_insertion_point(field_set:halakv.RouteTable.code)
+}
+
+// required string message = 2;
+inline bool RouteTable::_internal_has_message() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool RouteTable::has_message() const {
+  return _internal_has_message();
+}
+inline void RouteTable::clear_message() {
+  _impl_.message_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& RouteTable::message() const {
+  // @@protoc_insertion_point(field_get:halakv.RouteTable.message)
+  return _internal_message();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void RouteTable::set_message(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.message_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.RouteTable.message)
+}
+inline std::string* RouteTable::mutable_message() {
+  std::string* _s = _internal_mutable_message();
+  // @@protoc_insertion_point(field_mutable:halakv.RouteTable.message)
+  return _s;
+}
+inline const std::string& RouteTable::_internal_message() const {
+  return _impl_.message_.Get();
+}
+inline void RouteTable::_internal_set_message(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.message_.Set(value, GetArenaForAllocation());
+}
+inline std::string* RouteTable::_internal_mutable_message() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.message_.Mutable(GetArenaForAllocation());
+}
+inline std::string* RouteTable::release_message() {
+  // @@protoc_insertion_point(field_release:halakv.RouteTable.message)
+  if (!_internal_has_message()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.message_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.message_.IsDefault()) {
+    _impl_.message_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void RouteTable::set_allocated_message(std::string* message) {
+  if (message != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.message_.SetAllocated(message, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.message_.IsDefault()) {
+    _impl_.message_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.RouteTable.message)
+}
+
+// optional uint64 epoch = 3;
+inline bool RouteTable::_internal_has_epoch() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool RouteTable::has_epoch() const {
+  return _internal_has_epoch();
+}
+inline void RouteTable::clear_epoch() {
+  _impl_.epoch_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline uint64_t RouteTable::_internal_epoch() const {
+  return _impl_.epoch_;
+}
+inline uint64_t RouteTable::epoch() const {
+  // @@protoc_insertion_point(field_get:halakv.RouteTable.epoch)
+  return _internal_epoch();
+}
+inline void RouteTable::_internal_set_epoch(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.epoch_ = value;
+}
+inline void RouteTable::set_epoch(uint64_t value) {
+  _internal_set_epoch(value);
+  // @@protoc_insertion_point(field_set:halakv.RouteTable.epoch)
+}
+
+// optional string hash_scheme = 4;
+inline bool RouteTable::_internal_has_hash_scheme() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool RouteTable::has_hash_scheme() const {
+  return _internal_has_hash_scheme();
+}
+inline void RouteTable::clear_hash_scheme() {
+  _impl_.hash_scheme_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const std::string& RouteTable::hash_scheme() const {
+  // @@protoc_insertion_point(field_get:halakv.RouteTable.hash_scheme)
+  return _internal_hash_scheme();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void RouteTable::set_hash_scheme(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.hash_scheme_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.RouteTable.hash_scheme)
+}
+inline std::string* RouteTable::mutable_hash_scheme() {
+  std::string* _s = _internal_mutable_hash_scheme();
+  // @@protoc_insertion_point(field_mutable:halakv.RouteTable.hash_scheme)
+  return _s;
+}
+inline const std::string& RouteTable::_internal_hash_scheme() const {
+  return _impl_.hash_scheme_.Get();
+}
+inline void RouteTable::_internal_set_hash_scheme(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.hash_scheme_.Set(value, GetArenaForAllocation());
+}
+inline std::string* RouteTable::_internal_mutable_hash_scheme() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.hash_scheme_.Mutable(GetArenaForAllocation());
+}
+inline std::string* RouteTable::release_hash_scheme() {
+  // @@protoc_insertion_point(field_release:halakv.RouteTable.hash_scheme)
+  if (!_internal_has_hash_scheme()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.hash_scheme_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.hash_scheme_.IsDefault()) {
+    _impl_.hash_scheme_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void RouteTable::set_allocated_hash_scheme(std::string* hash_scheme) {
+  if (hash_scheme != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.hash_scheme_.SetAllocated(hash_scheme, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.hash_scheme_.IsDefault()) {
+    _impl_.hash_scheme_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.RouteTable.hash_scheme)
+}
+
+// repeated string peers = 5;
+inline int RouteTable::_internal_peers_size() const {
+  return _impl_.peers_.size();
+}
+inline int RouteTable::peers_size() const {
+  return _internal_peers_size();
+}
+inline void RouteTable::clear_peers() {
+  _impl_.peers_.Clear();
+}
+inline std::string* RouteTable::add_peers() {
+  std::string* _s = _internal_add_peers();
+  // @@protoc_insertion_point(field_add_mutable:halakv.RouteTable.peers)
+  return _s;
+}
+inline const std::string& RouteTable::_internal_peers(int index) const {
+  return _impl_.peers_.Get(index);
+}
+inline const std::string& RouteTable::peers(int index) const {
+  // @@protoc_insertion_point(field_get:halakv.RouteTable.peers)
+  return _internal_peers(index);
+}
+inline std::string* RouteTable::mutable_peers(int index) {
+  // @@protoc_insertion_point(field_mutable:halakv.RouteTable.peers)
+  return _impl_.peers_.Mutable(index);
+}
+inline void RouteTable::set_peers(int index, const std::string& value) {
+  _impl_.peers_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set:halakv.RouteTable.peers)
+}
+inline void RouteTable::set_peers(int index, std::string&& value) {
+  _impl_.peers_.Mutable(index)->assign(std::move(value));
+  // @@protoc_insertion_point(field_set:halakv.RouteTable.peers)
+}
+inline void RouteTable::set_peers(int index, const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  _impl_.peers_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:halakv.RouteTable.peers)
+}
+inline void RouteTable::set_peers(int index, const char* value, size_t size) {
+  _impl_.peers_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:halakv.RouteTable.peers)
+}
+inline std::string* RouteTable::_internal_add_peers() {
+  return _impl_.peers_.Add();
+}
+inline void RouteTable::add_peers(const std::string& value) {
+  _impl_.peers_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:halakv.RouteTable.peers)
+}
+inline void RouteTable::add_peers(std::string&& value) {
+  _impl_.peers_.Add(std::move(value));
+  // @@protoc_insertion_point(field_add:halakv.RouteTable.peers)
+}
+inline void RouteTable::add_peers(const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  _impl_.peers_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:halakv.RouteTable.peers)
+}
+inline void RouteTable::add_peers(const char* value, size_t size) {
+  _impl_.peers_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:halakv.RouteTable.peers)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>&
+RouteTable::peers() const {
+  // @@protoc_insertion_point(field_list:halakv.RouteTable.peers)
+  return _impl_.peers_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>*
+RouteTable::mutable_peers() {
+  // @@protoc_insertion_point(field_mutable_list:halakv.RouteTable.peers)
+  return &_impl_.peers_;
+}
+
+// repeated bool alive = 6;
+inline int RouteTable::_internal_alive_size() const {
+  return _impl_.alive_.size();
+}
+inline int RouteTable::alive_size() const {
+  return _internal_alive_size();
+}
+inline void RouteTable::clear_alive() {
+  _impl_.alive_.Clear();
+}
+inline bool RouteTable::_internal_alive(int index) const {
+  return _impl_.alive_.Get(index);
+}
+inline bool RouteTable::alive(int index) const {
+  // @@protoc_insertion_point(field_get:halakv.RouteTable.alive)
+  return _internal_alive(index);
+}
+inline void RouteTable::set_alive(int index, bool value) {
+  _impl_.alive_.Set(index, value);
+  // @@protoc_insertion_point(field_set:halakv.RouteTable.alive)
+}
+inline void RouteTable::_internal_add_alive(bool value) {
+  _impl_.alive_.Add(value);
+}
+inline void RouteTable::add_alive(bool value) {
+  _internal_add_alive(value);
+  // @@protoc_insertion_point(field_add:halakv.RouteTable.alive)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< bool >&
+RouteTable::_internal_alive() const {
+  return _impl_.alive_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< bool >&
+RouteTable::alive() const {
+  // @@protoc_insertion_point(field_list:halakv.RouteTable.alive)
+  return _internal_alive();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< bool >*
+RouteTable::_internal_mutable_alive() {
+  return &_impl_.alive_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< bool >*
+RouteTable::mutable_alive() {
+  // @@protoc_insertion_point(field_mutable_list:halakv.RouteTable.alive)
+  return _internal_mutable_alive();
+}
+
+// -------------------------------------------------------------------
+
+// HttpRequest
+
+// -------------------------------------------------------------------
+
+// HttpResponse
+
+// -------------------------------------------------------------------
+
+// MemberUpdate
+
+// required string address = 1;
+inline bool MemberUpdate::_internal_has_address() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool MemberUpdate::has_address() const {
+  return _internal_has_address();
+}
+inline void MemberUpdate::clear_address() {
+  _impl_.address_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& MemberUpdate::address() const {
+  // @@protoc_insertion_point(field_get:halakv.MemberUpdate.address)
+  return _internal_address();
+}
+template <typename ArgT0, typename... ArgT>
 inline PROTOBUF_ALWAYS_INLINE
-void KvRequest::set_key(ArgT0&& arg0, ArgT... args) {
- _has_bits_[0] |= 0x00000001u;
- key_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
-  // @@protoc_insertion_point(field_set:halakv.KvRequest.key)
+void MemberUpdate::set_address(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.address_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.MemberUpdate.address)
 }
-inline std::string* KvRequest::mutable_key() {
-  std::string* _s = _internal_mutable_key();
-  // @@protoc_insertion_point(field_mutable:halakv.KvRequest.key)
+inline std::string* MemberUpdate::mutable_address() {
+  std::string* _s = _internal_mutable_address();
+  // @@protoc_insertion_point(field_mutable:halakv.MemberUpdate.address)
   return _s;
 }
-inline const std::string& KvRequest::_internal_key() const {
-  return key_.Get();
+inline const std::string& MemberUpdate::_internal_address() const {
+  return _impl_.address_.Get();
 }
-inline void KvRequest::_internal_set_key(const std::string& value) {
-  _has_bits_[0] |= 0x00000001u;
-  key_.Set(value, GetArenaForAllocation());
+inline void MemberUpdate::_internal_set_address(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.address_.Set(value, GetArenaForAllocation());
 }
-inline std::string* KvRequest::_internal_mutable_key() {
-  _has_bits_[0] |= 0x00000001u;
-  return key_.Mutable(GetArenaForAllocation());
+inline std::string* MemberUpdate::_internal_mutable_address() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.address_.Mutable(GetArenaForAllocation());
 }
-inline std::string* KvRequest::release_key() {
-  // @@protoc_insertion_point(field_release:halakv.KvRequest.key)
-  if (!_internal_has_key()) {
+inline std::string* MemberUpdate::release_address() {
+  // @@protoc_insertion_point(field_release:halakv.MemberUpdate.address)
+  if (!_internal_has_address()) {
     return nullptr;
   }
-  _has_bits_[0] &= ~0x00000001u;
-  auto* p = key_.Release();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.address_.Release();
 #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (key_.IsDefault()) {
-    key_.Set("", GetArenaForAllocation());
+  if (_impl_.address_.IsDefault()) {
+    _impl_.address_.Set("", GetArenaForAllocation());
   }
 #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   return p;
 }
-inline void KvRequest::set_allocated_key(std::string* key) {
-  if (key != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
+inline void MemberUpdate::set_allocated_address(std::string* address) {
+  if (address != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    _has_bits_[0] &= ~0x00000001u;
+    _impl_._has_bits_[0] &= ~0x00000001u;
   }
-  key_.SetAllocated(key, GetArenaForAllocation());
+  _impl_.address_.SetAllocated(address, GetArenaForAllocation());
 #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (key_.IsDefault()) {
-    key_.Set("", GetArenaForAllocation());
+  if (_impl_.address_.IsDefault()) {
+    _impl_.address_.Set("", GetArenaForAllocation());
   }
 #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  // @@protoc_insertion_point(field_set_allocated:halakv.KvRequest.key)
+  // @@protoc_insertion_point(field_set_allocated:halakv.MemberUpdate.address)
 }
 
-// optional string value = 2;
-inline bool KvRequest::_internal_has_value() const {
-  bool value = (_has_bits_[0] & 0x00000002u) != 0;
+// required uint64 incarnation = 2;
+inline bool MemberUpdate::_internal_has_incarnation() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
   return value;
 }
-inline bool KvRequest::has_value() const {
-  return _internal_has_value();
+inline bool MemberUpdate::has_incarnation() const {
+  return _internal_has_incarnation();
 }
-inline void KvRequest::clear_value() {
-  value_.ClearToEmpty();
-  _has_bits_[0] &= ~0x00000002u;
+inline void MemberUpdate::clear_incarnation() {
+  _impl_.incarnation_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
-inline const std::string& KvRequest::value() const {
-  // @@protoc_insertion_point(field_get:halakv.KvRequest.value)
-  return _internal_value();
+inline uint64_t MemberUpdate::_internal_incarnation() const {
+  return _impl_.incarnation_;
+}
+inline uint64_t MemberUpdate::incarnation() const {
+  // @@protoc_insertion_point(field_get:halakv.MemberUpdate.incarnation)
+  return _internal_incarnation();
+}
+inline void MemberUpdate::_internal_set_incarnation(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.incarnation_ = value;
+}
+inline void MemberUpdate::set_incarnation(uint64_t value) {
+  _internal_set_incarnation(value);
+  // @@protoc_insertion_point(field_set:halakv.MemberUpdate.incarnation)
+}
+
+// required .halakv.MemberState state = 3;
+inline bool MemberUpdate::_internal_has_state() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool MemberUpdate::has_state() const {
+  return _internal_has_state();
+}
+inline void MemberUpdate::clear_state() {
+  _impl_.state_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline ::halakv::MemberState MemberUpdate::_internal_state() const {
+  return static_cast< ::halakv::MemberState >(_impl_.state_);
+}
+inline ::halakv::MemberState MemberUpdate::state() const {
+  // @@protoc_insertion_point(field_get:halakv.MemberUpdate.state)
+  return _internal_state();
+}
+inline void MemberUpdate::_internal_set_state(::halakv::MemberState value) {
+  assert(::halakv::MemberState_IsValid(value));
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.state_ = value;
+}
+inline void MemberUpdate::set_state(::halakv::MemberState value) {
+  _internal_set_state(value);
+  // @@protoc_insertion_point(field_set:halakv.MemberUpdate.state)
+}
+
+// -------------------------------------------------------------------
+
+// GossipRequest
+
+// required string from = 1;
+inline bool GossipRequest::_internal_has_from() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool GossipRequest::has_from() const {
+  return _internal_has_from();
+}
+inline void GossipRequest::clear_from() {
+  _impl_.from_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& GossipRequest::from() const {
+  // @@protoc_insertion_point(field_get:halakv.GossipRequest.from)
+  return _internal_from();
 }
 template <typename ArgT0, typename... ArgT>
 inline PROTOBUF_ALWAYS_INLINE
-void KvRequest::set_value(ArgT0&& arg0, ArgT... args) {
- _has_bits_[0] |= 0x00000002u;
- value_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
-  // @@protoc_insertion_point(field_set:halakv.KvRequest.value)
+void GossipRequest::set_from(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.from_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.GossipRequest.from)
 }
-inline std::string* KvRequest::mutable_value() {
-  std::string* _s = _internal_mutable_value();
-  // @@protoc_insertion_point(field_mutable:halakv.KvRequest.value)
+inline std::string* GossipRequest::mutable_from() {
+  std::string* _s = _internal_mutable_from();
+  // @@protoc_insertion_point(field_mutable:halakv.GossipRequest.from)
   return _s;
 }
-inline const std::string& KvRequest::_internal_value() const {
-  return value_.Get();
+inline const std::string& GossipRequest::_internal_from() const {
+  return _impl_.from_.Get();
 }
-inline void KvRequest::_internal_set_value(const std::string& value) {
-  _has_bits_[0] |= 0x00000002u;
-  value_.Set(value, GetArenaForAllocation());
+inline void GossipRequest::_internal_set_from(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.from_.Set(value, GetArenaForAllocation());
 }
-inline std::string* KvRequest::_internal_mutable_value() {
-  _has_bits_[0] |= 0x00000002u;
-  return value_.Mutable(GetArenaForAllocation());
+inline std::string* GossipRequest::_internal_mutable_from() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.from_.Mutable(GetArenaForAllocation());
 }
-inline std::string* KvRequest::release_value() {
-  // @@protoc_insertion_point(field_release:halakv.KvRequest.value)
-  if (!_internal_has_value()) {
+inline std::string* GossipRequest::release_from() {
+  // @@protoc_insertion_point(field_release:halakv.GossipRequest.from)
+  if (!_internal_has_from()) {
     return nullptr;
   }
-  _has_bits_[0] &= ~0x00000002u;
-  auto* p = value_.Release();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.from_.Release();
 #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (value_.IsDefault()) {
-    value_.Set("", GetArenaForAllocation());
+  if (_impl_.from_.IsDefault()) {
+    _impl_.from_.Set("", GetArenaForAllocation());
   }
 #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   return p;
 }
-inline void KvRequest::set_allocated_value(std::string* value) {
-  if (value != nullptr) {
-    _has_bits_[0] |= 0x00000002u;
+inline void GossipRequest::set_allocated_from(std::string* from) {
+  if (from != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    _has_bits_[0] &= ~0x00000002u;
+    _impl_._has_bits_[0] &= ~0x00000001u;
   }
-  value_.SetAllocated(value, GetArenaForAllocation());
+  _impl_.from_.SetAllocated(from, GetArenaForAllocation());
 #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (value_.IsDefault()) {
-    value_.Set("", GetArenaForAllocation());
+  if (_impl_.from_.IsDefault()) {
+    _impl_.from_.Set("", GetArenaForAllocation());
   }
 #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  // @@protoc_insertion_point(field_set_allocated:halakv.KvRequest.value)
+  // @@protoc_insertion_point(field_set_allocated:halakv.GossipRequest.from)
+}
+
+// optional string target = 2;
+inline bool GossipRequest::_internal_has_target() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool GossipRequest::has_target() const {
+  return _internal_has_target();
+}
+inline void GossipRequest::clear_target() {
+  _impl_.target_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const std::string& GossipRequest::target() const {
+  // @@protoc_insertion_point(field_get:halakv.GossipRequest.target)
+  return _internal_target();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void GossipRequest::set_target(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.target_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.GossipRequest.target)
+}
+inline std::string* GossipRequest::mutable_target() {
+  std::string* _s = _internal_mutable_target();
+  // @@protoc_insertion_point(field_mutable:halakv.GossipRequest.target)
+  return _s;
+}
+inline const std::string& GossipRequest::_internal_target() const {
+  return _impl_.target_.Get();
+}
+inline void GossipRequest::_internal_set_target(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.target_.Set(value, GetArenaForAllocation());
+}
+inline std::string* GossipRequest::_internal_mutable_target() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.target_.Mutable(GetArenaForAllocation());
+}
+inline std::string* GossipRequest::release_target() {
+  // @@protoc_insertion_point(field_release:halakv.GossipRequest.target)
+  if (!_internal_has_target()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.target_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.target_.IsDefault()) {
+    _impl_.target_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void GossipRequest::set_allocated_target(std::string* target) {
+  if (target != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.target_.SetAllocated(target, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.target_.IsDefault()) {
+    _impl_.target_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:halakv.GossipRequest.target)
+}
+
+// repeated .halakv.MemberUpdate updates = 3;
+inline int GossipRequest::_internal_updates_size() const {
+  return _impl_.updates_.size();
+}
+inline int GossipRequest::updates_size() const {
+  return _internal_updates_size();
+}
+inline void GossipRequest::clear_updates() {
+  _impl_.updates_.Clear();
+}
+inline ::halakv::MemberUpdate* GossipRequest::mutable_updates(int index) {
+  // @@protoc_insertion_point(field_mutable:halakv.GossipRequest.updates)
+  return _impl_.updates_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::MemberUpdate >*
+GossipRequest::mutable_updates() {
+  // @@protoc_insertion_point(field_mutable_list:halakv.GossipRequest.updates)
+  return &_impl_.updates_;
+}
+inline const ::halakv::MemberUpdate& GossipRequest::_internal_updates(int index) const {
+  return _impl_.updates_.Get(index);
+}
+inline const ::halakv::MemberUpdate& GossipRequest::updates(int index) const {
+  // @@protoc_insertion_point(field_get:halakv.GossipRequest.updates)
+  return _internal_updates(index);
+}
+inline ::halakv::MemberUpdate* GossipRequest::_internal_add_updates() {
+  return _impl_.updates_.Add();
+}
+inline ::halakv::MemberUpdate* GossipRequest::add_updates() {
+  ::halakv::MemberUpdate* _add = _internal_add_updates();
+  // @@protoc_insertion_point(field_add:halakv.GossipRequest.updates)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::MemberUpdate >&
+GossipRequest::updates() const {
+  // @@protoc_insertion_point(field_list:halakv.GossipRequest.updates)
+  return _impl_.updates_;
+}
+
+// optional uint64 clock = 4;
+inline bool GossipRequest::_internal_has_clock() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool GossipRequest::has_clock() const {
+  return _internal_has_clock();
+}
+inline void GossipRequest::clear_clock() {
+  _impl_.clock_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline uint64_t GossipRequest::_internal_clock() const {
+  return _impl_.clock_;
+}
+inline uint64_t GossipRequest::clock() const {
+  // @@protoc_insertion_point(field_get:halakv.GossipRequest.clock)
+  return _internal_clock();
+}
+inline void GossipRequest::_internal_set_clock(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.clock_ = value;
+}
+inline void GossipRequest::set_clock(uint64_t value) {
+  _internal_set_clock(value);
+  // @@protoc_insertion_point(field_set:halakv.GossipRequest.clock)
 }
 
 // -------------------------------------------------------------------
 
-// KvResponse
+// GossipResponse
 
 // required int32 code = 1;
-inline bool KvResponse::_internal_has_code() const {
-  bool value = (_has_bits_[0] & 0x00000004u) != 0;
+inline bool GossipResponse::_internal_has_code() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
   return value;
 }
-inline bool KvResponse::has_code() const {
+inline bool GossipResponse::has_code() const {
   return _internal_has_code();
 }
-inline void KvResponse::clear_code() {
-  code_ = 0;
-  _has_bits_[0] &= ~0x00000004u;
+inline void GossipResponse::clear_code() {
+  _impl_.code_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000004u;
 }
-inline int32_t KvResponse::_internal_code() const {
-  return code_;
+inline int32_t GossipResponse::_internal_code() const {
+  return _impl_.code_;
 }
-inline int32_t KvResponse::code() const {
-  // @@protoc_insertion_point(field_get:halakv.KvResponse.code)
+inline int32_t GossipResponse::code() const {
+  // @@protoc_insertion_point(field_get:halakv.GossipResponse.code)
   return _internal_code();
 }
-inline void KvResponse::_internal_set_code(int32_t value) {
-  _has_bits_[0] |= 0x00000004u;
-  code_ = value;
+inline void GossipResponse::_internal_set_code(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.code_ = value;
 }
-inline void KvResponse::set_code(int32_t value) {
+inline void GossipResponse::set_code(int32_t value) {
   _internal_set_code(value);
-  // @@protoc_insertion_point(field_set:halakv.KvResponse.code)
+  // @@protoc_insertion_point(field_set:halakv.GossipResponse.code)
 }
 
 // required string message = 2;
-inline bool KvResponse::_internal_has_message() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
+inline bool GossipResponse::_internal_has_message() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
-inline bool KvResponse::has_message() const {
+inline bool GossipResponse::has_message() const {
   return _internal_has_message();
 }
-inline void KvResponse::clear_message() {
-  message_.ClearToEmpty();
-  _has_bits_[0] &= ~0x00000001u;
+inline void GossipResponse::clear_message() {
+  _impl_.message_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
-inline const std::string& KvResponse::message() const {
-  // @@protoc_insertion_point(field_get:halakv.KvResponse.message)
+inline const std::string& GossipResponse::message() const {
+  // @@protoc_insertion_point(field_get:halakv.GossipResponse.message)
   return _internal_message();
 }
 template <typename ArgT0, typename... ArgT>
 inline PROTOBUF_ALWAYS_INLINE
-void KvResponse::set_message(ArgT0&& arg0, ArgT... args) {
- _has_bits_[0] |= 0x00000001u;
- message_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
-  // @@protoc_insertion_point(field_set:halakv.KvResponse.message)
+void GossipResponse::set_message(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.message_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:halakv.GossipResponse.message)
 }
-inline std::string* KvResponse::mutable_message() {
+inline std::string* GossipResponse::mutable_message() {
   std::string* _s = _internal_mutable_message();
-  // @@protoc_insertion_point(field_mutable:halakv.KvResponse.message)
+  // @@protoc_insertion_point(field_mutable:halakv.GossipResponse.message)
   return _s;
 }
-inline const std::string& KvResponse::_internal_message() const {
-  return message_.Get();
+inline const std::string& GossipResponse::_internal_message() const {
+  return _impl_.message_.Get();
 }
-inline void KvResponse::_internal_set_message(const std::string& value) {
-  _has_bits_[0] |= 0x00000001u;
-  message_.Set(value, GetArenaForAllocation());
+inline void GossipResponse::_internal_set_message(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.message_.Set(value, GetArenaForAllocation());
 }
-inline std::string* KvResponse::_internal_mutable_message() {
-  _has_bits_[0] |= 0x00000001u;
-  return message_.Mutable(GetArenaForAllocation());
+inline std::string* GossipResponse::_internal_mutable_message() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.message_.Mutable(GetArenaForAllocation());
 }
-inline std::string* KvResponse::release_message() {
-  // @@protoc_insertion_point(field_release:halakv.KvResponse.message)
+inline std::string* GossipResponse::release_message() {
+  // @@protoc_insertion_point(field_release:halakv.GossipResponse.message)
   if (!_internal_has_message()) {
     return nullptr;
   }
-  _has_bits_[0] &= ~0x00000001u;
-  auto* p = message_.Release();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.message_.Release();
 #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (message_.IsDefault()) {
-    message_.Set("", GetArenaForAllocation());
+  if (_impl_.message_.IsDefault()) {
+    _impl_.message_.Set("", GetArenaForAllocation());
   }
 #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   return p;
 }
-inline void KvResponse::set_allocated_message(std::string* message) {
+inline void GossipResponse::set_allocated_message(std::string* message) {
   if (message != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    _has_bits_[0] &= ~0x00000001u;
+    _impl_._has_bits_[0] &= ~0x00000001u;
   }
-  message_.SetAllocated(message, GetArenaForAllocation());
+  _impl_.message_.SetAllocated(message, GetArenaForAllocation());
 #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (message_.IsDefault()) {
-    message_.Set("", GetArenaForAllocation());
+  if (_impl_.message_.IsDefault()) {
+    _impl_.message_.Set("", GetArenaForAllocation());
   }
 #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  // @@protoc_insertion_point(field_set_allocated:halakv.KvResponse.message)
+  // @@protoc_insertion_point(field_set_allocated:halakv.GossipResponse.message)
 }
 
-// optional string value = 3;
-inline bool KvResponse::_internal_has_value() const {
-  bool value = (_has_bits_[0] & 0x00000002u) != 0;
-  return value;
+// repeated .halakv.MemberUpdate updates = 3;
+inline int GossipResponse::_internal_updates_size() const {
+  return _impl_.updates_.size();
 }
-inline bool KvResponse::has_value() const {
-  return _internal_has_value();
+inline int GossipResponse::updates_size() const {
+  return _internal_updates_size();
 }
-inline void KvResponse::clear_value() {
-  value_.ClearToEmpty();
-  _has_bits_[0] &= ~0x00000002u;
+inline void GossipResponse::clear_updates() {
+  _impl_.updates_.Clear();
 }
-inline const std::string& KvResponse::value() const {
-  // @@protoc_insertion_point(field_get:halakv.KvResponse.value)
-  return _internal_value();
+inline ::halakv::MemberUpdate* GossipResponse::mutable_updates(int index) {
+  // @@protoc_insertion_point(field_mutable:halakv.GossipResponse.updates)
+  return _impl_.updates_.Mutable(index);
 }
-template <typename ArgT0, typename... ArgT>
-inline PROTOBUF_ALWAYS_INLINE
-void KvResponse::set_value(ArgT0&& arg0, ArgT... args) {
- _has_bits_[0] |= 0x00000002u;
- value_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
-  // @@protoc_insertion_point(field_set:halakv.KvResponse.value)
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::MemberUpdate >*
+GossipResponse::mutable_updates() {
+  // @@protoc_insertion_point(field_mutable_list:halakv.GossipResponse.updates)
+  return &_impl_.updates_;
 }
-inline std::string* KvResponse::mutable_value() {
-  std::string* _s = _internal_mutable_value();
-  // @@protoc_insertion_point(field_mutable:halakv.KvResponse.value)
-  return _s;
+inline const ::halakv::MemberUpdate& GossipResponse::_internal_updates(int index) const {
+  return _impl_.updates_.Get(index);
 }
-inline const std::string& KvResponse::_internal_value() const {
-  return value_.Get();
+inline const ::halakv::MemberUpdate& GossipResponse::updates(int index) const {
+  // @@protoc_insertion_point(field_get:halakv.GossipResponse.updates)
+  return _internal_updates(index);
 }
-inline void KvResponse::_internal_set_value(const std::string& value) {
-  _has_bits_[0] |= 0x00000002u;
-  value_.Set(value, GetArenaForAllocation());
+inline ::halakv::MemberUpdate* GossipResponse::_internal_add_updates() {
+  return _impl_.updates_.Add();
 }
-inline std::string* KvResponse::_internal_mutable_value() {
-  _has_bits_[0] |= 0x00000002u;
-  return value_.Mutable(GetArenaForAllocation());
+inline ::halakv::MemberUpdate* GossipResponse::add_updates() {
+  ::halakv::MemberUpdate* _add = _internal_add_updates();
+  // @@protoc_insertion_point(field_add:halakv.GossipResponse.updates)
+  return _add;
 }
-inline std::string* KvResponse::release_value() {
-  // @@protoc_insertion_point(field_release:halakv.KvResponse.value)
-  if (!_internal_has_value()) {
-    return nullptr;
-  }
-  _has_bits_[0] &= ~0x00000002u;
-  auto* p = value_.Release();
-#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (value_.IsDefault()) {
-    value_.Set("", GetArenaForAllocation());
-  }
-#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  return p;
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::halakv::MemberUpdate >&
+GossipResponse::updates() const {
+  // @@protoc_insertion_point(field_list:halakv.GossipResponse.updates)
+  return _impl_.updates_;
 }
-inline void KvResponse::set_allocated_value(std::string* value) {
-  if (value != nullptr) {
-    _has_bits_[0] |= 0x00000002u;
-  } else {
-    _has_bits_[0] &= ~0x00000002u;
-  }
-  value_.SetAllocated(value, GetArenaForAllocation());
-#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (value_.IsDefault()) {
-    value_.Set("", GetArenaForAllocation());
-  }
-#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  // @@protoc_insertion_point(field_set_allocated:halakv.KvResponse.value)
+
+// optional uint64 clock = 4;
+inline bool GossipResponse::_internal_has_clock() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool GossipResponse::has_clock() const {
+  return _internal_has_clock();
+}
+inline void GossipResponse::clear_clock() {
+  _impl_.clock_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline uint64_t GossipResponse::_internal_clock() const {
+  return _impl_.clock_;
+}
+inline uint64_t GossipResponse::clock() const {
+  // @@protoc_insertion_point(field_get:halakv.GossipResponse.clock)
+  return _internal_clock();
+}
+inline void GossipResponse::_internal_set_clock(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.clock_ = value;
+}
+inline void GossipResponse::set_clock(uint64_t value) {
+  _internal_set_clock(value);
+  // @@protoc_insertion_point(field_set:halakv.GossipResponse.clock)
 }
 
 #ifdef __GNUC__
@@ -832,11 +9512,71 @@ inline void KvResponse::set_allocated_value(std::string* value) {
 #endif  // __GNUC__
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
 }  // namespace halakv
 
+PROTOBUF_NAMESPACE_OPEN
+
+template <> struct is_proto_enum< ::halakv::MemberState> : ::std::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::halakv::MemberState>() {
+  return ::halakv::MemberState_descriptor();
+}
+
+PROTOBUF_NAMESPACE_CLOSE
+
 // @@protoc_insertion_point(global_scope)
 
 #include <google/protobuf/port_undef.inc>
@@ -0,0 +1,405 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-4.
+//
+#include <halakv/kv_client.h>
+#include <halakv/key_hash.h>
+#include <halakv/fiber.h>
+#include <turbo/log/logging.h>
+#include <turbo/strings/str_split.h>
+#include <turbo/strings/substitute.h>
+#include <algorithm>
+#include <cerrno>
+
+namespace halakv {
+
+    turbo::Status KvClient::init(const KvClientOptions &options) {
+        _options = options;
+        _seeds = turbo::str_split(options.servers, ",", turbo::SkipEmpty());
+        if (_seeds.empty()) {
+            return turbo::invalid_argument_error("no server");
+        }
+        std::atomic_store(&_table, std::make_shared<const Table>());
+        auto rs = refresh();
+        if (!rs.ok()) {
+            // served through the seeds until a table is fetched.
+            LOG(WARNING) << "fetch route table failed: " << rs;
+        }
+        return turbo::OkStatus();
+    }
+
+    turbo::Status KvClient::set(const halakv::KvRequest &request, halakv::KvResponse *response) {
+        return call(Op::kSet, request, response);
+    }
+
+    turbo::Status KvClient::get(const halakv::KvRequest &request, halakv::KvResponse *response) {
+        return call(Op::kGet, request, response);
+    }
+
+    turbo::Status KvClient::remove(const halakv::KvRequest &request, halakv::KvResponse *response) {
+        return call(Op::kRemove, request, response);
+    }
+
+    void KvClient::async_set(const halakv::KvRequest &request, Callback done) {
+        async_call(Op::kSet, request, std::move(done));
+    }
+
+    void KvClient::async_get(const halakv::KvRequest &request, Callback done) {
+        async_call(Op::kGet, request, std::move(done));
+    }
+
+    void KvClient::async_remove(const halakv::KvRequest &request, Callback done) {
+        async_call(Op::kRemove, request, std::move(done));
+    }
+
+    turbo::Status KvClient::mset(const halakv::MultiKvRequest &request, halakv::MultiKvResponse *response) {
+        return multi_call(Op::kSet, request, response);
+    }
+
+    turbo::Status KvClient::mget(const halakv::MultiKvRequest &request, halakv::MultiKvResponse *response) {
+        return multi_call(Op::kGet, request, response);
+    }
+
+    turbo::Status KvClient::mremove(const halakv::MultiKvRequest &request, halakv::MultiKvResponse *response) {
+        return multi_call(Op::kRemove, request, response);
+    }
+
+    uint64_t KvClient::epoch() {
+        return table()->epoch;
+    }
+
+    turbo::Status KvClient::refresh(const std::string &server) {
+        std::unique_lock lock(_refresh_mutex);
+        return refresh_locked(server);
+    }
+
+    void KvClient::on_redirect(const std::string &server, uint64_t epoch) {
+        std::unique_lock lock(_refresh_mutex);
+        if (table()->epoch == epoch) {
+            // refreshed by another call meanwhile.
+            return;
+        }
+        auto rs = refresh_locked(server);
+        if (!rs.ok()) {
+            VLOG(10) << "refresh route table from " << server << " failed: " << rs;
+        }
+    }
+
+    turbo::Status KvClient::refresh_locked(const std::string &server) {
+        std::vector<std::string> servers;
+        if (server.empty()) {
+            servers = _seeds;
+        } else {
+            servers.push_back(server);
+        }
+        turbo::Status rs = turbo::unavailable_error("no server to fetch the route table");
+        for (auto &address: servers) {
+            auto channel = get_channel(address);
+            if (channel == nullptr) {
+                continue;
+            }
+            halakv::KvService_Stub stub(channel.get());
+            halakv::RouteRequest request;
+            halakv::RouteTable response;
+            melon::Controller cntl;
+            stub.route(&cntl, &request, &response, nullptr);
+            if (cntl.Failed()) {
+                rs = turbo::unavailable_error(turbo::substitute("fetch route table from $0 failed: $1", address,
+                                                                cntl.ErrorText()));
+                continue;
+            }
+            if (response.hash_scheme() != kHashScheme) {
+                return turbo::unimplemented_error(turbo::substitute("hash scheme $0 of $1 is not supported",
+                                                                    response.hash_scheme(), address));
+            }
+            if (response.peers_size() == 0 || response.peers_size() != response.alive_size()) {
+                return turbo::internal_error(turbo::substitute("bad route table from $0", address));
+            }
+            auto table = std::make_shared<Table>();
+            table->epoch = response.epoch();
+            table->peers.assign(response.peers().begin(), response.peers().end());
+            table->alive.assign(response.alive().begin(), response.alive().end());
+            for (auto &peer: table->peers) {
+                table->hashes.push_back(key_hash(peer));
+            }
+            std::atomic_store(&_table, std::shared_ptr<const Table>(std::move(table)));
+            VLOG(10) << "route table of epoch " << response.epoch() << " from " << address;
+            return turbo::OkStatus();
+        }
+        return rs;
+    }
+
+    std::shared_ptr<const KvClient::Table> KvClient::table() {
+        return std::atomic_load(&_table);
+    }
+
+    const std::string &KvClient::owner(const Table &table, std::string_view key) {
+        auto &peers = table.peers;
+        auto pos = owner_of(key, table.hashes);
+        for (size_t i = 0; i < peers.size(); i++) {
+            auto at = (pos + i) % peers.size();
+            if (table.alive[at]) {
+                return peers[at];
+            }
+        }
+        return peers[pos];
+    }
+
+    std::string KvClient::fallback(const Table &table, const std::string &failed) const {
+        for (size_t i = 0; i < table.peers.size(); i++) {
+            if (table.alive[i] && table.peers[i] != failed) {
+                return table.peers[i];
+            }
+        }
+        for (auto &seed: _seeds) {
+            if (seed != failed) {
+                return seed;
+            }
+        }
+        return std::string();
+    }
+
+    std::shared_ptr<melon::Channel> KvClient::get_channel(const std::string &server) {
+        std::unique_lock lock(_channel_mutex);
+        auto it = _channels.find(server);
+        if (it != _channels.end()) {
+            return it->second;
+        }
+        melon::ChannelOptions options;
+        options.timeout_ms = _options.timeout_ms;
+        options.connection_type = _options.connection_type;
+        auto channel = std::make_shared<melon::Channel>();
+        if (channel->Init(server.c_str(), &options) != 0) {
+            LOG(WARNING) << "init channel to " << server << " failed";
+            return nullptr;
+        }
+        _channels[server] = channel;
+        return channel;
+    }
+
+    turbo::Status KvClient::call(Op op, const halakv::KvRequest &request, halakv::KvResponse *response) {
+        halakv::KvRequest item = request;
+        for (int i = 0; i <= _options.max_redirects; i++) {
+            auto table = this->table();
+            if (table->peers.empty()) {
+                item.clear_epoch();
+                return send(op, _seeds.front(), item, response);
+            }
+            auto &server = owner(*table, scoped_key(item.ns(), item.key()));
+            item.set_epoch(table->epoch);
+            auto rs = send(op, server, item, response);
+            if (!rs.ok() && rs.code() != turbo::StatusCode::kUnavailable) {
+                // a shed or a timeout is the answer of a live owner.
+                return rs;
+            }
+            if (!rs.ok()) {
+                // the owner may be down, another peer forwards it to the backup.
+                auto other = fallback(*table, server);
+                if (other.empty()) {
+                    return rs;
+                }
+                VLOG(10) << "call to owner " << server << " failed, forward by " << other << ": " << rs;
+                item.clear_epoch();
+                rs = send(op, other, item, response);
+                // the table may tell the owner is dead by now.
+                auto refreshed = refresh(other);
+                if (!refreshed.ok()) {
+                    VLOG(10) << "refresh route table from " << other << " failed: " << refreshed;
+                }
+                return rs;
+            }
+            if (!response->has_redirect()) {
+                return turbo::OkStatus();
+            }
+            on_redirect(server, response->epoch());
+        }
+        return turbo::aborted_error(turbo::substitute("key $0 still redirected after $1 tries", request.key(),
+                                                      _options.max_redirects + 1));
+    }
+
+    turbo::Status KvClient::multi_call(Op op, const halakv::MultiKvRequest &request,
+                                       halakv::MultiKvResponse *response) {
+        const int n = request.requests_size();
+        response->Clear();
+        response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+        response->set_message("ok");
+        for (int i = 0; i < n; i++) {
+            response->add_responses();
+        }
+        std::vector<int> pending(n);
+        for (int i = 0; i < n; i++) {
+            pending[i] = i;
+        }
+        turbo::Status rs;
+        for (int round = 0; !pending.empty(); round++) {
+            auto table = this->table();
+            // with no table or after too many redirects the keys are forwarded by one peer.
+            const bool forward = table->peers.empty() || round > _options.max_redirects;
+            const std::string forwarder = table->peers.empty() ? _seeds.front() : fallback(*table, std::string());
+            std::unordered_map<std::string, std::vector<int>> groups;
+            for (auto i: pending) {
+                auto &item = request.requests(i);
+                groups[forward ? forwarder : owner(*table, scoped_key(item.ns(), item.key()))].push_back(i);
+            }
+            std::vector<std::string> servers;
+            for (auto &it: groups) {
+                servers.push_back(it.first);
+            }
+            std::vector<halakv::MultiKvRequest> sub_requests(servers.size());
+            std::vector<halakv::MultiKvResponse> sub_responses(servers.size());
+            std::vector<turbo::Status> sub_status(servers.size());
+            std::vector<Fiber> fibers(servers.size());
+            for (size_t g = 0; g < servers.size(); g++) {
+                for (auto i: groups[servers[g]]) {
+                    auto *item = sub_requests[g].add_requests();
+                    *item = request.requests(i);
+                    if (!forward) {
+                        item->set_epoch(table->epoch);
+                    }
+                }
+                fibers[g].run([this, op, g, &servers, &table, &sub_requests, &sub_responses, &sub_status]() {
+                    auto st = send(op, servers[g], sub_requests[g], &sub_responses[g]);
+                    auto other = fallback(*table, servers[g]);
+                    if (st.code() == turbo::StatusCode::kUnavailable && !other.empty()) {
+                        for (auto &item: *sub_requests[g].mutable_requests()) {
+                            item.clear_epoch();
+                        }
+                        st = send(op, other, sub_requests[g], &sub_responses[g]);
+                    }
+                    sub_status[g] = st;
+                });
+            }
+            std::vector<int> redirected;
+            std::string redirect_server;
+            uint64_t redirect_epoch = 0;
+            for (size_t g = 0; g < servers.size(); g++) {
+                fibers[g].join();
+                auto &group = groups[servers[g]];
+                auto st = sub_status[g];
+                if (st.ok() && sub_responses[g].responses_size() != static_cast<int>(group.size())) {
+                    st = turbo::internal_error(turbo::substitute("$0 returned $1 results for $2 keys", servers[g],
+                                                                 sub_responses[g].responses_size(), group.size()));
+                }
+                for (size_t k = 0; k < group.size(); k++) {
+                    auto *item = response->mutable_responses(group[k]);
+                    if (!st.ok()) {
+                        item->set_code(static_cast<int>(st.code()));
+                        item->set_message(std::string(st.message()));
+                        continue;
+                    }
+                    auto &sub = sub_responses[g].responses(k);
+                    if (sub.has_redirect()) {
+                        redirected.push_back(group[k]);
+                        redirect_server = servers[g];
+                        redirect_epoch = sub.epoch();
+                        continue;
+                    }
+                    *item = sub;
+                }
+                if (!st.ok() && rs.ok()) {
+                    rs = st;
+                }
+            }
+            if (!redirected.empty()) {
+                on_redirect(redirect_server, redirect_epoch);
+            }
+            pending.swap(redirected);
+        }
+        return rs;
+    }
+
+    void KvClient::async_call(Op op, const halakv::KvRequest &request, Callback done) {
+        Fiber fiber;
+        fiber.run([this, op, request, done]() {
+            halakv::KvResponse response;
+            auto rs = call(op, request, &response);
+            done(rs, response);
+        });
+    }
+
+    // unavailable only when the server could not take the call, the one error
+    // another peer is asked for.
+    static turbo::Status status_of(const std::string &server, const melon::Controller &cntl) {
+        if (!cntl.Failed()) {
+            return turbo::OkStatus();
+        }
+        switch (cntl.ErrorCode()) {
+            case EHOSTDOWN:
+            case ECONNREFUSED:
+            case ECONNRESET:
+            case melon::ELOGOFF:
+                return turbo::unavailable_error(turbo::substitute("call $0 failed: $1", server, cntl.ErrorText()));
+            case melon::ELIMIT:
+                return turbo::resource_exhausted_error(turbo::substitute("$0 shed the request: $1", server,
+                                                                         cntl.ErrorText()));
+            case melon::ERPCTIMEDOUT:
+                return turbo::deadline_exceeded_error(turbo::substitute("call $0 timed out: $1", server,
+                                                                        cntl.ErrorText()));
+            default:
+                return turbo::internal_error(turbo::substitute("call $0 failed: $1", server, cntl.ErrorText()));
+        }
+    }
+
+    turbo::Status KvClient::send(Op op, const std::string &server, const halakv::KvRequest &request,
+                                 halakv::KvResponse *response) {
+        auto channel = get_channel(server);
+        if (channel == nullptr) {
+            return turbo::unavailable_error(turbo::substitute("no channel to $0", server));
+        }
+        halakv::KvService_Stub stub(channel.get());
+        melon::Controller cntl;
+        response->Clear();
+        switch (op) {
+            case Op::kSet:
+                stub.set(&cntl, &request, response, nullptr);
+                break;
+            case Op::kGet:
+                stub.get(&cntl, &request, response, nullptr);
+                break;
+            case Op::kRemove:
+                stub.remove(&cntl, &request, response, nullptr);
+                break;
+        }
+        return status_of(server, cntl);
+    }
+
+    turbo::Status KvClient::send(Op op, const std::string &server, const halakv::MultiKvRequest &request,
+                                 halakv::MultiKvResponse *response) {
+        auto channel = get_channel(server);
+        if (channel == nullptr) {
+            return turbo::unavailable_error(turbo::substitute("no channel to $0", server));
+        }
+        halakv::KvService_Stub stub(channel.get());
+        melon::Controller cntl;
+        response->Clear();
+        switch (op) {
+            case Op::kSet:
+                stub.mset(&cntl, &request, response, nullptr);
+                break;
+            case Op::kGet:
+                stub.mget(&cntl, &request, response, nullptr);
+                break;
+            case Op::kRemove:
+                stub.mremove(&cntl, &request, response, nullptr);
+                break;
+        }
+        return status_of(server, cntl);
+    }
+
+}  // namespace halakv
@@ -0,0 +1,139 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-4.
+//
+#pragma once
+
+#include <melon/rpc/channel.h>
+#include <melon/rpc/controller.h>
+#include <turbo/utility/status.h>
+#include <halakv/kv.pb.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace halakv {
+
+    struct KvClientOptions {
+        // comma separated servers, the route table is fetched from them.
+        std::string servers;
+        int timeout_ms{100};
+        // single, pooled or short.
+        std::string connection_type{"pooled"};
+        // redirects followed before a call fails, each refreshes the route table.
+        int max_redirects{3};
+    };
+
+    // KvClient sends each key straight to the peer owning it, by the route table
+    // of the cluster, instead of through one server forwarding it. requests carry
+    // the epoch of the table, a server not owning the key answers with the owner
+    // and its epoch, the table is fetched again and the request resent. a call
+    // the owner can not take is sent without epoch to another peer, which
+    // forwards it like for any plain client.
+    class KvClient {
+    public:
+        using Callback = std::function<void(const turbo::Status &, const halakv::KvResponse &)>;
+
+        KvClient() = default;
+
+        turbo::Status init(const KvClientOptions &options);
+
+        // the status is the one of the rpc, the result of the key is in the response.
+        turbo::Status set(const halakv::KvRequest &request, halakv::KvResponse *response);
+
+        turbo::Status get(const halakv::KvRequest &request, halakv::KvResponse *response);
+
+        turbo::Status remove(const halakv::KvRequest &request, halakv::KvResponse *response);
+
+        // done is called in a fiber once the call and its redirects are over.
+        void async_set(const halakv::KvRequest &request, Callback done);
+
+        void async_get(const halakv::KvRequest &request, Callback done);
+
+        void async_remove(const halakv::KvRequest &request, Callback done);
+
+        // the keys are grouped by owner and sent in parallel, the responses are
+        // in request order.
+        turbo::Status mset(const halakv::MultiKvRequest &request, halakv::MultiKvResponse *response);
+
+        turbo::Status mget(const halakv::MultiKvRequest &request, halakv::MultiKvResponse *response);
+
+        turbo::Status mremove(const halakv::MultiKvRequest &request, halakv::MultiKvResponse *response);
+
+        uint64_t epoch();
+
+        // fetch the route table from server, or the first seed answering if empty.
+        turbo::Status refresh(const std::string &server = "");
+
+    private:
+        enum class Op {
+            kSet,
+            kGet,
+            kRemove
+        };
+
+        struct Table {
+            uint64_t epoch{0};
+            std::vector<std::string> peers;
+            std::vector<bool> alive;
+            std::vector<uint64_t> hashes;
+        };
+
+        std::shared_ptr<const Table> table();
+
+        // the first alive peer from the owner of the key on, like the servers do.
+        // keys in a namespace are hashed as stored, see scoped_key.
+        static const std::string &owner(const Table &table, std::string_view key);
+
+        // another server to forward a call the owner could not take.
+        std::string fallback(const Table &table, const std::string &failed) const;
+
+        void on_redirect(const std::string &server, uint64_t epoch);
+
+        turbo::Status refresh_locked(const std::string &server);
+
+        std::shared_ptr<melon::Channel> get_channel(const std::string &server);
+
+        turbo::Status call(Op op, const halakv::KvRequest &request, halakv::KvResponse *response);
+
+        turbo::Status multi_call(Op op, const halakv::MultiKvRequest &request, halakv::MultiKvResponse *response);
+
+        void async_call(Op op, const halakv::KvRequest &request, Callback done);
+
+        turbo::Status send(Op op, const std::string &server, const halakv::KvRequest &request,
+                           halakv::KvResponse *response);
+
+        turbo::Status send(Op op, const std::string &server, const halakv::MultiKvRequest &request,
+                           halakv::MultiKvResponse *response);
+
+    private:
+        KvClientOptions _options;
+        std::vector<std::string> _seeds;
+        std::shared_ptr<const Table> _table;
+        // one refresh at a time, the others wait for it and find the table current.
+        std::mutex _refresh_mutex;
+        std::mutex _channel_mutex;
+        std::unordered_map<std::string, std::shared_ptr<melon::Channel>> _channels;
+    };
+
+}  // namespace halakv
@@ -0,0 +1,183 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-7.
+//
+#include <halakv/kv_json.h>
+#include <charconv>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace halakv {
+
+    namespace {
+
+        // the escape of a byte, 'u' for \u00XX and 0 for none, as json2pb writes them.
+        struct EscapeTable {
+            char table[256]{};
+
+            constexpr EscapeTable() {
+                for (int c = 0; c < 0x20; c++) {
+                    table[c] = 'u';
+                }
+                table['\b'] = 'b';
+                table['\t'] = 't';
+                table['\n'] = 'n';
+                table['\f'] = 'f';
+                table['\r'] = 'r';
+                table['"'] = '"';
+                table['\\'] = '\\';
+            }
+        };
+
+        constexpr EscapeTable kEscape;
+        constexpr char kHexDigits[] = "0123456789ABCDEF";
+
+        // the length of the prefix of s needing no escape.
+        size_t clean_prefix(const char *s, size_t n) {
+            size_t i = 0;
+#if defined(__SSE2__)
+            const __m128i quote = _mm_set1_epi8('"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            // control bytes are the ones below 0x20, unsigned, found by saturating.
+            const __m128i space = _mm_set1_epi8(0x1f);
+            for (; i + 16 <= n; i += 16) {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+                __m128i control = _mm_cmpeq_epi8(_mm_subs_epu8(chunk, space), _mm_setzero_si128());
+                __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+                int mask = _mm_movemask_epi8(_mm_or_si128(control, special));
+                if (mask != 0) {
+                    return i + __builtin_ctz(static_cast<unsigned>(mask));
+                }
+            }
+#endif
+            for (; i < n; i++) {
+                if (kEscape.table[static_cast<uint8_t>(s[i])] != 0) {
+                    break;
+                }
+            }
+            return i;
+        }
+
+        // Out is a std::string or a mutil::IOBufAppender.
+        template<typename Out>
+        void append_raw(std::string_view s, Out *out) {
+            out->append(s.data(), s.size());
+        }
+
+        template<typename Out>
+        void escape(std::string_view s, Out *out) {
+            const char *p = s.data();
+            size_t n = s.size();
+            while (n > 0) {
+                auto clean = clean_prefix(p, n);
+                append_raw(std::string_view(p, clean), out);
+                p += clean;
+                n -= clean;
+                if (n == 0) {
+                    break;
+                }
+                auto c = static_cast<uint8_t>(*p);
+                auto code = kEscape.table[c];
+                out->push_back('\\');
+                out->push_back(code);
+                if (code == 'u') {
+                    append_raw("00", out);
+                    out->push_back(kHexDigits[c >> 4]);
+                    out->push_back(kHexDigits[c & 0xf]);
+                }
+                ++p;
+                --n;
+            }
+        }
+
+        template<typename Out>
+        void append_string(std::string_view s, Out *out) {
+            out->push_back('"');
+            escape(s, out);
+            out->push_back('"');
+        }
+
+        template<typename T, typename Out>
+        void append_number(T value, Out *out) {
+            char buf[24];
+            auto result = std::to_chars(buf, buf + sizeof(buf), value);
+            append_raw(std::string_view(buf, result.ptr - buf), out);
+        }
+
+        template<typename Out>
+        void append_response(const halakv::KvResponse &response, const std::string_view *key, Out *out) {
+            if (key != nullptr) {
+                append_raw(R"({"key":)", out);
+                append_string(*key, out);
+                append_raw(",", out);
+            } else {
+                append_raw("{", out);
+            }
+            // fields in the order of the proto, unset optional ones are left out.
+            append_raw(R"("code":)", out);
+            append_number(response.code(), out);
+            append_raw(R"(,"message":)", out);
+            append_string(response.message(), out);
+            if (response.has_value()) {
+                append_raw(R"(,"value":)", out);
+                append_string(response.value(), out);
+            }
+            if (response.has_redirect()) {
+                append_raw(R"(,"redirect":)", out);
+                append_string(response.redirect(), out);
+            }
+            if (response.has_epoch()) {
+                append_raw(R"(,"epoch":)", out);
+                append_number(response.epoch(), out);
+            }
+            if (response.has_expire_at_us()) {
+                append_raw(R"(,"expire_at_us":)", out);
+                append_number(response.expire_at_us(), out);
+            }
+            if (response.has_version()) {
+                append_raw(R"(,"version":)", out);
+                append_number(response.version(), out);
+            }
+            out->push_back('}');
+        }
+
+    }  // namespace
+
+    void append_json_escaped(std::string_view s, std::string *out) {
+        escape(s, out);
+    }
+
+    void append_json(const halakv::KvResponse &response, std::string *out) {
+        append_response(response, nullptr, out);
+    }
+
+    void write_json(const halakv::KvResponse &response, mutil::IOBuf *out) {
+        // written into the blocks of the buf, no string in between.
+        mutil::IOBufAppender appender;
+        append_response(response, nullptr, &appender);
+        appender.move_to(*out);
+    }
+
+    void append_json_line(std::string_view key, const halakv::KvResponse &response, std::string *out) {
+        append_response(response, &key, out);
+        out->push_back('\n');
+    }
+
+}  // namespace halakv
@@ -0,0 +1,44 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-7.
+//
+#pragma once
+
+#include <halakv/kv.pb.h>
+#include <melon/utility/iobuf.h>
+#include <string>
+#include <string_view>
+
+namespace halakv {
+
+    // escapes s as a json string body the way json2pb does: quote, backslash
+    // and control bytes are escaped, the rest, utf-8 included, is copied as is.
+    // the clean runs are found 16 bytes at a time with sse2 where available.
+    void append_json_escaped(std::string_view s, std::string *out);
+
+    // the json of a KvResponse, byte for byte what json2pb::ProtoMessageToJson
+    // gives, without going through reflection.
+    void append_json(const halakv::KvResponse &response, std::string *out);
+
+    void write_json(const halakv::KvResponse &response, mutil::IOBuf *out);
+
+    // a line of a ndjson batch, the key ahead of the fields of the response.
+    void append_json_line(std::string_view key, const halakv::KvResponse &response, std::string *out);
+
+}  // namespace halakv
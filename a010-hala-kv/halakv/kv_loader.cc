@@ -0,0 +1,165 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-12.
+//
+#include <halakv/kv_loader.h>
+#include <melon/rpc/controller.h>
+#include <melon/utility/time.h>
+#include <turbo/log/logging.h>
+#include <turbo/strings/substitute.h>
+#include <chrono>
+
+namespace halakv {
+
+    KvLoader::~KvLoader() {
+        close();
+    }
+
+    turbo::Status KvLoader::open(const KvLoaderOptions &options) {
+        _options = options;
+        melon::ChannelOptions channel_options;
+        channel_options.timeout_ms = options.timeout_ms;
+        // a stream is bound to the connection of the call that opened it.
+        channel_options.connection_type = "single";
+        if (_channel.Init(options.server.c_str(), &channel_options) != 0) {
+            return turbo::unavailable_error(turbo::substitute("init channel to $0 failed", options.server));
+        }
+        melon::StreamOptions stream_options;
+        stream_options.handler = this;
+        stream_options.max_buf_size = options.window_bytes;
+        melon::Controller cntl;
+        if (melon::StreamCreate(&_stream, cntl, &stream_options) != 0) {
+            return turbo::internal_error(turbo::substitute("create stream to $0 failed", options.server));
+        }
+        halakv::KvService_Stub stub(&_channel);
+        halakv::LoadRequest request;
+        halakv::KvResponse response;
+        if (!options.ns.empty()) {
+            request.set_ns(options.ns);
+        }
+        stub.load(&cntl, &request, &response, nullptr);
+        if (cntl.Failed()) {
+            melon::StreamClose(_stream);
+            _stream = melon::INVALID_STREAM_ID;
+            return turbo::unavailable_error(turbo::substitute("load to $0 failed: $1", options.server,
+                                                              cntl.ErrorText()));
+        }
+        return turbo::OkStatus();
+    }
+
+    turbo::Status KvLoader::add(std::string_view key, std::string_view value) {
+        auto *item = _batch.add_requests();
+        item->set_key(key.data(), key.size());
+        item->set_value(value.data(), value.size());
+        _batch_bytes += key.size() + value.size();
+        if (_batch.requests_size() >= _options.batch_keys || _batch_bytes >= static_cast<size_t>(_options.batch_bytes)) {
+            return flush();
+        }
+        return turbo::OkStatus();
+    }
+
+    turbo::Status KvLoader::flush() {
+        if (_batch.requests_size() == 0) {
+            return turbo::OkStatus();
+        }
+        if (_stream == melon::INVALID_STREAM_ID) {
+            return turbo::failed_precondition_error("loader is not open");
+        }
+        mutil::IOBuf buf;
+        buf.append(_batch.SerializeAsString());
+        _batch.Clear();
+        _batch_bytes = 0;
+        while (true) {
+            auto rc = melon::StreamWrite(_stream, buf);
+            if (rc == 0) {
+                break;
+            }
+            if (rc != EAGAIN) {
+                return turbo::unavailable_error(turbo::substitute("write to $0 failed: $1", _options.server, rc));
+            }
+            // the window is full, wait for the server to take some.
+            auto due = mutil::milliseconds_from_now(_options.write_timeout_ms);
+            rc = melon::StreamWait(_stream, &due);
+            if (rc != 0) {
+                return turbo::unavailable_error(turbo::substitute("wait for $0 failed: $1", _options.server, rc));
+            }
+        }
+        ++_sent_batches;
+        return turbo::OkStatus();
+    }
+
+    turbo::Status KvLoader::finish(halakv::LoadAck *ack) {
+        auto rs = flush();
+        if (!rs.ok()) {
+            return rs;
+        }
+        std::unique_lock lock(_mutex);
+        auto acked = _cond.wait_for(lock, std::chrono::milliseconds(_options.write_timeout_ms), [this] {
+            return _ack.batches() >= _sent_batches || _closed;
+        });
+        *ack = _ack;
+        if (_ack.batches() >= _sent_batches) {
+            return turbo::OkStatus();
+        }
+        if (!acked) {
+            return turbo::deadline_exceeded_error(turbo::substitute("$0 of $1 batches acked by $2", _ack.batches(),
+                                                                    _sent_batches, _options.server));
+        }
+        return turbo::unavailable_error(turbo::substitute("stream to $0 closed: $1", _options.server, _error));
+    }
+
+    int KvLoader::on_received_messages(melon::StreamId id, mutil::IOBuf *const messages[], size_t size) {
+        std::unique_lock lock(_mutex);
+        for (size_t i = 0; i < size; i++) {
+            halakv::LoadAck ack;
+            // acks carry totals, the last one wins.
+            if (ack.ParseFromString(messages[i]->to_string()) && ack.batches() >= _ack.batches()) {
+                _ack = ack;
+            }
+        }
+        _cond.notify_all();
+        return 0;
+    }
+
+    void KvLoader::on_closed(melon::StreamId id) {
+        std::unique_lock lock(_mutex);
+        _closed = true;
+        _cond.notify_all();
+    }
+
+    void KvLoader::on_failed(melon::StreamId id, int error_code, const std::string &error_text) {
+        LOG(WARNING) << "load stream to " << _options.server << " failed: " << error_text;
+        std::unique_lock lock(_mutex);
+        _error = error_text;
+    }
+
+    void KvLoader::close() {
+        if (_stream == melon::INVALID_STREAM_ID) {
+            return;
+        }
+        melon::StreamClose(_stream);
+        _stream = melon::INVALID_STREAM_ID;
+        // the handler is called until the stream is closed.
+        std::unique_lock lock(_mutex);
+        _cond.wait(lock, [this] {
+            return _closed;
+        });
+    }
+
+}  // namespace halakv
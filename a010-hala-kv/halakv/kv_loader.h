@@ -0,0 +1,95 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-12.
+//
+#pragma once
+
+#include <melon/rpc/channel.h>
+#include <melon/rpc/stream.h>
+#include <turbo/utility/status.h>
+#include <halakv/kv.pb.h>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace halakv {
+
+    struct KvLoaderOptions {
+        // any server of the cluster, it routes the keys to their owners.
+        std::string server;
+        // the namespace the keys are loaded into, the default one if empty.
+        std::string ns;
+        int timeout_ms{1000};
+        // a batch is sent at this many keys or bytes of keys and values.
+        int batch_keys{1000};
+        int batch_bytes{1024 * 1024};
+        // bytes sent ahead of what the server took.
+        int window_bytes{64 * 1024 * 1024};
+        int write_timeout_ms{10000};
+    };
+
+    // KvLoader streams keys and values to a server in batches for the initial
+    // load of a cluster, instead of a call per key. add batches them, a full
+    // batch is written to the stream and add waits only when the window is
+    // full. finish waits for the server to take every batch.
+    class KvLoader : public melon::StreamInputHandler {
+    public:
+        KvLoader() = default;
+
+        ~KvLoader() override;
+
+        turbo::Status open(const KvLoaderOptions &options);
+
+        turbo::Status add(std::string_view key, std::string_view value);
+
+        // sends the last batch and waits for the acks, the totals of the
+        // server are in ack.
+        turbo::Status finish(halakv::LoadAck *ack);
+
+        int on_received_messages(melon::StreamId id, mutil::IOBuf *const messages[], size_t size) override;
+
+        void on_idle_timeout(melon::StreamId id) override {
+        }
+
+        void on_closed(melon::StreamId id) override;
+
+        void on_failed(melon::StreamId id, int error_code, const std::string &error_text) override;
+
+    private:
+        turbo::Status flush();
+
+        void close();
+
+    private:
+        KvLoaderOptions _options;
+        melon::Channel _channel;
+        melon::StreamId _stream{melon::INVALID_STREAM_ID};
+        halakv::MultiKvRequest _batch;
+        size_t _batch_bytes{0};
+        uint64_t _sent_batches{0};
+        std::mutex _mutex;
+        std::condition_variable _cond;
+        halakv::LoadAck _ack;
+        bool _closed{false};
+        std::string _error;
+    };
+
+}  // namespace halakv
@@ -20,100 +20,997 @@
 //
 #include <halakv/kv_proxy.h>
 #include <halakv/cache.h>
+#include <halakv/hlc.h>
 #include <turbo/strings/str_split.h>
+#include <turbo/strings/substitute.h>
 #include <halakv/fiber.h>
 #include <melon/rpc/channel.h>
 #include <halakv/kv.pb.h>
+#include <algorithm>
+
+DEFINE_bool(gossip, true, "Detect failed and new peers by gossip, off to route on the static peers only");
+DEFINE_bool(coalesce_remote_get, true, "Concurrent gets of the same remote key share one forwarded rpc");
+DEFINE_int64(near_cache_bytes, 0, "Bytes of the near cache for keys owned by other peers, 0 disables it");
+DEFINE_int32(near_cache_ttl_ms, 1000, "Max staleness of a value in the near cache");
+DEFINE_int32(near_cache_negative_ttl_ms, 200, "Max staleness of a not found result in the near cache");
+DEFINE_bool(near_cache_push_invalidation, false, "Push invalidations of local keys written to the other peers, "
+                                                 "for clusters whose peers run a near cache");
+DEFINE_int32(near_cache_invalidation_interval_ms, 5, "Pending invalidations are pushed in a batch every this interval");
+DEFINE_int32(near_cache_max_pending_invalidations, 100000, "Invalidations beyond this are dropped and left to the ttl");
+DEFINE_bool(hinted_handoff, true, "Keep writes to an unavailable peer as hints and replay them when it is back");
+DEFINE_int64(hint_max_bytes_per_peer, 64 * 1024 * 1024, "Max bytes of hints kept for one peer");
+DEFINE_int32(hint_replay_interval_ms, 1000, "Interval to try replaying the hints of unavailable peers");
+DEFINE_int32(hint_replay_batch, 200, "Max hints replayed in one rpc");
+DEFINE_int32(tombstone_min_ms, 10000, "A remove is kept as a tombstone at least this long, and after until no alive "
+                                      "peer keeps a hint for the server");
+DEFINE_int32(replica_capacity, 0, "Max entries of the replica of the primary kept to serve its keys if it dies, 0 disables replication");
+DEFINE_int32(anti_entropy_interval_ms, 10000, "Interval to repair the replica against the primary, 0 to disable");
+DEFINE_int64(anti_entropy_bytes_per_second, 1024 * 1024, "Max bytes per second read from the primary by anti entropy");
+DEFINE_bool(restore_on_start, true, "Fill the local cache from the replica of the backup before serving");
+DEFINE_int64(restore_bytes_per_second, 64 * 1024 * 1024, "Max bytes per second read from the backup by a restore");
+DEFINE_bool(log_shipping, true, "Stream the local writes to the backup peer, which serves them if the local peer dies");
+DEFINE_int32(log_ship_interval_ms, 2, "Interval to ship the pending writes to the backup");
+DEFINE_int32(log_ship_retry_ms, 100, "Interval to retry when the backup can not be reached");
+DEFINE_int32(expire_interval_ms, 100, "Interval of removing the keys whose expiry is due");
+DEFINE_int32(default_deadline_ms, 1000, "Deadline of the forwarded calls of a request that carries none, as the rest, "
+                                        "resp and memcache ones do, 0 to bound them by the retries only");
+DEFINE_int32(expire_batch, 1000, "Max expired keys removed under one lock of the cache");
 
 namespace halakv {
 
     turbo::Status KvProxy::initialize(const std::string &address, const std::string &local_peer, Cache *cache) {
-        _peers = turbo::str_split(address, ",", turbo::SkipEmpty());
+        std::vector<std::string> peers = turbo::str_split(address, ",", turbo::SkipEmpty());
         _local_peer = local_peer;
         _cache = cache;
-        _peer_index = std::numeric_limits<size_t>::max();
-        for (size_t i = 0; i < _peers.size(); i++) {
-            if (_peers[i] == _local_peer) {
-                _peer_index = i;
-                break;
+        if (std::find(peers.begin(), peers.end(), _local_peer) == peers.end()) {
+            return turbo::invalid_argument_error("local peer not found in peers");
+        }
+        _peers.resize(kMaxPeers);
+        _senders.resize(kMaxPeers);
+        _alive.resize(kMaxPeers, false);
+        {
+            std::unique_lock lock(_route_mutex);
+            for (auto &peer: peers) {
+                size_t index;
+                auto rs = add_peer_locked(peer, &index);
+                if (!rs.ok()) {
+                    return rs;
+                }
+                _alive[index] = true;
+                if (peer == _local_peer) {
+                    _peer_index = index;
+                }
             }
+            publish_route_locked();
         }
-        if (_peer_index == std::numeric_limits<size_t>::max()) {
-            return turbo::invalid_argument_error("local peer not found in peers");
+        _route_change_count.expose_as("halakv_proxy", "route_change");
+        _redirect_count.expose_as("halakv_proxy", "redirect");
+        _single_flight.expose("halakv_proxy");
+        _near_cache.init(std::max<int64_t>(FLAGS_near_cache_bytes, 0), FLAGS_near_cache_ttl_ms,
+                         FLAGS_near_cache_negative_ttl_ms);
+        _near_cache.expose("halakv_proxy");
+        _hints.init(kMaxPeers, std::max<int64_t>(FLAGS_hint_max_bytes_per_peer, 0));
+        _hints.expose("halakv_proxy");
+        // with gossip a single node may be joined by others later.
+        const bool clustered = peers.size() > 1 || FLAGS_gossip;
+        if (FLAGS_hinted_handoff && clustered) {
+            // hints are replayed to the owners only, the replica keeps none.
+            _cache->keep_tombstones(true);
+            _replay_fiber.run([this]() {
+                replay_hints();
+            });
+        }
+        _push_invalidation = FLAGS_near_cache_push_invalidation && clustered;
+        if (_push_invalidation) {
+            _invalidation_fiber.run([this]() {
+                push_invalidations();
+            });
         }
-        _senders.resize(_peers.size());
-        for (size_t i = 0; i < _peers.size(); i++) {
-            _senders[i] = std::make_unique<halakv::RouterSender>();
-            auto rs = _senders[i]->init(_peers[i]);
-            if(!rs.ok()) {
+        // the replica is as large as asked, not the local cache, it costs memory
+        // on every peer.
+        _replicated = FLAGS_replica_capacity > 0 && clustered;
+        if (_replicated) {
+            auto rs = _replica.init(FLAGS_replica_capacity, _cache->namespaces());
+            if (!rs.ok()) {
                 return rs;
             }
+            _anti_entropy.init(&_replica, false, FLAGS_anti_entropy_bytes_per_second);
+            _anti_entropy.expose("halakv_proxy");
+            _restore.init(_cache, true, FLAGS_restore_bytes_per_second);
+            _restore.expose("halakv_restore");
+            _shipper.init(_local_peer);
+            _shipper.expose("halakv_replication");
+            _applier.init(&_replica);
+            _applier.expose("halakv_replication");
+        }
+        _watches.expose("halakv_watch");
+        // the seq of a watch event and the log of the backup are taken in the
+        // order the cache applied the writes, a write it refused is neither.
+        _cache->set_write_listener([this](const Cache::Write &write) {
+            _watches.publish(write.key, write.remove);
+            if (_log_shipping) {
+                _shipper.append(write);
+            }
+        });
+        _watch_fiber.run([this]() {
+            _watches.run();
+        });
+        _expired_count.expose_as("halakv_proxy", "expired");
+        _expire_fiber.run([this]() {
+            run_expire();
+        });
+        // a restarted peer takes back its keys from its backup, which served them meanwhile.
+        size_t backup;
+        if (_replicated && FLAGS_restore_on_start && get_backup_index(&backup)) {
+            auto rs = _restore.sync(_senders[backup].get());
+            if (!rs.ok()) {
+                LOG(WARNING) << "restore from backup " << _peers[backup] << " failed: " << rs;
+            }
+        }
+        if (FLAGS_anti_entropy_interval_ms > 0 && _replicated) {
+            _anti_entropy_fiber.run([this]() {
+                run_anti_entropy();
+            });
+        }
+        _log_shipping = FLAGS_log_shipping && _replicated;
+        if (_log_shipping) {
+            _log_shipping_fiber.run([this]() {
+                run_log_shipping();
+            });
+        }
+        if (FLAGS_gossip) {
+            return Membership::instance()->init(_local_peer, peers,
+                                                [this](const std::string &address, MemberState state) {
+                                                    on_member_change(address, state);
+                                                });
         }
         return turbo::OkStatus();
     }
 
+    void KvProxy::start() {
+        if (FLAGS_gossip) {
+            Membership::instance()->start();
+        }
+    }
+
     turbo::Status KvProxy::set(const ::halakv::KvRequest *request,
-                      ::halakv::KvResponse *response) {
-        auto index = get_peer_index(request->key());
+                      ::halakv::KvResponse *response, melon::Controller *cntl) {
+        auto route = std::atomic_load(&_route);
+        Cache *local;
+        auto index = get_peer_index(*route, request->key(), &local);
         VLOG(20) << "set key: " << request->key()<< " server: "<< _peers[index];
+        if (should_redirect(*request, index)) {
+            redirect(*route, index, response);
+            return turbo::OkStatus();
+        }
         if (index == _peer_index) {
-            _cache->put(request, response);
+            local->put(request, response);
+            on_local_write(*request, false, local);
             return turbo::OkStatus();
-        } else {
-            turbo::Status rs;
-            auto func = [&rs, this, index, request, response]() {
-                auto sender = _senders[index].get();
-                rs = sender->set(*request, *response, RouterSender::kRetryTimes);
-            };
-            Fiber fiber;
-            fiber.run_urgent(func);
-            fiber.join();
         }
-        return turbo::OkStatus();
+        turbo::Status rs;
+        auto deadline_us = deadline_of(cntl);
+        Cancellation cancel(cntl);
+        auto func = [&rs, this, index, request, response, deadline_us, &cancel]() {
+            auto sender = _senders[index].get();
+            rs = sender->set(*request, *response, retry_times_of(*request), deadline_us, &cancel);
+        };
+        Fiber fiber;
+        fiber.run_urgent(func);
+        fiber.join();
+        on_remote_write(request->key());
+        if (rs.ok()) {
+            _hints.drop(index, request->key());
+            Hlc::instance()->update(response->version());
+        } else if (hintable(rs, cancel) && hint_write(index, *request, false, response)) {
+            return turbo::OkStatus();
+        }
+        return rs;
     }
 
     turbo::Status KvProxy::get(const ::halakv::KvRequest *request,
-                      ::halakv::KvResponse *response) {
-        auto index = get_peer_index(request->key());
-        VLOG(20) << "get key: " << request->key()<< " server: "<< _peers[index];
-        if (index == _peer_index) {
-            _cache->get(request, response);
+                      ::halakv::KvResponse *response, melon::Controller *cntl) {
+        size_t index;
+        if (get_nearby(request, response, &index)) {
             return turbo::OkStatus();
+        }
+        turbo::Status rs;
+        Fiber fiber;
+        fiber.run_urgent([&rs, this, index, request, response, cntl]() {
+            rs = get_remote(index, request, response, cntl);
+        });
+        fiber.join();
+        return rs;
+    }
+
+    void KvProxy::get_async(const ::halakv::KvRequest *request,
+                            ::halakv::KvResponse *response, melon::Controller *cntl,
+                            std::function<void(const turbo::Status &)> done) {
+        size_t index;
+        if (get_nearby(request, response, &index)) {
+            done(turbo::OkStatus());
+            return;
+        }
+        auto version = _near_cache.version(request->key());
+        // owned by the call, dropped before done, as the inbound rpc may end in done.
+        auto *cancel = new Cancellation(cntl);
+        _senders[index]->get_async(*request, response, RouterSender::kRetryTimes, deadline_of(cntl), cancel,
+                                   [this, cancel, version, request, response, done = std::move(done)](
+                                           const turbo::Status &rs) {
+                                       delete cancel;
+                                       if (rs.ok() && _near_cache.enabled()) {
+                                           _near_cache.put(request->key(), *response, version);
+                                       }
+                                       done(rs);
+                                   });
+    }
+
+    Cache *KvProxy::local_cache_of(std::string_view key) {
+        auto route = std::atomic_load(&_route);
+        Cache *local;
+        auto index = get_peer_index(*route, key, &local);
+        return index == _peer_index ? local : nullptr;
+    }
+
+    bool KvProxy::get_nearby(const ::halakv::KvRequest *request, ::halakv::KvResponse *response, size_t *index) {
+        auto route = std::atomic_load(&_route);
+        Cache *local;
+        *index = get_peer_index(*route, request->key(), &local);
+        VLOG(20) << "get key: " << request->key()<< " server: "<< _peers[*index];
+        if (should_redirect(*request, *index)) {
+            redirect(*route, *index, response);
+            return true;
+        }
+        if (*index == _peer_index) {
+            local->get(request, response);
+            return true;
+        }
+        // a hinted write is newer than what the owner has.
+        if (_hints.lookup(*index, request->key(), response)) {
+            return true;
+        }
+        return _near_cache.enabled() && _near_cache.lookup(request->key(), response);
+    }
+
+    turbo::Status KvProxy::get_remote(size_t index, const ::halakv::KvRequest *request,
+                                      ::halakv::KvResponse *response, melon::Controller *cntl) {
+        auto version = _near_cache.version(request->key());
+        auto deadline_us = deadline_of(cntl);
+        auto sender = _senders[index].get();
+        turbo::Status rs;
+        // a conditional get may come back without a value, it is not shared.
+        if (FLAGS_coalesce_remote_get && !request->has_if_not_version()) {
+            // the call is shared with other callers, each waits up to its own
+            // deadline and the call is canceled once none of them waits.
+            rs = _single_flight.run(request->key(), response,
+                                    [sender, forward = *request](halakv::KvResponse *flight_response,
+                                                                 Cancellation *cancel) {
+                                        return sender->get(forward, *flight_response, RouterSender::kRetryTimes,
+                                                           -1, cancel);
+                                    }, cntl, deadline_us);
         } else {
-            turbo::Status rs;
-            auto func = [&rs, this, index, request, response]() {
-                auto sender = _senders[index].get();
-                rs = sender->get(*request, *response, RouterSender::kRetryTimes);
-            };
-            Fiber fiber;
-            fiber.run_urgent(func);
-            fiber.join();
+            Cancellation cancel(cntl);
+            rs = sender->get(*request, *response, RouterSender::kRetryTimes, deadline_us, &cancel);
         }
-        return turbo::OkStatus();
+        if (rs.ok() && _near_cache.enabled()) {
+            _near_cache.put(request->key(), *response, version);
+        }
+        return rs;
     }
 
     turbo::Status KvProxy::remove(const ::halakv::KvRequest *request,
-                         ::halakv::KvResponse *response) {
-        auto index = get_peer_index(request->key());
+                      ::halakv::KvResponse *response, melon::Controller *cntl) {
+        auto route = std::atomic_load(&_route);
+        Cache *local;
+        auto index = get_peer_index(*route, request->key(), &local);
         VLOG(20) << "remove key: " << request->key()<< " server: "<< _peers[index];
+        if (should_redirect(*request, index)) {
+            redirect(*route, index, response);
+            return turbo::OkStatus();
+        }
         if (index == _peer_index) {
-            _cache->remove(request, response);
+            local->remove(request, response);
+            on_local_write(*request, true, local);
             return turbo::OkStatus();
-        } else {
-            turbo::Status rs;
-            auto func = [&rs, this, index, request, response]() {
-                auto sender = _senders[index].get();
-                rs = sender->remove(*request, *response, RouterSender::kRetryTimes);
+        }
+        turbo::Status rs;
+        auto deadline_us = deadline_of(cntl);
+        Cancellation cancel(cntl);
+        auto func = [&rs, this, index, request, response, deadline_us, &cancel]() {
+            auto sender = _senders[index].get();
+            rs = sender->remove(*request, *response, RouterSender::kRetryTimes, deadline_us, &cancel);
+        };
+        Fiber fiber;
+        fiber.run_urgent(func);
+        fiber.join();
+        on_remote_write(request->key());
+        if (rs.ok()) {
+            _hints.drop(index, request->key());
+            Hlc::instance()->update(response->version());
+        } else if (hintable(rs, cancel) && hint_write(index, *request, true, response)) {
+            return turbo::OkStatus();
+        }
+        return rs;
+    }
+
+    turbo::Status KvProxy::mset(const ::halakv::MultiKvRequest *request,
+                                ::halakv::MultiKvResponse *response, melon::Controller *cntl) {
+        return multi_call(MultiOp::kSet, request, response, cntl);
+    }
+
+    turbo::Status KvProxy::mget(const ::halakv::MultiKvRequest *request,
+                                ::halakv::MultiKvResponse *response, melon::Controller *cntl) {
+        return multi_call(MultiOp::kGet, request, response, cntl);
+    }
+
+    turbo::Status KvProxy::mremove(const ::halakv::MultiKvRequest *request,
+                                   ::halakv::MultiKvResponse *response, melon::Controller *cntl) {
+        return multi_call(MultiOp::kRemove, request, response, cntl);
+    }
+
+    turbo::Status KvProxy::multi_call(MultiOp op, const ::halakv::MultiKvRequest *request,
+                                      ::halakv::MultiKvResponse *response, melon::Controller *cntl) {
+        auto deadline_us = deadline_of(cntl);
+        const int n = request->requests_size();
+        response->mutable_responses()->Reserve(n);
+        for (int i = 0; i < n; i++) {
+            response->add_responses();
+        }
+        const bool use_near_cache = op == MultiOp::kGet && _near_cache.enabled();
+        std::vector<uint64_t> versions(use_near_cache ? n : 0);
+        // one route for the whole request, loaded before the size so that it covers every slot in the route.
+        auto route = std::atomic_load(&_route);
+        const size_t peer_size = _peer_size.load(std::memory_order_acquire);
+        std::vector<std::vector<int>> groups(peer_size);
+        std::vector<Cache *> locals(n, nullptr);
+        for (int i = 0; i < n; i++) {
+            auto &key = request->requests(i).key();
+            auto index = get_peer_index(*route, key, &locals[i]);
+            if (should_redirect(request->requests(i), index)) {
+                redirect(*route, index, response->mutable_responses(i));
+                continue;
+            }
+            if (op == MultiOp::kGet && index != _peer_index && _hints.lookup(index, key, response->mutable_responses(i))) {
+                continue;
+            }
+            if (use_near_cache && index != _peer_index) {
+                if (_near_cache.lookup(key, response->mutable_responses(i))) {
+                    continue;
+                }
+                versions[i] = _near_cache.version(key);
+            }
+            groups[index].push_back(i);
+        }
+
+        std::vector<halakv::MultiKvRequest> sub_requests(peer_size);
+        std::vector<halakv::MultiKvResponse> sub_responses(peer_size);
+        std::vector<turbo::Status> sub_status(peer_size);
+        Cancellation cancel(cntl);
+        std::vector<Fiber> fibers(peer_size);
+        std::vector<size_t> remotes;
+        for (size_t index = 0; index < groups.size(); index++) {
+            if (index == _peer_index || groups[index].empty()) {
+                continue;
+            }
+            auto &sub_request = sub_requests[index];
+            sub_request.mutable_requests()->Reserve(groups[index].size());
+            for (auto i: groups[index]) {
+                *sub_request.add_requests() = request->requests(i);
+            }
+            VLOG(20) << "multi op: " << static_cast<int>(op) << " keys: " << groups[index].size()
+                     << " server: " << _peers[index];
+            auto func = [this, op, index, deadline_us, &sub_requests, &sub_responses, &sub_status, &cancel]() {
+                sub_status[index] = remote_call(op, index, sub_requests[index], sub_responses[index], deadline_us,
+                                                &cancel);
             };
-            Fiber fiber;
-            fiber.run_urgent(func);
-            fiber.join();
+            fibers[index].run(func);
+            remotes.push_back(index);
+        }
+
+        // local keys are served while the remote sub requests are in flight.
+        if (_peer_index < groups.size() && op == MultiOp::kSet) {
+            // one lock of each local cache for the whole group.
+            for (auto *cache: {_cache, &_replica}) {
+                std::vector<const halakv::KvRequest *> items;
+                std::vector<halakv::KvResponse *> results;
+                for (auto i: groups[_peer_index]) {
+                    if (locals[i] == cache) {
+                        items.push_back(&request->requests(i));
+                        results.push_back(response->mutable_responses(i));
+                    }
+                }
+                if (items.empty()) {
+                    continue;
+                }
+                cache->put_batch(items, results);
+                for (auto *item: items) {
+                    on_local_write(*item, false, cache);
+                }
+            }
+        } else if (_peer_index < groups.size()) {
+            for (auto i: groups[_peer_index]) {
+                local_call(op, locals[i], &request->requests(i), response->mutable_responses(i));
+                if (op != MultiOp::kGet) {
+                    on_local_write(request->requests(i), op == MultiOp::kRemove, locals[i]);
+                }
+            }
+        }
+
+        turbo::Status rs;
+        for (auto index: remotes) {
+            fibers[index].join();
+            auto &group = groups[index];
+            auto &sub_response = sub_responses[index];
+            auto st = sub_status[index];
+            if (st.ok() && sub_response.responses_size() != static_cast<int>(group.size())) {
+                st = turbo::internal_error(turbo::substitute("peer $0 returned $1 results for $2 keys", _peers[index],
+                                                             sub_response.responses_size(), group.size()));
+            }
+            if (!st.ok()) {
+                LOG(WARNING) << "multi op to " << _peers[index] << " failed: " << st;
+                bool hinted = op != MultiOp::kGet;
+                for (auto i: group) {
+                    auto &item_request = request->requests(i);
+                    auto *item = response->mutable_responses(i);
+                    if (op != MultiOp::kGet) {
+                        on_remote_write(item_request.key());
+                        if (hintable(st, cancel) && (op == MultiOp::kRemove || item_request.has_value()) &&
+                            hint_write(index, item_request, op == MultiOp::kRemove, item)) {
+                            continue;
+                        }
+                    }
+                    hinted = false;
+                    item->set_code(static_cast<int>(st.code()));
+                    item->set_message(std::string(st.message()));
+                }
+                if (!hinted && rs.ok()) {
+                    rs = st;
+                }
+                continue;
+            }
+            for (size_t j = 0; j < group.size(); j++) {
+                response->mutable_responses(group[j])->Swap(sub_response.mutable_responses(j));
+            }
+            for (auto i: group) {
+                auto &key = request->requests(i).key();
+                if (use_near_cache) {
+                    _near_cache.put(key, response->responses(i), versions[i]);
+                } else if (op != MultiOp::kGet) {
+                    on_remote_write(key);
+                    _hints.drop(index, key);
+                    Hlc::instance()->update(response->responses(i).version());
+                }
+            }
+        }
+        if (rs.ok()) {
+            response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+            response->set_message("ok");
+        } else {
+            response->set_code(static_cast<int>(rs.code()));
+            response->set_message(std::string(rs.message()));
+        }
+        return turbo::OkStatus();
+    }
+
+    void KvProxy::local_call(MultiOp op, Cache *cache, const ::halakv::KvRequest *request,
+                             ::halakv::KvResponse *response) {
+        switch (op) {
+            case MultiOp::kSet:
+                cache->put(request, response);
+                break;
+            case MultiOp::kGet:
+                cache->get(request, response);
+                break;
+            case MultiOp::kRemove:
+                cache->remove(request, response);
+                break;
+        }
+    }
+
+    turbo::Status KvProxy::remote_call(MultiOp op, size_t index, const ::halakv::MultiKvRequest &request,
+                                       ::halakv::MultiKvResponse &response, int64_t deadline_us,
+                                       Cancellation *cancel) {
+        auto sender = _senders[index].get();
+        switch (op) {
+            case MultiOp::kSet: {
+                auto retry_times = RouterSender::kRetryTimes;
+                for (auto &item: request.requests()) {
+                    retry_times = std::min(retry_times, retry_times_of(item));
+                }
+                return sender->mset(request, response, retry_times, deadline_us, cancel);
+            }
+            case MultiOp::kGet:
+                return sender->mget(request, response, RouterSender::kRetryTimes, deadline_us, cancel);
+            case MultiOp::kRemove:
+                return sender->mremove(request, response, RouterSender::kRetryTimes, deadline_us, cancel);
+        }
+        return turbo::invalid_argument_error("unknown multi op");
+    }
+
+    void KvProxy::invalidate(const ::halakv::InvalidateRequest *request, ::halakv::KvResponse *response) {
+        if (_near_cache.enabled()) {
+            for (auto &key: request->keys()) {
+                _near_cache.invalidate(key);
+            }
+        }
+        response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+        response->set_message("ok");
+    }
+
+    void KvProxy::on_local_write(const ::halakv::KvRequest &request, bool remove, Cache *cache) {
+        // the writes of the owned keys are published and shipped by the cache
+        // listener. the ones served from the replica for a dead primary are
+        // published after the write and stay in the replica, the primary
+        // restores them from here when it is back.
+        if (cache == &_replica) {
+            _watches.publish(request.key(), remove);
+        }
+        if (!_push_invalidation) {
+            return;
+        }
+        std::unique_lock lock(_invalidation_mutex);
+        if (_pending_invalidations.size() < static_cast<size_t>(FLAGS_near_cache_max_pending_invalidations)) {
+            _pending_invalidations.push_back(request.key());
+        }
+    }
+
+    turbo::Status KvProxy::watch(melon::Controller *cntl, const ::halakv::WatchRequest *request) {
+        return _watches.accept(cntl, request);
+    }
+
+    void KvProxy::on_remote_write(const std::string &key) {
+        if (_near_cache.enabled()) {
+            _near_cache.invalidate(key);
+        }
+    }
+
+    void KvProxy::push_invalidations() {
+        while (!melon::IsAskedToQuit()) {
+            fiber_usleep(1000L * FLAGS_near_cache_invalidation_interval_ms);
+            std::vector<std::string> keys;
+            {
+                std::unique_lock lock(_invalidation_mutex);
+                keys.swap(_pending_invalidations);
+            }
+            if (keys.empty()) {
+                continue;
+            }
+            halakv::InvalidateRequest request;
+            request.mutable_keys()->Reserve(keys.size());
+            for (auto &key: keys) {
+                request.add_keys()->swap(key);
+            }
+            // best effort, a lost invalidation is bounded by the near cache ttl.
+            auto deadline_us = mutil::gettimeofday_us() + 1000L * FLAGS_near_cache_ttl_ms;
+            auto route = std::atomic_load(&_route);
+            auto &ring = route->ring;
+            std::vector<Fiber> fibers(ring.size());
+            for (size_t i = 0; i < ring.size(); i++) {
+                auto index = ring[i];
+                if (index == _peer_index || !route->alive[i]) {
+                    continue;
+                }
+                fibers[i].run([this, index, &request, deadline_us]() {
+                    halakv::KvResponse response;
+                    auto rs = _senders[index]->invalidate(request, response, 1, deadline_us);
+                    if (!rs.ok()) {
+                        VLOG(10) << "push invalidation to " << _peers[index] << " failed: " << rs;
+                    }
+                });
+            }
+            for (size_t i = 0; i < ring.size(); i++) {
+                if (ring[i] != _peer_index && route->alive[i]) {
+                    fibers[i].join();
+                }
+            }
+        }
+    }
+
+    bool KvProxy::hint_write(size_t index, const ::halakv::KvRequest &request, bool remove,
+                             ::halakv::KvResponse *response) {
+        // a change of the expiry alone needs the key, which is on the owner.
+        if (!FLAGS_hinted_handoff || (!remove && (!request.has_value() || !idempotent(request))) ||
+            !_hints.add(index, request.key(), request.value(), remove, request.expire_at_us(), request.flags())) {
+            return false;
+        }
+        VLOG(20) << "hinted " << (remove ? "remove" : "set") << " key: " << request.key() << " server: " << _peers[index];
+        response->Clear();
+        response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+        response->set_message("hinted");
+        return true;
+    }
+
+    bool KvProxy::hintable(const turbo::Status &rs, const Cancellation &cancel) {
+        // only a write that surely did not reach the peer, one that timed out may
+        // be applied already and a hint would replay it over newer writes. a shed
+        // write is failed fast for the client to back off.
+        return !cancel.canceled() && rs.code() == turbo::StatusCode::kUnavailable;
+    }
+
+    void KvProxy::replay_hints() {
+        while (!melon::IsAskedToQuit()) {
+            fiber_usleep(1000L * FLAGS_hint_replay_interval_ms);
+            auto route = std::atomic_load(&_route);
+            for (size_t i = 0; i < route->ring.size(); i++) {
+                auto index = route->ring[i];
+                if (index == _peer_index || !route->alive[i]) {
+                    continue;
+                }
+                while (!_hints.empty(index)) {
+                    auto rs = replay_hints(index);
+                    if (!rs.ok()) {
+                        VLOG(10) << "replay hints to " << _peers[index] << " failed: " << rs;
+                        break;
+                    }
+                }
+            }
+            drop_tombstones();
+        }
+    }
+
+    void KvProxy::drop_tombstones() {
+        if (_cache->tombstone_count() == 0) {
+            return;
+        }
+        auto before = Hlc::instance()->now() - 1000L * std::max(FLAGS_tombstone_min_ms, 0);
+        // a dead peer dropped its hints for the local server, see on_member_change.
+        halakv::HintsRequest request;
+        request.set_peer(_local_peer);
+        auto route = std::atomic_load(&_route);
+        for (size_t i = 0; i < route->ring.size(); i++) {
+            auto index = route->ring[i];
+            if (index == _peer_index || !route->alive[i]) {
+                continue;
+            }
+            halakv::HintsResponse response;
+            auto rs = _senders[index]->hints(request, response, 1);
+            if (!rs.ok() || response.count() > 0) {
+                VLOG(10) << "keep tombstones, " << _peers[index] << " may keep hints: " << rs;
+                return;
+            }
+        }
+        _cache->drop_tombstones(before);
+    }
+
+    void KvProxy::hints(const ::halakv::HintsRequest *request, ::halakv::HintsResponse *response) {
+        uint64_t count = 0;
+        auto size = _peer_size.load(std::memory_order_acquire);
+        for (size_t i = 0; i < size; i++) {
+            if (_peers[i] == request->peer()) {
+                count = _hints.size(i);
+                break;
+            }
+        }
+        response->set_count(count);
+        response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+        response->set_message("ok");
+    }
+
+    turbo::Status KvProxy::replay_hints(size_t index) {
+        std::vector<HintStore::Hint> hints;
+        _hints.peek(index, FLAGS_hint_replay_batch, &hints);
+        halakv::MultiKvRequest sets;
+        halakv::MultiKvRequest removes;
+        std::vector<size_t> set_hints;
+        std::vector<size_t> remove_hints;
+        for (size_t i = 0; i < hints.size(); i++) {
+            auto &hint = hints[i];
+            auto *item = hint.remove ? removes.add_requests() : sets.add_requests();
+            (hint.remove ? remove_hints : set_hints).push_back(i);
+            item->set_key(hint.key);
+            // the owner keeps a write or a remove taken after the hint.
+            item->set_version(hint.version);
+            if (!hint.remove) {
+                item->set_value(hint.value);
+            }
+            if (hint.expire_at_us != 0) {
+                item->set_expire_at_us(hint.expire_at_us);
+            }
+            if (hint.flags != 0) {
+                item->set_flags(hint.flags);
+            }
+        }
+        // one try each, the breaker of the peer lets one probe through while it is open.
+        auto sender = _senders[index].get();
+        std::vector<HintStore::Hint> replayed;
+        auto call = [&](bool remove, const halakv::MultiKvRequest &request, const std::vector<size_t> &positions) {
+            if (request.requests_size() == 0) {
+                return turbo::OkStatus();
+            }
+            halakv::MultiKvResponse response;
+            auto rs = remove ? sender->mremove(request, response, 1) : sender->mset(request, response, 1);
+            if (!rs.ok()) {
+                return rs;
+            }
+            // only what the owner took, the rest is tried again.
+            for (int i = 0; i < response.responses_size() && i < static_cast<int>(positions.size()); i++) {
+                auto code = response.responses(i).code();
+                if (code == static_cast<int>(turbo::StatusCode::kOk) ||
+                    (remove && code == static_cast<int>(turbo::StatusCode::kNotFound))) {
+                    replayed.push_back(hints[positions[i]]);
+                }
+            }
+            return turbo::OkStatus();
+        };
+        auto rs = call(false, sets, set_hints);
+        if (rs.ok()) {
+            rs = call(true, removes, remove_hints);
+        }
+        _hints.ack(index, replayed);
+        if (!replayed.empty()) {
+            LOG(INFO) << "replayed " << replayed.size() << " of " << hints.size() << " hints to " << _peers[index];
+        }
+        if (rs.ok() && replayed.size() < hints.size()) {
+            return turbo::unavailable_error(turbo::substitute("$0 took $1 of $2 hints", _peers[index], replayed.size(),
+                                                              hints.size()));
+        }
+        return rs;
+    }
+
+    void KvProxy::merkle(const ::halakv::MerkleRequest *request, ::halakv::MerkleResponse *response) {
+        (request->replica() ? &_replica : _cache)->merkle(request, response);
+    }
+
+    void KvProxy::scan(const ::halakv::ScanRequest *request, ::halakv::ScanResponse *response) {
+        (request->replica() ? &_replica : _cache)->scan(request, response);
+    }
+
+    turbo::Status KvProxy::replicate(melon::Controller *cntl, const ::halakv::ReplicateRequest *request,
+                                     ::halakv::KvResponse *response) {
+        if (!_replicated) {
+            response->set_code(static_cast<int>(turbo::StatusCode::kFailedPrecondition));
+            response->set_message(turbo::substitute("$0 keeps no replica", _local_peer));
+            return turbo::OkStatus();
         }
+        size_t index;
+        bool alive;
+        if (!get_primary_index(&index, &alive) || _peers[index] != request->primary()) {
+            response->set_code(static_cast<int>(turbo::StatusCode::kFailedPrecondition));
+            response->set_message(turbo::substitute("$0 is not the primary of $1", request->primary(), _local_peer));
+            return turbo::OkStatus();
+        }
+        use_primary(index);
+        auto rs = _applier.accept(cntl, request);
+        if (!rs.ok()) {
+            return rs;
+        }
+        response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+        response->set_message("ok");
         return turbo::OkStatus();
     }
 
-    size_t KvProxy::get_peer_index(const std::string_view &key) {
-        return _hash(key) % _peers.size();
+    void KvProxy::route(const ::halakv::RouteRequest *request, ::halakv::RouteTable *response) {
+        auto route = std::atomic_load(&_route);
+        response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+        response->set_message("ok");
+        response->set_epoch(route->epoch);
+        response->set_hash_scheme(kHashScheme);
+        for (size_t i = 0; i < route->ring.size(); i++) {
+            response->add_peers(_peers[route->ring[i]]);
+            response->add_alive(route->alive[i]);
+        }
+    }
+
+    bool KvProxy::should_redirect(const ::halakv::KvRequest &request, size_t index) const {
+        return request.has_epoch() && index != _peer_index;
+    }
+
+    void KvProxy::redirect(const Route &route, size_t index, ::halakv::KvResponse *response) {
+        _redirect_count << 1;
+        response->Clear();
+        response->set_code(static_cast<int>(turbo::StatusCode::kFailedPrecondition));
+        response->set_message("moved");
+        response->set_redirect(_peers[index]);
+        response->set_epoch(route.epoch);
+    }
+
+    bool KvProxy::get_primary_index(size_t *index, bool *alive) {
+        auto route = std::atomic_load(&_route);
+        auto &ring = route->ring;
+        if (ring.size() < 2) {
+            return false;
+        }
+        auto pos = std::find(ring.begin(), ring.end(), _peer_index) - ring.begin();
+        pos = (pos + ring.size() - 1) % ring.size();
+        *index = ring[pos];
+        *alive = route->alive[pos];
+        return true;
+    }
+
+    bool KvProxy::get_backup_index(size_t *index) {
+        auto route = std::atomic_load(&_route);
+        auto &ring = route->ring;
+        if (ring.size() < 2) {
+            return false;
+        }
+        auto pos = std::find(ring.begin(), ring.end(), _peer_index) - ring.begin();
+        pos = (pos + 1) % ring.size();
+        // a dead backup is not replaced, the next peer holds the replica of the dead one.
+        if (!route->alive[pos]) {
+            return false;
+        }
+        *index = ring[pos];
+        return true;
+    }
+
+    void KvProxy::use_primary(size_t index) {
+        std::unique_lock lock(_replica_mutex);
+        if (index == _primary_index) {
+            return;
+        }
+        // the replica belongs to another primary now, rebuild it from scratch.
+        LOG(INFO) << "primary of the replica changed to " << _peers[index];
+        _replica.clear();
+        _primary_index = index;
+    }
+
+    void KvProxy::run_anti_entropy() {
+        while (!melon::IsAskedToQuit()) {
+            fiber_usleep(1000L * FLAGS_anti_entropy_interval_ms);
+            size_t index;
+            if (_restore_pending.load(std::memory_order_acquire) && get_backup_index(&index)) {
+                auto rs = _restore.sync(_senders[index].get());
+                if (rs.ok()) {
+                    _restore_pending.store(false, std::memory_order_release);
+                } else {
+                    VLOG(10) << "restore from " << _peers[index] << " failed: " << rs;
+                }
+            }
+            bool alive;
+            // the replica of a dead primary is served as it is until the primary is back.
+            if (!get_primary_index(&index, &alive) || !alive) {
+                continue;
+            }
+            use_primary(index);
+            auto rs = _anti_entropy.sync(_senders[index].get());
+            if (!rs.ok()) {
+                VLOG(10) << "anti entropy with " << _peers[index] << " failed: " << rs;
+            }
+        }
+    }
+
+    void KvProxy::run_log_shipping() {
+        while (!melon::IsAskedToQuit()) {
+            size_t index;
+            if (!get_backup_index(&index)) {
+                _shipper.reset();
+                fiber_usleep(1000L * FLAGS_log_ship_retry_ms);
+                continue;
+            }
+            auto rs = _shipper.ship(_peers[index], _senders[index].get());
+            if (!rs.ok()) {
+                VLOG(10) << "ship writes to " << _peers[index] << " failed: " << rs;
+                fiber_usleep(1000L * FLAGS_log_ship_retry_ms);
+                continue;
+            }
+            fiber_usleep(1000L * FLAGS_log_ship_interval_ms);
+        }
+    }
+
+    void KvProxy::run_expire() {
+        const size_t batch = std::max(FLAGS_expire_batch, 1);
+        while (!melon::IsAskedToQuit()) {
+            fiber_usleep(1000L * std::max(FLAGS_expire_interval_ms, 1));
+            std::vector<std::string> keys;
+            do {
+                keys.clear();
+                _cache->remove_expired(mutil::gettimeofday_us(), batch, &keys);
+                halakv::KvRequest request;
+                for (auto &key: keys) {
+                    request.set_key(key);
+                    on_local_write(request, true, _cache);
+                }
+                _expired_count << keys.size();
+            } while (keys.size() == batch);
+            // the replica expires the same keys by itself, a dead primary ships nothing.
+            do {
+                keys.clear();
+                _replica.remove_expired(mutil::gettimeofday_us(), batch, &keys);
+            } while (keys.size() == batch);
+        }
+    }
+
+    int64_t KvProxy::deadline_of(const melon::Controller *cntl) {
+        if (cntl != nullptr && cntl->deadline_us() > 0) {
+            return cntl->deadline_us();
+        }
+        if (FLAGS_default_deadline_ms <= 0) {
+            return -1;
+        }
+        return mutil::gettimeofday_us() + FLAGS_default_deadline_ms * 1000L;
+    }
+
+    void KvProxy::on_member_change(const std::string &address, MemberState state) {
+        if (address == _local_peer) {
+            if (state == MEMBER_DEAD) {
+                // the backup served the local keys meanwhile, take them back from its replica.
+                LOG(WARNING) << "local peer was declared dead, restore the local cache from the backup";
+                _cache->clear();
+                _restore_pending.store(true, std::memory_order_release);
+            }
+            return;
+        }
+        std::unique_lock lock(_route_mutex);
+        size_t index;
+        auto rs = add_peer_locked(address, &index);
+        if (!rs.ok()) {
+            LOG(WARNING) << "add peer " << address << " failed: " << rs;
+            return;
+        }
+        const bool alive = state != MEMBER_DEAD;
+        if (_alive[index] == alive) {
+            return;
+        }
+        _alive[index] = alive;
+        if (!alive) {
+            _hints.clear(index);
+        }
+        publish_route_locked();
+        _route_change_count << 1;
+        LOG(INFO) << "peer " << address << (alive ? " is alive" : " is dead, its backup takes its keys");
+    }
+
+    turbo::Status KvProxy::add_peer_locked(const std::string &address, size_t *index) {
+        auto size = _peer_size.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < size; i++) {
+            if (_peers[i] == address) {
+                *index = i;
+                return turbo::OkStatus();
+            }
+        }
+        if (size >= kMaxPeers) {
+            return turbo::resource_exhausted_error(turbo::substitute("more than $0 peers", kMaxPeers));
+        }
+        auto sender = std::make_unique<halakv::RouterSender>();
+        auto rs = sender->init(address);
+        if (!rs.ok()) {
+            return rs;
+        }
+        _peers[size] = address;
+        _senders[size] = std::move(sender);
+        _peer_size.store(size + 1, std::memory_order_release);
+        *index = size;
+        return turbo::OkStatus();
+    }
+
+    void KvProxy::publish_route_locked() {
+        auto route = std::make_shared<Route>();
+        auto size = _peer_size.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < size; i++) {
+            route->ring.push_back(i);
+        }
+        std::sort(route->ring.begin(), route->ring.end(), [this](size_t a, size_t b) {
+            return _peers[a] < _peers[b];
+        });
+        std::string fingerprint;
+        for (auto index: route->ring) {
+            route->alive.push_back(_alive[index]);
+            route->hashes.push_back(key_hash(_peers[index]));
+            fingerprint.append(_peers[index]).append(_alive[index] ? "+" : "-");
+        }
+        route->epoch = key_hash(fingerprint);
+        std::atomic_store(&_route, std::shared_ptr<const Route>(std::move(route)));
+    }
+
+    size_t KvProxy::get_peer_index(const Route &route, const std::string_view &key, Cache **local) {
+        auto &ring = route.ring;
+        auto pos = owner_of(key, route.hashes);
+        *local = _cache;
+        // a dead owner is served by the next alive peer on the ring. only its
+        // backup, the peer right after it, holds its replica, past a dead backup
+        // too, or without replicas, the keys are served from the cache and
+        // refilled by the clients. the local peer is always alive, the walk stops
+        // there at the latest.
+        for (size_t i = 0; i < ring.size(); i++) {
+            auto at = (pos + i) % ring.size();
+            if (route.alive[at]) {
+                if (i == 1 && _replicated) {
+                    *local = &_replica;
+                }
+                return ring[at];
+            }
+        }
+        return _peer_index;
     }
 
-}  // namespace halakv
\ No newline at end of file
+}  // namespace halakv
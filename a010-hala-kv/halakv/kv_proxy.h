@@ -23,9 +23,25 @@
 #include <gflags/gflags.h>
 #include <turbo/log/logging.h>
 #include <melon/rpc/server.h>
+#include <melon/rpc/controller.h>
 #include <halakv/kv.pb.h>
 #include <halakv/cache.h>
 #include <halakv/router_sender.h>
+#include <halakv/single_flight.h>
+#include <halakv/near_cache.h>
+#include <halakv/hint_store.h>
+#include <halakv/membership.h>
+#include <halakv/anti_entropy.h>
+#include <halakv/log_shipper.h>
+#include <halakv/log_applier.h>
+#include <halakv/watch_hub.h>
+#include <halakv/fiber.h>
+#include <halakv/key_hash.h>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 
@@ -44,22 +60,222 @@ namespace halakv {
 
         turbo::Status initialize(const std::string& address, const std::string& local_peer, Cache *cache);
 
+        // joins the membership, after the server started listening.
+        void start();
+
         turbo::Status set(const ::halakv::KvRequest *request,
-                 ::halakv::KvResponse *response);
+                 ::halakv::KvResponse *response,
+                          melon::Controller *cntl = nullptr);
 
         turbo::Status get(const ::halakv::KvRequest *request,
-                 ::halakv::KvResponse *response);
+                 ::halakv::KvResponse *response,
+                          melon::Controller *cntl = nullptr);
+
+        // the cache holding the key if this server owns it, or its replica when
+        // standing in for the dead owner, nullptr if another peer owns it.
+        Cache *local_cache_of(std::string_view key);
+
+        // like get, but a key owned by another peer is asked for with a done
+        // closure and done runs from it, no fiber is held for the round trip.
+        // the call is not coalesced with other gets of the key, that would hold
+        // the caller. done runs in place when the key is answered locally.
+        // request, response and cntl must live until done runs.
+        void get_async(const ::halakv::KvRequest *request,
+                       ::halakv::KvResponse *response,
+                       melon::Controller *cntl,
+                       std::function<void(const turbo::Status &)> done);
 
         turbo::Status remove(const ::halakv::KvRequest *request,
-                    ::halakv::KvResponse *response);
+                    ::halakv::KvResponse *response,
+                             melon::Controller *cntl = nullptr);
+
+        turbo::Status mset(const ::halakv::MultiKvRequest *request,
+                           ::halakv::MultiKvResponse *response,
+                           melon::Controller *cntl = nullptr);
+
+        turbo::Status mget(const ::halakv::MultiKvRequest *request,
+                           ::halakv::MultiKvResponse *response,
+                           melon::Controller *cntl = nullptr);
+
+        turbo::Status mremove(const ::halakv::MultiKvRequest *request,
+                              ::halakv::MultiKvResponse *response,
+                              melon::Controller *cntl = nullptr);
+        // invalidations pushed by the owners of keys in the near cache.
+        void invalidate(const ::halakv::InvalidateRequest *request, ::halakv::KvResponse *response);
+
+        // the count of hints kept for a peer, it keeps its tombstones until none is left.
+        void hints(const ::halakv::HintsRequest *request, ::halakv::HintsResponse *response);
+
+        // a peer joined or changed state in the gossip membership, the keys of a
+        // dead peer are served by its backup, the next alive peer on the ring.
+        void on_member_change(const std::string &address, MemberState state);
+
+        // the merkle tree and entries of the local cache, read by the replica.
+        void merkle(const ::halakv::MerkleRequest *request, ::halakv::MerkleResponse *response);
+
+        void scan(const ::halakv::ScanRequest *request, ::halakv::ScanResponse *response);
+
+        // a stream of writes opened by the primary, taken only if it is the
+        // alive peer before the local one on the ring.
+        turbo::Status replicate(melon::Controller *cntl, const ::halakv::ReplicateRequest *request,
+                                ::halakv::KvResponse *response);
+
+        // a stream of the writes of the keys owned here, for a watcher.
+        turbo::Status watch(melon::Controller *cntl, const ::halakv::WatchRequest *request);
+
+        // the route for clients sending each key to its owner.
+        void route(const ::halakv::RouteRequest *request, ::halakv::RouteTable *response);
+
     private:
-        size_t get_peer_index(const std::string_view& key);
+        // the slot indexes of all known peers, sorted by address so that all
+        // peers agree on the owner of a key. a dead peer keeps its place on the
+        // ring and its keys go to the next alive peer, which holds its replica.
+        struct Route {
+            std::vector<size_t> ring;
+            std::vector<bool> alive;
+            // key_hash of the address of each peer of the ring.
+            std::vector<uint64_t> hashes;
+            // a hash of the ring, clients holding another one are behind.
+            uint64_t epoch{0};
+        };
+
+        static constexpr size_t kMaxPeers = 256;
+
+        enum class MultiOp {
+            kSet,
+            kGet,
+            kRemove
+        };
+
+        // local is set to the cache serving the key when it is owned here, the
+        // replica when the key belongs to a dead primary.
+        size_t get_peer_index(const Route &route, const std::string_view& key, Cache **local);
+
+        // a request from a client routing by epoch for a key not owned here is
+        // answered with the owner instead of forwarded.
+        bool should_redirect(const ::halakv::KvRequest &request, size_t index) const;
+
+        void redirect(const Route &route, size_t index, ::halakv::KvResponse *response);
+
+        turbo::Status add_peer_locked(const std::string &address, size_t *index);
+
+        void publish_route_locked();
+
+        // the peer before the local one on the ring, its cache is replicated here.
+        // false if the local peer is alone.
+        bool get_primary_index(size_t *index, bool *alive);
+
+        // the peer after the local one on the ring, the local writes are shipped
+        // to it. false if it is dead, it holds the replica of the dead peer then.
+        bool get_backup_index(size_t *index);
+
+        // the replica is dropped when it starts following another primary.
+        void use_primary(size_t index);
+
+        void run_anti_entropy();
+
+        void run_log_shipping();
+
+        // drops the expired keys, the local ones are removed as if written.
+        void run_expire();
+
+        // group the keys by owning peer, serve the local ones from cache and
+        // send one sub request per remote peer in parallel, then merge the
+        // results back in request order.
+        turbo::Status multi_call(MultiOp op, const ::halakv::MultiKvRequest *request,
+                                 ::halakv::MultiKvResponse *response, melon::Controller *cntl);
+
+        void local_call(MultiOp op, Cache *cache, const ::halakv::KvRequest *request, ::halakv::KvResponse *response);
+
+        turbo::Status remote_call(MultiOp op, size_t index, const ::halakv::MultiKvRequest &request,
+                                  ::halakv::MultiKvResponse &response, int64_t deadline_us, Cancellation *cancel);
+
+        // a write to a local key is shipped to the backup and queued to be pushed
+        // to the near caches of the other peers, a write forwarded to the owner
+        // drops the near cache entry here.
+        void on_local_write(const ::halakv::KvRequest &request, bool remove, Cache *cache);
+
+        void on_remote_write(const std::string &key);
+
+        void push_invalidations();
+
+        // a write the owner could not take is kept as a hint and answered as done,
+        // returns false if hinted handoff is off or the hints of the peer are full.
+        bool hint_write(size_t index, const ::halakv::KvRequest &request, bool remove,
+                        ::halakv::KvResponse *response);
+
+        // not for calls canceled by the client or shed by the limiter of the peer.
+        static bool hintable(const turbo::Status &rs, const Cancellation &cancel);
+
+        // an increment or an add is not idempotent, a retry after a timeout may
+        // apply it twice or answer it exists. nor is it hinted, it needs the key.
+        static bool idempotent(const ::halakv::KvRequest &request) {
+            return !request.has_incr_by() && !request.has_incr_unsigned() && !request.if_absent();
+        }
+
+        static int retry_times_of(const ::halakv::KvRequest &request) {
+            return idempotent(request) ? RouterSender::kRetryTimes : 1;
+        }
+
+        void replay_hints();
+
+        turbo::Status replay_hints(size_t index);
+
+        // drops the tombstones old enough once no alive peer keeps a hint for
+        // the local server, a hint older than a remove is not replayed over it.
+        void drop_tombstones();
+
+        // answers from the local cache, a hint or the near cache, false if the
+        // owner at index must be asked.
+        bool get_nearby(const ::halakv::KvRequest *request, ::halakv::KvResponse *response, size_t *index);
+
+        turbo::Status get_remote(size_t index, const ::halakv::KvRequest *request,
+                                 ::halakv::KvResponse *response, melon::Controller *cntl);
+
+        // the deadline of the inbound rpc, forwarded calls must finish before it.
+        // default_deadline_ms from now for a request without one.
+        static int64_t deadline_of(const melon::Controller *cntl);
     private:
         Cache *_cache;
+        // a slot per peer ever known, sized to kMaxPeers up front so that a
+        // slot can be read without lock once _peer_size covers it. slots are
+        // never reused, hints and senders stay with the address.
         std::vector<std::string> _peers;
+        std::vector<std::unique_ptr<RouterSender>> _senders;
+        std::atomic<size_t> _peer_size{0};
         std::string _local_peer;
         size_t _peer_index;
-        std::hash<std::string_view> _hash;
-        std::vector<std::unique_ptr<RouterSender>> _senders;
+        std::mutex _route_mutex;
+        std::vector<bool> _alive;
+        std::shared_ptr<const Route> _route;
+        melon::var::Adder<int64_t> _route_change_count;
+        melon::var::Adder<int64_t> _redirect_count;
+        SingleFlight _single_flight;
+        NearCache _near_cache;
+        bool _push_invalidation{false};
+        std::mutex _invalidation_mutex;
+        std::vector<std::string> _pending_invalidations;
+        Fiber _invalidation_fiber;
+        HintStore _hints;
+        Fiber _replay_fiber;
+        // replica_capacity is set, the peer keeps a copy of the cache of its
+        // primary, served when the primary is dead.
+        bool _replicated{false};
+        Cache _replica;
+        std::mutex _replica_mutex;
+        size_t _primary_index{std::numeric_limits<size_t>::max()};
+        AntiEntropy _anti_entropy;
+        Fiber _anti_entropy_fiber;
+        // fills the local cache back from the replica kept by the backup.
+        AntiEntropy _restore;
+        std::atomic<bool> _restore_pending{false};
+        bool _log_shipping{false};
+        LogShipper _shipper;
+        LogApplier _applier;
+        Fiber _log_shipping_fiber;
+        WatchHub _watches;
+        Fiber _watch_fiber;
+        Fiber _expire_fiber;
+        melon::var::Adder<int64_t> _expired_count;
     };
 }  // namespace halakv
\ No newline at end of file
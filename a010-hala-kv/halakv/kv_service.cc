@@ -21,17 +21,82 @@
 #include <halakv/kv_service.h>
 #include <halakv/cache.h>
 #include <halakv/kv_proxy.h>
+#include <halakv/bulk_loader.h>
+#include <halakv/compression.h>
+#include <halakv/namespaces.h>
+#include <melon/utility/time.h>
+#include <cerrno>
 
 namespace halakv {
 
+    KvServiceimpl::KvServiceimpl() {
+        _expired_count.expose_as("halakv_service", "expired");
+        _canceled_count.expose_as("halakv_service", "canceled");
+    }
+
+    void KvServiceimpl::set_failed(melon::Controller *cntl, const turbo::Status &rs) {
+        // shed by a limiter, the client may retry it on another peer or later.
+        if (rs.code() == turbo::StatusCode::kResourceExhausted) {
+            cntl->SetFailed(melon::ELIMIT, "%s", rs.to_string().c_str());
+            return;
+        }
+        cntl->SetFailed(rs.to_string());
+    }
+
+    bool KvServiceimpl::admit(melon::Controller *cntl) {
+        auto deadline_us = cntl->deadline_us();
+        if (deadline_us > 0 && mutil::gettimeofday_us() >= deadline_us) {
+            _expired_count << 1;
+            cntl->SetFailed(melon::ERPCTIMEDOUT, "deadline passed before the request was served");
+            return false;
+        }
+        if (cntl->IsCanceled()) {
+            _canceled_count << 1;
+            cntl->SetFailed(ECANCELED, "client canceled before the request was served");
+            return false;
+        }
+        return true;
+    }
+
+    bool KvServiceimpl::scope(melon::Controller *cntl, const halakv::KvRequest *request) {
+        // the request is owned by the call, scoped in place instead of copied with its value.
+        auto rs = Namespaces::instance()->scope(const_cast<halakv::KvRequest *>(request));
+        if (!rs.ok()) {
+            set_failed(cntl, rs);
+            return false;
+        }
+        return true;
+    }
+
+    bool KvServiceimpl::scope(melon::Controller *cntl, const halakv::MultiKvRequest *request) {
+        auto rs = Namespaces::instance()->scope(const_cast<halakv::MultiKvRequest *>(request));
+        if (!rs.ok()) {
+            set_failed(cntl, rs);
+            return false;
+        }
+        return true;
+    }
+
     void KvServiceimpl::set(::google::protobuf::RpcController *cntl_base,
                             const ::halakv::KvRequest *request,
                             ::halakv::KvResponse *response,
                             ::google::protobuf::Closure *done) {
         melon::ClosureGuard done_guard(done);
-        auto rs = KvProxy::instance()->set(request, response);
+        auto *cntl = static_cast<melon::Controller *>(cntl_base);
+        if (!admit(cntl)) {
+            return;
+        }
+        if (!scope(cntl, request)) {
+            return;
+        }
+        serve_set(cntl, request, response);
+    }
+
+    void KvServiceimpl::serve_set(melon::Controller *cntl, const halakv::KvRequest *request,
+                                  halakv::KvResponse *response) {
+        auto rs = KvProxy::instance()->set(request, response, cntl);
         if (!rs.ok()) {
-            cntl_base->SetFailed(rs.to_string());
+            set_failed(cntl, rs);
         }
     }
 
@@ -40,9 +105,24 @@ namespace halakv {
                             ::halakv::KvResponse *response,
                             ::google::protobuf::Closure *done) {
         melon::ClosureGuard done_guard(done);
-        auto rs = KvProxy::instance()->get(request, response);
+        auto *cntl = static_cast<melon::Controller *>(cntl_base);
+        if (!admit(cntl)) {
+            return;
+        }
+        if (!scope(cntl, request)) {
+            return;
+        }
+        serve_get(cntl, request, response);
+        if (!cntl->Failed()) {
+            Compressor::instance()->rpc_compress(cntl, response->value().size());
+        }
+    }
+
+    void KvServiceimpl::serve_get(melon::Controller *cntl, const halakv::KvRequest *request,
+                                  halakv::KvResponse *response) {
+        auto rs = KvProxy::instance()->get(request, response, cntl);
         if (!rs.ok()) {
-            cntl_base->SetFailed(rs.to_string());
+            set_failed(cntl, rs);
         }
     }
 
@@ -51,10 +131,253 @@ namespace halakv {
                             ::halakv::KvResponse *response,
                             ::google::protobuf::Closure *done) {
         melon::ClosureGuard done_guard(done);
-        auto rs = KvProxy::instance()->remove(request, response);
+        auto *cntl = static_cast<melon::Controller *>(cntl_base);
+        if (!admit(cntl)) {
+            return;
+        }
+        if (!scope(cntl, request)) {
+            return;
+        }
+        serve_remove(cntl, request, response);
+    }
+
+    void KvServiceimpl::serve_remove(melon::Controller *cntl, const halakv::KvRequest *request,
+                                     halakv::KvResponse *response) {
+        auto rs = KvProxy::instance()->remove(request, response, cntl);
+        if (!rs.ok()) {
+            set_failed(cntl, rs);
+        }
+    }
+
+    void KvServiceimpl::mset(::google::protobuf::RpcController *cntl_base,
+                            const ::halakv::MultiKvRequest *request,
+                            ::halakv::MultiKvResponse *response,
+                            ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        auto *cntl = static_cast<melon::Controller *>(cntl_base);
+        if (!admit(cntl)) {
+            return;
+        }
+        if (!scope(cntl, request)) {
+            return;
+        }
+        serve_mset(cntl, request, response);
+    }
+
+    void KvServiceimpl::serve_mset(melon::Controller *cntl, const halakv::MultiKvRequest *request,
+                                   halakv::MultiKvResponse *response) {
+        auto rs = KvProxy::instance()->mset(request, response, cntl);
+        if (!rs.ok()) {
+            set_failed(cntl, rs);
+        }
+    }
+
+    void KvServiceimpl::mget(::google::protobuf::RpcController *cntl_base,
+                            const ::halakv::MultiKvRequest *request,
+                            ::halakv::MultiKvResponse *response,
+                            ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        auto *cntl = static_cast<melon::Controller *>(cntl_base);
+        if (!admit(cntl)) {
+            return;
+        }
+        if (!scope(cntl, request)) {
+            return;
+        }
+        serve_mget(cntl, request, response);
+        if (cntl->Failed()) {
+            return;
+        }
+        size_t value_bytes = 0;
+        for (auto &item: response->responses()) {
+            value_bytes += item.value().size();
+        }
+        Compressor::instance()->rpc_compress(cntl, value_bytes);
+    }
+
+    void KvServiceimpl::serve_mget(melon::Controller *cntl, const halakv::MultiKvRequest *request,
+                                   halakv::MultiKvResponse *response) {
+        auto rs = KvProxy::instance()->mget(request, response, cntl);
+        if (!rs.ok()) {
+            set_failed(cntl, rs);
+        }
+    }
+
+    void KvServiceimpl::mremove(::google::protobuf::RpcController *cntl_base,
+                            const ::halakv::MultiKvRequest *request,
+                            ::halakv::MultiKvResponse *response,
+                            ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        auto *cntl = static_cast<melon::Controller *>(cntl_base);
+        if (!admit(cntl)) {
+            return;
+        }
+        if (!scope(cntl, request)) {
+            return;
+        }
+        serve_mremove(cntl, request, response);
+    }
+
+    void KvServiceimpl::serve_mremove(melon::Controller *cntl, const halakv::MultiKvRequest *request,
+                                      halakv::MultiKvResponse *response) {
+        auto rs = KvProxy::instance()->mremove(request, response, cntl);
+        if (!rs.ok()) {
+            set_failed(cntl, rs);
+        }
+    }
+
+    void KvServiceimpl::peer_set(::google::protobuf::RpcController *cntl_base,
+                            const ::halakv::KvRequest *request,
+                            ::halakv::KvResponse *response,
+                            ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        auto *cntl = static_cast<melon::Controller *>(cntl_base);
+        if (!admit(cntl)) {
+            return;
+        }
+        serve_set(cntl, request, response);
+    }
+
+    void KvServiceimpl::peer_get(::google::protobuf::RpcController *cntl_base,
+                            const ::halakv::KvRequest *request,
+                            ::halakv::KvResponse *response,
+                            ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        auto *cntl = static_cast<melon::Controller *>(cntl_base);
+        if (!admit(cntl)) {
+            return;
+        }
+        serve_get(cntl, request, response);
+    }
+
+    void KvServiceimpl::peer_remove(::google::protobuf::RpcController *cntl_base,
+                            const ::halakv::KvRequest *request,
+                            ::halakv::KvResponse *response,
+                            ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        auto *cntl = static_cast<melon::Controller *>(cntl_base);
+        if (!admit(cntl)) {
+            return;
+        }
+        serve_remove(cntl, request, response);
+    }
+
+    void KvServiceimpl::peer_mset(::google::protobuf::RpcController *cntl_base,
+                            const ::halakv::MultiKvRequest *request,
+                            ::halakv::MultiKvResponse *response,
+                            ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        auto *cntl = static_cast<melon::Controller *>(cntl_base);
+        if (!admit(cntl)) {
+            return;
+        }
+        serve_mset(cntl, request, response);
+    }
+
+    void KvServiceimpl::peer_mget(::google::protobuf::RpcController *cntl_base,
+                            const ::halakv::MultiKvRequest *request,
+                            ::halakv::MultiKvResponse *response,
+                            ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        auto *cntl = static_cast<melon::Controller *>(cntl_base);
+        if (!admit(cntl)) {
+            return;
+        }
+        serve_mget(cntl, request, response);
+    }
+
+    void KvServiceimpl::peer_mremove(::google::protobuf::RpcController *cntl_base,
+                            const ::halakv::MultiKvRequest *request,
+                            ::halakv::MultiKvResponse *response,
+                            ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        auto *cntl = static_cast<melon::Controller *>(cntl_base);
+        if (!admit(cntl)) {
+            return;
+        }
+        serve_mremove(cntl, request, response);
+    }
+
+    void KvServiceimpl::invalidate(::google::protobuf::RpcController *cntl_base,
+                            const ::halakv::InvalidateRequest *request,
+                            ::halakv::KvResponse *response,
+                            ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        KvProxy::instance()->invalidate(request, response);
+    }
+
+    void KvServiceimpl::hints(::google::protobuf::RpcController *cntl_base,
+                            const ::halakv::HintsRequest *request,
+                            ::halakv::HintsResponse *response,
+                            ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        KvProxy::instance()->hints(request, response);
+    }
+
+    void KvServiceimpl::merkle(::google::protobuf::RpcController *cntl_base,
+                            const ::halakv::MerkleRequest *request,
+                            ::halakv::MerkleResponse *response,
+                            ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        KvProxy::instance()->merkle(request, response);
+    }
+
+    void KvServiceimpl::scan(::google::protobuf::RpcController *cntl_base,
+                            const ::halakv::ScanRequest *request,
+                            ::halakv::ScanResponse *response,
+                            ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        KvProxy::instance()->scan(request, response);
+    }
+
+    void KvServiceimpl::replicate(::google::protobuf::RpcController *cntl_base,
+                            const ::halakv::ReplicateRequest *request,
+                            ::halakv::KvResponse *response,
+                            ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        auto *cntl = static_cast<melon::Controller *>(cntl_base);
+        auto rs = KvProxy::instance()->replicate(cntl, request, response);
+        if (!rs.ok()) {
+            set_failed(cntl, rs);
+        }
+    }
+
+    void KvServiceimpl::route(::google::protobuf::RpcController *cntl_base,
+                            const ::halakv::RouteRequest *request,
+                            ::halakv::RouteTable *response,
+                            ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        KvProxy::instance()->route(request, response);
+    }
+
+    void KvServiceimpl::load(::google::protobuf::RpcController *cntl_base,
+                             const ::halakv::LoadRequest *request,
+                             ::halakv::KvResponse *response,
+                             ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        auto *cntl = static_cast<melon::Controller *>(cntl_base);
+        auto rs = BulkLoader::instance()->accept(cntl, request);
+        if (!rs.ok()) {
+            set_failed(cntl, rs);
+            return;
+        }
+        response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+        response->set_message("ok");
+    }
+
+    void KvServiceimpl::watch(::google::protobuf::RpcController *cntl_base,
+                              const ::halakv::WatchRequest *request,
+                              ::halakv::KvResponse *response,
+                              ::google::protobuf::Closure *done) {
+        melon::ClosureGuard done_guard(done);
+        auto *cntl = static_cast<melon::Controller *>(cntl_base);
+        auto rs = KvProxy::instance()->watch(cntl, request);
         if (!rs.ok()) {
-            cntl_base->SetFailed(rs.to_string());
+            set_failed(cntl, rs);
+            return;
         }
+        response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+        response->set_message("ok");
     }
 
 }  // namespace halakv
\ No newline at end of file
@@ -25,13 +25,16 @@
 #include <melon/rpc/server.h>
 #include <halakv/kv.pb.h>
 #include <halakv/cache.h>
+#include <melon/rpc/controller.h>
+#include <melon/var/var.h>
+#include <turbo/utility/status.h>
 
 namespace halakv {
 
     class KvServiceimpl : public KvService {
     public:
 
-        KvServiceimpl() = default;
+        KvServiceimpl();
         ~KvServiceimpl() override = default;
 
         void set(::google::protobuf::RpcController *cntl_base,
@@ -48,5 +51,128 @@ namespace halakv {
                     const ::halakv::KvRequest *request,
                     ::halakv::KvResponse *response,
                     ::google::protobuf::Closure *done) override;
+
+        void mset(::google::protobuf::RpcController *cntl_base,
+                  const ::halakv::MultiKvRequest *request,
+                  ::halakv::MultiKvResponse *response,
+                  ::google::protobuf::Closure *done) override;
+
+        void mget(::google::protobuf::RpcController *cntl_base,
+                  const ::halakv::MultiKvRequest *request,
+                  ::halakv::MultiKvResponse *response,
+                  ::google::protobuf::Closure *done) override;
+
+        void mremove(::google::protobuf::RpcController *cntl_base,
+                     const ::halakv::MultiKvRequest *request,
+                     ::halakv::MultiKvResponse *response,
+                     ::google::protobuf::Closure *done) override;
+
+        void invalidate(::google::protobuf::RpcController *cntl_base,
+                        const ::halakv::InvalidateRequest *request,
+                        ::halakv::KvResponse *response,
+                        ::google::protobuf::Closure *done) override;
+
+        void hints(::google::protobuf::RpcController *cntl_base,
+                   const ::halakv::HintsRequest *request,
+                   ::halakv::HintsResponse *response,
+                   ::google::protobuf::Closure *done) override;
+
+        void merkle(::google::protobuf::RpcController *cntl_base,
+                    const ::halakv::MerkleRequest *request,
+                    ::halakv::MerkleResponse *response,
+                    ::google::protobuf::Closure *done) override;
+
+        void scan(::google::protobuf::RpcController *cntl_base,
+                  const ::halakv::ScanRequest *request,
+                  ::halakv::ScanResponse *response,
+                  ::google::protobuf::Closure *done) override;
+
+        void replicate(::google::protobuf::RpcController *cntl_base,
+                       const ::halakv::ReplicateRequest *request,
+                       ::halakv::KvResponse *response,
+                       ::google::protobuf::Closure *done) override;
+
+        void route(::google::protobuf::RpcController *cntl_base,
+                   const ::halakv::RouteRequest *request,
+                   ::halakv::RouteTable *response,
+                   ::google::protobuf::Closure *done) override;
+
+        void load(::google::protobuf::RpcController *cntl_base,
+                  const ::halakv::LoadRequest *request,
+                  ::halakv::KvResponse *response,
+                  ::google::protobuf::Closure *done) override;
+
+        void watch(::google::protobuf::RpcController *cntl_base,
+                   const ::halakv::WatchRequest *request,
+                   ::halakv::KvResponse *response,
+                   ::google::protobuf::Closure *done) override;
+
+        // the same as set to mremove, for keys scoped already by the peer that
+        // passed the request.
+        void peer_set(::google::protobuf::RpcController *cntl_base,
+                      const ::halakv::KvRequest *request,
+                      ::halakv::KvResponse *response,
+                      ::google::protobuf::Closure *done) override;
+
+        void peer_get(::google::protobuf::RpcController *cntl_base,
+                      const ::halakv::KvRequest *request,
+                      ::halakv::KvResponse *response,
+                      ::google::protobuf::Closure *done) override;
+
+        void peer_remove(::google::protobuf::RpcController *cntl_base,
+                         const ::halakv::KvRequest *request,
+                         ::halakv::KvResponse *response,
+                         ::google::protobuf::Closure *done) override;
+
+        void peer_mset(::google::protobuf::RpcController *cntl_base,
+                       const ::halakv::MultiKvRequest *request,
+                       ::halakv::MultiKvResponse *response,
+                       ::google::protobuf::Closure *done) override;
+
+        void peer_mget(::google::protobuf::RpcController *cntl_base,
+                       const ::halakv::MultiKvRequest *request,
+                       ::halakv::MultiKvResponse *response,
+                       ::google::protobuf::Closure *done) override;
+
+        void peer_mremove(::google::protobuf::RpcController *cntl_base,
+                          const ::halakv::MultiKvRequest *request,
+                          ::halakv::MultiKvResponse *response,
+                          ::google::protobuf::Closure *done) override;
+
+    private:
+        // a request queued past its deadline, or whose client is gone, is failed
+        // before any work is done on it.
+        bool admit(melon::Controller *cntl);
+
+        static void set_failed(melon::Controller *cntl, const turbo::Status &rs);
+
+        // the keys of the request scoped in place to their namespaces, false and
+        // the call failed if a namespace or a key was refused.
+        static bool scope(melon::Controller *cntl, const halakv::KvRequest *request);
+
+        static bool scope(melon::Controller *cntl, const halakv::MultiKvRequest *request);
+
+        // the request served once admitted, and scoped if it came from a client.
+        void serve_set(melon::Controller *cntl, const halakv::KvRequest *request,
+                       halakv::KvResponse *response);
+
+        void serve_get(melon::Controller *cntl, const halakv::KvRequest *request,
+                       halakv::KvResponse *response);
+
+        void serve_remove(melon::Controller *cntl, const halakv::KvRequest *request,
+                          halakv::KvResponse *response);
+
+        void serve_mset(melon::Controller *cntl, const halakv::MultiKvRequest *request,
+                        halakv::MultiKvResponse *response);
+
+        void serve_mget(melon::Controller *cntl, const halakv::MultiKvRequest *request,
+                        halakv::MultiKvResponse *response);
+
+        void serve_mremove(melon::Controller *cntl, const halakv::MultiKvRequest *request,
+                           halakv::MultiKvResponse *response);
+
+    private:
+        melon::var::Adder<int64_t> _expired_count;
+        melon::var::Adder<int64_t> _canceled_count;
     };
 }  // namespace halakv
\ No newline at end of file
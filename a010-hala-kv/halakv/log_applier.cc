@@ -0,0 +1,134 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-1.
+//
+#include <halakv/log_applier.h>
+#include <gflags/gflags.h>
+#include <turbo/log/logging.h>
+
+DECLARE_int32(log_ship_window_bytes);
+
+namespace halakv {
+
+    void LogApplier::init(Cache *replica) {
+        _replica = replica;
+    }
+
+    void LogApplier::expose(const std::string &prefix) {
+        _applied_count.expose_as(prefix, "applied");
+        _gap_count.expose_as(prefix, "gap");
+    }
+
+    turbo::Status LogApplier::accept(melon::Controller *cntl, const halakv::ReplicateRequest *request) {
+        melon::StreamOptions options;
+        options.handler = this;
+        options.max_buf_size = FLAGS_log_ship_window_bytes;
+        melon::StreamId stream;
+        if (melon::StreamAccept(&stream, *cntl, &options) != 0) {
+            return turbo::invalid_argument_error("no stream in the replicate request");
+        }
+        melon::StreamId old_stream;
+        {
+            std::unique_lock lock(_mutex);
+            old_stream = _stream;
+            _stream = stream;
+            // a restarted primary numbers its writes from 1 again.
+            if (request->primary() != _primary || request->incarnation() != _incarnation) {
+                _primary = request->primary();
+                _incarnation = request->incarnation();
+                _applied_seq = 0;
+            }
+            if (request->start_seq() > _applied_seq + 1 && _applied_seq > 0) {
+                _gap_count << 1;
+            }
+        }
+        if (old_stream != melon::INVALID_STREAM_ID) {
+            melon::StreamClose(old_stream);
+        }
+        LOG(INFO) << "replicate writes of " << request->primary() << " from seq " << request->start_seq();
+        return turbo::OkStatus();
+    }
+
+    int LogApplier::on_received_messages(melon::StreamId id, mutil::IOBuf *const messages[], size_t size) {
+        halakv::LogAck ack;
+        {
+            std::unique_lock lock(_mutex);
+            if (id != _stream) {
+                return 0;
+            }
+            halakv::KvResponse response;
+            halakv::KvRequest request;
+            for (size_t i = 0; i < size; i++) {
+                halakv::LogBatch batch;
+                if (!batch.ParseFromString(messages[i]->to_string())) {
+                    LOG(WARNING) << "bad log batch from " << _primary;
+                    continue;
+                }
+                for (auto &entry: batch.entries()) {
+                    // resent after a reconnect.
+                    if (entry.seq() <= _applied_seq) {
+                        continue;
+                    }
+                    if (entry.seq() > _applied_seq + 1 && _applied_seq > 0) {
+                        _gap_count << 1;
+                    }
+                    request.set_key(entry.key());
+                    request.clear_value();
+                    request.clear_expire_at_us();
+                    request.clear_flags();
+                    // a write older than the entry of the replica is dropped.
+                    request.clear_version();
+                    if (entry.has_version()) {
+                        request.set_version(entry.version());
+                    }
+                    if (entry.expire_at_us() != 0) {
+                        request.set_expire_at_us(entry.expire_at_us());
+                    }
+                    if (entry.remove()) {
+                        _replica->remove(&request, &response);
+                    } else {
+                        if (entry.has_value()) {
+                            request.set_value(entry.value());
+                            request.set_flags(entry.flags());
+                        }
+                        _replica->put(&request, &response);
+                    }
+                    _applied_seq = entry.seq();
+                    _applied_count << 1;
+                }
+            }
+            ack.set_seq(_applied_seq);
+        }
+        mutil::IOBuf buf;
+        buf.append(ack.SerializeAsString());
+        if (melon::StreamWrite(id, buf) != 0) {
+            // the primary resends what is not acked on its next stream.
+            VLOG(10) << "ack to primary failed, seq " << ack.seq();
+        }
+        return 0;
+    }
+
+    void LogApplier::on_closed(melon::StreamId id) {
+        std::unique_lock lock(_mutex);
+        if (id == _stream) {
+            _stream = melon::INVALID_STREAM_ID;
+        }
+    }
+
+}  // namespace halakv
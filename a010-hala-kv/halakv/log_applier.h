@@ -0,0 +1,67 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-1.
+//
+#pragma once
+
+#include <halakv/cache.h>
+#include <halakv/kv.pb.h>
+#include <melon/rpc/controller.h>
+#include <melon/rpc/stream.h>
+#include <melon/var/var.h>
+#include <turbo/utility/status.h>
+#include <mutex>
+#include <string>
+
+namespace halakv {
+
+    // LogApplier takes the stream of writes from the primary and applies them
+    // to the replica in seq order, each message is acked with the last seq
+    // applied, which is the credit for the primary to send more. a gap in the
+    // seqs, writes dropped by the primary, is left to anti entropy.
+    class LogApplier : public melon::StreamInputHandler {
+    public:
+        LogApplier() = default;
+
+        void init(Cache *replica);
+
+        void expose(const std::string &prefix);
+
+        // accept the stream of a replicate call, it replaces the stream before.
+        turbo::Status accept(melon::Controller *cntl, const halakv::ReplicateRequest *request);
+
+        int on_received_messages(melon::StreamId id, mutil::IOBuf *const messages[], size_t size) override;
+
+        void on_idle_timeout(melon::StreamId id) override {
+        }
+
+        void on_closed(melon::StreamId id) override;
+
+    private:
+        Cache *_replica{nullptr};
+        std::mutex _mutex;
+        std::string _primary;
+        uint64_t _incarnation{0};
+        melon::StreamId _stream{melon::INVALID_STREAM_ID};
+        uint64_t _applied_seq{0};
+        melon::var::Adder<int64_t> _applied_count;
+        melon::var::Adder<int64_t> _gap_count;
+    };
+
+}  // namespace halakv
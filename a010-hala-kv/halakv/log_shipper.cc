@@ -0,0 +1,265 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-1.
+//
+#include <halakv/log_shipper.h>
+#include <gflags/gflags.h>
+#include <turbo/log/logging.h>
+#include <melon/utility/time.h>
+#include <cerrno>
+
+DEFINE_int64(log_ship_max_bytes, 64 * 1024 * 1024, "Max bytes of writes kept for the backup, the oldest are dropped beyond it");
+DEFINE_int32(log_ship_window_bytes, 1024 * 1024, "Max bytes of writes shipped to the backup and not acked yet");
+DEFINE_int32(log_ship_batch, 256, "Max writes in one message to the backup");
+DEFINE_int32(log_ship_write_timeout_ms, 500, "The stream is reopened if the backup does not take a message in this time");
+
+namespace halakv {
+
+    void LogShipper::init(const std::string &local) {
+        _local = local;
+        _incarnation = mutil::gettimeofday_us();
+    }
+
+    void LogShipper::expose(const std::string &prefix) {
+        _lag_bytes_var = std::make_unique<melon::var::PassiveStatus<int64_t>>(get_lag_bytes, this);
+        _lag_bytes_var->expose_as(prefix, "lag_bytes");
+        _lag_ms_var = std::make_unique<melon::var::PassiveStatus<int64_t>>(get_lag_ms, this);
+        _lag_ms_var->expose_as(prefix, "lag_ms");
+        _shipped_count.expose_as(prefix, "shipped");
+        _drop_count.expose_as(prefix, "drop");
+        _connect_count.expose_as(prefix, "connect");
+    }
+
+    void LogShipper::append(const Cache::Write &write) {
+        Entry entry;
+        entry.key = write.key;
+        entry.remove = write.remove;
+        entry.version = write.version;
+        if (!write.remove) {
+            entry.has_value = write.value != nullptr;
+            if (write.value != nullptr) {
+                entry.value = *write.value;
+            }
+            entry.expire_at_us = write.expire_at_us;
+            entry.flags = write.flags;
+        }
+        entry.time_us = mutil::gettimeofday_us();
+        entry.bytes = entry.key.size() + entry.value.size() + sizeof(Entry);
+        std::unique_lock lock(_mutex);
+        entry.seq = _next_seq++;
+        while (!_log.empty() && _log_bytes + entry.bytes > static_cast<size_t>(FLAGS_log_ship_max_bytes)) {
+            auto &front = _log.front();
+            _log_bytes -= front.bytes;
+            if (front.seq <= _sent_seq) {
+                _inflight_bytes -= front.bytes;
+            }
+            _log.pop_front();
+            _drop_count << 1;
+        }
+        _log_bytes += entry.bytes;
+        _log.push_back(std::move(entry));
+    }
+
+    turbo::Status LogShipper::ship(const std::string &backup, RouterSender *sender) {
+        if (backup != _backup || _stream == melon::INVALID_STREAM_ID || _broken.load(std::memory_order_acquire)) {
+            auto rs = connect(backup, sender);
+            if (!rs.ok()) {
+                return rs;
+            }
+        }
+        while (true) {
+            mutil::IOBuf buf;
+            melon::StreamId stream;
+            {
+                std::unique_lock lock(_mutex);
+                if (_log.empty() || _log.back().seq <= _sent_seq) {
+                    return turbo::OkStatus();
+                }
+                // seqs in the log are contiguous, only the front is ever dropped.
+                size_t offset = _log.front().seq > _sent_seq ? 0 : _sent_seq - _log.front().seq + 1;
+                halakv::LogBatch batch;
+                size_t bytes = 0;
+                for (size_t i = offset; i < _log.size() && batch.entries_size() < FLAGS_log_ship_batch; i++) {
+                    auto &entry = _log[i];
+                    if (_inflight_bytes + bytes + entry.bytes > static_cast<size_t>(FLAGS_log_ship_window_bytes) &&
+                        _inflight_bytes + bytes > 0) {
+                        break;
+                    }
+                    auto *item = batch.add_entries();
+                    item->set_seq(entry.seq);
+                    item->set_key(entry.key);
+                    item->set_version(entry.version);
+                    if (entry.remove) {
+                        item->set_remove(true);
+                    } else if (entry.has_value) {
+                        item->set_value(entry.value);
+                    }
+                    if (entry.expire_at_us != 0) {
+                        item->set_expire_at_us(entry.expire_at_us);
+                    }
+                    if (entry.flags != 0) {
+                        item->set_flags(entry.flags);
+                    }
+                    bytes += entry.bytes;
+                }
+                if (batch.entries_size() == 0) {
+                    // out of credits, wait for the backup to ack.
+                    return turbo::OkStatus();
+                }
+                // taken as sent before the write, so that an ack racing with it is accounted.
+                _sent_seq = batch.entries(batch.entries_size() - 1).seq();
+                _inflight_bytes += bytes;
+                _shipped_count << batch.entries_size();
+                buf.append(batch.SerializeAsString());
+                stream = _stream;
+            }
+            auto rs = write(stream, buf);
+            if (!rs.ok()) {
+                _broken.store(true, std::memory_order_release);
+                return rs;
+            }
+        }
+    }
+
+    turbo::Status LogShipper::connect(const std::string &backup, RouterSender *sender) {
+        halakv::ReplicateRequest request;
+        melon::StreamId old_stream;
+        {
+            std::unique_lock lock(_mutex);
+            old_stream = release_locked();
+            // everything not acked is sent again on the new stream.
+            _sent_seq = _log.empty() ? _next_seq - 1 : _log.front().seq - 1;
+            _inflight_bytes = 0;
+            _backup.clear();
+            request.set_primary(_local);
+            request.set_incarnation(_incarnation);
+            request.set_start_seq(_sent_seq + 1);
+        }
+        if (old_stream != melon::INVALID_STREAM_ID) {
+            melon::StreamClose(old_stream);
+        }
+        _broken.store(false, std::memory_order_release);
+        melon::StreamOptions options;
+        options.handler = this;
+        options.max_buf_size = FLAGS_log_ship_window_bytes;
+        melon::StreamId stream;
+        halakv::KvResponse response;
+        auto rs = sender->replicate(request, response, options, &stream);
+        if (!rs.ok()) {
+            return rs;
+        }
+        std::unique_lock lock(_mutex);
+        _stream = stream;
+        _backup = backup;
+        _connect_count << 1;
+        LOG(INFO) << "ship writes to backup " << backup << " from seq " << request.start_seq();
+        return turbo::OkStatus();
+    }
+
+    void LogShipper::reset() {
+        melon::StreamId stream;
+        {
+            std::unique_lock lock(_mutex);
+            stream = release_locked();
+            _backup.clear();
+            _log.clear();
+            _log_bytes = 0;
+            _inflight_bytes = 0;
+            _sent_seq = _next_seq - 1;
+        }
+        if (stream != melon::INVALID_STREAM_ID) {
+            melon::StreamClose(stream);
+        }
+    }
+
+    melon::StreamId LogShipper::release_locked() {
+        auto stream = _stream;
+        _stream = melon::INVALID_STREAM_ID;
+        return stream;
+    }
+
+    turbo::Status LogShipper::write(melon::StreamId stream, const mutil::IOBuf &buf) {
+        while (true) {
+            auto rc = melon::StreamWrite(stream, buf);
+            if (rc == 0) {
+                return turbo::OkStatus();
+            }
+            if (rc != EAGAIN) {
+                return turbo::unavailable_error(turbo::substitute("write to backup $0 failed: $1", _backup, rc));
+            }
+            // the stream buffer of the backup is full.
+            auto due = mutil::milliseconds_from_now(FLAGS_log_ship_write_timeout_ms);
+            rc = melon::StreamWait(stream, &due);
+            if (rc != 0) {
+                return turbo::unavailable_error(turbo::substitute("wait for backup $0 failed: $1", _backup, rc));
+            }
+        }
+    }
+
+    int LogShipper::on_received_messages(melon::StreamId id, mutil::IOBuf *const messages[], size_t size) {
+        uint64_t acked = 0;
+        for (size_t i = 0; i < size; i++) {
+            halakv::LogAck ack;
+            if (ack.ParseFromString(messages[i]->to_string())) {
+                acked = std::max<uint64_t>(acked, ack.seq());
+            }
+        }
+        std::unique_lock lock(_mutex);
+        if (id != _stream) {
+            return 0;
+        }
+        while (!_log.empty() && _log.front().seq <= acked) {
+            auto &front = _log.front();
+            _log_bytes -= front.bytes;
+            if (front.seq <= _sent_seq) {
+                _inflight_bytes -= front.bytes;
+            }
+            _log.pop_front();
+        }
+        return 0;
+    }
+
+    void LogShipper::on_closed(melon::StreamId id) {
+        std::unique_lock lock(_mutex);
+        if (id == _stream) {
+            _broken.store(true, std::memory_order_release);
+        }
+    }
+
+    void LogShipper::on_failed(melon::StreamId id, int error_code, const std::string &error_text) {
+        LOG(WARNING) << "stream " << id << " to backup failed: " << error_text;
+        on_closed(id);
+    }
+
+    int64_t LogShipper::get_lag_bytes(void *arg) {
+        auto *self = static_cast<LogShipper *>(arg);
+        std::unique_lock lock(self->_mutex);
+        return self->_log_bytes;
+    }
+
+    int64_t LogShipper::get_lag_ms(void *arg) {
+        auto *self = static_cast<LogShipper *>(arg);
+        std::unique_lock lock(self->_mutex);
+        if (self->_log.empty()) {
+            return 0;
+        }
+        return (mutil::gettimeofday_us() - self->_log.front().time_us) / 1000;
+    }
+
+}  // namespace halakv
@@ -0,0 +1,117 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-1.
+//
+#pragma once
+
+#include <halakv/cache.h>
+#include <halakv/kv.pb.h>
+#include <halakv/router_sender.h>
+#include <melon/rpc/stream.h>
+#include <melon/var/var.h>
+#include <turbo/utility/status.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace halakv {
+
+    // LogShipper streams the writes of the local cache to the backup peer in
+    // sequence order. writes are kept in memory until the backup acks them,
+    // bounded by log_ship_max_bytes, the oldest are dropped beyond that and the
+    // backup is left to anti entropy. at most log_ship_window_bytes are in
+    // flight, the backup grants more credits by acking what it applied.
+    class LogShipper : public melon::StreamInputHandler {
+    public:
+        LogShipper() = default;
+
+        void init(const std::string &local);
+
+        void expose(const std::string &prefix);
+
+        // a write applied by the local cache, called from its write listener so
+        // that the writes are shipped in the order the cache took them. a set
+        // without a value carries only the expiry of the key.
+        void append(const Cache::Write &write);
+
+        // send what is pending to the backup, a new stream is opened when the
+        // backup changed or the stream broke and the unacked writes are resent.
+        turbo::Status ship(const std::string &backup, RouterSender *sender);
+
+        // no backup, the writes are not kept.
+        void reset();
+
+        int on_received_messages(melon::StreamId id, mutil::IOBuf *const messages[], size_t size) override;
+
+        void on_idle_timeout(melon::StreamId id) override {
+        }
+
+        void on_closed(melon::StreamId id) override;
+
+        void on_failed(melon::StreamId id, int error_code, const std::string &error_text) override;
+
+    private:
+        struct Entry {
+            uint64_t seq{0};
+            std::string key;
+            std::string value;
+            bool remove{false};
+            bool has_value{false};
+            uint64_t expire_at_us{0};
+            uint64_t version{0};
+            uint32_t flags{0};
+            int64_t time_us{0};
+            size_t bytes{0};
+        };
+
+        turbo::Status connect(const std::string &backup, RouterSender *sender);
+
+        // the stream is closed by the caller out of the lock.
+        melon::StreamId release_locked();
+
+        turbo::Status write(melon::StreamId stream, const mutil::IOBuf &buf);
+
+        static int64_t get_lag_bytes(void *arg);
+
+        static int64_t get_lag_ms(void *arg);
+
+    private:
+        std::string _local;
+        // the seqs are numbered from 1 in each incarnation.
+        uint64_t _incarnation{0};
+        std::mutex _mutex;
+        // unacked writes in seq order, the ones after _sent_seq are not sent yet.
+        std::deque<Entry> _log;
+        size_t _log_bytes{0};
+        size_t _inflight_bytes{0};
+        uint64_t _next_seq{1};
+        uint64_t _sent_seq{0};
+        std::string _backup;
+        melon::StreamId _stream{melon::INVALID_STREAM_ID};
+        std::atomic<bool> _broken{false};
+        std::unique_ptr<melon::var::PassiveStatus<int64_t>> _lag_bytes_var;
+        std::unique_ptr<melon::var::PassiveStatus<int64_t>> _lag_ms_var;
+        melon::var::Adder<int64_t> _shipped_count;
+        melon::var::Adder<int64_t> _drop_count;
+        melon::var::Adder<int64_t> _connect_count;
+    };
+
+}  // namespace halakv
@@ -0,0 +1,466 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-29.
+//
+#include <halakv/membership.h>
+#include <halakv/hlc.h>
+#include <gflags/gflags.h>
+#include <turbo/log/logging.h>
+#include <melon/rpc/controller.h>
+#include <melon/rpc/server.h>
+#include <melon/utility/fast_rand.h>
+#include <melon/utility/time.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+DEFINE_int32(gossip_interval_ms, 500, "Interval to probe one member");
+DEFINE_int32(gossip_ping_timeout_ms, 150, "Timeout of a direct probe, indirect probes wait three times of it");
+DEFINE_int32(gossip_indirect_probes, 3, "Members asked to probe a member that did not ack a direct probe");
+DEFINE_int32(gossip_suspect_timeout_ms, 3000, "A suspected member not refuting in this time is declared dead");
+DEFINE_int32(gossip_max_piggyback, 8, "Max membership updates piggybacked on one message");
+DEFINE_int32(gossip_retransmit_mult, 3, "Each update is piggybacked this times of log2(members) times");
+DEFINE_int32(gossip_join_grace_ms, 5000, "A member failing probes is not suspected in this time after it joined");
+DEFINE_int32(gossip_dead_probe_interval_ms, 5000, "Interval to probe a dead member, so a healed partition merges back");
+
+namespace halakv {
+
+    turbo::Status Membership::init(const std::string &local, const std::vector<std::string> &seeds, Listener listener) {
+        _local = local;
+        _listener = std::move(listener);
+        // a restarted node starts above every incarnation of its previous run, so
+        // that it is not taken for the dead one it was.
+        _incarnation = mutil::gettimeofday_ms();
+        auto now = mutil::gettimeofday_us();
+        for (auto &seed: seeds) {
+            if (seed == _local) {
+                continue;
+            }
+            Member member;
+            member.address = seed;
+            member.state_us = now;
+            member.joined_us = now;
+            _members.emplace(seed, member);
+        }
+        _live_var = std::make_unique<melon::var::PassiveStatus<int64_t>>(get_live_count, this);
+        _live_var->expose_as("halakv_gossip", "live_members");
+        _ping_count.expose_as("halakv_gossip", "ping");
+        _ping_fail_count.expose_as("halakv_gossip", "ping_fail");
+        _ping_req_count.expose_as("halakv_gossip", "ping_req");
+        _suspect_count.expose_as("halakv_gossip", "suspect");
+        _dead_count.expose_as("halakv_gossip", "dead");
+        return turbo::OkStatus();
+    }
+
+    void Membership::start() {
+        {
+            // the seeds may be starting along with the local node.
+            std::unique_lock lock(_mutex);
+            auto now = mutil::gettimeofday_us();
+            for (auto &it: _members) {
+                it.second.joined_us = now;
+            }
+        }
+        _fiber.run([this]() {
+            run();
+        });
+    }
+
+    void Membership::run() {
+        while (!melon::IsAskedToQuit()) {
+            auto start_us = mutil::gettimeofday_us();
+            probe_round();
+            auto left_us = 1000L * FLAGS_gossip_interval_ms - (mutil::gettimeofday_us() - start_us);
+            if (left_us > 0) {
+                fiber_usleep(left_us);
+            }
+        }
+    }
+
+    void Membership::probe_round() {
+        Events events;
+        {
+            std::unique_lock lock(_mutex);
+            expire_suspects(&events);
+        }
+        notify(events);
+        auto target = next_target();
+        if (target.empty()) {
+            return;
+        }
+        _ping_count << 1;
+        if (send_ping(target, target, FLAGS_gossip_ping_timeout_ms)) {
+            return;
+        }
+        _ping_fail_count << 1;
+        if (probe_indirect(target)) {
+            return;
+        }
+        events.clear();
+        {
+            std::unique_lock lock(_mutex);
+            auto it = _members.find(target);
+            auto now = mutil::gettimeofday_us();
+            if (it != _members.end() && it->second.state == MEMBER_ALIVE &&
+                now - it->second.joined_us >= 1000L * FLAGS_gossip_join_grace_ms) {
+                _suspect_count << 1;
+                set_state_locked(it->second, it->second.incarnation, MEMBER_SUSPECT, &events);
+            }
+        }
+        notify(events);
+    }
+
+    std::string Membership::next_target() {
+        std::unique_lock lock(_mutex);
+        auto now = mutil::gettimeofday_us();
+        if (now - _last_dead_probe_us > 1000L * FLAGS_gossip_dead_probe_interval_ms) {
+            _last_dead_probe_us = now;
+            std::vector<const std::string *> dead;
+            for (auto &it: _members) {
+                if (it.second.state == MEMBER_DEAD) {
+                    dead.push_back(&it.first);
+                }
+            }
+            if (!dead.empty()) {
+                return *dead[mutil::fast_rand_less_than(dead.size())];
+            }
+        }
+        for (int round = 0; round < 2; round++) {
+            while (_probe_pos < _probe_order.size()) {
+                auto &address = _probe_order[_probe_pos++];
+                auto it = _members.find(address);
+                if (it != _members.end() && it->second.state != MEMBER_DEAD) {
+                    return address;
+                }
+            }
+            _probe_order.clear();
+            _probe_pos = 0;
+            for (auto &it: _members) {
+                if (it.second.state != MEMBER_DEAD) {
+                    _probe_order.push_back(it.first);
+                }
+            }
+            for (size_t i = _probe_order.size(); i > 1; i--) {
+                std::swap(_probe_order[i - 1], _probe_order[mutil::fast_rand_less_than(i)]);
+            }
+        }
+        return std::string();
+    }
+
+    bool Membership::send_ping(const std::string &address, const std::string &target, int64_t timeout_ms) {
+        auto channel = get_channel(address);
+        if (channel == nullptr) {
+            return false;
+        }
+        ::halakv::GossipRequest request;
+        ::halakv::GossipResponse response;
+        {
+            std::unique_lock lock(_mutex);
+            request.set_from(_local);
+            request.set_clock(Hlc::instance()->now());
+            if (address != target) {
+                request.set_target(target);
+            }
+            fill_updates_locked(request.mutable_updates());
+            // let a member we suspect or declared dead know, so it can refute.
+            auto it = _members.find(address);
+            if (it != _members.end() && it->second.state != MEMBER_ALIVE) {
+                auto *update = request.add_updates();
+                update->set_address(address);
+                update->set_incarnation(it->second.incarnation);
+                update->set_state(it->second.state);
+            }
+        }
+        melon::Controller cntl;
+        cntl.set_timeout_ms(timeout_ms);
+        ::halakv::GossipService_Stub stub(channel.get());
+        if (address == target) {
+            stub.ping(&cntl, &request, &response, nullptr);
+        } else {
+            stub.ping_req(&cntl, &request, &response, nullptr);
+        }
+        if (cntl.Failed()) {
+            VLOG(10) << "gossip to " << address << " for " << target << " failed: " << cntl.ErrorText();
+            return false;
+        }
+        Hlc::instance()->update(response.clock());
+        Events events;
+        {
+            std::unique_lock lock(_mutex);
+            for (auto &update: response.updates()) {
+                apply_locked(update, &events);
+            }
+        }
+        notify(events);
+        return response.code() == static_cast<int>(turbo::StatusCode::kOk);
+    }
+
+    bool Membership::probe_indirect(const std::string &target) {
+        std::vector<std::string> helpers;
+        {
+            std::unique_lock lock(_mutex);
+            for (auto &it: _members) {
+                if (it.second.state == MEMBER_ALIVE && it.first != target) {
+                    helpers.push_back(it.first);
+                }
+            }
+        }
+        auto k = std::min<size_t>(helpers.size(), std::max(FLAGS_gossip_indirect_probes, 0));
+        for (size_t i = 0; i < k; i++) {
+            std::swap(helpers[i], helpers[i + mutil::fast_rand_less_than(helpers.size() - i)]);
+        }
+        helpers.resize(k);
+        if (helpers.empty()) {
+            return false;
+        }
+        std::atomic<bool> acked{false};
+        std::vector<Fiber> fibers(helpers.size());
+        for (size_t i = 0; i < helpers.size(); i++) {
+            _ping_req_count << 1;
+            fibers[i].run([this, i, &helpers, &target, &acked]() {
+                if (send_ping(helpers[i], target, 3L * FLAGS_gossip_ping_timeout_ms)) {
+                    acked.store(true, std::memory_order_relaxed);
+                }
+            });
+        }
+        for (auto &fiber: fibers) {
+            fiber.join();
+        }
+        return acked.load(std::memory_order_relaxed);
+    }
+
+    void Membership::expire_suspects(Events *events) {
+        auto now = mutil::gettimeofday_us();
+        for (auto &it: _members) {
+            auto &member = it.second;
+            if (member.state == MEMBER_SUSPECT && now - member.state_us > 1000L * FLAGS_gossip_suspect_timeout_ms) {
+                _dead_count << 1;
+                set_state_locked(member, member.incarnation, MEMBER_DEAD, events);
+            }
+        }
+    }
+
+    void Membership::ping(const ::halakv::GossipRequest *request, ::halakv::GossipResponse *response) {
+        Hlc::instance()->update(request->clock());
+        response->set_clock(Hlc::instance()->now());
+        Events events;
+        {
+            std::unique_lock lock(_mutex);
+            bool known = _members.find(request->from()) != _members.end();
+            for (auto &update: request->updates()) {
+                apply_locked(update, &events);
+            }
+            // a joining node gets the whole membership at once.
+            if (known) {
+                fill_updates_locked(response->mutable_updates());
+            } else {
+                fill_all_locked(response->mutable_updates());
+            }
+        }
+        notify(events);
+        response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+        response->set_message("ok");
+    }
+
+    void Membership::ping_req(const ::halakv::GossipRequest *request, ::halakv::GossipResponse *response) {
+        if (!request->has_target() || request->target() == _local) {
+            response->set_code(static_cast<int>(turbo::StatusCode::kInvalidArgument));
+            response->set_message("bad target");
+            return;
+        }
+        Hlc::instance()->update(request->clock());
+        Events events;
+        {
+            std::unique_lock lock(_mutex);
+            for (auto &update: request->updates()) {
+                apply_locked(update, &events);
+            }
+        }
+        notify(events);
+        auto acked = send_ping(request->target(), request->target(), FLAGS_gossip_ping_timeout_ms);
+        response->set_clock(Hlc::instance()->now());
+        {
+            std::unique_lock lock(_mutex);
+            fill_updates_locked(response->mutable_updates());
+        }
+        if (acked) {
+            response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+            response->set_message("ok");
+        } else {
+            response->set_code(static_cast<int>(turbo::StatusCode::kUnavailable));
+            response->set_message("no ack");
+        }
+    }
+
+    void Membership::apply_locked(const MemberUpdate &update, Events *events) {
+        if (update.address() == _local) {
+            if (update.state() != MEMBER_ALIVE && update.incarnation() >= _incarnation) {
+                LOG(WARNING) << "local member is " << MemberState_Name(update.state())
+                             << " to others, refute with incarnation " << update.incarnation() + 1;
+                _incarnation = update.incarnation() + 1;
+                if (update.state() == MEMBER_DEAD) {
+                    events->emplace_back(_local, MEMBER_DEAD);
+                }
+            }
+            return;
+        }
+        auto it = _members.find(update.address());
+        if (it == _members.end()) {
+            Member member;
+            member.address = update.address();
+            member.incarnation = update.incarnation();
+            member.state = update.state();
+            member.state_us = mutil::gettimeofday_us();
+            member.joined_us = member.state_us;
+            _members.emplace(member.address, member);
+            if (member.state != MEMBER_DEAD) {
+                LOG(INFO) << "member " << member.address << " joined as " << MemberState_Name(member.state);
+                events->emplace_back(member.address, member.state);
+            }
+            broadcast_locked(member.address, member.incarnation, member.state);
+            return;
+        }
+        auto &member = it->second;
+        bool newer;
+        switch (update.state()) {
+            case MEMBER_ALIVE:
+                newer = update.incarnation() > member.incarnation;
+                break;
+            case MEMBER_SUSPECT:
+                newer = update.incarnation() > member.incarnation ||
+                        (update.incarnation() == member.incarnation && member.state == MEMBER_ALIVE);
+                break;
+            default:
+                newer = update.incarnation() > member.incarnation ||
+                        (update.incarnation() == member.incarnation && member.state != MEMBER_DEAD);
+                break;
+        }
+        if (newer) {
+            set_state_locked(member, update.incarnation(), update.state(), events);
+        }
+    }
+
+    void Membership::set_state_locked(Member &member, uint64_t incarnation, MemberState state, Events *events) {
+        if (member.state != state) {
+            LOG(INFO) << "member " << member.address << " " << MemberState_Name(member.state) << " -> "
+                      << MemberState_Name(state) << " incarnation " << incarnation;
+            member.state_us = mutil::gettimeofday_us();
+            if (member.state == MEMBER_DEAD) {
+                member.joined_us = member.state_us;
+            }
+            events->emplace_back(member.address, state);
+        }
+        member.incarnation = incarnation;
+        member.state = state;
+        broadcast_locked(member.address, incarnation, state);
+    }
+
+    void Membership::broadcast_locked(const std::string &address, uint64_t incarnation, MemberState state) {
+        auto &broadcast = _broadcasts[address];
+        broadcast.update.set_address(address);
+        broadcast.update.set_incarnation(incarnation);
+        broadcast.update.set_state(state);
+        broadcast.transmits = 0;
+    }
+
+    void Membership::fill_updates_locked(google::protobuf::RepeatedPtrField<MemberUpdate> *updates) {
+        auto *local = updates->Add();
+        local->set_address(_local);
+        local->set_incarnation(_incarnation);
+        local->set_state(MEMBER_ALIVE);
+        if (_broadcasts.empty()) {
+            return;
+        }
+        const int limit = FLAGS_gossip_retransmit_mult * static_cast<int>(std::ceil(std::log2(_members.size() + 2)));
+        std::vector<Broadcast *> pending;
+        pending.reserve(_broadcasts.size());
+        for (auto &it: _broadcasts) {
+            pending.push_back(&it.second);
+        }
+        auto n = std::min<size_t>(pending.size(), std::max(FLAGS_gossip_max_piggyback, 0));
+        std::partial_sort(pending.begin(), pending.begin() + n, pending.end(),
+                          [](const Broadcast *a, const Broadcast *b) {
+                              return a->transmits < b->transmits;
+                          });
+        std::vector<std::string> done;
+        for (size_t i = 0; i < n; i++) {
+            *updates->Add() = pending[i]->update;
+            if (++pending[i]->transmits >= limit) {
+                done.push_back(pending[i]->update.address());
+            }
+        }
+        for (auto &address: done) {
+            _broadcasts.erase(address);
+        }
+    }
+
+    void Membership::fill_all_locked(google::protobuf::RepeatedPtrField<MemberUpdate> *updates) {
+        auto *local = updates->Add();
+        local->set_address(_local);
+        local->set_incarnation(_incarnation);
+        local->set_state(MEMBER_ALIVE);
+        for (auto &it: _members) {
+            auto *update = updates->Add();
+            update->set_address(it.first);
+            update->set_incarnation(it.second.incarnation);
+            update->set_state(it.second.state);
+        }
+    }
+
+    void Membership::notify(const Events &events) {
+        if (!_listener) {
+            return;
+        }
+        for (auto &event: events) {
+            _listener(event.first, event.second);
+        }
+    }
+
+    std::shared_ptr<melon::Channel> Membership::get_channel(const std::string &address) {
+        std::unique_lock lock(_channel_mutex);
+        auto it = _channels.find(address);
+        if (it != _channels.end()) {
+            return it->second;
+        }
+        melon::ChannelOptions options;
+        options.timeout_ms = FLAGS_gossip_ping_timeout_ms;
+        options.connect_timeout_ms = FLAGS_gossip_ping_timeout_ms;
+        options.max_retry = 0;
+        auto channel = std::make_shared<melon::Channel>();
+        if (channel->Init(address.c_str(), &options) != 0) {
+            LOG(WARNING) << "init gossip channel to " << address << " failed";
+            return nullptr;
+        }
+        _channels[address] = channel;
+        return channel;
+    }
+
+    int64_t Membership::get_live_count(void *arg) {
+        auto *self = static_cast<Membership *>(arg);
+        std::unique_lock lock(self->_mutex);
+        int64_t count = 1;
+        for (auto &it: self->_members) {
+            if (it.second.state != MEMBER_DEAD) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+}  // namespace halakv
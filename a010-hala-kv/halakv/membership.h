@@ -0,0 +1,142 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-29.
+//
+#pragma once
+
+#include <halakv/kv.pb.h>
+#include <halakv/fiber.h>
+#include <melon/rpc/channel.h>
+#include <melon/var/var.h>
+#include <turbo/utility/status.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace halakv {
+
+    // Membership is a SWIM style failure detector. every interval one member is
+    // probed with ping, if it does not ack, a few other members are asked to probe
+    // it with ping_req, and it is only suspected if none of them gets an ack. a
+    // suspected member that does not refute by a higher incarnation before the
+    // suspicion timeout is declared dead. membership updates are piggybacked on
+    // the probes, each for a number of times growing with log(n) and at most
+    // gossip_max_piggyback of them per message, so the traffic per node does not
+    // grow with the cluster.
+    class Membership {
+    public:
+        // called out of the lock on every state change of a member, a new member
+        // is reported on its first state. the local member is reported dead when it
+        // learns that the others declared it dead.
+        using Listener = std::function<void(const std::string &address, MemberState state)>;
+
+        static Membership *instance() {
+            static Membership ins;
+            return &ins;
+        }
+
+        // seeds are the members known at start, they are taken as alive and
+        // probed first, a new node joins by probing any of them.
+        turbo::Status init(const std::string &local, const std::vector<std::string> &seeds, Listener listener);
+
+        // starts probing, once the local server listens, so that the others do
+        // not find the local member before it can ack.
+        void start();
+
+        void ping(const ::halakv::GossipRequest *request, ::halakv::GossipResponse *response);
+
+        void ping_req(const ::halakv::GossipRequest *request, ::halakv::GossipResponse *response);
+
+    private:
+        struct Member {
+            std::string address;
+            uint64_t incarnation{0};
+            MemberState state{MEMBER_ALIVE};
+            int64_t state_us{0};
+            // when the member was first seen, or came back from dead, it is not
+            // suspected within gossip_join_grace_ms of it, it may be starting.
+            int64_t joined_us{0};
+        };
+
+        struct Broadcast {
+            MemberUpdate update;
+            int transmits{0};
+        };
+
+        using Events = std::vector<std::pair<std::string, MemberState>>;
+
+        Membership() = default;
+
+        void run();
+
+        void probe_round();
+
+        // returns the member to probe, round robin over a shuffled order of the
+        // live members, a dead member is tried now and then to heal partitions.
+        std::string next_target();
+
+        bool send_ping(const std::string &address, const std::string &target, int64_t timeout_ms);
+
+        bool probe_indirect(const std::string &target);
+
+        void expire_suspects(Events *events);
+
+        // merge a update by the SWIM precedence of incarnation and state.
+        void apply_locked(const MemberUpdate &update, Events *events);
+
+        void set_state_locked(Member &member, uint64_t incarnation, MemberState state, Events *events);
+
+        void broadcast_locked(const std::string &address, uint64_t incarnation, MemberState state);
+
+        // the local alive state first, then the pending broadcasts least sent.
+        void fill_updates_locked(google::protobuf::RepeatedPtrField<MemberUpdate> *updates);
+
+        void fill_all_locked(google::protobuf::RepeatedPtrField<MemberUpdate> *updates);
+
+        void notify(const Events &events);
+
+        std::shared_ptr<melon::Channel> get_channel(const std::string &address);
+
+        static int64_t get_live_count(void *arg);
+
+    private:
+        std::string _local;
+        uint64_t _incarnation{0};
+        Listener _listener;
+        std::mutex _mutex;
+        std::map<std::string, Member> _members;
+        std::map<std::string, Broadcast> _broadcasts;
+        std::vector<std::string> _probe_order;
+        size_t _probe_pos{0};
+        int64_t _last_dead_probe_us{0};
+        std::mutex _channel_mutex;
+        std::map<std::string, std::shared_ptr<melon::Channel>> _channels;
+        Fiber _fiber;
+        std::unique_ptr<melon::var::PassiveStatus<int64_t>> _live_var;
+        melon::var::Adder<int64_t> _ping_count;
+        melon::var::Adder<int64_t> _ping_fail_count;
+        melon::var::Adder<int64_t> _ping_req_count;
+        melon::var::Adder<int64_t> _suspect_count;
+        melon::var::Adder<int64_t> _dead_count;
+    };
+
+}  // namespace halakv
@@ -0,0 +1,513 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-11.
+//
+#include <halakv/memcache_service.h>
+#include <halakv/fiber.h>
+#include <halakv/kv_proxy.h>
+#include <halakv/namespaces.h>
+#include <gflags/gflags.h>
+#include <melon/utility/time.h>
+#include <turbo/strings/substitute.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+
+DEFINE_int32(memcache_max_body_bytes, 32 * 1024 * 1024, "A memcache request with a larger body closes the connection");
+
+namespace halakv {
+
+    namespace {
+
+        constexpr size_t kHeaderSize = 24;
+        constexpr uint8_t kRequestMagic = 0x80;
+        constexpr uint8_t kResponseMagic = 0x81;
+
+        enum Opcode : uint8_t {
+            kGet = 0x00,
+            kSet = 0x01,
+            kAdd = 0x02,
+            kDelete = 0x04,
+            kIncr = 0x05,
+            kQuit = 0x07,
+            kGetQ = 0x09,
+            kNoop = 0x0a,
+            kVersion = 0x0b,
+            kGetK = 0x0c,
+            kGetKQ = 0x0d,
+            kSetQ = 0x11,
+            kAddQ = 0x12,
+            kDeleteQ = 0x14,
+            kIncrQ = 0x15,
+            kQuitQ = 0x17,
+        };
+
+        enum Status : uint16_t {
+            kNoError = 0x0000,
+            kKeyNotFound = 0x0001,
+            kKeyExists = 0x0002,
+            kInvalidArguments = 0x0004,
+            kNonNumeric = 0x0006,
+            kUnknownCommand = 0x0081,
+            kInternalError = 0x0084,
+            kTemporaryFailure = 0x0086,
+        };
+
+        bool is_get(uint8_t opcode) {
+            return opcode == kGet || opcode == kGetQ || opcode == kGetK || opcode == kGetKQ;
+        }
+
+        bool is_quiet(uint8_t opcode) {
+            return opcode == kGetQ || opcode == kGetKQ || opcode == kSetQ || opcode == kAddQ ||
+                   opcode == kDeleteQ || opcode == kIncrQ || opcode == kQuitQ;
+        }
+
+        uint64_t read_be(std::string_view buf, size_t offset, size_t bytes) {
+            uint64_t value = 0;
+            for (size_t i = 0; i < bytes; i++) {
+                value = (value << 8) | static_cast<uint8_t>(buf[offset + i]);
+            }
+            return value;
+        }
+
+        // memcached takes up to 30 days as seconds from now, a unix time beyond.
+        uint64_t expire_at_of(uint64_t expiration) {
+            constexpr uint64_t kMaxRelative = 30 * 24 * 3600;
+            if (expiration == 0) {
+                return 0;
+            }
+            if (expiration <= kMaxRelative) {
+                return mutil::gettimeofday_us() + expiration * 1000000;
+            }
+            return expiration * 1000000;
+        }
+
+        void append_be(uint64_t value, size_t bytes, std::string *out) {
+            for (size_t i = bytes; i > 0; i--) {
+                out->push_back(static_cast<char>((value >> ((i - 1) * 8)) & 0xff));
+            }
+        }
+
+        uint16_t status_of(const turbo::Status &rs, const halakv::KvResponse &response) {
+            if (!rs.ok()) {
+                return rs.code() == turbo::StatusCode::kResourceExhausted ? kTemporaryFailure : kInternalError;
+            }
+            if (response.code() == static_cast<int>(turbo::StatusCode::kOk)) {
+                return kNoError;
+            }
+            if (response.code() == static_cast<int>(turbo::StatusCode::kNotFound)) {
+                return kKeyNotFound;
+            }
+            if (response.code() == static_cast<int>(turbo::StatusCode::kAlreadyExists)) {
+                return kKeyExists;
+            }
+            if (response.code() == static_cast<int>(turbo::StatusCode::kInvalidArgument)) {
+                // the value of an incr is not a number.
+                return kNonNumeric;
+            }
+            return kInternalError;
+        }
+
+    }  // namespace
+
+    turbo::Status MemcacheServer::start(int port) {
+        _listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (_listen_fd < 0) {
+            return turbo::internal_error(turbo::substitute("create memcache socket failed: $0", strerror(errno)));
+        }
+        int on = 1;
+        setsockopt(_listen_fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        addr.sin_port = htons(static_cast<uint16_t>(port));
+        if (bind(_listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || listen(_listen_fd, 1024) != 0) {
+            auto err = errno;
+            close(_listen_fd);
+            _listen_fd = -1;
+            return turbo::internal_error(turbo::substitute("listen on memcache port $0 failed: $1", port, strerror(err)));
+        }
+        _connection_count.expose_as("halakv_memcache", "connection");
+        _request_count.expose_as("halakv_memcache", "request");
+        _local_hit_count.expose_as("halakv_memcache", "local_hit");
+        _remote_get_count.expose_as("halakv_memcache", "remote_get");
+        Fiber().run([this] {
+            accept_loop();
+        });
+        LOG(INFO) << "serve memcache on port " << port;
+        return turbo::OkStatus();
+    }
+
+    void MemcacheServer::accept_loop() {
+        while (true) {
+            int fd = accept4(_listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    fiber_fd_wait(_listen_fd, EPOLLIN);
+                } else if (errno != EINTR) {
+                    // out of fds most likely, give the connections some time to go.
+                    LOG(WARNING) << "accept memcache connection failed: " << strerror(errno);
+                    fiber_usleep(10 * 1000);
+                }
+                continue;
+            }
+            int on = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            Fiber().run([this, fd] {
+                serve(fd);
+            });
+        }
+    }
+
+    void MemcacheServer::serve(int fd) {
+        _connection_count << 1;
+        std::string in;
+        std::string out;
+        std::vector<Request> requests;
+        char buf[64 * 1024];
+        bool closing = false;
+        while (!closing) {
+            auto n = read(fd, buf, sizeof(buf));
+            if (n == 0) {
+                break;
+            }
+            if (n < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    fiber_fd_wait(fd, EPOLLIN);
+                    continue;
+                }
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            in.append(buf, n);
+            requests.clear();
+            bool bad = false;
+            auto consumed = parse(in, &requests, &bad);
+            out.clear();
+            closing = process(requests, &out) || bad;
+            // everything read so far is answered at once.
+            if (!out.empty() && !write_all(fd, out)) {
+                break;
+            }
+            in.erase(0, consumed);
+        }
+        close(fd);
+        _connection_count << -1;
+    }
+
+    size_t MemcacheServer::parse(std::string_view buf, std::vector<Request> *requests, bool *bad) const {
+        size_t offset = 0;
+        while (buf.size() - offset >= kHeaderSize) {
+            auto header = buf.substr(offset, kHeaderSize);
+            auto body_size = read_be(header, 8, 4);
+            if (static_cast<uint8_t>(header[0]) != kRequestMagic ||
+                body_size > static_cast<uint64_t>(FLAGS_memcache_max_body_bytes)) {
+                *bad = true;
+                break;
+            }
+            auto key_size = read_be(header, 2, 2);
+            auto extras_size = read_be(header, 4, 1);
+            if (key_size + extras_size > body_size) {
+                *bad = true;
+                break;
+            }
+            if (buf.size() - offset < kHeaderSize + body_size) {
+                break;
+            }
+            auto body = buf.substr(offset + kHeaderSize, body_size);
+            Request request;
+            request.opcode = static_cast<uint8_t>(header[1]);
+            request.opaque = static_cast<uint32_t>(read_be(header, 12, 4));
+            request.extras = body.substr(0, extras_size);
+            request.key = body.substr(extras_size, key_size);
+            request.value = body.substr(extras_size + key_size);
+            requests->push_back(request);
+            offset += kHeaderSize + body_size;
+        }
+        return offset;
+    }
+
+    bool MemcacheServer::process(const std::vector<Request> &requests, std::string *out) {
+        _request_count << requests.size();
+        for (size_t i = 0; i < requests.size();) {
+            auto &request = requests[i];
+            if (!Namespaces::check_key(request.key).ok()) {
+                // would name a key of a namespace.
+                append_error(request, kInvalidArguments, out);
+                ++i;
+                continue;
+            }
+            if (is_get(request.opcode)) {
+                // a run of gets is resolved together, the remote keys by one mget.
+                auto last = i;
+                while (last < requests.size() && is_get(requests[last].opcode) &&
+                       Namespaces::check_key(requests[last].key).ok()) {
+                    ++last;
+                }
+                get(requests, i, last, out);
+                i = last;
+                continue;
+            }
+            switch (request.opcode) {
+                case kSet:
+                case kSetQ:
+                case kAdd:
+                case kAddQ:
+                    store(request, out);
+                    break;
+                case kDelete:
+                case kDeleteQ:
+                    remove(request, out);
+                    break;
+                case kIncr:
+                case kIncrQ:
+                    incr(request, out);
+                    break;
+                case kNoop:
+                    append_response(request, kNoError, {}, {}, {}, out);
+                    break;
+                case kVersion:
+                    append_response(request, kNoError, {}, {}, "halakv", out);
+                    break;
+                case kQuit:
+                    append_response(request, kNoError, {}, {}, {}, out);
+                    return true;
+                case kQuitQ:
+                    return true;
+                default:
+                    append_error(request, kUnknownCommand, out);
+                    break;
+            }
+            ++i;
+        }
+        return false;
+    }
+
+    void MemcacheServer::get(const std::vector<Request> &requests, size_t first, size_t last, std::string *out) {
+        std::vector<std::string> values(last - first);
+        std::vector<uint32_t> flags(last - first, 0);
+        std::vector<uint16_t> statuses(last - first, kKeyNotFound);
+        halakv::MultiKvRequest remote;
+        std::vector<size_t> remote_index;
+        for (auto i = first; i < last; i++) {
+            auto &request = requests[i];
+            if (request.key.empty() || !request.extras.empty() || !request.value.empty()) {
+                statuses[i - first] = kInvalidArguments;
+                continue;
+            }
+            auto *local = KvProxy::instance()->local_cache_of(request.key);
+            if (local != nullptr) {
+                if (local->lookup(request.key, &values[i - first], &flags[i - first])) {
+                    statuses[i - first] = kNoError;
+                    _local_hit_count << 1;
+                }
+                continue;
+            }
+            remote.add_requests()->set_key(std::string(request.key));
+            remote_index.push_back(i - first);
+        }
+        if (!remote_index.empty()) {
+            _remote_get_count << remote_index.size();
+            halakv::MultiKvResponse response;
+            auto rs = KvProxy::instance()->mget(&remote, &response);
+            for (size_t j = 0; j < remote_index.size(); j++) {
+                auto index = remote_index[j];
+                if (!rs.ok() || static_cast<int>(j) >= response.responses_size()) {
+                    statuses[index] = rs.ok() ? kInternalError : status_of(rs, halakv::KvResponse());
+                    continue;
+                }
+                auto *item = response.mutable_responses(static_cast<int>(j));
+                statuses[index] = status_of(rs, *item);
+                if (statuses[index] == kNoError) {
+                    values[index].swap(*item->mutable_value());
+                    flags[index] = item->flags();
+                }
+            }
+        }
+        std::string extras;
+        for (auto i = first; i < last; i++) {
+            auto &request = requests[i];
+            auto status = statuses[i - first];
+            if (status == kNoError) {
+                auto with_key = request.opcode == kGetK || request.opcode == kGetKQ;
+                extras.clear();
+                append_be(flags[i - first], 4, &extras);
+                append_response(request, kNoError, extras, with_key ? request.key : std::string_view(),
+                                values[i - first], out);
+            } else if (status != kKeyNotFound || !is_quiet(request.opcode)) {
+                // a quiet get says nothing on a miss.
+                append_error(request, status, out);
+            }
+        }
+    }
+
+    void MemcacheServer::store(const Request &request, std::string *out) {
+        if (request.key.empty() || request.extras.size() != 8) {
+            append_error(request, kInvalidArguments, out);
+            return;
+        }
+        halakv::KvRequest kv_request;
+        halakv::KvResponse kv_response;
+        kv_request.set_key(std::string(request.key));
+        // the owner checks the key is not there under the lock of its cache.
+        if (request.opcode == kAdd || request.opcode == kAddQ) {
+            kv_request.set_if_absent(true);
+        }
+        kv_request.set_value(std::string(request.value));
+        auto flags = static_cast<uint32_t>(read_be(request.extras, 0, 4));
+        if (flags != 0) {
+            kv_request.set_flags(flags);
+        }
+        auto expire_at_us = expire_at_of(read_be(request.extras, 4, 4));
+        if (expire_at_us != 0) {
+            kv_request.set_expire_at_us(expire_at_us);
+        }
+        auto rs = KvProxy::instance()->set(&kv_request, &kv_response);
+        auto status = status_of(rs, kv_response);
+        if (status != kNoError) {
+            append_error(request, status, out);
+        } else if (!is_quiet(request.opcode)) {
+            append_response(request, kNoError, {}, {}, {}, out);
+        }
+    }
+
+    void MemcacheServer::remove(const Request &request, std::string *out) {
+        if (request.key.empty() || !request.extras.empty() || !request.value.empty()) {
+            append_error(request, kInvalidArguments, out);
+            return;
+        }
+        halakv::KvRequest kv_request;
+        halakv::KvResponse kv_response;
+        kv_request.set_key(std::string(request.key));
+        auto rs = KvProxy::instance()->remove(&kv_request, &kv_response);
+        auto status = status_of(rs, kv_response);
+        if (status != kNoError) {
+            append_error(request, status, out);
+        } else if (!is_quiet(request.opcode)) {
+            append_response(request, kNoError, {}, {}, {}, out);
+        }
+    }
+
+    void MemcacheServer::incr(const Request &request, std::string *out) {
+        if (request.key.empty() || request.extras.size() != 20 || !request.value.empty()) {
+            append_error(request, kInvalidArguments, out);
+            return;
+        }
+        auto expiration = read_be(request.extras, 16, 4);
+        halakv::KvRequest kv_request;
+        halakv::KvResponse kv_response;
+        kv_request.set_key(std::string(request.key));
+        kv_request.set_incr_unsigned(read_be(request.extras, 0, 8));
+        // a missing key is created from the initial value unless the expiration is all ones.
+        if (expiration != 0xffffffff) {
+            kv_request.set_incr_initial(read_be(request.extras, 8, 8));
+            auto expire_at_us = expire_at_of(expiration);
+            if (expire_at_us != 0) {
+                kv_request.set_expire_at_us(expire_at_us);
+            }
+        }
+        auto rs = KvProxy::instance()->set(&kv_request, &kv_response);
+        auto status = status_of(rs, kv_response);
+        uint64_t value = 0;
+        if (status == kNoError) {
+            auto &current = kv_response.value();
+            auto result = std::from_chars(current.data(), current.data() + current.size(), value);
+            if (result.ec != std::errc()) {
+                status = kInternalError;
+            }
+        }
+        if (status != kNoError) {
+            append_error(request, status, out);
+        } else if (!is_quiet(request.opcode)) {
+            std::string bytes;
+            append_be(value, 8, &bytes);
+            append_response(request, kNoError, {}, {}, bytes, out);
+        }
+    }
+
+    bool MemcacheServer::write_all(int fd, const std::string &out) {
+        size_t written = 0;
+        while (written < out.size()) {
+            auto n = write(fd, out.data() + written, out.size() - written);
+            if (n >= 0) {
+                written += n;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                fiber_fd_wait(fd, EPOLLOUT);
+            } else if (errno != EINTR) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void MemcacheServer::append_response(const Request &request, uint16_t status, std::string_view extras,
+                                         std::string_view key, std::string_view value, std::string *out) {
+        out->push_back(static_cast<char>(kResponseMagic));
+        out->push_back(static_cast<char>(request.opcode));
+        append_be(key.size(), 2, out);
+        append_be(extras.size(), 1, out);
+        // data type.
+        out->push_back(0);
+        append_be(status, 2, out);
+        append_be(extras.size() + key.size() + value.size(), 4, out);
+        append_be(request.opaque, 4, out);
+        // cas is not kept.
+        append_be(0, 8, out);
+        out->append(extras);
+        out->append(key);
+        out->append(value);
+    }
+
+    void MemcacheServer::append_error(const Request &request, uint16_t status, std::string *out) {
+        std::string_view message;
+        switch (status) {
+            case kKeyNotFound:
+                message = "Not found";
+                break;
+            case kKeyExists:
+                message = "Data exists for key.";
+                break;
+            case kInvalidArguments:
+                message = "Invalid arguments";
+                break;
+            case kNonNumeric:
+                message = "Non-numeric server-side value for incr or decr";
+                break;
+            case kUnknownCommand:
+                message = "Unknown command";
+                break;
+            case kTemporaryFailure:
+                message = "Temporary failure";
+                break;
+            default:
+                message = "Internal error";
+                break;
+        }
+        append_response(request, status, {}, {}, message, out);
+    }
+
+}  // namespace halakv
@@ -0,0 +1,97 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-11.
+//
+#pragma once
+
+#include <melon/var/var.h>
+#include <turbo/utility/status.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace halakv {
+
+    // MemcacheServer serves the memcache binary protocol on its own port:
+    // get, getk, set, add, delete, incr, their quiet variants, noop, version
+    // and quit. a connection is served by a fiber waiting on the socket, all
+    // the requests of a read are answered by one write, so a pipeline of
+    // quiet gets ended by a noop costs one write.
+    //
+    // keys owned by this server are looked up in the local cache directly,
+    // the others of a run of gets are asked for by one mget. writes go through
+    // KvProxy as any other, the expiration and the flags are kept on the entry
+    // of the owner. add and incr are done by the owner under the lock of its
+    // cache, so they hold across servers. cas is not kept, it is answered as 0.
+    class MemcacheServer {
+    public:
+        static MemcacheServer *instance() {
+            static MemcacheServer ins;
+            return &ins;
+        }
+
+        turbo::Status start(int port);
+
+    private:
+        struct Request {
+            uint8_t opcode{0};
+            uint32_t opaque{0};
+            std::string_view extras;
+            std::string_view key;
+            std::string_view value;
+        };
+
+        MemcacheServer() = default;
+
+        void accept_loop();
+
+        void serve(int fd);
+
+        // the requests parsed from the front of the buffer, the partial last one is left.
+        size_t parse(std::string_view buf, std::vector<Request> *requests, bool *bad) const;
+
+        // true to close the connection after the responses are written.
+        bool process(const std::vector<Request> &requests, std::string *out);
+
+        void get(const std::vector<Request> &requests, size_t first, size_t last, std::string *out);
+
+        void store(const Request &request, std::string *out);
+
+        void remove(const Request &request, std::string *out);
+
+        void incr(const Request &request, std::string *out);
+
+        static bool write_all(int fd, const std::string &out);
+
+        static void append_response(const Request &request, uint16_t status, std::string_view extras,
+                                    std::string_view key, std::string_view value, std::string *out);
+
+        static void append_error(const Request &request, uint16_t status, std::string *out);
+
+    private:
+        int _listen_fd{-1};
+        melon::var::Adder<int64_t> _connection_count;
+        melon::var::Adder<int64_t> _request_count;
+        melon::var::Adder<int64_t> _local_hit_count;
+        melon::var::Adder<int64_t> _remote_get_count;
+    };
+
+}  // namespace halakv
@@ -0,0 +1,58 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-30.
+//
+#include <halakv/merkle_tree.h>
+#include <algorithm>
+#include <functional>
+
+namespace halakv {
+
+    namespace {
+        // splitmix64 finalizer, spreads std::hash over all bits.
+        inline uint64_t mix(uint64_t x) {
+            x += 0x9e3779b97f4a7c15ULL;
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+            return x ^ (x >> 31);
+        }
+    }  // namespace
+
+    uint32_t MerkleTree::leaf_of(std::string_view key) {
+        auto h = mix(std::hash<std::string_view>()(key));
+        return kLeaves + static_cast<uint32_t>(h >> (64 - kDepth));
+    }
+
+    void MerkleTree::clear() {
+        std::fill(_nodes.begin(), _nodes.end(), 0);
+    }
+
+    void MerkleTree::toggle(std::string_view key, std::string_view value) {
+        auto delta = entry_hash(key, value);
+        for (auto i = leaf_of(key); i > 0; i >>= 1) {
+            _nodes[i] ^= delta;
+        }
+    }
+
+    uint64_t MerkleTree::entry_hash(std::string_view key, std::string_view value) {
+        std::hash<std::string_view> hash;
+        return mix(hash(key) ^ mix(hash(value)));
+    }
+
+}  // namespace halakv
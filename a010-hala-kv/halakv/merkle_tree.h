@@ -0,0 +1,72 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-30.
+//
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace halakv {
+
+    // MerkleTree hashes the entries of a cache by key hash range. the leaves are
+    // kLeaves buckets of the key hash, a node is the xor of the entry hashes
+    // below it, so a put or remove updates one path in O(kDepth) and two caches
+    // with the same entries have the same tree. nodes are indexed as a heap, the
+    // root is 1, the children of i are 2i and 2i+1, the leaves are [kLeaves, 2kLeaves).
+    class MerkleTree {
+    public:
+        static constexpr int kDepth = 10;
+        static constexpr uint32_t kLeaves = 1u << kDepth;
+
+        MerkleTree() : _nodes(2 * kLeaves, 0) {
+        }
+
+        static uint32_t leaf_of(std::string_view key);
+
+        static bool is_leaf(uint32_t node) {
+            return node >= kLeaves;
+        }
+
+        void add(std::string_view key, std::string_view value) {
+            toggle(key, value);
+        }
+
+        void remove(std::string_view key, std::string_view value) {
+            toggle(key, value);
+        }
+
+        // 0 for a node out of the tree.
+        uint64_t node(uint32_t index) const {
+            return index > 0 && index < _nodes.size() ? _nodes[index] : 0;
+        }
+
+        void clear();
+
+    private:
+        void toggle(std::string_view key, std::string_view value);
+
+        static uint64_t entry_hash(std::string_view key, std::string_view value);
+
+    private:
+        std::vector<uint64_t> _nodes;
+    };
+
+}  // namespace halakv
@@ -0,0 +1,169 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-6.
+//
+#include <halakv/namespaces.h>
+#include <halakv/key_hash.h>
+#include <gflags/gflags.h>
+#include <turbo/strings/str_split.h>
+#include <turbo/strings/substitute.h>
+#include <melon/utility/time.h>
+#include <algorithm>
+
+DEFINE_string(namespaces, "", "Comma separated namespaces as name:quota_mb:eviction:qps, eviction is lru or fifo, "
+                              "0 quota or qps for no limit, e.g. ads:512:lru:10000,backfill:128:fifo:2000");
+
+namespace halakv {
+
+    turbo::Status Namespaces::init(const std::string &config) {
+        std::vector<std::string> items = turbo::str_split(config, ",", turbo::SkipEmpty());
+        for (auto &item: items) {
+            NamespaceOptions options;
+            auto rs = parse(item, &options);
+            if (!rs.ok()) {
+                return rs;
+            }
+            if (_index.count(options.name) > 0) {
+                return turbo::already_exists_error(turbo::substitute("namespace $0 configured twice", options.name));
+            }
+            auto limiter = std::make_unique<Limiter>();
+            limiter->tokens = static_cast<double>(options.qps);
+            limiter->last_us = mutil::gettimeofday_us();
+            limiter->request_count.expose_as("halakv_ns", options.name + "_request");
+            limiter->limited_count.expose_as("halakv_ns", options.name + "_limited");
+            _index[options.name] = _options.size();
+            _options.push_back(options);
+            _limiters.push_back(std::move(limiter));
+        }
+        return turbo::OkStatus();
+    }
+
+    turbo::Status Namespaces::parse(const std::string &item, NamespaceOptions *options) {
+        std::vector<std::string> fields = turbo::str_split(item, ":");
+        if (fields.size() != 4 || fields[0].empty()) {
+            return turbo::invalid_argument_error(turbo::substitute("bad namespace $0, want name:quota_mb:eviction:qps", item));
+        }
+        // default names the partition of the keys in no namespace.
+        if (fields[0] == "default" || fields[0].find(kNamespaceSeparator) != std::string::npos) {
+            return turbo::invalid_argument_error(turbo::substitute("bad namespace name $0", fields[0]));
+        }
+        options->name = fields[0];
+        try {
+            options->quota_bytes = std::stoll(fields[1]) * 1024 * 1024;
+            options->qps = std::stoll(fields[3]);
+        } catch (...) {
+            return turbo::invalid_argument_error(turbo::substitute("bad quota or qps in namespace $0", item));
+        }
+        if (fields[2] == "lru") {
+            options->eviction = NamespaceOptions::kLru;
+        } else if (fields[2] == "fifo") {
+            options->eviction = NamespaceOptions::kFifo;
+        } else {
+            return turbo::invalid_argument_error(turbo::substitute("unknown eviction $0 in namespace $1", fields[2], item));
+        }
+        if (options->quota_bytes < 0 || options->qps < 0) {
+            return turbo::invalid_argument_error(turbo::substitute("negative quota or qps in namespace $0", item));
+        }
+        return turbo::OkStatus();
+    }
+
+    turbo::Status Namespaces::scope(halakv::KvRequest *request) {
+        auto rs = check_key(request->key());
+        if (!rs.ok() || !request->has_ns()) {
+            return rs;
+        }
+        rs = admit(request->ns(), 1);
+        if (!rs.ok()) {
+            return rs;
+        }
+        request->set_key(scoped_key(request->ns(), request->key()));
+        request->clear_ns();
+        return turbo::OkStatus();
+    }
+
+    turbo::Status Namespaces::scope(halakv::MultiKvRequest *request) {
+        std::unordered_map<std::string, int64_t> counts;
+        for (auto &item: request->requests()) {
+            auto rs = check_key(item.key());
+            if (!rs.ok()) {
+                return rs;
+            }
+            if (item.has_ns()) {
+                ++counts[item.ns()];
+            }
+        }
+        if (counts.empty()) {
+            return turbo::OkStatus();
+        }
+        for (auto &it: counts) {
+            auto rs = admit(it.first, it.second);
+            if (!rs.ok()) {
+                return rs;
+            }
+        }
+        for (auto &item: *request->mutable_requests()) {
+            if (item.has_ns()) {
+                item.set_key(scoped_key(item.ns(), item.key()));
+                item.clear_ns();
+            }
+        }
+        return turbo::OkStatus();
+    }
+
+    turbo::Status Namespaces::check_key(std::string_view key) {
+        if (key.find(kNamespaceSeparator) != std::string_view::npos) {
+            return turbo::invalid_argument_error("key holds the namespace separator");
+        }
+        return turbo::OkStatus();
+    }
+
+    bool Namespaces::has_namespace(const halakv::MultiKvRequest &request) {
+        return std::any_of(request.requests().begin(), request.requests().end(), [](const halakv::KvRequest &item) {
+            return item.has_ns();
+        });
+    }
+
+    turbo::Status Namespaces::admit(const std::string &ns, int64_t count) {
+        if (ns.empty()) {
+            return turbo::OkStatus();
+        }
+        auto it = _index.find(ns);
+        if (it == _index.end()) {
+            return turbo::invalid_argument_error(turbo::substitute("unknown namespace $0", ns));
+        }
+        auto qps = _options[it->second].qps;
+        auto &limiter = *_limiters[it->second];
+        limiter.request_count << count;
+        if (qps <= 0) {
+            return turbo::OkStatus();
+        }
+        // a token bucket holding up to one second of requests.
+        auto now = mutil::gettimeofday_us();
+        std::unique_lock lock(limiter.mutex);
+        limiter.tokens = std::min<double>(qps, limiter.tokens + (now - limiter.last_us) * qps / 1000000.0);
+        limiter.last_us = now;
+        if (limiter.tokens < count) {
+            limiter.limited_count << count;
+            return turbo::resource_exhausted_error(turbo::substitute("namespace $0 is over $1 qps", ns, qps));
+        }
+        limiter.tokens -= count;
+        return turbo::OkStatus();
+    }
+
+}  // namespace halakv
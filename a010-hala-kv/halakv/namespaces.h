@@ -0,0 +1,105 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-6.
+//
+#pragma once
+
+#include <halakv/kv.pb.h>
+#include <melon/var/var.h>
+#include <turbo/utility/status.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace halakv {
+
+    struct NamespaceOptions {
+        enum Eviction {
+            kLru,
+            kFifo
+        };
+        std::string name;
+        // bytes of keys and values the namespace may hold, 0 for no quota.
+        int64_t quota_bytes{0};
+        Eviction eviction{kLru};
+        // requests per second taken by the server, 0 for no limit.
+        int64_t qps{0};
+    };
+
+    // Namespaces holds the namespaces configured by --namespaces and limits the
+    // request rate of each. a key in a namespace is stored as the namespace,
+    // a separator and the key, see scoped_key, so that routing, replication and
+    // repair carry it as any key, and the cache charges it to its namespace.
+    class Namespaces {
+    public:
+        static Namespaces *instance() {
+            static Namespaces ins;
+            return &ins;
+        }
+
+        turbo::Status init(const std::string &config);
+
+        const std::vector<NamespaceOptions> &options() const {
+            return _options;
+        }
+
+        // the default namespace, empty, is always known.
+        bool known(const std::string &ns) const {
+            return ns.empty() || _index.count(ns) > 0;
+        }
+
+        // scopes the key of the request in place to its namespace, after the rate
+        // limit of the namespace. invalid_argument for an unknown namespace or a
+        // key holding the separator, resource_exhausted when over the rate. keys
+        // passed between peers come scoped already on the peer_* methods.
+        turbo::Status scope(halakv::KvRequest *request);
+
+        turbo::Status scope(halakv::MultiKvRequest *request);
+
+        // a key from a client must not hold the separator, it would name a key of
+        // another namespace.
+        static turbo::Status check_key(std::string_view key);
+
+        static bool has_namespace(const halakv::MultiKvRequest &request);
+
+    private:
+        struct Limiter {
+            std::mutex mutex;
+            double tokens{0};
+            int64_t last_us{0};
+            melon::var::Adder<int64_t> request_count;
+            melon::var::Adder<int64_t> limited_count;
+        };
+
+        turbo::Status admit(const std::string &ns, int64_t count);
+
+        static turbo::Status parse(const std::string &item, NamespaceOptions *options);
+
+    private:
+        std::vector<NamespaceOptions> _options;
+        // one per namespace in _options order, built once in init.
+        std::unordered_map<std::string, size_t> _index;
+        std::vector<std::unique_ptr<Limiter>> _limiters;
+    };
+
+}  // namespace halakv
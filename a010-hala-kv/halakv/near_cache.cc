@@ -0,0 +1,122 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-27.
+//
+#include <halakv/near_cache.h>
+#include <melon/utility/time.h>
+#include <turbo/utility/status.h>
+
+namespace halakv {
+
+    void NearCache::init(size_t max_bytes, int64_t ttl_ms, int64_t negative_ttl_ms) {
+        _max_bytes = max_bytes;
+        _ttl_us = ttl_ms * 1000;
+        _negative_ttl_us = negative_ttl_ms * 1000;
+    }
+
+    void NearCache::expose(const std::string &prefix) {
+        _hit_count.expose_as(prefix, "near_cache_hit");
+        _miss_count.expose_as(prefix, "near_cache_miss");
+        _invalidate_count.expose_as(prefix, "near_cache_invalidate");
+        _evict_count.expose_as(prefix, "near_cache_evict");
+    }
+
+    bool NearCache::lookup(const std::string &key, halakv::KvResponse *response) {
+        std::unique_lock lock(_mutex);
+        auto it = _index.find(key);
+        if (it == _index.end()) {
+            _miss_count << 1;
+            return false;
+        }
+        auto entry = it->second;
+        if (entry->expire_us < mutil::gettimeofday_us()) {
+            erase_locked(entry);
+            _miss_count << 1;
+            return false;
+        }
+        _lru.splice(_lru.begin(), _lru, entry);
+        if (entry->found) {
+            response->set_value(entry->value);
+            if (entry->version != 0) {
+                response->set_version(entry->version);
+            }
+            response->set_code(static_cast<int>(turbo::StatusCode::kOk));
+            response->set_message("ok");
+        } else {
+            response->set_code(static_cast<int>(turbo::StatusCode::kNotFound));
+            response->set_message("not found");
+        }
+        _hit_count << 1;
+        return true;
+    }
+
+    void NearCache::put(const std::string &key, const halakv::KvResponse &response, uint64_t version) {
+        bool found = response.code() == static_cast<int>(turbo::StatusCode::kOk);
+        // a not modified answer to a conditional get carries no value.
+        if ((!found && response.code() != static_cast<int>(turbo::StatusCode::kNotFound)) ||
+            (found && !response.has_value())) {
+            return;
+        }
+        Entry entry;
+        entry.key = key;
+        entry.found = found;
+        if (found) {
+            entry.value = response.value();
+            entry.version = response.version();
+        }
+        auto bytes = entry_bytes(entry);
+        if (bytes > _max_bytes) {
+            return;
+        }
+        entry.expire_us = mutil::gettimeofday_us() + (found ? _ttl_us : _negative_ttl_us);
+
+        std::unique_lock lock(_mutex);
+        if (version_of(key).load(std::memory_order_acquire) != version) {
+            return;
+        }
+        auto it = _index.find(key);
+        if (it != _index.end()) {
+            erase_locked(it->second);
+        }
+        while (_bytes + bytes > _max_bytes && !_lru.empty()) {
+            erase_locked(std::prev(_lru.end()));
+            _evict_count << 1;
+        }
+        _lru.push_front(std::move(entry));
+        _index.emplace(_lru.front().key, _lru.begin());
+        _bytes += bytes;
+    }
+
+    void NearCache::invalidate(const std::string &key) {
+        std::unique_lock lock(_mutex);
+        version_of(key).fetch_add(1, std::memory_order_release);
+        auto it = _index.find(key);
+        if (it != _index.end()) {
+            erase_locked(it->second);
+            _invalidate_count << 1;
+        }
+    }
+
+    void NearCache::erase_locked(EntryList::iterator it) {
+        _bytes -= entry_bytes(*it);
+        _index.erase(it->key);
+        _lru.erase(it);
+    }
+
+}  // namespace halakv
@@ -0,0 +1,103 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-27.
+//
+#pragma once
+
+#include <halakv/key_hash.h>
+#include <halakv/kv.pb.h>
+#include <melon/var/var.h>
+#include <array>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace halakv {
+
+    // NearCache keeps recently read values of keys owned by other peers, bounded
+    // by bytes and ttl. not found results are cached as negative entries with a
+    // shorter ttl. owners push invalidations on set and remove, the ttl bounds the
+    // staleness when an invalidation is lost.
+    class NearCache {
+    public:
+        NearCache() = default;
+
+        void init(size_t max_bytes, int64_t ttl_ms, int64_t negative_ttl_ms);
+
+        bool enabled() const {
+            return _max_bytes > 0;
+        }
+
+        void expose(const std::string &prefix);
+
+        // take the version of the key before reading from the owner and pass it
+        // to put, a put racing with an invalidation of the key is dropped. keys
+        // share a version by stripe, a put may rarely be dropped for another key.
+        uint64_t version(const std::string &key) const {
+            return version_of(key).load(std::memory_order_acquire);
+        }
+
+        bool lookup(const std::string &key, halakv::KvResponse *response);
+
+        void put(const std::string &key, const halakv::KvResponse &response, uint64_t version);
+
+        void invalidate(const std::string &key);
+
+    private:
+        struct Entry {
+            std::string key;
+            std::string value;
+            bool found{false};
+            uint64_t version{0};
+            int64_t expire_us{0};
+        };
+        using EntryList = std::list<Entry>;
+
+        void erase_locked(EntryList::iterator it);
+
+        std::atomic<uint64_t> &version_of(std::string_view key) const {
+            return _versions[key_hash(key) % kVersionStripes];
+        }
+
+        static size_t entry_bytes(const Entry &entry) {
+            return entry.key.size() + entry.value.size() + sizeof(Entry) + 32;
+        }
+
+    private:
+        static constexpr size_t kVersionStripes = 4096;
+
+        size_t _max_bytes{0};
+        int64_t _ttl_us{0};
+        int64_t _negative_ttl_us{0};
+        std::mutex _mutex;
+        // front is the most recently used.
+        EntryList _lru;
+        std::unordered_map<std::string_view, EntryList::iterator> _index;
+        size_t _bytes{0};
+        mutable std::array<std::atomic<uint64_t>, kVersionStripes> _versions{};
+        melon::var::Adder<int64_t> _hit_count;
+        melon::var::Adder<int64_t> _miss_count;
+        melon::var::Adder<int64_t> _invalidate_count;
+        melon::var::Adder<int64_t> _evict_count;
+    };
+
+}  // namespace halakv
@@ -0,0 +1,184 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-5.
+//
+// press a kv server with gets or sets, by coroutines and by hand written
+// callbacks, to compare the two styles at the same concurrency.
+
+#include <gflags/gflags.h>
+#include <turbo/log/logging.h>
+#include <melon/rpc/channel.h>
+#include <melon/var/var.h>
+#include <melon/utility/time.h>
+#include <halakv/coro_client.h>
+#include <halakv/kv.pb.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+DEFINE_string(server, "0.0.0.0:8018", "IP Address of server");
+DEFINE_string(connection_type, "single", "Connection type. Available values: single, pooled, short");
+DEFINE_int32(timeout_ms, 100, "RPC timeout in milliseconds");
+DEFINE_string(op, "get", "Operation pressed. Available values: get, set");
+DEFINE_string(style, "both", "Client style. Available values: coro, callback, both");
+DEFINE_int32(concurrency, 64, "Calls in flight");
+DEFINE_int32(duration_s, 10, "Seconds each style is pressed");
+DEFINE_int32(key_space, 10000, "Keys are picked from key0 to key<key_space - 1>");
+DEFINE_int32(value_size, 64, "Bytes of a value set");
+
+namespace {
+
+    struct Stats {
+        melon::var::LatencyRecorder latency;
+        std::atomic<int64_t> errors{0};
+    };
+
+    std::atomic<bool> g_stop{false};
+    std::atomic<int> g_running{0};
+    std::string g_value;
+
+    std::string next_key() {
+        return "key" + std::to_string(mutil::fast_rand_less_than(FLAGS_key_space));
+    }
+
+    const google::protobuf::MethodDescriptor *pressed_method() {
+        return halakv::KvService::descriptor()->FindMethodByName(FLAGS_op);
+    }
+
+    halakv::CoroTask<> coro_loop(halakv::CoroKvClient &kv, Stats &stats) {
+        while (!g_stop.load(std::memory_order_relaxed)) {
+            auto start_us = mutil::gettimeofday_us();
+            auto result = FLAGS_op == "set" ? co_await kv.set(next_key(), g_value) : co_await kv.get(next_key());
+            if (result.status.ok()) {
+                stats.latency << mutil::gettimeofday_us() - start_us;
+            } else {
+                stats.errors.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        g_running.fetch_sub(1, std::memory_order_release);
+    }
+
+    // the callback style, one closure per loop issues the next call from the done of the last.
+    class CallbackLoop : public google::protobuf::Closure {
+    public:
+        CallbackLoop(melon::Channel *channel, Stats *stats) : _channel(channel), _stats(stats) {
+        }
+
+        void start() {
+            _cntl.Reset();
+            _cntl.set_timeout_ms(FLAGS_timeout_ms);
+            _request.Clear();
+            _response.Clear();
+            _request.set_key(next_key());
+            if (FLAGS_op == "set") {
+                _request.set_value(g_value);
+            }
+            _start_us = mutil::gettimeofday_us();
+            _channel->CallMethod(pressed_method(), &_cntl, &_request, &_response, this);
+        }
+
+        void Run() override {
+            if (_cntl.Failed()) {
+                _stats->errors.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                _stats->latency << mutil::gettimeofday_us() - _start_us;
+            }
+            if (g_stop.load(std::memory_order_relaxed)) {
+                g_running.fetch_sub(1, std::memory_order_release);
+                return;
+            }
+            start();
+        }
+
+    private:
+        melon::Channel *_channel;
+        Stats *_stats;
+        melon::Controller _cntl;
+        halakv::KvRequest _request;
+        halakv::KvResponse _response;
+        int64_t _start_us{0};
+    };
+
+    void report(const std::string &style, Stats &stats) {
+        LOG(INFO) << style << " " << FLAGS_op << " concurrency=" << FLAGS_concurrency
+                  << " qps=" << stats.latency.qps(FLAGS_duration_s)
+                  << " avg_us=" << stats.latency.latency(FLAGS_duration_s)
+                  << " p99_us=" << stats.latency.latency_percentile(0.99)
+                  << " p999_us=" << stats.latency.latency_percentile(0.999)
+                  << " errors=" << stats.errors.load();
+    }
+
+    void wait_done() {
+        std::this_thread::sleep_for(std::chrono::seconds(FLAGS_duration_s));
+        g_stop.store(true, std::memory_order_relaxed);
+        while (g_running.load(std::memory_order_acquire) > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        g_stop.store(false, std::memory_order_relaxed);
+    }
+
+    void press_coro(melon::Channel *channel) {
+        Stats stats;
+        halakv::CoroKvClient kv(channel, nullptr, FLAGS_timeout_ms);
+        g_running.store(FLAGS_concurrency);
+        for (int i = 0; i < FLAGS_concurrency; i++) {
+            coro_loop(kv, stats).spawn();
+        }
+        wait_done();
+        report("coro", stats);
+    }
+
+    void press_callback(melon::Channel *channel) {
+        Stats stats;
+        std::vector<std::unique_ptr<CallbackLoop>> loops;
+        g_running.store(FLAGS_concurrency);
+        for (int i = 0; i < FLAGS_concurrency; i++) {
+            loops.push_back(std::make_unique<CallbackLoop>(channel, &stats));
+            loops.back()->start();
+        }
+        wait_done();
+        report("callback", stats);
+    }
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, true);
+    if (pressed_method() == nullptr || (FLAGS_op != "get" && FLAGS_op != "set")) {
+        LOG(ERROR) << "Invalid operation type";
+        return -1;
+    }
+    g_value.assign(FLAGS_value_size, 'v');
+    melon::Channel channel;
+    melon::ChannelOptions options;
+    options.connection_type = FLAGS_connection_type;
+    options.timeout_ms = FLAGS_timeout_ms;
+    if (channel.Init(FLAGS_server.c_str(), &options) != 0) {
+        LOG(ERROR) << "Fail to initialize channel";
+        return -1;
+    }
+    if (FLAGS_style == "coro" || FLAGS_style == "both") {
+        press_coro(&channel);
+    }
+    if (FLAGS_style == "callback" || FLAGS_style == "both") {
+        press_callback(&channel);
+    }
+    return 0;
+}
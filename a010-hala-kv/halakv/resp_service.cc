@@ -0,0 +1,397 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-10.
+//
+#include <halakv/resp_service.h>
+#include <halakv/kv_proxy.h>
+#include <halakv/namespaces.h>
+#include <melon/utility/time.h>
+#include <turbo/strings/substitute.h>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <limits>
+
+namespace halakv {
+
+    namespace {
+
+        // the commands of a connection batched so far, see RespService.
+        thread_local std::vector<std::vector<std::string>> t_batch;
+
+        constexpr const char *kCommands[] = {"get", "set", "del", "mget", "mset", "expire", "incr"};
+
+        // a key holding the namespace separator would name a key of a namespace.
+        bool has_bad_key(const std::vector<std::string> &command) {
+            auto &name = command[0];
+            for (size_t i = 1; i < command.size(); i++) {
+                bool is_key = name == "del" || name == "mget" || (name == "mset" ? i % 2 == 1 : i == 1);
+                if (is_key && !Namespaces::check_key(command[i]).ok()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::string wrong_args(const std::string &name) {
+            return turbo::substitute("ERR wrong number of arguments for '$0' command", name);
+        }
+
+        bool parse_int(const std::string &s, int64_t *value) {
+            auto result = std::from_chars(s.data(), s.data() + s.size(), *value);
+            return !s.empty() && result.ec == std::errc() && result.ptr == s.data() + s.size();
+        }
+
+        void reply_get(const turbo::Status &rs, const halakv::KvResponse &response, melon::RedisReply *reply) {
+            if (!rs.ok()) {
+                reply->SetError("ERR " + rs.to_string());
+            } else if (response.code() == static_cast<int>(turbo::StatusCode::kOk)) {
+                reply->SetString(response.value());
+            } else if (response.code() == static_cast<int>(turbo::StatusCode::kNotFound)) {
+                reply->SetNullString();
+            } else {
+                reply->SetError("ERR " + response.message());
+            }
+        }
+
+        void reply_set(const turbo::Status &rs, const halakv::KvResponse &response, melon::RedisReply *reply) {
+            if (!rs.ok()) {
+                reply->SetError("ERR " + rs.to_string());
+            } else if (response.code() == static_cast<int>(turbo::StatusCode::kOk)) {
+                reply->SetStatus("OK");
+            } else {
+                reply->SetError("ERR " + response.message());
+            }
+        }
+
+    }  // namespace
+
+    RespService::RespService() {
+        for (auto name: kCommands) {
+            _handlers.push_back(std::make_unique<Handler>(this));
+            AddCommandHandler(name, _handlers.back().get());
+        }
+        _command_count.expose_as("halakv_resp", "command");
+        _batch_count.expose_as("halakv_resp", "batch");
+    }
+
+    RespService::~RespService() = default;
+
+    melon::RedisCommandHandlerResult RespService::run(const std::vector<mutil::StringPiece> &args,
+                                                      melon::RedisReply *output, bool flush_batched) {
+        Command command;
+        command.reserve(args.size());
+        for (auto &arg: args) {
+            command.emplace_back(arg.data(), arg.size());
+        }
+        std::transform(command[0].begin(), command[0].end(), command[0].begin(), ::tolower);
+        _command_count << 1;
+        if (!flush_batched) {
+            t_batch.push_back(std::move(command));
+            return melon::REDIS_CMD_BATCHED;
+        }
+        if (t_batch.empty()) {
+            std::vector<Command> commands{std::move(command)};
+            execute(commands, 0, [output](size_t) {
+                return output;
+            });
+            return melon::REDIS_CMD_HANDLED;
+        }
+        // taken off the thread before anything may block and move the fiber.
+        std::vector<Command> commands;
+        commands.swap(t_batch);
+        commands.push_back(std::move(command));
+        _batch_count << 1;
+        output->SetArray(static_cast<int>(commands.size()));
+        auto reply = [output](size_t i) {
+            return &(*output)[i];
+        };
+        for (size_t i = 0; i < commands.size();) {
+            i = execute(commands, i, reply);
+        }
+        return melon::REDIS_CMD_HANDLED;
+    }
+
+    size_t RespService::execute(const std::vector<Command> &commands, size_t first,
+                                const std::function<melon::RedisReply *(size_t)> &reply) {
+        auto &command = commands[first];
+        auto &name = command[0];
+        if (has_bad_key(command)) {
+            reply(first)->SetError("ERR key holds the namespace separator");
+            return first + 1;
+        }
+        // a run of plain GETs or SETs in a row is sent as one multi call, the order is kept.
+        auto run_of = [&commands, first](const char *op, size_t argc) {
+            auto last = first;
+            while (last < commands.size() && commands[last][0] == op && commands[last].size() == argc &&
+                   !has_bad_key(commands[last])) {
+                ++last;
+            }
+            return last;
+        };
+        if (name == "get") {
+            auto last = run_of("get", 2);
+            if (last == first) {
+                reply(first)->SetError(wrong_args(name));
+                return first + 1;
+            }
+            get(commands, first, last, reply);
+            return last;
+        }
+        if (name == "set") {
+            auto last = run_of("set", 3);
+            if (last == first) {
+                set(commands, first, first + 1, reply);
+                return first + 1;
+            }
+            set(commands, first, last, reply);
+            return last;
+        }
+        if (name == "del") {
+            del(command, reply(first));
+        } else if (name == "mget") {
+            mget(command, reply(first));
+        } else if (name == "mset") {
+            mset(command, reply(first));
+        } else if (name == "expire") {
+            expire(command, reply(first));
+        } else if (name == "incr") {
+            incr(command, reply(first));
+        } else {
+            reply(first)->SetError(turbo::substitute("ERR unknown command '$0'", name));
+        }
+        return first + 1;
+    }
+
+    void RespService::get(const std::vector<Command> &commands, size_t first, size_t last,
+                          const std::function<melon::RedisReply *(size_t)> &reply) {
+        if (last - first == 1) {
+            halakv::KvRequest request;
+            halakv::KvResponse response;
+            request.set_key(commands[first][1]);
+            auto rs = KvProxy::instance()->get(&request, &response);
+            reply_get(rs, response, reply(first));
+            return;
+        }
+        halakv::MultiKvRequest request;
+        halakv::MultiKvResponse response;
+        for (auto i = first; i < last; i++) {
+            request.add_requests()->set_key(commands[i][1]);
+        }
+        auto rs = KvProxy::instance()->mget(&request, &response);
+        for (auto i = first; i < last; i++) {
+            auto index = static_cast<int>(i - first);
+            reply_get(rs, index < response.responses_size() ? response.responses(index) : halakv::KvResponse(),
+                      reply(i));
+        }
+    }
+
+    void RespService::set(const std::vector<Command> &commands, size_t first, size_t last,
+                          const std::function<melon::RedisReply *(size_t)> &reply) {
+        if (last - first == 1) {
+            auto &command = commands[first];
+            int64_t ttl_ms = -1;
+            if (command.size() < 3) {
+                reply(first)->SetError(wrong_args(command[0]));
+                return;
+            }
+            if (!parse_set(command, &ttl_ms)) {
+                reply(first)->SetError("ERR syntax error");
+                return;
+            }
+            halakv::KvRequest request;
+            halakv::KvResponse response;
+            request.set_key(command[1]);
+            request.set_value(command[2]);
+            if (ttl_ms > 0) {
+                request.set_expire_at_us(mutil::gettimeofday_us() + ttl_ms * 1000);
+            }
+            auto rs = KvProxy::instance()->set(&request, &response);
+            reply_set(rs, response, reply(first));
+            return;
+        }
+        halakv::MultiKvRequest request;
+        halakv::MultiKvResponse response;
+        for (auto i = first; i < last; i++) {
+            auto *item = request.add_requests();
+            item->set_key(commands[i][1]);
+            item->set_value(commands[i][2]);
+        }
+        auto rs = KvProxy::instance()->mset(&request, &response);
+        for (auto i = first; i < last; i++) {
+            auto index = static_cast<int>(i - first);
+            reply_set(rs, index < response.responses_size() ? response.responses(index) : halakv::KvResponse(),
+                      reply(i));
+        }
+    }
+
+    bool RespService::parse_set(const Command &command, int64_t *ttl_ms) {
+        *ttl_ms = -1;
+        if (command.size() == 3) {
+            return true;
+        }
+        if (command.size() != 5) {
+            return false;
+        }
+        std::string option = command[3];
+        std::transform(option.begin(), option.end(), option.begin(), ::tolower);
+        int64_t ttl;
+        if ((option != "ex" && option != "px") || !parse_int(command[4], &ttl) || ttl <= 0 ||
+            ttl > std::numeric_limits<int64_t>::max() / 1000000) {
+            return false;
+        }
+        *ttl_ms = option == "ex" ? ttl * 1000 : ttl;
+        return true;
+    }
+
+    void RespService::del(const Command &command, melon::RedisReply *reply) {
+        if (command.size() < 2) {
+            reply->SetError(wrong_args(command[0]));
+            return;
+        }
+        halakv::MultiKvRequest request;
+        halakv::MultiKvResponse response;
+        for (size_t i = 1; i < command.size(); i++) {
+            request.add_requests()->set_key(command[i]);
+        }
+        auto rs = KvProxy::instance()->mremove(&request, &response);
+        if (!rs.ok()) {
+            reply->SetError("ERR " + rs.to_string());
+            return;
+        }
+        auto removed = std::count_if(response.responses().begin(), response.responses().end(),
+                                     [](const halakv::KvResponse &item) {
+                                         return item.code() == static_cast<int>(turbo::StatusCode::kOk);
+                                     });
+        reply->SetInteger(removed);
+    }
+
+    void RespService::mget(const Command &command, melon::RedisReply *reply) {
+        if (command.size() < 2) {
+            reply->SetError(wrong_args(command[0]));
+            return;
+        }
+        halakv::MultiKvRequest request;
+        halakv::MultiKvResponse response;
+        for (size_t i = 1; i < command.size(); i++) {
+            request.add_requests()->set_key(command[i]);
+        }
+        auto rs = KvProxy::instance()->mget(&request, &response);
+        if (!rs.ok()) {
+            reply->SetError("ERR " + rs.to_string());
+            return;
+        }
+        reply->SetArray(request.requests_size());
+        for (int i = 0; i < request.requests_size(); i++) {
+            // MGET answers nil for any key it could not get.
+            if (i < response.responses_size() &&
+                response.responses(i).code() == static_cast<int>(turbo::StatusCode::kOk)) {
+                (*reply)[i].SetString(response.responses(i).value());
+            } else {
+                (*reply)[i].SetNullString();
+            }
+        }
+    }
+
+    void RespService::mset(const Command &command, melon::RedisReply *reply) {
+        if (command.size() < 3 || command.size() % 2 == 0) {
+            reply->SetError(wrong_args(command[0]));
+            return;
+        }
+        halakv::MultiKvRequest request;
+        halakv::MultiKvResponse response;
+        for (size_t i = 1; i + 1 < command.size(); i += 2) {
+            auto *item = request.add_requests();
+            item->set_key(command[i]);
+            item->set_value(command[i + 1]);
+        }
+        auto rs = KvProxy::instance()->mset(&request, &response);
+        if (!rs.ok()) {
+            reply->SetError("ERR " + rs.to_string());
+            return;
+        }
+        for (auto &item: response.responses()) {
+            if (item.code() != static_cast<int>(turbo::StatusCode::kOk)) {
+                reply->SetError("ERR " + item.message());
+                return;
+            }
+        }
+        reply->SetStatus("OK");
+    }
+
+    void RespService::expire(const Command &command, melon::RedisReply *reply) {
+        if (command.size() != 3) {
+            reply->SetError(wrong_args(command[0]));
+            return;
+        }
+        int64_t seconds;
+        if (!parse_int(command[2], &seconds) || seconds > std::numeric_limits<int64_t>::max() / 1000000) {
+            reply->SetError("ERR value is not an integer or out of range");
+            return;
+        }
+        halakv::KvRequest request;
+        halakv::KvResponse response;
+        request.set_key(command[1]);
+        turbo::Status rs;
+        if (seconds <= 0) {
+            rs = KvProxy::instance()->remove(&request, &response);
+        } else {
+            // a set without a value, the owner changes the expiry of the key it holds.
+            request.set_expire_at_us(mutil::gettimeofday_us() + seconds * 1000000);
+            rs = KvProxy::instance()->set(&request, &response);
+        }
+        if (!rs.ok()) {
+            reply->SetError("ERR " + rs.to_string());
+        } else if (response.code() == static_cast<int>(turbo::StatusCode::kOk)) {
+            reply->SetInteger(1);
+        } else if (response.code() == static_cast<int>(turbo::StatusCode::kNotFound)) {
+            reply->SetInteger(0);
+        } else {
+            reply->SetError("ERR " + response.message());
+        }
+    }
+
+    void RespService::incr(const Command &command, melon::RedisReply *reply) {
+        if (command.size() != 2) {
+            reply->SetError(wrong_args(command[0]));
+            return;
+        }
+        // the owner reads and writes the key under the lock of its cache.
+        halakv::KvRequest request;
+        halakv::KvResponse response;
+        request.set_key(command[1]);
+        request.set_incr_by(1);
+        auto rs = KvProxy::instance()->set(&request, &response);
+        int64_t value;
+        if (!rs.ok()) {
+            reply->SetError("ERR " + rs.to_string());
+        } else if (response.code() == static_cast<int>(turbo::StatusCode::kInvalidArgument)) {
+            reply->SetError("ERR value is not an integer or out of range");
+        } else if (response.code() == static_cast<int>(turbo::StatusCode::kOutOfRange)) {
+            reply->SetError("ERR increment or decrement would overflow");
+        } else if (response.code() != static_cast<int>(turbo::StatusCode::kOk)) {
+            reply->SetError("ERR " + response.message());
+        } else if (!parse_int(response.value(), &value)) {
+            reply->SetError("ERR bad increment reply");
+        } else {
+            reply->SetInteger(value);
+        }
+    }
+
+}  // namespace halakv
@@ -0,0 +1,101 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-10.
+//
+#pragma once
+
+#include <halakv/kv.pb.h>
+#include <melon/rpc/redis/redis.h>
+#include <melon/var/var.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace halakv {
+
+    // RespService serves GET, SET, DEL, MGET, MSET, EXPIRE and INCR of the redis
+    // protocol on the port of the server, mapped onto KvProxy, so redis clients
+    // reach the cluster as they reach the rpc and http services.
+    //
+    // pipelined commands are buffered until melon asks to flush the batch, the
+    // last command read from the connection, then run in order with the runs
+    // of GET and of SET merged into one mget and one mset. the commands of a
+    // connection are read and batched on one fiber without blocking, so the
+    // buffer is thread local.
+    //
+    // EXPIRE and SET EX or PX put the expiry on the entry of the owner, any
+    // later write clears it. INCR keeps it, the owner increments under the
+    // lock of its cache, so INCRs through any server are not lost.
+    class RespService : public melon::RedisService {
+    public:
+        RespService();
+
+        ~RespService() override;
+
+        melon::RedisCommandHandlerResult run(const std::vector<mutil::StringPiece> &args,
+                                             melon::RedisReply *output, bool flush_batched);
+
+    private:
+        using Command = std::vector<std::string>;
+
+        class Handler : public melon::RedisCommandHandler {
+        public:
+            explicit Handler(RespService *service) : _service(service) {}
+
+            melon::RedisCommandHandlerResult Run(const std::vector<mutil::StringPiece> &args,
+                                                 melon::RedisReply *output, bool flush_batched) override {
+                return _service->run(args, output, flush_batched);
+            }
+
+        private:
+            RespService *_service;
+        };
+
+        // runs commands[first, last) into replies[first, last), returns the next not run.
+        size_t execute(const std::vector<Command> &commands, size_t first,
+                       const std::function<melon::RedisReply *(size_t)> &reply);
+
+        void get(const std::vector<Command> &commands, size_t first, size_t last,
+                 const std::function<melon::RedisReply *(size_t)> &reply);
+
+        void set(const std::vector<Command> &commands, size_t first, size_t last,
+                 const std::function<melon::RedisReply *(size_t)> &reply);
+
+        void del(const Command &command, melon::RedisReply *reply);
+
+        void mget(const Command &command, melon::RedisReply *reply);
+
+        void mset(const Command &command, melon::RedisReply *reply);
+
+        void expire(const Command &command, melon::RedisReply *reply);
+
+        void incr(const Command &command, melon::RedisReply *reply);
+
+        // a SET with EX or PX, the ttl in ms in ttl_ms, -1 for none. false if the options are bad.
+        static bool parse_set(const Command &command, int64_t *ttl_ms);
+
+    private:
+        std::vector<std::unique_ptr<Handler>> _handlers;
+        melon::var::Adder<int64_t> _command_count;
+        melon::var::Adder<int64_t> _batch_count;
+    };
+
+}  // namespace halakv
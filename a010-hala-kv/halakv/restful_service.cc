@@ -22,10 +22,22 @@
 #include <halakv/restful_service.h>
 #include <turbo/strings/substitute.h>
 #include <turbo/strings/match.h>
+#include <turbo/strings/str_split.h>
 #include <melon/json2pb/pb_to_json.h>
 #include <collie/nlohmann/json.hpp>
+#include <gflags/gflags.h>
 #include <halakv/kv_proxy.h>
+#include <halakv/kv_json.h>
+#include <halakv/batch_stream.h>
+#include <halakv/key_hash.h>
+#include <halakv/compression.h>
+#include <halakv/namespaces.h>
 #include <halakv/kv.pb.h>
+#include <algorithm>
+#include <charconv>
+#include <memory>
+
+DEFINE_bool(rest_async_get, true, "Serve /ea/cache/get by the async http service, the worker is not held while a peer is asked");
 
 namespace halakv {
 
@@ -58,6 +70,77 @@ namespace halakv {
 
     static constexpr std::string_view kTemplate = R"({"code":$0,"msg":"$1", "value":"$2"})";
 
+    // 429 for a namespace over its rate, the client should back off.
+    static int status_of(const turbo::Status &rs) {
+        if (rs.ok()) {
+            return 200;
+        }
+        return rs.code() == turbo::StatusCode::kResourceExhausted ? 429 : 500;
+    }
+
+    static void set_json_body(const google::protobuf::Message &message, melon::RestfulResponse *response) {
+        std::string json;
+        std::string err;
+        if (json2pb::ProtoMessageToJson(message, &json, &err)) {
+            response->set_body(json);
+        } else {
+            LOG(ERROR) << "error: " << err;
+            response->set_body(get_proto_conversion_err());
+        }
+    }
+
+    // the cache key of a body built from the entry of key, null if the entry has no version.
+    static std::unique_ptr<Compressor::Key> gzip_key(const std::string &key, const halakv::KvResponse &message,
+                                                     Compressor::Form form) {
+        if (!message.has_version()) {
+            return nullptr;
+        }
+        return std::make_unique<Compressor::Key>(Compressor::Key{key, message.version(), form});
+    }
+
+    // a large value of key is gzipped for a client taking it, the body is left empty otherwise.
+    static bool gzip_json(const std::string *accept_encoding, const std::string &key,
+                          const halakv::KvResponse &message, mutil::IOBuf *body) {
+        if (message.value().size() < Compressor::http_min_bytes() || !Compressor::accepts_gzip(accept_encoding)) {
+            return false;
+        }
+        std::string json;
+        append_json(message, &json);
+        auto cache_key = gzip_key(key, message, Compressor::kJson);
+        return Compressor::instance()->http_gzip(accept_encoding, cache_key.get(), json, body);
+    }
+
+    // the single key responses skip json2pb, they are written by hand into the body.
+    // key is the stored key the response was read for, it names the cached gzip.
+    static void set_json_body(const halakv::KvResponse &message, melon::RestfulResponse *response,
+                              const melon::RestfulRequest *request = nullptr, const std::string &key = {}) {
+        mutil::IOBuf body;
+        response->set_header("Vary", "Accept-Encoding");
+        if (request != nullptr && gzip_json(request->header("Accept-Encoding"), key, message, &body)) {
+            response->set_header("Content-Encoding", "gzip");
+        } else {
+            write_json(message, &body);
+        }
+        response->set_body(body);
+    }
+
+    // scopes the key to the ns query if any, the response is set if refused.
+    static bool scope_request(const std::string *ns, halakv::KvRequest *kv_request, melon::RestfulResponse *response) {
+        if (ns != nullptr && !ns->empty()) {
+            kv_request->set_ns(*ns);
+        }
+        auto rs = Namespaces::instance()->scope(kv_request);
+        if (!rs.ok()) {
+            halakv::KvResponse kv_response;
+            kv_response.set_code(static_cast<int>(rs.code()));
+            kv_response.set_message(std::string(rs.message()));
+            response->set_status_code(rs.code() == turbo::StatusCode::kResourceExhausted ? 429 : 200);
+            set_json_body(kv_response, response);
+            return false;
+        }
+        return true;
+    }
+
     void CacheSetProcessor::process(const melon::RestfulRequest *request, melon::RestfulResponse *response) {
         response->set_content_json();
         response->set_access_control_all_allow();
@@ -73,18 +156,12 @@ namespace halakv {
         halakv::KvRequest kv_request;
         kv_request.set_key(*key);
         kv_request.set_value(value.to_string());
-        auto rs = KvProxy::instance()->set(&kv_request, &kv_response);
-        if (!rs.ok()) {
-            response->set_status_code(500);
-        } else {
-            response->set_status_code(200);
-        }
-        std::string json;
-        if (json2pb::ProtoMessageToJson(kv_response, &json)) {
-            response->set_body(json);
-        } else {
-            response->set_body(get_proto_conversion_err());
+        if (!scope_request(uri.GetQuery("ns"), &kv_request, response)) {
+            return;
         }
+        auto rs = KvProxy::instance()->set(&kv_request, &kv_response);
+        response->set_status_code(status_of(rs));
+        set_json_body(kv_response, response);
     }
 
     void CacheGetProcessor::process(const melon::RestfulRequest *request, melon::RestfulResponse *response) {
@@ -99,38 +176,385 @@ namespace halakv {
             kv_response.set_code(static_cast<int>(turbo::StatusCode::kInvalidArgument));
             kv_response.set_value("");
             kv_response.set_message("no key");
-            std::string json;
-            if (json2pb::ProtoMessageToJson(kv_response, &json)) {
-                response->set_body(json);
-            } else {
-                response->set_body(get_proto_conversion_err());
-            }
+            set_json_body(kv_response, response);
             return;
         }
         // get key from cache
         kv_request.set_key(*key);
         VLOG(20) << "get key: " << *key;
+        if (!scope_request(uri.GetQuery("ns"), &kv_request, response)) {
+            return;
+        }
         auto rs = KvProxy::instance()->get(&kv_request, &kv_response);
+        response->set_status_code(status_of(rs));
+        VLOG(30) << "get key: " << *key << " code: " << kv_response.code();
+        set_json_body(kv_response, response, request, kv_request.key());
+    }
+
+    // mget and mremove take a json array of keys, mset takes a json object
+    // of key to value.
+    static turbo::Status parse_multi_request(const std::string &body, bool with_value,
+                                             halakv::MultiKvRequest *kv_request) {
+        nlohmann::json j = nlohmann::json::parse(body, nullptr, false);
+        if (j.is_discarded()) {
+            return turbo::invalid_argument_error("body is not a valid json");
+        }
+        if (with_value) {
+            if (!j.is_object()) {
+                return turbo::invalid_argument_error("body should be a json object of key to value");
+            }
+            for (auto it = j.begin(); it != j.end(); ++it) {
+                if (!it.value().is_string()) {
+                    return turbo::invalid_argument_error(turbo::substitute("value of key $0 is not a string", it.key()));
+                }
+                auto *item = kv_request->add_requests();
+                item->set_key(it.key());
+                item->set_value(it.value().get<std::string>());
+            }
+        } else {
+            if (!j.is_array()) {
+                return turbo::invalid_argument_error("body should be a json array of keys");
+            }
+            for (auto &key: j) {
+                if (!key.is_string()) {
+                    return turbo::invalid_argument_error("key is not a string");
+                }
+                kv_request->add_requests()->set_key(key.get<std::string>());
+            }
+        }
+        if (kv_request->requests_size() == 0) {
+            return turbo::invalid_argument_error("no key or value");
+        }
+        return turbo::OkStatus();
+    }
+
+    static bool has_ndjson(const std::string *header) {
+        return header != nullptr && header->find("application/x-ndjson") != std::string::npos;
+    }
+
+    // a ndjson body, or a json one asked to be answered in ndjson.
+    static bool wants_ndjson(const melon::RestfulRequest *request) {
+        return has_ndjson(request->header("Content-Type")) || has_ndjson(request->header("Accept"));
+    }
+
+    static void stream_multi(const melon::RestfulRequest *request, melon::RestfulResponse *response,
+                             bool with_value, BatchStream::Call call) {
+        auto *ns = request->uri().GetQuery("ns");
+        auto stream = std::make_shared<BatchStream>(call, with_value, ns == nullptr ? std::string() : *ns);
+        if (has_ndjson(request->header("Content-Type"))) {
+            stream->init_ndjson(request->body());
+        } else {
+            halakv::MultiKvRequest kv_request;
+            auto rs = parse_multi_request(request->body().to_string(), with_value, &kv_request);
+            if (!rs.ok()) {
+                halakv::KvResponse kv_response;
+                kv_response.set_code(static_cast<int>(rs.code()));
+                kv_response.set_message(std::string(rs.message()));
+                response->set_status_code(200);
+                set_json_body(kv_response, response);
+                return;
+            }
+            stream->init_request(std::move(kv_request));
+        }
+        response->set_status_code(200);
+        response->set_header("Content-Type", "application/x-ndjson");
+        // the header goes out when the processor returns, the lines follow as keys resolve.
+        stream->start(response->controller()->CreateProgressiveAttachment());
+    }
+
+    static void process_multi(const melon::RestfulRequest *request, melon::RestfulResponse *response,
+                              bool with_value,
+                              turbo::Status (KvProxy::*call)(const halakv::MultiKvRequest *,
+                                                            halakv::MultiKvResponse *,
+                                                            melon::Controller *)) {
+        response->set_content_json();
+        response->set_access_control_all_allow();
+        if (wants_ndjson(request)) {
+            stream_multi(request, response, with_value, call);
+            return;
+        }
+        halakv::MultiKvRequest kv_request;
+        halakv::MultiKvResponse kv_response;
+        auto rs = parse_multi_request(request->body().to_string(), with_value, &kv_request);
+        auto *ns = request->uri().GetQuery("ns");
+        if (rs.ok()) {
+            if (ns != nullptr && !ns->empty()) {
+                for (auto &item: *kv_request.mutable_requests()) {
+                    item.set_ns(*ns);
+                }
+            }
+            rs = Namespaces::instance()->scope(&kv_request);
+        }
         if (!rs.ok()) {
-            response->set_status_code(500);
+            response->set_status_code(rs.code() == turbo::StatusCode::kResourceExhausted ? 429 : 200);
+            kv_response.set_code(static_cast<int>(rs.code()));
+            kv_response.set_message(std::string(rs.message()));
         } else {
-            response->set_status_code(200);
+            rs = (KvProxy::instance()->*call)(&kv_request, &kv_response, nullptr);
+            response->set_status_code(status_of(rs));
         }
-        std::string json;
-        std::string err;
-        if (json2pb::ProtoMessageToJson(kv_response, &json, &err)) {
-            VLOG(30) << "get key: " << *key << "response: " << json;
-            response->set_body(json);
+        set_json_body(kv_response, response);
+    }
+
+    void CacheMSetProcessor::process(const melon::RestfulRequest *request, melon::RestfulResponse *response) {
+        process_multi(request, response, true, &KvProxy::mset);
+    }
+
+    void CacheMGetProcessor::process(const melon::RestfulRequest *request, melon::RestfulResponse *response) {
+        process_multi(request, response, false, &KvProxy::mget);
+    }
+
+    void CacheMRemoveProcessor::process(const melon::RestfulRequest *request, melon::RestfulResponse *response) {
+        process_multi(request, response, false, &KvProxy::mremove);
+    }
+
+    // the version of the entry, a hash of the value for a read answered with
+    // no version, from a hint.
+    static std::string etag_of(const halakv::KvResponse &response) {
+        char buf[24];
+        if (response.has_version()) {
+            snprintf(buf, sizeof(buf), "\"%016lx\"", static_cast<unsigned long>(response.version()));
         } else {
-            LOG(ERROR)<< "error: " << err;
-            response->set_body(get_proto_conversion_err());
+            snprintf(buf, sizeof(buf), "\"h%015lx\"",
+                     static_cast<unsigned long>(key_hash(response.value()) >> 4));
+        }
+        return buf;
+    }
+
+    // the version named by an If-None-Match of one etag, so that the owner
+    // answers a 304 without reading the value.
+    static bool version_of_etag(const std::string *header, uint64_t *version) {
+        if (header == nullptr) {
+            return false;
+        }
+        std::string_view tag(*header);
+        tag.remove_prefix(std::min(tag.find_first_not_of(' '), tag.size()));
+        tag.remove_suffix(tag.size() - std::min(tag.find_last_not_of(' ') + 1, tag.size()));
+        if (turbo::starts_with(tag, "W/")) {
+            tag.remove_prefix(2);
+        }
+        if (tag.size() != 18 || tag.front() != '"' || tag.back() != '"') {
+            return false;
+        }
+        auto result = std::from_chars(tag.data() + 1, tag.data() + 17, *version, 16);
+        return result.ec == std::errc() && result.ptr == tag.data() + 17;
+    }
+
+    // If-None-Match holds a list of etags, weak ones match too, * matches any.
+    static bool etag_matches(const std::string *header, const std::string &etag) {
+        if (header == nullptr) {
+            return false;
+        }
+        std::vector<std::string> items = turbo::str_split(*header, ",", turbo::SkipEmpty());
+        for (auto &item: items) {
+            std::string_view tag(item);
+            tag.remove_prefix(std::min(tag.find_first_not_of(' '), tag.size()));
+            tag.remove_suffix(tag.size() - std::min(tag.find_last_not_of(' ') + 1, tag.size()));
+            if (turbo::starts_with(tag, "W/")) {
+                tag.remove_prefix(2);
+            }
+            if (tag == "*" || tag == etag) {
+                return true;
+            }
         }
+        return false;
+    }
+
+    // a single range of bytes=first-last, bytes=first- or bytes=-suffix. false
+    // if it is not satisfiable, a header not understood is ignored as rfc 9110 allows.
+    static bool parse_range(const std::string &header, size_t size, bool *ranged, size_t *first, size_t *last) {
+        *ranged = false;
+        std::string_view spec(header);
+        if (!turbo::starts_with(spec, "bytes=") || spec.find(',') != std::string_view::npos) {
+            return true;
+        }
+        spec.remove_prefix(6);
+        auto dash = spec.find('-');
+        if (dash == std::string_view::npos) {
+            return true;
+        }
+        auto to_size = [](std::string_view v, size_t *out) {
+            if (v.empty() || v.size() > 19 || v.find_first_not_of("0123456789") != std::string_view::npos) {
+                return false;
+            }
+            *out = std::stoull(std::string(v));
+            return true;
+        };
+        size_t a = 0;
+        size_t b = 0;
+        auto head = spec.substr(0, dash);
+        auto tail = spec.substr(dash + 1);
+        if (head.empty()) {
+            if (!to_size(tail, &b)) {
+                return true;
+            }
+            if (b == 0 || size == 0) {
+                return false;
+            }
+            *first = size > b ? size - b : 0;
+            *last = size - 1;
+        } else {
+            if (!to_size(head, &a) || (!tail.empty() && (!to_size(tail, &b) || b < a))) {
+                return true;
+            }
+            if (a >= size) {
+                return false;
+            }
+            *first = a;
+            *last = tail.empty() ? size - 1 : std::min(b, size - 1);
+        }
+        *ranged = true;
+        return true;
+    }
+
+    void CacheRawProcessor::process(const melon::RestfulRequest *request, melon::RestfulResponse *response) {
+        response->set_access_control_all_allow();
+        auto &uri = request->uri();
+        auto *key = uri.GetQuery("key");
+        if (key == nullptr) {
+            response->set_status_code(400);
+            response->set_header("Content-Type", "text/plain");
+            response->set_body("no key\n");
+            return;
+        }
+        halakv::KvRequest kv_request;
+        halakv::KvResponse kv_response;
+        kv_request.set_key(*key);
+        if (!scope_request(uri.GetQuery("ns"), &kv_request, response)) {
+            return;
+        }
+        uint64_t if_not_version;
+        if (version_of_etag(request->header("If-None-Match"), &if_not_version)) {
+            kv_request.set_if_not_version(if_not_version);
+        }
+        auto rs = KvProxy::instance()->get(&kv_request, &kv_response);
+        if (!rs.ok()) {
+            response->set_status_code(status_of(rs));
+            response->set_header("Content-Type", "text/plain");
+            response->set_body(rs.to_string() + "\n");
+            return;
+        }
+        if (kv_response.code() != static_cast<int>(turbo::StatusCode::kOk)) {
+            auto not_found = kv_response.code() == static_cast<int>(turbo::StatusCode::kNotFound);
+            response->set_status_code(not_found ? 404 : 500);
+            response->set_header("Content-Type", "text/plain");
+            response->set_body(kv_response.message() + "\n");
+            return;
+        }
+        auto &value = kv_response.value();
+        auto etag = etag_of(kv_response);
+        response->set_header("ETag", etag);
+        response->set_header("Accept-Ranges", "bytes");
+        response->set_header("Cache-Control", "no-cache");
+        // the owner left the value out, the entry is still at the asked version.
+        if (!kv_response.has_value() || etag_matches(request->header("If-None-Match"), etag)) {
+            response->set_status_code(304);
+            return;
+        }
+        response->set_header("Content-Type", "application/octet-stream");
+        auto *range = request->header("Range");
+        // If-Range with another etag asks for the whole new value.
+        auto *if_range = request->header("If-Range");
+        bool ranged = false;
+        size_t first = 0;
+        size_t last = 0;
+        if (range != nullptr && (if_range == nullptr || *if_range == etag)) {
+            if (!parse_range(*range, value.size(), &ranged, &first, &last)) {
+                response->set_status_code(416);
+                response->set_header("Content-Range", turbo::substitute("bytes */$0", value.size()));
+                return;
+            }
+        }
+        if (!ranged) {
+            response->set_status_code(200);
+            response->set_header("Vary", "Accept-Encoding");
+            mutil::IOBuf gzip;
+            auto cache_key = gzip_key(kv_request.key(), kv_response, Compressor::kValue);
+            if (Compressor::instance()->http_gzip(request->header("Accept-Encoding"), cache_key.get(), value,
+                                                  &gzip)) {
+                // the bytes differ from the ones the strong etag names.
+                response->set_header("ETag", "W/" + etag);
+                response->set_header("Content-Encoding", "gzip");
+                response->set_body(gzip);
+            } else {
+                response->set_body(value);
+            }
+            return;
+        }
+        response->set_status_code(206);
+        response->set_header("Content-Range", turbo::substitute("bytes $0-$1/$2", first, last, value.size()));
+        mutil::IOBuf body;
+        body.append(value.data() + first, last - first + 1);
+        response->set_body(body);
+    }
+
+    namespace {
+        struct AsyncGet {
+            melon::Controller *cntl;
+            google::protobuf::Closure *done;
+            halakv::KvRequest request;
+            halakv::KvResponse response;
+        };
+
+        void finish_async_get(AsyncGet *call, int status_code) {
+            std::unique_ptr<AsyncGet> guard(call);
+            melon::ClosureGuard done_guard(call->done);
+            auto &http = call->cntl->http_response();
+            http.set_status_code(status_code);
+            http.set_content_type("application/json");
+            http.SetHeader("Access-Control-Allow-Origin", "*");
+            http.SetHeader("Vary", "Accept-Encoding");
+            auto *accept_encoding = call->cntl->http_request().GetHeader("Accept-Encoding");
+            if (gzip_json(accept_encoding, call->request.key(), call->response,
+                          &call->cntl->response_attachment())) {
+                http.SetHeader("Content-Encoding", "gzip");
+            } else {
+                write_json(call->response, &call->cntl->response_attachment());
+            }
+        }
+    }  // namespace
+
+    void KvRestServiceImpl::get(::google::protobuf::RpcController *controller,
+                                const ::halakv::HttpRequest *,
+                                ::halakv::HttpResponse *,
+                                ::google::protobuf::Closure *done) {
+        auto *call = new AsyncGet{static_cast<melon::Controller *>(controller), done};
+        auto &uri = call->cntl->http_request().uri();
+        auto *key = uri.GetQuery("key");
+        if (key == nullptr) {
+            call->response.set_code(static_cast<int>(turbo::StatusCode::kInvalidArgument));
+            call->response.set_value("");
+            call->response.set_message("no key");
+            finish_async_get(call, 200);
+            return;
+        }
+        call->request.set_key(*key);
+        auto *ns = uri.GetQuery("ns");
+        if (ns != nullptr && !ns->empty()) {
+            call->request.set_ns(*ns);
+        }
+        auto rs = Namespaces::instance()->scope(&call->request);
+        if (!rs.ok()) {
+            call->response.set_code(static_cast<int>(rs.code()));
+            call->response.set_message(std::string(rs.message()));
+            finish_async_get(call, rs.code() == turbo::StatusCode::kResourceExhausted ? 429 : 200);
+            return;
+        }
+        KvProxy::instance()->get_async(&call->request, &call->response, call->cntl, [call](const turbo::Status &rs) {
+            finish_async_get(call, status_of(rs));
+        });
     }
 
     turbo::Status registry_server(melon::Server *server) {
         auto service = melon::RestfulService::instance();
         service->set_processor("/cache/set", std::make_shared<CacheSetProcessor>());
-        service->set_processor("/cache/get", std::make_shared<CacheGetProcessor>());
+        if (!FLAGS_rest_async_get) {
+            service->set_processor("/cache/get", std::make_shared<CacheGetProcessor>());
+        }
+        service->set_processor("/cache/mset", std::make_shared<CacheMSetProcessor>());
+        service->set_processor("/cache/mget", std::make_shared<CacheMGetProcessor>());
+        service->set_processor("/cache/mremove", std::make_shared<CacheMRemoveProcessor>());
+        service->set_processor("/cache/raw", std::make_shared<CacheRawProcessor>());
         service->set_not_found_processor(std::make_shared<NotFoundProcessor>());
         service->set_root_processor(std::make_shared<RootProcessor>());
         service->set_mapping_path("ea");
@@ -24,6 +24,7 @@
 #include <halakv/web_service.h>
 #include <melon/rpc/server.h>
 #include <halakv/cache.h>
+#include <halakv/kv.pb.h>
 
 namespace halakv {
 
@@ -67,6 +68,37 @@ namespace halakv {
         void process(const melon::RestfulRequest *request, melon::RestfulResponse *response) override;
     };
 
+    struct CacheMSetProcessor : public melon::RestfulProcessor {
+        void process(const melon::RestfulRequest *request, melon::RestfulResponse *response) override;
+    };
+
+    struct CacheMGetProcessor : public melon::RestfulProcessor {
+        void process(const melon::RestfulRequest *request, melon::RestfulResponse *response) override;
+    };
+
+    struct CacheMRemoveProcessor : public melon::RestfulProcessor {
+        void process(const melon::RestfulRequest *request, melon::RestfulResponse *response) override;
+    };
+
+    // the value as is, with an etag of its content, answering If-None-Match
+    // with 304 and a single Range with 206.
+    struct CacheRawProcessor : public melon::RestfulProcessor {
+        void process(const melon::RestfulRequest *request, melon::RestfulResponse *response) override;
+    };
+
+    // /ea/cache/get served as an http method of a pb service, so that the
+    // response can be finished after the processor returns. a key owned by a
+    // peer is asked for on a background fiber and done runs when it is back,
+    // no worker waits for the round trip. mounted by --rest_async_get in place
+    // of CacheGetProcessor.
+    class KvRestServiceImpl : public halakv::KvRestService {
+    public:
+        void get(::google::protobuf::RpcController *controller,
+                 const ::halakv::HttpRequest *request,
+                 ::halakv::HttpResponse *response,
+                 ::google::protobuf::Closure *done) override;
+    };
+
     turbo::Status registry_server(melon::Server *server);
 
 
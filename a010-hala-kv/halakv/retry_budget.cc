@@ -0,0 +1,59 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-25.
+//
+#include <halakv/retry_budget.h>
+#include <algorithm>
+
+namespace halakv {
+
+    void RetryBudget::init(double ratio, int max_tokens) {
+        _deposit = std::max<int64_t>(static_cast<int64_t>(ratio * kMilli), 0);
+        _max_milli_tokens = std::max<int64_t>(max_tokens, 1) * kMilli;
+        _milli_tokens.store(_max_milli_tokens, std::memory_order_relaxed);
+    }
+
+    void RetryBudget::on_request() {
+        auto cur = _milli_tokens.load(std::memory_order_relaxed);
+        while (cur < _max_milli_tokens) {
+            auto next = std::min(cur + _deposit, _max_milli_tokens);
+            if (_milli_tokens.compare_exchange_weak(cur, next, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    bool RetryBudget::acquire_retry() {
+        auto cur = _milli_tokens.load(std::memory_order_relaxed);
+        while (cur >= kMilli) {
+            if (_milli_tokens.compare_exchange_weak(cur, cur - kMilli, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void RetryBudget::release_retry() {
+        auto cur = _milli_tokens.load(std::memory_order_relaxed);
+        while (!_milli_tokens.compare_exchange_weak(cur, std::min(cur + kMilli, _max_milli_tokens),
+                                                    std::memory_order_relaxed)) {
+        }
+    }
+
+}  // namespace halakv
@@ -0,0 +1,55 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-25.
+//
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace halakv {
+
+    // token bucket that bounds retries to a fraction of the requests sent to
+    // a peer. every request deposits `ratio` token, every retry withdraws one,
+    // so an overloaded peer sees at most (1 + ratio) times of its normal load.
+    class RetryBudget {
+    public:
+        RetryBudget() = default;
+
+        void init(double ratio, int max_tokens);
+
+        void on_request();
+
+        bool acquire_retry();
+
+        // a token taken by acquire_retry and not used.
+        void release_retry();
+
+        int64_t tokens() const {
+            return _milli_tokens.load(std::memory_order_relaxed) / kMilli;
+        }
+
+    private:
+        static constexpr int64_t kMilli = 1000;
+        int64_t _deposit{100};
+        int64_t _max_milli_tokens{10 * kMilli};
+        std::atomic<int64_t> _milli_tokens{10 * kMilli};
+    };
+
+}  // namespace halakv
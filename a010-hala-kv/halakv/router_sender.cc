@@ -20,14 +20,366 @@
 //
 
 #include <halakv/router_sender.h>
+#include <gflags/gflags.h>
+#include <melon/utility/fast_rand.h>
+#include <unordered_map>
+
+DEFINE_string(router_connection_type, "single", "Connection type of the channels to peers. Available values: single, pooled");
+DEFINE_double(router_retry_ratio, 0.1, "Retries to a peer are limited to this ratio of the requests sent to it");
+DEFINE_int32(router_retry_budget, 10, "Max retry tokens a peer can accumulate");
+DEFINE_int32(router_hedge_percent, 5, "Backup requests of gets are limited to this percent of the gets sent to a peer, 0 to disable hedging");
+DEFINE_double(router_hedge_percentile, 0.95, "A backup get is sent once the first one takes longer than this latency percentile of the peer");
+DEFINE_int32(router_hedge_min_ms, 2, "Min delay before a backup get is sent");
+DEFINE_int32(router_hedge_refresh_ms, 100, "Interval to refresh the hedge delay from the latency of the peer");
 
 namespace halakv {
 
     turbo::Status RouterSender::init(const std::string &server) {
         _server = server;
+        if (_connection_type.empty()) {
+            _connection_type = FLAGS_router_connection_type;
+        }
+        _channel_init_count.expose_as("halakv_router", _server + "_channel_init");
+        _channel_init_fail_count.expose_as("halakv_router", _server + "_channel_init_fail");
+        _request_fail_count.expose_as("halakv_router", _server + "_request_fail");
+        _retry_count.expose_as("halakv_router", _server + "_retry");
+        _retry_budget_exhausted_count.expose_as("halakv_router", _server + "_retry_budget_exhausted");
+        _deadline_exceeded_count.expose_as("halakv_router", _server + "_deadline_exceeded");
+        _hedge_count.expose_as("halakv_router", _server + "_hedge");
+        _canceled_count.expose_as("halakv_router", _server + "_canceled");
+        _latency.expose("halakv_router", _server);
+        _retry_budget.init(FLAGS_router_retry_ratio, FLAGS_router_retry_budget);
+        _hedge_budget.init(FLAGS_router_hedge_percent / 100.0, FLAGS_router_retry_budget);
+        _breaker.init(_server);
+        _limiter.init(_server);
+        std::unique_lock lock(_channel_mutex);
+        auto rs = init_channel();
+        if (!rs.ok()) {
+            // not fatal, the peer may be not started yet, retry on the first request.
+            LOG(WARNING) << "init channel to " << _server << " failed: " << rs;
+        }
+        return turbo::OkStatus();
+    }
+
+    turbo::Status RouterSender::init_channel() {
+        _last_init_us = mutil::gettimeofday_us();
+        _channel_init_count << 1;
+        melon::ChannelOptions channel_opt;
+        channel_opt.timeout_ms = _timeout_ms;
+        channel_opt.connect_timeout_ms = _connect_timeout_ms;
+        channel_opt.connection_type = _connection_type;
+        // retries are done by send_request within the deadline and retry budget.
+        channel_opt.max_retry = 0;
+        auto channel = std::make_shared<melon::Channel>();
+        if (channel->Init(_server.c_str(), &channel_opt) != 0) {
+            _channel_init_fail_count << 1;
+            return turbo::unavailable_error(turbo::substitute("channel init fail, server:$0", _server));
+        }
+        std::atomic_store(&_channel, channel);
         return turbo::OkStatus();
     }
 
+    std::shared_ptr<melon::Channel> RouterSender::get_channel() {
+        auto channel = std::atomic_load(&_channel);
+        if (channel != nullptr) {
+            return channel;
+        }
+        std::unique_lock lock(_channel_mutex);
+        channel = std::atomic_load(&_channel);
+        if (channel != nullptr) {
+            return channel;
+        }
+        if (mutil::gettimeofday_us() - _last_init_us < 1000L * _between_meta_connect_error_ms) {
+            return nullptr;
+        }
+        auto rs = init_channel();
+        LOG_IF(WARNING, !rs.ok()) << "reinit channel to " << _server << " failed: " << rs;
+        return std::atomic_load(&_channel);
+    }
+
+    int64_t RouterSender::backoff_us(int retry_time) const {
+        const int64_t cap_us = 1000L * _between_meta_connect_error_ms;
+        int64_t backoff = 1000L * _backoff_base_ms;
+        for (int i = 1; i < retry_time && backoff < cap_us; i++) {
+            backoff *= 2;
+        }
+        backoff = std::min(backoff, cap_us);
+        // half fixed, half random, so that retries from many callers spread out.
+        return backoff / 2 + static_cast<int64_t>(mutil::fast_rand_less_than(backoff / 2 + 1));
+    }
+
+    void RouterSender::HedgeWait::done(int call) {
+        std::unique_lock lock(_mutex);
+        _done[call] = true;
+        _cond.notify_all();
+    }
+
+    bool RouterSender::HedgeWait::wait(int call, int64_t timeout_us) {
+        auto deadline_us = timeout_us < 0 ? -1 : mutil::gettimeofday_us() + timeout_us;
+        std::unique_lock lock(_mutex);
+        while (!_done[call]) {
+            if (deadline_us < 0) {
+                _cond.wait(lock);
+                continue;
+            }
+            auto left_us = deadline_us - mutil::gettimeofday_us();
+            if (left_us <= 0) {
+                return false;
+            }
+            _cond.wait_for(lock, left_us);
+        }
+        return true;
+    }
+
+    int RouterSender::HedgeWait::wait_winner(melon::Controller *const calls[2]) {
+        std::unique_lock lock(_mutex);
+        while (true) {
+            for (int i = 0; i < 2; i++) {
+                if (_done[i] && !calls[i]->Failed()) {
+                    return i;
+                }
+            }
+            if (_done[0] && _done[1]) {
+                return -1;
+            }
+            _cond.wait(lock);
+        }
+    }
+
+    void RouterSender::release_limiter(const melon::Controller &cntl) {
+        if (!cntl.Failed()) {
+            _limiter.release(cntl.latency_us());
+        } else if (cntl.ErrorCode() == melon::ERPCTIMEDOUT) {
+            _limiter.release_dropped();
+        } else {
+            _limiter.release(-1);
+        }
+    }
+
+    int64_t RouterSender::hedge_delay_ms(int64_t timeout_ms) {
+        if (FLAGS_router_hedge_percent <= 0) {
+            return -1;
+        }
+        // the percentile is merged from all the samples of the window, too heavy for every request.
+        auto now = mutil::gettimeofday_us();
+        auto refresh_us = _hedge_refresh_us.load(std::memory_order_relaxed);
+        if (now - refresh_us > 1000L * FLAGS_router_hedge_refresh_ms &&
+            _hedge_refresh_us.compare_exchange_strong(refresh_us, now, std::memory_order_relaxed)) {
+            auto percentile_us = _latency.latency_percentile(FLAGS_router_hedge_percentile);
+            // no sample yet, do not hedge blindly.
+            auto delay_ms = percentile_us <= 0 ? -1 : std::max<int64_t>(percentile_us / 1000, FLAGS_router_hedge_min_ms);
+            _hedge_delay_ms.store(delay_ms, std::memory_order_relaxed);
+        }
+        auto delay_ms = _hedge_delay_ms.load(std::memory_order_relaxed);
+        return delay_ms < timeout_ms ? delay_ms : -1;
+    }
+
+    turbo::Status RouterSender::final_status(int retry_time, int retry_times, bool attempted, bool delivered,
+                                             bool unreachable, Cancellation *cancel) {
+        if (cancel != nullptr && cancel->canceled()) {
+            if (!attempted) {
+                _breaker.release_probe();
+            }
+            _canceled_count << 1;
+            return turbo::cancelled_error(turbo::substitute("canceled by the caller after $0 tries", retry_time));
+        }
+        if (!attempted) {
+            // no call was made within the deadline, give the probe to the next request.
+            _breaker.release_probe();
+        }
+        _deadline_exceeded_count << 1;
+        return give_up(delivered, unreachable,
+                       turbo::substitute("try times $0 reach max_try $1 or deadline and can not get response.",
+                                         retry_time, retry_times));
+    }
+
+    // the state of get_async across its attempts, it is the done closure of each.
+    class RouterSender::AsyncGet : public google::protobuf::Closure {
+    public:
+        void Run() override {
+            sender->on_async_done(this);
+        }
+
+        RouterSender *sender{nullptr};
+        halakv::KvRequest request;
+        halakv::KvResponse *response{nullptr};
+        int retry_times{0};
+        int64_t deadline_us{-1};
+        Cancellation *cancel{nullptr};
+        std::function<void(const turbo::Status &)> done;
+        melon::Controller cntl;
+        melon::CallId call_id;
+        uint64_t log_id{0};
+        int retry_time{0};
+        bool attempted{false};
+        bool delivered{false};
+        bool unreachable{false};
+    };
+
+    void RouterSender::get_async(const halakv::KvRequest &request, halakv::KvResponse *response, int retry_times,
+                                 int64_t deadline_us, Cancellation *cancel,
+                                 std::function<void(const turbo::Status &)> done) {
+        if (!_breaker.allow()) {
+            done(turbo::unavailable_error(turbo::substitute("circuit breaker of $0 is open", _server)));
+            return;
+        }
+        _retry_budget.on_request();
+        auto *call = new AsyncGet;
+        call->sender = this;
+        call->request = request;
+        call->response = response;
+        call->retry_times = retry_times;
+        call->deadline_us = deadline_us;
+        call->cancel = cancel;
+        call->done = std::move(done);
+        call->log_id = mutil::fast_rand();
+        issue_async(call);
+    }
+
+    void RouterSender::issue_async(AsyncGet *call) {
+        static const auto *method = find_method("peer_get");
+        auto *cancel = call->cancel;
+        do {
+            if (cancel != nullptr && cancel->canceled()) {
+                break;
+            }
+            if (call->retry_time > 0) {
+                if (_breaker.state() != CircuitBreaker::kClosed) {
+                    finish_async(call, give_up(call->delivered, true,
+                                               turbo::substitute("circuit breaker of $0 opened after $1 tries",
+                                                                 _server, call->retry_time)));
+                    return;
+                }
+            }
+            int64_t timeout_ms = _timeout_ms;
+            if (call->deadline_us > 0) {
+                auto left_us = call->deadline_us - mutil::gettimeofday_us();
+                if (left_us < kMinAttemptUs) {
+                    break;
+                }
+                timeout_ms = std::min<int64_t>(timeout_ms, left_us / 1000);
+            }
+            // the token is taken once the deadline leaves room for the retry.
+            bool retry_token = false;
+            if (call->retry_time > 0) {
+                if (!_retry_budget.acquire_retry()) {
+                    _retry_budget_exhausted_count << 1;
+                    finish_async(call, give_up(call->delivered, call->unreachable,
+                                               turbo::substitute("retry budget of $0 exhausted after $1 tries",
+                                                                 _server, call->retry_time)));
+                    return;
+                }
+                retry_token = true;
+            }
+            if (!_limiter.acquire()) {
+                if (retry_token) {
+                    _retry_budget.release_retry();
+                }
+                if (!call->attempted) {
+                    _breaker.release_probe();
+                }
+                finish_async(call, turbo::resource_exhausted_error(
+                        turbo::substitute("$0 is at its concurrency limit $1", _server, _limiter.limit())));
+                return;
+            }
+            auto channel = get_channel();
+            call->attempted = true;
+            if (channel == nullptr) {
+                _limiter.release(-1);
+                _breaker.on_failure();
+                call->unreachable = true;
+                ++call->retry_time;
+                continue;
+            }
+            call->cntl.Reset();
+            call->cntl.set_log_id(call->log_id);
+            call->cntl.set_timeout_ms(timeout_ms);
+            call->call_id = call->cntl.call_id();
+            if (cancel != nullptr && !cancel->enter(call->call_id)) {
+                _limiter.release(-1);
+                if (retry_token) {
+                    _retry_budget.release_retry();
+                }
+                break;
+            }
+            if (retry_token) {
+                _retry_count << 1;
+            }
+            // the closure may run in place, call must not be touched after this.
+            channel->CallMethod(method, &call->cntl, &call->request, call->response, call);
+            return;
+        } while (call->retry_time < call->retry_times);
+        finish_async(call, final_status(call->retry_time, call->retry_times, call->attempted, call->delivered,
+                                        call->unreachable, cancel));
+    }
+
+    void RouterSender::on_async_done(AsyncGet *call) {
+        auto &cntl = call->cntl;
+        auto *cancel = call->cancel;
+        if (cancel != nullptr) {
+            cancel->leave(call->call_id);
+        }
+        if (cntl.Failed() && cntl.ErrorCode() == melon::ELIMIT) {
+            _limiter.release(-1);
+            _breaker.release_probe();
+            _request_fail_count << 1;
+            finish_async(call, turbo::resource_exhausted_error(turbo::substitute("$0 shed the request: $1", _server,
+                                                                                 cntl.ErrorText())));
+            return;
+        }
+        if (!cntl.Failed()) {
+            _limiter.release(cntl.latency_us());
+        } else if (cntl.ErrorCode() == melon::ERPCTIMEDOUT) {
+            _limiter.release_dropped();
+        } else {
+            _limiter.release(-1);
+        }
+        if (!cntl.Failed()) {
+            _latency << cntl.latency_us();
+            _breaker.on_success(cntl.latency_us());
+            finish_async(call, turbo::OkStatus());
+            return;
+        }
+        if (cancel != nullptr && cancel->canceled()) {
+            _breaker.release_probe();
+        } else {
+            _request_fail_count << 1;
+            _breaker.on_failure();
+            if (connection_failure(cntl.ErrorCode())) {
+                call->unreachable = true;
+            } else {
+                call->delivered = true;
+            }
+            LOG_IF(WARNING, _verbose) << "async get from " << _server << " failed: " << cntl.ErrorText()
+                                      << ", log_id:" << cntl.log_id();
+            if (++call->retry_time < call->retry_times) {
+                issue_async(call);
+                return;
+            }
+        }
+        finish_async(call, final_status(call->retry_time, call->retry_times, call->attempted, call->delivered,
+                                        call->unreachable, cancel));
+    }
+
+    void RouterSender::finish_async(AsyncGet *call, const turbo::Status &status) {
+        auto done = std::move(call->done);
+        delete call;
+        done(status);
+    }
+
+    const ::google::protobuf::MethodDescriptor *RouterSender::find_method(const std::string &name) {
+        static const std::unordered_map<std::string, const ::google::protobuf::MethodDescriptor *> methods = []() {
+            std::unordered_map<std::string, const ::google::protobuf::MethodDescriptor *> m;
+            const ::google::protobuf::ServiceDescriptor *service_desc = halakv::KvService::descriptor();
+            for (int i = 0; i < service_desc->method_count(); i++) {
+                m[service_desc->method(i)->name()] = service_desc->method(i);
+            }
+            return m;
+        }();
+        auto it = methods.find(name);
+        return it == methods.end() ? nullptr : it->second;
+    }
+
     RouterSender &RouterSender::set_verbose(bool verbose) {
         _verbose = verbose;
         return *this;
@@ -53,16 +405,92 @@ namespace halakv {
         return *this;
     }
 
-    turbo::Status RouterSender::set(const halakv::KvRequest &request, halakv::KvResponse &response, int retry_times) {
-        return send_request("set", request, response, retry_times);
+    RouterSender &RouterSender::set_connection_type(const std::string &type) {
+        _connection_type = type;
+        return *this;
+    }
+
+    turbo::Status RouterSender::set(const halakv::KvRequest &request, halakv::KvResponse &response, int retry_times,
+                                  int64_t deadline_us, Cancellation *cancel) {
+        return send_request("peer_set", request, response, retry_times, deadline_us, false, cancel);
+    }
+
+    turbo::Status RouterSender::get(const halakv::KvRequest &request, halakv::KvResponse &response, int retry_times,
+                                  int64_t deadline_us, Cancellation *cancel) {
+        return send_request("peer_get", request, response, retry_times, deadline_us, true, cancel);
+    }
+
+    turbo::Status RouterSender::remove(const halakv::KvRequest &request, halakv::KvResponse &response, int retry_times,
+                                  int64_t deadline_us, Cancellation *cancel) {
+        return send_request("peer_remove", request, response, retry_times, deadline_us, false, cancel);
     }
 
-    turbo::Status RouterSender::get(const halakv::KvRequest &request, halakv::KvResponse &response, int retry_times) {
-        return send_request("get", request, response, retry_times);
+    turbo::Status RouterSender::mset(const halakv::MultiKvRequest &request, halakv::MultiKvResponse &response, int retry_times,
+                                  int64_t deadline_us, Cancellation *cancel) {
+        return send_request("peer_mset", request, response, retry_times, deadline_us, false, cancel);
     }
 
-    turbo::Status RouterSender::remove(const halakv::KvRequest &request, halakv::KvResponse &response, int retry_times) {
-        return send_request("remove", request, response, retry_times);
+    turbo::Status RouterSender::mget(const halakv::MultiKvRequest &request, halakv::MultiKvResponse &response, int retry_times,
+                                  int64_t deadline_us, Cancellation *cancel) {
+        return send_request("peer_mget", request, response, retry_times, deadline_us, true, cancel);
+    }
+
+    turbo::Status RouterSender::mremove(const halakv::MultiKvRequest &request, halakv::MultiKvResponse &response, int retry_times,
+                                  int64_t deadline_us, Cancellation *cancel) {
+        return send_request("peer_mremove", request, response, retry_times, deadline_us, false, cancel);
+    }
+
+    turbo::Status RouterSender::invalidate(const halakv::InvalidateRequest &request, halakv::KvResponse &response,
+                                           int retry_times, int64_t deadline_us, Cancellation *cancel) {
+        return send_request("invalidate", request, response, retry_times, deadline_us, false, cancel);
+    }
+
+    turbo::Status RouterSender::hints(const halakv::HintsRequest &request, halakv::HintsResponse &response,
+                                      int retry_times, int64_t deadline_us, Cancellation *cancel) {
+        return send_request("hints", request, response, retry_times, deadline_us, false, cancel);
+    }
+
+    turbo::Status RouterSender::merkle(const halakv::MerkleRequest &request, halakv::MerkleResponse &response,
+                                       int retry_times, int64_t deadline_us, Cancellation *cancel) {
+        return send_request("merkle", request, response, retry_times, deadline_us, false, cancel);
+    }
+
+    turbo::Status RouterSender::scan(const halakv::ScanRequest &request, halakv::ScanResponse &response,
+                                     int retry_times, int64_t deadline_us, Cancellation *cancel) {
+        return send_request("scan", request, response, retry_times, deadline_us, false, cancel);
+    }
+
+    turbo::Status RouterSender::replicate(const halakv::ReplicateRequest &request, halakv::KvResponse &response,
+                                          const melon::StreamOptions &options, melon::StreamId *stream) {
+        if (!_breaker.allow()) {
+            return turbo::unavailable_error(turbo::substitute("circuit breaker of $0 is open", _server));
+        }
+        auto channel = get_channel();
+        if (channel == nullptr) {
+            _breaker.release_probe();
+            return turbo::unavailable_error(turbo::substitute("channel init fail, server:$0", _server));
+        }
+        melon::Controller cntl;
+        cntl.set_timeout_ms(_timeout_ms);
+        if (melon::StreamCreate(stream, cntl, &options) != 0) {
+            _breaker.release_probe();
+            return turbo::internal_error(turbo::substitute("create stream to $0 failed", _server));
+        }
+        channel->CallMethod(find_method("replicate"), &cntl, &request, &response, nullptr);
+        if (cntl.Failed()) {
+            _breaker.on_failure();
+            melon::StreamClose(*stream);
+            *stream = melon::INVALID_STREAM_ID;
+            return turbo::unavailable_error(turbo::substitute("replicate to $0 failed: $1", _server, cntl.ErrorText()));
+        }
+        _breaker.on_success(cntl.latency_us());
+        if (response.code() != static_cast<int>(turbo::StatusCode::kOk)) {
+            melon::StreamClose(*stream);
+            *stream = melon::INVALID_STREAM_ID;
+            return turbo::failed_precondition_error(turbo::substitute("replicate to $0 rejected: $1", _server,
+                                                                      response.message()));
+        }
+        return turbo::OkStatus();
     }
 
 }  // halakv
@@ -28,9 +28,24 @@
 #include <melon/rpc/channel.h>
 #include <melon/rpc/server.h>
 #include <melon/rpc/controller.h>
+#include <melon/rpc/stream.h>
 #include <google/protobuf/descriptor.h>
 #include <turbo/strings/substitute.h>
+#include <melon/var/var.h>
+#include <melon/utility/time.h>
 #include <halakv/kv.pb.h>
+#include <halakv/retry_budget.h>
+#include <halakv/circuit_breaker.h>
+#include <halakv/cancellation.h>
+#include <halakv/concurrency_limiter.h>
+#include <melon/fiber/condition_variable.h>
+#include <melon/fiber/mutex.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <functional>
+#include <memory>
+#include <mutex>
 
 namespace halakv {
 
@@ -58,16 +73,155 @@ namespace halakv {
 
         RouterSender &set_retry_time(int retry);
 
-        turbo::Status set(const halakv::KvRequest &request, halakv::KvResponse &response, int retry_times);
+        // single or pooled, must be called before init.
+        RouterSender &set_connection_type(const std::string &type);
 
-        turbo::Status get(const halakv::KvRequest &request, halakv::KvResponse &response, int retry_times);
+        CircuitBreaker &breaker() {
+            return _breaker;
+        }
+
+        turbo::Status set(const halakv::KvRequest &request, halakv::KvResponse &response, int retry_times,
+                          int64_t deadline_us = -1, Cancellation *cancel = nullptr);
+
+        // gets are idempotent and hedged, see hedge_delay_ms.
+        turbo::Status get(const halakv::KvRequest &request, halakv::KvResponse &response, int retry_times,
+                          int64_t deadline_us = -1, Cancellation *cancel = nullptr);
+
+        // get without holding a fiber for the round trip, each attempt is sent
+        // with a done closure and the retry or done is run from it. the budget,
+        // breaker and deadline are the same as for get, but a retry is sent at
+        // once and the call is not hedged. response and cancel must live until
+        // done runs, it may run in place.
+        void get_async(const halakv::KvRequest &request, halakv::KvResponse *response, int retry_times,
+                       int64_t deadline_us, Cancellation *cancel, std::function<void(const turbo::Status &)> done);
+
+        turbo::Status remove(const halakv::KvRequest &request, halakv::KvResponse &response, int retry_times,
+                             int64_t deadline_us = -1, Cancellation *cancel = nullptr);
+
+        turbo::Status mset(const halakv::MultiKvRequest &request, halakv::MultiKvResponse &response, int retry_times,
+                           int64_t deadline_us = -1, Cancellation *cancel = nullptr);
+
+        turbo::Status mget(const halakv::MultiKvRequest &request, halakv::MultiKvResponse &response, int retry_times,
+                           int64_t deadline_us = -1, Cancellation *cancel = nullptr);
+
+        turbo::Status mremove(const halakv::MultiKvRequest &request, halakv::MultiKvResponse &response, int retry_times,
+                              int64_t deadline_us = -1, Cancellation *cancel = nullptr);
 
-        turbo::Status remove(const halakv::KvRequest &request, halakv::KvResponse &response, int retry_times);
+        // deadline_us is the absolute deadline of the caller in gettimeofday_us,
+        // -1 means no deadline and each attempt uses the channel timeout. cancel
+        // stops the attempt in flight and the retries when the caller gives up.
+        turbo::Status invalidate(const halakv::InvalidateRequest &request, halakv::KvResponse &response, int retry_times,
+                                 int64_t deadline_us = -1, Cancellation *cancel = nullptr);
+
+        turbo::Status hints(const halakv::HintsRequest &request, halakv::HintsResponse &response, int retry_times,
+                            int64_t deadline_us = -1, Cancellation *cancel = nullptr);
+
+        // hedge must only be set for idempotent methods.
+        turbo::Status merkle(const halakv::MerkleRequest &request, halakv::MerkleResponse &response, int retry_times,
+                             int64_t deadline_us = -1, Cancellation *cancel = nullptr);
+
+        turbo::Status scan(const halakv::ScanRequest &request, halakv::ScanResponse &response, int retry_times,
+                           int64_t deadline_us = -1, Cancellation *cancel = nullptr);
+
+        // one try, the stream is created along with the call and must be closed by the caller.
+        turbo::Status replicate(const halakv::ReplicateRequest &request, halakv::KvResponse &response,
+                                const melon::StreamOptions &options, melon::StreamId *stream);
 
         template<typename Request, typename Response>
         turbo::Status send_request(const std::string &service_name,
                                    const Request &request,
-                                   Response &response, int retry_times);
+                                   Response &response, int retry_times, int64_t deadline_us = -1,
+                                   bool hedge = false, Cancellation *cancel = nullptr);
+
+    private:
+        // a attempt with less time left than this is not worth sending.
+        static constexpr int64_t kMinAttemptUs = 1000;
+
+        class AsyncGet;
+
+        // the calls of a hedged attempt, the first one and its backup, each
+        // marks itself done from its closure.
+        class HedgeWait {
+        public:
+            class Done : public google::protobuf::Closure {
+            public:
+                Done(HedgeWait *wait, int call) : _wait(wait), _call(call) {}
+
+                void Run() override {
+                    _wait->done(_call);
+                }
+
+            private:
+                HedgeWait *_wait;
+                int _call;
+            };
+
+            void done(int call);
+
+            // false if the call is not done within timeout_us.
+            bool wait(int call, int64_t timeout_us = -1);
+
+            // the first call done without failure, -1 once both failed.
+            int wait_winner(melon::Controller *const calls[2]);
+
+        private:
+            fiber::Mutex _mutex;
+            fiber::ConditionVariable _cond;
+            bool _done[2]{false, false};
+        };
+
+        // sends the first call, and the backup on a controller of its own if the
+        // first is not back after backup_ms. the first to succeed wins and the
+        // other is canceled. returns the controller of the result, the first
+        // one if both failed. the hedge token is given back if no backup is sent.
+        template<typename Request, typename Response>
+        melon::Controller *hedge_call(melon::Channel *channel, const ::google::protobuf::MethodDescriptor *method,
+                                      const Request &request, Response &response, melon::Controller &cntl,
+                                      Response &backup_response, melon::Controller &backup_cntl,
+                                      int64_t timeout_ms, int64_t backup_ms, Cancellation *cancel);
+
+        void release_limiter(const melon::Controller &cntl);
+
+        // sends the next attempt of the call, or runs its done if none is left.
+        void issue_async(AsyncGet *call);
+
+        void on_async_done(AsyncGet *call);
+
+        // runs done of the call after the last attempt, as send_request returns.
+        void finish_async(AsyncGet *call, const turbo::Status &status);
+
+        turbo::Status final_status(int retry_time, int retry_times, bool attempted, bool delivered,
+                                   bool unreachable, Cancellation *cancel);
+
+        // the channel is created once in init and shared by all requests. a broken
+        // connection is health checked and revived by the channel itself, the channel
+        // is only rebuilt here when it could not be initialized at all.
+        std::shared_ptr<melon::Channel> get_channel();
+
+        turbo::Status init_channel();
+
+        static const ::google::protobuf::MethodDescriptor *find_method(const std::string &name);
+
+        // the peer could not be connected to, the request was not sent.
+        static bool connection_failure(int error_code) {
+            return error_code == EHOSTDOWN || error_code == ECONNREFUSED;
+        }
+
+        // unavailable only if the request surely did not reach the peer, which
+        // callers may take as safe to hint, deadline_exceeded otherwise.
+        static turbo::Status give_up(bool delivered, bool unreachable, const std::string &message) {
+            if (unreachable && !delivered) {
+                return turbo::unavailable_error(message);
+            }
+            return turbo::deadline_exceeded_error(message);
+        }
+
+        // exponential backoff with jitter, capped by _between_meta_connect_error_ms.
+        int64_t backoff_us(int retry_time) const;
+
+        // delay after which a backup request is sent, the observed latency percentile
+        // of the peer, or -1 if hedging is off or not warmed up.
+        int64_t hedge_delay_ms(int64_t timeout_ms);
 
     private:
         bool _verbose{false};
@@ -76,50 +230,236 @@ namespace halakv {
         int _timeout_ms{300};
         int _connect_timeout_ms{500};
         int _between_meta_connect_error_ms{1000};
+        int _backoff_base_ms{10};
+        std::string _connection_type;
+        std::mutex _channel_mutex;
+        std::shared_ptr<melon::Channel> _channel;
+        int64_t _last_init_us{0};
+        melon::var::Adder<int64_t> _channel_init_count;
+        melon::var::Adder<int64_t> _channel_init_fail_count;
+        melon::var::Adder<int64_t> _request_fail_count;
+        melon::var::Adder<int64_t> _retry_count;
+        melon::var::Adder<int64_t> _retry_budget_exhausted_count;
+        melon::var::Adder<int64_t> _deadline_exceeded_count;
+        melon::var::Adder<int64_t> _hedge_count;
+        melon::var::Adder<int64_t> _canceled_count;
+        melon::var::LatencyRecorder _latency;
+        RetryBudget _retry_budget;
+        // same bucket as retries, every hedged method deposits and every backup sent withdraws.
+        RetryBudget _hedge_budget;
+        std::atomic<int64_t> _hedge_delay_ms{-1};
+        std::atomic<int64_t> _hedge_refresh_us{0};
+        CircuitBreaker _breaker;
+        ConcurrencyLimiter _limiter;
     };
 
+    template<typename Request, typename Response>
+    melon::Controller *RouterSender::hedge_call(melon::Channel *channel,
+                                                const ::google::protobuf::MethodDescriptor *method,
+                                                const Request &request, Response &response, melon::Controller &cntl,
+                                                Response &backup_response, melon::Controller &backup_cntl,
+                                                int64_t timeout_ms, int64_t backup_ms, Cancellation *cancel) {
+        HedgeWait wait;
+        HedgeWait::Done first_done(&wait, 0);
+        HedgeWait::Done backup_done(&wait, 1);
+        channel->CallMethod(method, &cntl, &request, &response, &first_done);
+        if (wait.wait(0, backup_ms * 1000)) {
+            _hedge_budget.release_retry();
+            return &cntl;
+        }
+        // the backup is a call of its own to the limiter and the cancellation.
+        if (!_limiter.acquire()) {
+            _hedge_budget.release_retry();
+            wait.wait(0);
+            return &cntl;
+        }
+        backup_cntl.set_log_id(cntl.log_id());
+        backup_cntl.set_timeout_ms(std::max<int64_t>(timeout_ms - backup_ms, 1));
+        auto backup_id = backup_cntl.call_id();
+        if (cancel != nullptr && !cancel->enter(backup_id)) {
+            _limiter.release(-1);
+            _hedge_budget.release_retry();
+            wait.wait(0);
+            return &cntl;
+        }
+        _hedge_count << 1;
+        channel->CallMethod(method, &backup_cntl, &request, &backup_response, &backup_done);
+        melon::Controller *const calls[2] = {&cntl, &backup_cntl};
+        auto winner = wait.wait_winner(calls);
+        if (winner >= 0) {
+            melon::StartCancel(calls[1 - winner]->call_id());
+        }
+        // both closures are on this stack.
+        wait.wait(0);
+        wait.wait(1);
+        if (cancel != nullptr) {
+            cancel->leave(backup_id);
+        }
+        // the slot of the call that is not the result, the caller releases the other.
+        release_limiter(winner == 1 ? cntl : backup_cntl);
+        return winner == 1 ? &backup_cntl : &cntl;
+    }
+
     template<typename Request, typename Response>
     turbo::Status RouterSender::send_request(const std::string &service_name,
                                              const Request &request,
-                                             Response &response, int retry_times) {
-        const ::google::protobuf::ServiceDescriptor *service_desc = halakv::KvService::descriptor();
-        const ::google::protobuf::MethodDescriptor *method =
-                service_desc->FindMethodByName(service_name);
+                                             Response &response, int retry_times, int64_t deadline_us,
+                                             bool hedge, Cancellation *cancel) {
+        const ::google::protobuf::MethodDescriptor *method = find_method(service_name);
         if (method == nullptr) {
             LOG_IF(ERROR, _verbose) << "service name not exist, service:" << service_name;
             return turbo::invalid_argument_error(turbo::substitute("service name not exist, service:$0", service_name));
         }
+        if (!_breaker.allow()) {
+            return turbo::unavailable_error(turbo::substitute("circuit breaker of $0 is open", _server));
+        }
         int retry_time = 0;
+        bool attempted = false;
+        // whether an attempt may have reached the peer, and whether one could not
+        // connect to it, see give_up.
+        bool delivered = false;
+        bool unreachable = false;
         uint64_t log_id = mutil::fast_rand();
+        _retry_budget.on_request();
+        if (hedge) {
+            _hedge_budget.on_request();
+        }
         do {
-            if (retry_time > 0 && retry_times > 0) {
-                fiber_usleep(1000 * _between_meta_connect_error_ms);
+            if (cancel != nullptr && cancel->canceled()) {
+                break;
+            }
+            // a retry token is given back if the retry is not sent after all.
+            bool retry_token = false;
+            if (retry_time > 0) {
+                if (_breaker.state() != CircuitBreaker::kClosed) {
+                    return give_up(delivered, true, turbo::substitute("circuit breaker of $0 opened after $1 tries",
+                                                                      _server, retry_time));
+                }
+                auto sleep_us = backoff_us(retry_time);
+                if (deadline_us > 0 && mutil::gettimeofday_us() + sleep_us + kMinAttemptUs > deadline_us) {
+                    break;
+                }
+                if (!_retry_budget.acquire_retry()) {
+                    _retry_budget_exhausted_count << 1;
+                    return give_up(delivered, unreachable,
+                                   turbo::substitute("retry budget of $0 exhausted after $1 tries", _server,
+                                                     retry_time));
+                }
+                retry_token = true;
+                fiber_usleep(sleep_us);
+                if (cancel != nullptr && cancel->canceled()) {
+                    _retry_budget.release_retry();
+                    break;
+                }
             }
-            melon::Controller cntl;
-            cntl.set_log_id(log_id);
-            //store has leader address
-            melon::ChannelOptions channel_opt;
-            channel_opt.timeout_ms = _timeout_ms;
-            channel_opt.connect_timeout_ms = _connect_timeout_ms;
-            melon::Channel short_channel;
-            if (short_channel.Init(_server.c_str(), &channel_opt) != 0) {
+            int64_t timeout_ms = _timeout_ms;
+            if (deadline_us > 0) {
+                auto left_us = deadline_us - mutil::gettimeofday_us();
+                if (left_us < kMinAttemptUs) {
+                    if (retry_token) {
+                        _retry_budget.release_retry();
+                    }
+                    break;
+                }
+                timeout_ms = std::min<int64_t>(timeout_ms, left_us / 1000);
+            }
+            // an overloaded peer is not retried, the caller gets a fast error and backs off.
+            if (!_limiter.acquire()) {
+                if (retry_token) {
+                    _retry_budget.release_retry();
+                }
+                if (!attempted) {
+                    _breaker.release_probe();
+                }
+                return turbo::resource_exhausted_error(turbo::substitute("$0 is at its concurrency limit $1",
+                                                                         _server, _limiter.limit()));
+            }
+            if (retry_token) {
+                _retry_count << 1;
+            }
+            auto channel = get_channel();
+            attempted = true;
+            if (channel == nullptr) {
                 LOG_IF(WARNING, _verbose) << "connect with router server fail. channel Init fail, leader_addr:" << _server;
+                _limiter.release(-1);
+                _breaker.on_failure();
+                unreachable = true;
                 ++retry_time;
                 continue;
             }
-            short_channel.CallMethod(method, &cntl, &request, &response, nullptr);
+            melon::Controller attempt_cntl;
+            attempt_cntl.set_log_id(log_id);
+            attempt_cntl.set_timeout_ms(timeout_ms);
+            // the channel makes no retry of its own, so a backup is sent here on
+            // a second controller, within the hedge budget. the token is taken
+            // before the first call and given back if no backup is sent.
+            int64_t backup_ms = -1;
+            if (hedge) {
+                backup_ms = hedge_delay_ms(timeout_ms);
+                if (backup_ms > 0 && !_hedge_budget.acquire_retry()) {
+                    backup_ms = -1;
+                }
+            }
+            auto call_id = attempt_cntl.call_id();
+            if (cancel != nullptr && !cancel->enter(call_id)) {
+                _limiter.release(-1);
+                if (backup_ms > 0) {
+                    _hedge_budget.release_retry();
+                }
+                if (retry_token) {
+                    _retry_budget.release_retry();
+                }
+                break;
+            }
+            Response backup_response;
+            melon::Controller backup_cntl;
+            melon::Controller *result = &attempt_cntl;
+            if (backup_ms > 0) {
+                result = hedge_call(channel.get(), method, request, response, attempt_cntl, backup_response,
+                                    backup_cntl, timeout_ms, backup_ms, cancel);
+                if (result == &backup_cntl) {
+                    response.Swap(&backup_response);
+                }
+            } else {
+                channel->CallMethod(method, &attempt_cntl, &request, &response, nullptr);
+            }
+            if (cancel != nullptr) {
+                cancel->leave(call_id);
+            }
+            auto &cntl = *result;
             LOG_IF(INFO, _verbose) << "router_req[" << request.ShortDebugString() << "], router_resp["
                                    << response.ShortDebugString() << "]";
+            if (cntl.Failed() && cntl.ErrorCode() == melon::ELIMIT) {
+                // shed by the peer, it is up but busy: not retried and not held
+                // against its breaker, which would only add to its load.
+                _limiter.release(-1);
+                _breaker.release_probe();
+                _request_fail_count << 1;
+                return turbo::resource_exhausted_error(turbo::substitute("$0 shed the request: $1", _server,
+                                                                         cntl.ErrorText()));
+            }
+            release_limiter(cntl);
+            if (cntl.Failed() && cancel != nullptr && cancel->canceled()) {
+                // canceled by the caller, says nothing about the peer.
+                _breaker.release_probe();
+                break;
+            }
             if (cntl.Failed()) {
+                _request_fail_count << 1;
+                _breaker.on_failure();
+                if (connection_failure(cntl.ErrorCode())) {
+                    unreachable = true;
+                } else {
+                    delivered = true;
+                }
                 LOG_IF(WARNING, _verbose) << "connect with router server fail. send request fail, error:" << cntl.ErrorText() << ", log_id:" << cntl.log_id();
                 ++retry_time;
                 continue;
             }
+            _latency << cntl.latency_us();
+            _breaker.on_success(cntl.latency_us());
             return turbo::OkStatus();
         } while (retry_time < retry_times);
-        return turbo::deadline_exceeded_error(turbo::substitute("try times $0 reach max_try $1 and can not get response.", retry_time,
-                                                                retry_times));
-
+        return final_status(retry_time, retry_times, attempted, delivered, unreachable, cancel);
     }
-
 }
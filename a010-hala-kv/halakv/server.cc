@@ -22,21 +22,33 @@
 #include <melon/rpc/restful_service.h>
 #include <halakv/restful_service.h>
 #include <halakv/kv_service.h>
+#include <halakv/gossip_service.h>
 #include <melon/rpc/webui.h>
 #include <melon/rpc/server.h>
 #include "version.h"
 #include <halakv/cache.h>
 #include <halakv/kv_proxy.h>
+#include <halakv/namespaces.h>
+#include <halakv/compression.h>
+#include <halakv/resp_service.h>
+#include <halakv/memcache_service.h>
 DEFINE_string(peers, "127.0.0.1:8018,127.0.0.1:8019,127.0.0.1:8020", "TCP Port of this server");
 DEFINE_string(local_peer, "", "TCP Port of this server");
 DEFINE_int32(cache_size, 10, "TCP Port of this server");
 DEFINE_string(root_path, "www", "TCP Port of this server");
+DEFINE_bool(ui_from_memory, false, "Serve /ea/ui from the files under root_path kept in memory and precompressed, "
+                                   "instead of the webui service reading them on each request");
 DEFINE_int32(idle_timeout_s, -1, "Connection will be closed if there is no "
                                  "read/write operations during the last `idle_timeout_s'");
 
 DEFINE_string(certificate, "cert.pem", "Certificate file path to enable SSL");
 DEFINE_string(private_key, "key.pem", "Private key file path to enable SSL");
 DEFINE_string(ciphers, "", "Cipher suite used for SSL connections");
+DECLARE_string(namespaces);
+DECLARE_bool(rest_async_get);
+DEFINE_bool(resp, true, "Serve the redis protocol on the same port");
+DEFINE_int32(memcache_port, 0, "Serve the memcache binary protocol on this port, 0 to disable");
+DEFINE_string(kv_max_concurrency, "auto", "Max concurrency of each kv method, auto to adapt it to the latency, 0 for no limit");
 
 
 int main(int argc, char* argv[]) {
@@ -44,20 +56,35 @@ int main(int argc, char* argv[]) {
     turbo::setup_color_stderr_sink();
     // Generally you only need one Server.
     melon::Server server;
-    halakv::WebServie vue_service(FLAGS_root_path);
+    auto vue_service = std::make_shared<halakv::WebServie>(FLAGS_root_path);
 
+    auto rs = halakv::Namespaces::instance()->init(FLAGS_namespaces);
+    if(!rs.ok()) {
+        LOG(ERROR) << "init namespaces failed: " << rs;
+        return -1;
+    }
     halakv::Cache cache;
-    auto rs = cache.init(FLAGS_cache_size);
+    rs = cache.init(FLAGS_cache_size, halakv::Namespaces::instance()->options());
     if(!rs.ok()) {
         LOG(ERROR) << "init cache failed: " << rs;
         return -1;
     }
+    cache.expose("halakv_ns");
+    halakv::Compressor::instance()->expose("halakv_compress");
     halakv::KvProxy* kv_proxy = halakv::KvProxy::instance();
     rs = kv_proxy->initialize(FLAGS_peers, FLAGS_local_peer, &cache);
     if(!rs.ok()) {
         LOG(ERROR) << "init kv proxy failed: " << rs;
         return -1;
     }
+    if (FLAGS_ui_from_memory) {
+        rs = vue_service->init();
+        if(!rs.ok()) {
+            LOG(ERROR) << "load ui files failed: " << rs;
+            return -1;
+        }
+        melon::RestfulService::instance()->set_processor("/ui", vue_service);
+    }
     rs = halakv::registry_server(&server);
     if(!rs.ok()) {
         LOG(ERROR) << "register server failed: " << rs;
@@ -69,17 +96,39 @@ int main(int argc, char* argv[]) {
         LOG(ERROR) << "Fail to add kv service";
         return -1;
     }
-    melon::WebuiConfig conf = melon::WebuiConfig::default_config();
-    conf.mapping_path = "/ea/ui";
-    conf.root_path = FLAGS_root_path;
-    auto instance = melon::WebuiService::instance();
-    rs = instance->register_server(conf, &server);
-    if(!rs.ok()) {
-        LOG(ERROR) << "register webui failed: " << rs;
+    // the excess is rejected with ELIMIT before queueing, gossip and replication are not limited.
+    for (auto method: {"set", "get", "remove", "mset", "mget", "mremove",
+                        "peer_set", "peer_get", "peer_remove", "peer_mset", "peer_mget", "peer_mremove"}) {
+        server.MaxConcurrencyOf(&kv_service, method) = FLAGS_kv_max_concurrency;
+    }
+    halakv::KvRestServiceImpl rest_service;
+    if (FLAGS_rest_async_get &&
+        server.AddService(&rest_service, melon::SERVER_DOESNT_OWN_SERVICE, "/ea/cache/get => get") != 0) {
+        LOG(ERROR) << "Fail to add kv rest service";
         return -1;
     }
+    halakv::GossipServiceImpl gossip_service;
+    if(server.AddService(&gossip_service,melon::SERVER_DOESNT_OWN_SERVICE) != 0) {
+        LOG(ERROR) << "Fail to add gossip service";
+        return -1;
+    }
+    if (!FLAGS_ui_from_memory) {
+        melon::WebuiConfig conf = melon::WebuiConfig::default_config();
+        conf.mapping_path = "/ea/ui";
+        conf.root_path = FLAGS_root_path;
+        auto instance = melon::WebuiService::instance();
+        rs = instance->register_server(conf, &server);
+        if(!rs.ok()) {
+            LOG(ERROR) << "register webui failed: " << rs;
+            return -1;
+        }
+    }
     melon::ServerOptions options;
     options.idle_timeout_sec = FLAGS_idle_timeout_s;
+    if (FLAGS_resp) {
+        // owned by the server.
+        options.redis_service = new halakv::RespService();
+    }
     //options.mutable_ssl_options()->default_cert.certificate = FLAGS_certificate;
     //options.mutable_ssl_options()->default_cert.private_key = FLAGS_private_key;
     //options.mutable_ssl_options()->ciphers = FLAGS_ciphers;
@@ -87,6 +136,15 @@ int main(int argc, char* argv[]) {
         LOG(ERROR) << "Fail to start HttpServer";
         return -1;
     }
+    // the others route to the local peer once gossip finds it, it must listen by then.
+    kv_proxy->start();
+    if (FLAGS_memcache_port > 0) {
+        auto rs = halakv::MemcacheServer::instance()->start(FLAGS_memcache_port);
+        if (!rs.ok()) {
+            LOG(ERROR) << rs;
+            return -1;
+        }
+    }
     server.RunUntilAskedToQuit();
     return 0;
 }
\ No newline at end of file
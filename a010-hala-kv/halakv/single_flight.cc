@@ -0,0 +1,115 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-26.
+//
+#include <halakv/single_flight.h>
+#include <melon/utility/time.h>
+
+namespace halakv {
+
+    void SingleFlight::expose(const std::string &prefix) {
+        _leader_count.expose_as(prefix, "single_flight_leader");
+        _coalesced_count.expose_as(prefix, "single_flight_coalesced");
+        _abandoned_count.expose_as(prefix, "single_flight_abandoned");
+    }
+
+    turbo::Status SingleFlight::run(const std::string &key, halakv::KvResponse *response, const Call &call,
+                                    melon::Controller *cntl, int64_t deadline_us) {
+        Cancellation cancel(cntl);
+        std::shared_ptr<Flight> flight;
+        {
+            std::unique_lock lock(_mutex);
+            auto it = _flights.find(key);
+            if (it != _flights.end()) {
+                flight = it->second;
+                _coalesced_count << 1;
+            } else {
+                flight = std::make_shared<Flight>();
+                _flights.emplace(key, flight);
+                _leader_count << 1;
+                Fiber().run([this, key, flight, call]() {
+                    finish(key, flight, call(&flight->response, &flight->cancel));
+                });
+            }
+            // a flight is found only while it has a waiter or is not done, the
+            // last waiter leaving takes it out.
+            std::unique_lock flight_lock(flight->mutex);
+            ++flight->waiters;
+        }
+        cancel.on_cancel([flight]() {
+            std::unique_lock lock(flight->mutex);
+            flight->cond.notify_all();
+        });
+        {
+            std::unique_lock lock(flight->mutex);
+            while (!flight->done && !cancel.canceled()) {
+                if (deadline_us < 0) {
+                    flight->cond.wait(lock);
+                    continue;
+                }
+                auto left_us = deadline_us - mutil::gettimeofday_us();
+                if (left_us <= 0) {
+                    break;
+                }
+                flight->cond.wait_for(lock, left_us);
+            }
+            if (flight->done) {
+                if (flight->status.ok()) {
+                    response->CopyFrom(flight->response);
+                }
+                return flight->status;
+            }
+        }
+        bool abandoned = false;
+        {
+            std::unique_lock lock(_mutex);
+            std::unique_lock flight_lock(flight->mutex);
+            if (!flight->done && --flight->waiters == 0) {
+                auto it = _flights.find(key);
+                if (it != _flights.end() && it->second == flight) {
+                    _flights.erase(it);
+                }
+                abandoned = true;
+            }
+        }
+        if (abandoned) {
+            flight->cancel.cancel();
+            _abandoned_count << 1;
+        }
+        if (cancel.canceled()) {
+            return turbo::cancelled_error("canceled by the caller while waiting for a coalesced get");
+        }
+        return turbo::deadline_exceeded_error("deadline exceeded while waiting for a coalesced get");
+    }
+
+    void SingleFlight::finish(const std::string &key, const std::shared_ptr<Flight> &flight, turbo::Status status) {
+        {
+            std::unique_lock lock(_mutex);
+            auto it = _flights.find(key);
+            if (it != _flights.end() && it->second == flight) {
+                _flights.erase(it);
+            }
+        }
+        std::unique_lock lock(flight->mutex);
+        flight->status = std::move(status);
+        flight->done = true;
+        flight->cond.notify_all();
+    }
+
+}  // namespace halakv
@@ -0,0 +1,77 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-6-26.
+//
+#pragma once
+
+#include <turbo/utility/status.h>
+#include <melon/var/var.h>
+#include <halakv/kv.pb.h>
+#include <halakv/cancellation.h>
+#include <halakv/fiber.h>
+#include <melon/fiber/condition_variable.h>
+#include <melon/fiber/mutex.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace halakv {
+
+    // SingleFlight deduplicates concurrent gets of the same key, the first caller
+    // starts the call in a fiber and every caller waits on the flight for the
+    // shared response, without blocking the worker pthread. a caller stops
+    // waiting when its rpc is canceled or its deadline passes, the call is
+    // canceled when the last caller waiting for it left.
+    class SingleFlight {
+    public:
+        // runs after the first caller may have left, it must own what it uses.
+        using Call = std::function<turbo::Status(halakv::KvResponse *response, Cancellation *cancel)>;
+
+        SingleFlight() = default;
+
+        void expose(const std::string &prefix);
+
+        // cntl and deadline_us bound the wait of this caller only.
+        turbo::Status run(const std::string &key, halakv::KvResponse *response, const Call &call,
+                          melon::Controller *cntl = nullptr, int64_t deadline_us = -1);
+
+    private:
+        struct Flight {
+            fiber::Mutex mutex;
+            fiber::ConditionVariable cond;
+            bool done{false};
+            size_t waiters{0};
+            turbo::Status status;
+            halakv::KvResponse response;
+            // canceled when no caller waits for the call any more.
+            Cancellation cancel{nullptr};
+        };
+
+        void finish(const std::string &key, const std::shared_ptr<Flight> &flight, turbo::Status status);
+
+        std::mutex _mutex;
+        std::unordered_map<std::string, std::shared_ptr<Flight>> _flights;
+        melon::var::Adder<int64_t> _leader_count;
+        melon::var::Adder<int64_t> _coalesced_count;
+        melon::var::Adder<int64_t> _abandoned_count;
+    };
+
+}  // namespace halakv
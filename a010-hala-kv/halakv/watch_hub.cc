@@ -0,0 +1,261 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-13.
+//
+#include <halakv/watch_hub.h>
+#include <halakv/fiber.h>
+#include <halakv/key_hash.h>
+#include <halakv/namespaces.h>
+#include <gflags/gflags.h>
+#include <melon/rpc/server.h>
+#include <turbo/log/logging.h>
+#include <turbo/strings/substitute.h>
+#include <algorithm>
+#include <cerrno>
+
+DEFINE_int32(watch_flush_interval_ms, 10, "Interval of sending the pending events to the watchers");
+DEFINE_int32(watch_max_pending_keys, 100000, "Keys with events pending for a watcher before they are dropped for a resync");
+DEFINE_int32(watch_window_bytes, 4 * 1024 * 1024, "Bytes sent to a watcher ahead of what it took, events are coalesced beyond");
+
+namespace halakv {
+
+    void WatchHub::expose(const std::string &prefix) {
+        _watcher_count.expose_as(prefix, "watcher");
+        _event_count.expose_as(prefix, "event");
+        _coalesced_count.expose_as(prefix, "coalesced");
+        _resync_count.expose_as(prefix, "resync");
+        _sent_count.expose_as(prefix, "sent");
+    }
+
+    turbo::Status WatchHub::accept(melon::Controller *cntl, const halakv::WatchRequest *request) {
+        if (!Namespaces::instance()->known(request->ns())) {
+            return turbo::invalid_argument_error(turbo::substitute("unknown namespace $0", request->ns()));
+        }
+        for (auto &key: request->prefixes()) {
+            auto rs = Namespaces::check_key(key);
+            if (!rs.ok()) {
+                return rs;
+            }
+        }
+        for (auto &key: request->keys()) {
+            auto rs = Namespaces::check_key(key);
+            if (!rs.ok()) {
+                return rs;
+            }
+        }
+        auto watcher = std::make_shared<Watcher>(this, *request);
+        melon::StreamOptions options;
+        options.handler = watcher.get();
+        options.max_buf_size = FLAGS_watch_window_bytes;
+        melon::StreamId stream;
+        if (melon::StreamAccept(&stream, *cntl, &options) != 0) {
+            return turbo::invalid_argument_error("no stream in the watch request");
+        }
+        watcher->set_stream(stream);
+        {
+            std::unique_lock lock(_mutex);
+            _watchers.push_back(std::move(watcher));
+            _watcher_size.store(_watchers.size(), std::memory_order_release);
+        }
+        _watcher_count << 1;
+        LOG(INFO) << "watch from " << cntl->remote_side() << " on " << request->prefixes_size() << " prefixes and "
+                  << request->keys_size() << " keys";
+        return turbo::OkStatus();
+    }
+
+    void WatchHub::publish(const std::string &key, bool remove) {
+        if (_watcher_size.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+        std::shared_lock lock(_mutex);
+        uint64_t seq = 0;
+        for (auto &watcher: _watchers) {
+            if (!watcher->matches(key)) {
+                continue;
+            }
+            if (seq == 0) {
+                seq = _seq.fetch_add(1, std::memory_order_relaxed) + 1;
+                _event_count << 1;
+            }
+            watcher->add(seq, key, remove);
+        }
+    }
+
+    void WatchHub::run() {
+        while (!melon::IsAskedToQuit()) {
+            fiber_usleep(1000L * FLAGS_watch_flush_interval_ms);
+            if (_watcher_size.load(std::memory_order_acquire) == 0) {
+                continue;
+            }
+            std::vector<std::shared_ptr<Watcher>> watchers;
+            {
+                std::shared_lock lock(_mutex);
+                watchers = _watchers;
+            }
+            for (auto &watcher: watchers) {
+                flush(watcher.get());
+            }
+        }
+    }
+
+    void WatchHub::flush(Watcher *watcher) {
+        halakv::WatchBatch batch;
+        if (!watcher->take(&batch)) {
+            return;
+        }
+        mutil::IOBuf buf;
+        buf.append(batch.SerializeAsString());
+        auto rc = melon::StreamWrite(watcher->stream(), buf);
+        if (rc == EAGAIN) {
+            // the watcher is behind, its events wait for the next round and
+            // are coalesced with the writes meanwhile.
+            watcher->restore(batch);
+            return;
+        }
+        if (rc != 0) {
+            VLOG(10) << "write to watcher " << watcher->stream() << " failed: " << rc;
+            return;
+        }
+        _sent_count << batch.events_size();
+    }
+
+    void WatchHub::remove(Watcher *watcher) {
+        std::shared_ptr<Watcher> removed;
+        {
+            std::unique_lock lock(_mutex);
+            auto it = std::find_if(_watchers.begin(), _watchers.end(), [watcher](const std::shared_ptr<Watcher> &item) {
+                return item.get() == watcher;
+            });
+            if (it == _watchers.end()) {
+                return;
+            }
+            removed = std::move(*it);
+            _watchers.erase(it);
+            _watcher_size.store(_watchers.size(), std::memory_order_release);
+        }
+        _watcher_count << -1;
+    }
+
+    WatchHub::Watcher::Watcher(WatchHub *hub, const halakv::WatchRequest &request) : _hub(hub), _ns(request.ns()) {
+        for (auto &prefix: request.prefixes()) {
+            _prefixes.push_back(scoped_key(_ns, prefix));
+        }
+        for (auto &key: request.keys()) {
+            _keys.insert(scoped_key(_ns, key));
+        }
+        if (_prefixes.empty() && _keys.empty()) {
+            _prefixes.push_back(scoped_key(_ns, ""));
+        }
+    }
+
+    bool WatchHub::Watcher::matches(std::string_view key) const {
+        // a watcher of the default namespace does not see the others.
+        if (namespace_of(key) != _ns) {
+            return false;
+        }
+        if (!_keys.empty() && _keys.count(std::string(key)) > 0) {
+            return true;
+        }
+        return std::any_of(_prefixes.begin(), _prefixes.end(), [key](const std::string &prefix) {
+            return key.size() >= prefix.size() && key.compare(0, prefix.size(), prefix) == 0;
+        });
+    }
+
+    void WatchHub::Watcher::add(uint64_t seq, const std::string &key, bool remove) {
+        std::unique_lock lock(_mutex);
+        add_locked(seq, key, remove);
+    }
+
+    void WatchHub::Watcher::add_locked(uint64_t seq, const std::string &key, bool remove) {
+        auto it = _pending.find(key);
+        if (it != _pending.end()) {
+            if (it->second.seq < seq) {
+                it->second = Event{seq, remove};
+            }
+            _hub->_coalesced_count << 1;
+            return;
+        }
+        if (_pending.size() >= static_cast<size_t>(FLAGS_watch_max_pending_keys)) {
+            // too far behind, the watcher starts over from the resync marker.
+            _pending.clear();
+            _resync = true;
+            _resync_seq = std::max(_resync_seq, seq);
+            _hub->_resync_count << 1;
+            return;
+        }
+        _pending.emplace(key, Event{seq, remove});
+    }
+
+    bool WatchHub::Watcher::take(halakv::WatchBatch *batch) {
+        std::unordered_map<std::string, Event> pending;
+        bool resync;
+        uint64_t resync_seq;
+        {
+            std::unique_lock lock(_mutex);
+            if (_pending.empty() && !_resync) {
+                return false;
+            }
+            pending.swap(_pending);
+            resync = _resync;
+            resync_seq = _resync_seq;
+            _resync = false;
+        }
+        if (resync) {
+            batch->set_resync(true);
+            batch->set_resync_seq(resync_seq);
+        }
+        auto strip = _ns.empty() ? 0 : _ns.size() + 1;
+        batch->mutable_events()->Reserve(pending.size());
+        for (auto &it: pending) {
+            auto *event = batch->add_events();
+            event->set_seq(it.second.seq);
+            event->set_key(it.first.substr(strip));
+            if (it.second.remove) {
+                event->set_remove(true);
+            }
+        }
+        std::sort(batch->mutable_events()->begin(), batch->mutable_events()->end(),
+                  [](const halakv::WatchEvent &a, const halakv::WatchEvent &b) {
+                      return a.seq() < b.seq();
+                  });
+        return true;
+    }
+
+    void WatchHub::Watcher::restore(const halakv::WatchBatch &batch) {
+        std::unique_lock lock(_mutex);
+        if (batch.resync()) {
+            _resync = true;
+            _resync_seq = std::max(_resync_seq, batch.resync_seq());
+        }
+        for (auto &event: batch.events()) {
+            // covered by a resync taken meanwhile.
+            if (_resync && event.seq() <= _resync_seq) {
+                continue;
+            }
+            add_locked(event.seq(), scoped_key(_ns, event.key()), event.remove());
+        }
+    }
+
+    void WatchHub::Watcher::on_closed(melon::StreamId id) {
+        LOG(INFO) << "watch stream " << id << " closed";
+        // the last call on the watcher, it may be gone after.
+        _hub->remove(this);
+    }
+
+}  // namespace halakv
@@ -0,0 +1,136 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-13.
+//
+#pragma once
+
+#include <halakv/kv.pb.h>
+#include <melon/rpc/controller.h>
+#include <melon/rpc/stream.h>
+#include <melon/var/var.h>
+#include <turbo/utility/status.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace halakv {
+
+    // WatchHub pushes the writes of the keys owned by the server to the
+    // watchers over their streams, so that they can drop their own copies of
+    // the keys instead of polling. every write watched gets a seq, a watcher
+    // keeps one pending event per key, the last write, until it is sent, so a
+    // slow watcher gets the writes coalesced. past watch_max_pending_keys the
+    // pending events are dropped for a resync marker. a watcher sees only the
+    // keys owned by the server it watches, it watches every peer for all. the
+    // seqs follow the order the cache applied the writes in, publish is called
+    // under the lock of the cache, see Cache::set_write_listener.
+    class WatchHub {
+    public:
+        WatchHub() = default;
+
+        void expose(const std::string &prefix);
+
+        // accept the stream of a watch call, it lives until the watcher closes it.
+        turbo::Status accept(melon::Controller *cntl, const halakv::WatchRequest *request);
+
+        // cheap while no one watches.
+        void publish(const std::string &key, bool remove);
+
+        // sends the pending events of each watcher every watch_flush_interval_ms
+        // until asked to quit.
+        void run();
+
+    private:
+        class Watcher : public melon::StreamInputHandler {
+        public:
+            Watcher(WatchHub *hub, const halakv::WatchRequest &request);
+
+            void set_stream(melon::StreamId stream) {
+                _stream = stream;
+            }
+
+            melon::StreamId stream() const {
+                return _stream;
+            }
+
+            bool matches(std::string_view key) const;
+
+            void add(uint64_t seq, const std::string &key, bool remove);
+
+            // the pending events as a batch, false if there is none.
+            bool take(halakv::WatchBatch *batch);
+
+            // a batch the stream did not take is pending again, behind the
+            // newer writes of its keys.
+            void restore(const halakv::WatchBatch &batch);
+
+            int on_received_messages(melon::StreamId id, mutil::IOBuf *const messages[], size_t size) override {
+                return 0;
+            }
+
+            void on_idle_timeout(melon::StreamId id) override {
+            }
+
+            void on_closed(melon::StreamId id) override;
+
+        private:
+            struct Event {
+                uint64_t seq{0};
+                bool remove{false};
+            };
+
+            void add_locked(uint64_t seq, const std::string &key, bool remove);
+
+        private:
+            WatchHub *_hub;
+            melon::StreamId _stream{melon::INVALID_STREAM_ID};
+            std::string _ns;
+            // scoped to the namespace, as the keys are stored.
+            std::vector<std::string> _prefixes;
+            std::unordered_set<std::string> _keys;
+            std::mutex _mutex;
+            std::unordered_map<std::string, Event> _pending;
+            bool _resync{false};
+            uint64_t _resync_seq{0};
+        };
+
+        void remove(Watcher *watcher);
+
+        void flush(Watcher *watcher);
+
+    private:
+        std::shared_mutex _mutex;
+        std::vector<std::shared_ptr<Watcher>> _watchers;
+        std::atomic<size_t> _watcher_size{0};
+        std::atomic<uint64_t> _seq{0};
+        melon::var::Adder<int64_t> _watcher_count;
+        melon::var::Adder<int64_t> _event_count;
+        melon::var::Adder<int64_t> _coalesced_count;
+        melon::var::Adder<int64_t> _resync_count;
+        melon::var::Adder<int64_t> _sent_count;
+    };
+
+}  // namespace halakv
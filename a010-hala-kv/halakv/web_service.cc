@@ -20,12 +20,190 @@
 //
 
 #include <halakv/web_service.h>
+#include <halakv/compression.h>
+#include <halakv/fiber.h>
+#include <halakv/key_hash.h>
 #include <alkaid/files/filesystem.h>
+#include <gflags/gflags.h>
+#include <turbo/strings/match.h>
+#include <turbo/strings/str_split.h>
 #include <turbo/strings/strip.h>
+#include <turbo/strings/substitute.h>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+DEFINE_int32(web_reload_interval_s, 2, "Seconds between checks of the files under root_path for changes, 0 to not watch");
+DEFINE_int32(web_gzip_min_bytes, 1024, "Files smaller than this are not precompressed");
 
 namespace halakv {
 
-    void WebServie::process(const melon::RestfulRequest *request, melon::RestfulResponse *response) const {
+    namespace {
+
+        const std::unordered_map<std::string, std::string> kContentTypes = {
+                {".html", "text/html; charset=utf-8"},
+                {".css",  "text/css; charset=utf-8"},
+                {".js",   "application/javascript; charset=utf-8"},
+                {".json", "application/json; charset=utf-8"},
+                {".map",  "application/json; charset=utf-8"},
+                {".txt",  "text/plain; charset=utf-8"},
+                {".svg",  "image/svg+xml"},
+                {".png",  "image/png"},
+                {".jpg",  "image/jpeg"},
+                {".gif",  "image/gif"},
+                {".ico",  "image/x-icon"},
+                {".woff", "font/woff"},
+                {".woff2", "font/woff2"},
+        };
+
+        bool compressible(const std::string &content_type) {
+            return content_type.compare(0, 5, "text/") == 0 || content_type.find("javascript") != std::string::npos ||
+                   content_type.find("json") != std::string::npos || content_type.find("svg") != std::string::npos;
+        }
+
+        // If-None-Match holds a list of etags, weak ones match too, * matches any.
+        bool etag_matches(const std::string *header, const std::string &etag) {
+            if (header == nullptr) {
+                return false;
+            }
+            std::vector<std::string> items = turbo::str_split(*header, ",", turbo::SkipEmpty());
+            for (auto &item: items) {
+                std::string_view tag(item);
+                tag.remove_prefix(std::min(tag.find_first_not_of(' '), tag.size()));
+                tag.remove_suffix(tag.size() - std::min(tag.find_last_not_of(' ') + 1, tag.size()));
+                if (turbo::starts_with(tag, "W/")) {
+                    tag.remove_prefix(2);
+                }
+                if (tag == "*" || tag == etag) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    }  // namespace
+
+    WebServie::~WebServie() {
+        _stop.store(true, std::memory_order_release);
+        while (_watching.load(std::memory_order_acquire)) {
+            fiber_usleep(10 * 1000);
+        }
+    }
+
+    turbo::Status WebServie::init() {
+        auto table = std::make_shared<AssetTable>();
+        auto rs = load(table.get());
+        if (!rs.ok()) {
+            return rs;
+        }
+        LOG(INFO) << "loaded " << table->size() << " files under " << _root;
+        {
+            std::unique_lock lock(_mutex);
+            _table = std::move(table);
+            _fingerprint = fingerprint();
+        }
+        if (FLAGS_web_reload_interval_s > 0) {
+            _watching.store(true, std::memory_order_release);
+            Fiber().run([this] {
+                watch();
+            });
+        }
+        return turbo::OkStatus();
+    }
+
+    turbo::Status WebServie::load(AssetTable *table) const {
+        auto lfs = alkaid::Filesystem::localfs();
+        if (!lfs) {
+            return turbo::internal_error("no local filesystem");
+        }
+        std::error_code ec;
+        alkaid::filesystem::recursive_directory_iterator it(_root, ec);
+        if (ec) {
+            return turbo::not_found_error(turbo::substitute("can not list $0: $1", _root, ec.message()));
+        }
+        for (auto end = alkaid::filesystem::recursive_directory_iterator(); it != end; it.increment(ec)) {
+            if (ec) {
+                return turbo::internal_error(turbo::substitute("can not list $0: $1", _root, ec.message()));
+            }
+            if (!it->is_regular_file(ec)) {
+                continue;
+            }
+            auto &path = it->path();
+            std::string content;
+            auto rs = lfs->read_file(path.string(), &content);
+            if (!rs.ok()) {
+                return rs;
+            }
+            auto asset = std::make_shared<Asset>();
+            auto ct = kContentTypes.find(path.extension().string());
+            asset->content_type = ct == kContentTypes.end() ? "application/octet-stream" : ct->second;
+            char etag[24];
+            auto hash = static_cast<unsigned long>(key_hash(content));
+            snprintf(etag, sizeof(etag), "\"%016lx\"", hash);
+            asset->etag = etag;
+            std::string compressed;
+            if (content.size() >= static_cast<size_t>(FLAGS_web_gzip_min_bytes) && compressible(asset->content_type) &&
+                gzip_compress(content, &compressed, 9) && compressed.size() < content.size()) {
+                asset->gzip.append(compressed);
+                snprintf(etag, sizeof(etag), "\"%016lx-gz\"", hash);
+                asset->gzip_etag = etag;
+            }
+            asset->body.append(content);
+            auto relative = alkaid::filesystem::relative(path, _root, ec).generic_string();
+            (*table)[relative] = std::move(asset);
+        }
+        return turbo::OkStatus();
+    }
+
+    uint64_t WebServie::fingerprint() const {
+        uint64_t hash = 0;
+        std::error_code ec;
+        alkaid::filesystem::recursive_directory_iterator it(_root, ec);
+        for (auto end = alkaid::filesystem::recursive_directory_iterator(); !ec && it != end; it.increment(ec)) {
+            if (!it->is_regular_file(ec)) {
+                continue;
+            }
+            auto mtime = alkaid::filesystem::last_write_time(it->path(), ec).time_since_epoch().count();
+            auto size = it->file_size(ec);
+            // xor keeps it independent of the listing order.
+            hash ^= key_hash(turbo::substitute("$0:$1:$2", it->path().string(), mtime, size));
+        }
+        return hash;
+    }
+
+    void WebServie::watch() {
+        while (!_stop.load(std::memory_order_acquire)) {
+            for (int i = 0; i < FLAGS_web_reload_interval_s * 10 && !_stop.load(std::memory_order_acquire); i++) {
+                fiber_usleep(100 * 1000);
+            }
+            auto current = fingerprint();
+            {
+                std::unique_lock lock(_mutex);
+                if (current == _fingerprint) {
+                    continue;
+                }
+            }
+            auto table = std::make_shared<AssetTable>();
+            auto rs = load(table.get());
+            if (!rs.ok()) {
+                // a file may be half written, try again on the next round.
+                LOG(WARNING) << "reload files under " << _root << " failed: " << rs;
+                continue;
+            }
+            LOG(INFO) << "reloaded " << table->size() << " files under " << _root;
+            std::unique_lock lock(_mutex);
+            _table = std::move(table);
+            _fingerprint = current;
+        }
+        _watching.store(false, std::memory_order_release);
+    }
+
+    std::shared_ptr<const WebServie::AssetTable> WebServie::table() const {
+        std::unique_lock lock(_mutex);
+        return _table;
+    }
+
+    void WebServie::process(const melon::RestfulRequest *request, melon::RestfulResponse *response) {
         // process request
         auto unresolved_path = request->unresolved_path();
         // path must starts with "ui"
@@ -38,52 +216,33 @@ namespace halakv {
         if(unresolved_path.empty()) {
             unresolved_path = "index.html";
         }
-        auto path = alkaid::filesystem::path(_root) / unresolved_path;
-        LOG(INFO)<<"path: "<<path.string();
-        std::error_code ec;
-        if(!alkaid::filesystem::exists(path, ec)) {
+        response->set_header("Vary", "Accept-Encoding");
+        auto assets = table();
+        auto it = assets ? assets->find(unresolved_path) : AssetTable::const_iterator();
+        if(!assets || it == assets->end()) {
             response->set_status_code(404);
             response->set_header("Content-Type", "text/html; charset=utf-8");
-            response->set_header("Vary", "Accept-Encoding");
             response->set_body("404 not found");
             return;
         }
-        auto lfs = alkaid::Filesystem::localfs();
-        if(!lfs) {
-            response->set_status_code(500);
-            response->set_header("Content-Type", "text/html; charset=utf-8");
-            response->set_header("Vary", "Accept-Encoding");
-            response->set_body("500 internal error");
-            return;
-        }
-        std::string content;
-        auto rs =lfs->read_file(path.string(),&content);
-        if(!rs.ok()) {
-            response->set_status_code(500);
-            response->set_header("Content-Type", "text/html; charset=utf-8");
-            response->set_header("Vary", "Accept-Encoding");
-            response->set_body("500 internal error");
+        auto &asset = *it->second;
+        auto gzip = !asset.gzip.empty() && Compressor::accepts_gzip(request->header("Accept-Encoding"));
+        auto &etag = gzip ? asset.gzip_etag : asset.etag;
+        response->set_header("ETag", etag);
+        response->set_header("Cache-Control", "no-cache");
+        if (etag_matches(request->header("If-None-Match"), etag)) {
+            response->set_status_code(304);
             return;
         }
-        std::string ct = "text/html; charset=utf-8";
-        if(path.extension() == ".css") {
-            ct = "text/css; charset=utf-8";
-        } else if(path.extension() == ".js") {
-            ct = "application/javascript; charset=utf-8";
-        } else if(path.extension() == ".png") {
-            ct = "image/png";
-        } else if(path.extension() == ".jpg") {
-            ct = "image/jpeg";
-        } else if(path.extension() == ".gif") {
-            ct = "image/gif";
-        } else if(path.extension() == ".ico") {
-            ct = "image/x-icon";
-        }
-        LOG(INFO)<<"file path: "<<path.string()<<" content size: "<<content.size();
         response->set_status_code(200);
-        response->set_header("Content-Type", ct);
-        response->set_header("Vary", "Accept-Encoding");
-        response->set_body(content);
+        response->set_header("Content-Type", asset.content_type);
+        // the bodies share the blocks of the table, the table may be swapped meanwhile.
+        if (gzip) {
+            response->set_header("Content-Encoding", "gzip");
+            response->set_body(asset.gzip);
+        } else {
+            response->set_body(asset.body);
+        }
     }
 
-}  // namespace halavue
\ No newline at end of file
+}  // namespace halakv
@@ -22,17 +22,61 @@
 
 #include <melon/rpc/restful_service.h>
 #include <melon/rpc/server.h>
+#include <melon/utility/iobuf.h>
+#include <turbo/utility/status.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 namespace halakv {
 
-    class WebServie {
+    // WebServie serves the files under root from memory. they are loaded once
+    // into a table keyed by path, with a gzip body for the text ones, an etag
+    // and a content type, and the table is rebuilt and swapped when a watcher
+    // sees a file change. a request takes a reference to the bodies, nothing
+    // is copied or read from disk.
+    class WebServie : public melon::RestfulProcessor {
     public:
         explicit WebServie(const std::string &root) : _root(root){}
 
-        void process(const melon::RestfulRequest *request, melon::RestfulResponse *response) const;
+        ~WebServie() override;
+
+        // loads the files and starts watching them.
+        turbo::Status init();
+
+        void process(const melon::RestfulRequest *request, melon::RestfulResponse *response) override;
+
+    private:
+        struct Asset {
+            std::string content_type;
+            std::string etag;
+            mutil::IOBuf body;
+            // empty when it does not pay to compress.
+            mutil::IOBuf gzip;
+            // the gzip body is another representation, it has a tag of its own.
+            std::string gzip_etag;
+        };
+        using AssetTable = std::unordered_map<std::string, std::shared_ptr<const Asset>>;
+
+        turbo::Status load(AssetTable *table) const;
+
+        // a hash of the paths, sizes and mtimes under root, it moves when a file changes.
+        uint64_t fingerprint() const;
+
+        void watch();
+
+        std::shared_ptr<const AssetTable> table() const;
 
     private:
         std::string _root;
+        mutable std::mutex _mutex;
+        std::shared_ptr<const AssetTable> _table;
+        uint64_t _fingerprint{0};
+        std::atomic<bool> _stop{false};
+        std::atomic<bool> _watching{false};
     };
 
 }  // namespace halakv
@@ -0,0 +1,241 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Created by jeff on 24-7-13.
+//
+// starts a few kv servers on localhost and checks how keys are placed and
+// served across them as members join and die.
+
+#include <gtest/gtest.h>
+#include <halakv/kv.pb.h>
+#include <halakv/key_hash.h>
+#include <melon/rpc/channel.h>
+#include <melon/rpc/controller.h>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <memory>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+    constexpr int kBasePort = 18618;
+
+    std::string address_of(int port) {
+        return "127.0.0.1:" + std::to_string(port);
+    }
+
+    class Server {
+    public:
+        Server(int port, const std::string &peers) : _address(address_of(port)) {
+            std::vector<std::string> args = {
+                    HALAKV_SERVER_PATH,
+                    "--local_peer=" + _address,
+                    "--peers=" + peers,
+                    "--cache_size=10000",
+                    "--replica_capacity=10000",
+                    "--resp=false",
+                    "--gossip_interval_ms=100",
+                    "--gossip_ping_timeout_ms=100",
+                    "--gossip_suspect_timeout_ms=1000",
+                    "--gossip_join_grace_ms=1000",
+                    "--anti_entropy_interval_ms=200",
+            };
+            _pid = fork();
+            if (_pid == 0) {
+                std::vector<char *> argv;
+                for (auto &arg: args) {
+                    argv.push_back(arg.data());
+                }
+                argv.push_back(nullptr);
+                execv(argv[0], argv.data());
+                _exit(127);
+            }
+            _channel = std::make_unique<melon::Channel>();
+            melon::ChannelOptions options;
+            options.timeout_ms = 500;
+            options.max_retry = 0;
+            _channel->Init(_address.c_str(), &options);
+        }
+
+        ~Server() {
+            kill(SIGTERM);
+        }
+
+        void kill(int sig = SIGKILL) {
+            if (_pid > 0) {
+                ::kill(_pid, sig);
+                waitpid(_pid, nullptr, 0);
+                _pid = -1;
+            }
+        }
+
+        const std::string &address() const {
+            return _address;
+        }
+
+        bool route(halakv::RouteTable *table) {
+            melon::Controller cntl;
+            halakv::RouteRequest request;
+            halakv::KvService_Stub(_channel.get()).route(&cntl, &request, table, nullptr);
+            return !cntl.Failed();
+        }
+
+        bool set(const std::string &key, const std::string &value) {
+            melon::Controller cntl;
+            halakv::KvRequest request;
+            halakv::KvResponse response;
+            request.set_key(key);
+            request.set_value(value);
+            halakv::KvService_Stub(_channel.get()).set(&cntl, &request, &response, nullptr);
+            return !cntl.Failed() && response.code() == 0;
+        }
+
+        // empty if the key is not found or the call failed.
+        std::string get(const std::string &key) {
+            melon::Controller cntl;
+            halakv::KvRequest request;
+            halakv::KvResponse response;
+            request.set_key(key);
+            halakv::KvService_Stub(_channel.get()).get(&cntl, &request, &response, nullptr);
+            return cntl.Failed() ? std::string() : response.value();
+        }
+
+    private:
+        std::string _address;
+        pid_t _pid{-1};
+        std::unique_ptr<melon::Channel> _channel;
+    };
+
+    // true once server sees the members alive or dead as asked, within timeout_ms.
+    bool wait_route(Server &server, const std::vector<std::string> &alive, const std::vector<std::string> &dead,
+                    int timeout_ms = 10000) {
+        for (int waited = 0; waited < timeout_ms; waited += 100) {
+            halakv::RouteTable table;
+            if (server.route(&table)) {
+                size_t matched = 0;
+                for (int i = 0; i < table.peers_size(); i++) {
+                    auto &peer = table.peers(i);
+                    auto &expect = table.alive(i) ? alive : dead;
+                    matched += std::find(expect.begin(), expect.end(), peer) != expect.end();
+                }
+                if (matched == alive.size() + dead.size()) {
+                    return true;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        return false;
+    }
+
+    // the owner of the key and its backup, the peer after it in the route.
+    std::pair<std::string, std::string> placement(const halakv::RouteTable &table, const std::string &key) {
+        std::vector<uint64_t> hashes;
+        for (auto &peer: table.peers()) {
+            hashes.push_back(halakv::key_hash(peer));
+        }
+        auto pos = halakv::owner_of(key, hashes);
+        return {table.peers(pos), table.peers((pos + 1) % table.peers_size())};
+    }
+
+    class ClusterTest : public testing::Test {
+    protected:
+        void start(int count) {
+            std::string peers;
+            for (int i = 0; i < count; i++) {
+                peers += (i > 0 ? "," : "") + address_of(kBasePort + i);
+            }
+            for (int i = 0; i < count; i++) {
+                _servers.push_back(std::make_unique<Server>(kBasePort + i, peers));
+                _addresses.push_back(address_of(kBasePort + i));
+            }
+            for (auto &server: _servers) {
+                ASSERT_TRUE(wait_route(*server, _addresses, {}));
+            }
+        }
+
+        Server &server_of(const std::string &address) {
+            for (auto &server: _servers) {
+                if (server->address() == address) {
+                    return *server;
+                }
+            }
+            return *_servers.front();
+        }
+
+        std::vector<std::unique_ptr<Server>> _servers;
+        std::vector<std::string> _addresses;
+    };
+
+    TEST_F(ClusterTest, EveryServerFindsTheOwner) {
+        start(3);
+        for (int i = 0; i < 64; i++) {
+            auto key = "key" + std::to_string(i);
+            ASSERT_TRUE(_servers[i % 3]->set(key, "value" + std::to_string(i)));
+        }
+        for (auto &server: _servers) {
+            for (int i = 0; i < 64; i++) {
+                EXPECT_EQ(server->get("key" + std::to_string(i)), "value" + std::to_string(i));
+            }
+        }
+    }
+
+    TEST_F(ClusterTest, BackupServesTheKeysOfADeadOwner) {
+        start(3);
+        halakv::RouteTable table;
+        ASSERT_TRUE(_servers.front()->route(&table));
+        for (int i = 0; i < 64; i++) {
+            ASSERT_TRUE(_servers.front()->set("key" + std::to_string(i), "value" + std::to_string(i)));
+        }
+        // the writes are shipped to the backups in the background.
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        auto dead = placement(table, "key0").first;
+        server_of(dead).kill();
+        std::vector<std::string> alive;
+        for (auto &address: _addresses) {
+            if (address != dead) {
+                alive.push_back(address);
+            }
+        }
+        ASSERT_TRUE(wait_route(server_of(alive.front()), alive, {dead}));
+        for (int i = 0; i < 64; i++) {
+            auto key = "key" + std::to_string(i);
+            if (placement(table, key).first == dead) {
+                EXPECT_EQ(server_of(alive.back()).get(key), "value" + std::to_string(i));
+            }
+        }
+    }
+
+    TEST_F(ClusterTest, ANewServerJoinsAlive) {
+        start(2);
+        // seeded with one member only, the others find it by gossip.
+        auto joined = address_of(kBasePort + 2);
+        _servers.push_back(std::make_unique<Server>(kBasePort + 2, _addresses.front() + "," + joined));
+        _addresses.push_back(joined);
+        for (auto &server: _servers) {
+            ASSERT_TRUE(wait_route(*server, _addresses, {}));
+        }
+        ASSERT_TRUE(_servers.front()->set("joined", "yes"));
+        EXPECT_EQ(server_of(joined).get("joined"), "yes");
+    }
+
+}  // namespace